@@ -18,8 +18,10 @@
 //		TODO: Let's add a capture for 6309 illegal opcodes and correct cycle behavior for 6809 illegal opcodes.
 //
 #pragma once
+#ifdef _MSC_VER
 #pragma warning(push)
 #pragma warning(disable : 26812)
+#endif
 #include <string>
 #include <map>
 #include <array>
@@ -297,7 +299,7 @@ namespace VCC::Debugger
 			0xCA,	"ORB",		Immediate,		2,		2,		2,		1,	false,	Fixed,
 			0xCB,	"ADDB",		Immediate,		2,		2,		2,		1,	false,	Fixed,
 			0xCC,	"LDD",		Immediate,		3,		3,		3,		1,	false,	Fixed,
-			0xCD,	"LDQ",		Immediate,		5,		5,		5,		1,	false,	Fixed,
+			0xCD,	"LDQ",		Immediate,		5,		5,		5,		1,	true,	Fixed,						// Illegal on 6809
 			0xCE,	"LDU",		Immediate,		3,		3,		3,		1,	false,	Fixed,
 			0xCF,	"-",		Illegal,		0,		0,		0,		1,	false,	None,
 																				
@@ -606,8 +608,8 @@ namespace VCC::Debugger
 			0xE9,	"-",		Illegal,		0,		0,		0,		2,	false,	None,
 			0xEA,	"-",		Illegal,		0,		0,		0,		2,	false,	None,
 			0xEB,	"-",		Illegal,		0,		0,		0,		2,	false,	None,
-			0xEC,	"LDQ",		Indexed,		0,		8,		3,		2,	false,	IndexedModeAdjust,
-			0xED,	"STQ",		Indexed,		0,		8,		3,		2,	false,	IndexedModeAdjust,
+			0xEC,	"LDQ",		Indexed,		0,		8,		3,		2,	true,	IndexedModeAdjust,			// Illegal on 6809
+			0xED,	"STQ",		Indexed,		0,		8,		3,		2,	true,	IndexedModeAdjust,			// Illegal on 6809
 			0xEE,	"LDS",		Indexed,		6,		6,		3,		2,	false,	IndexedModeAdjust,
 			0xEF,	"STS",		Indexed,		6,		6,		3,		2,	false,	IndexedModeAdjust,
 																			
@@ -623,8 +625,8 @@ namespace VCC::Debugger
 			0xF9,	"-",		Illegal,		0,		0,		0,		2,	false,	None,
 			0xFA,	"-",		Illegal,		0,		0,		0,		2,	false,	None,
 			0xFB,	"-",		Illegal,		0,		0,		0,		2,	false,	None,
-			0xFC,	"LDQ",		Extended,		0,		8,		4,		2,	false,	Fixed,
-			0xFD,	"STQ",		Extended,		0,		8,		4,		2,	false,	Fixed,
+			0xFC,	"LDQ",		Extended,		0,		8,		4,		2,	true,	Fixed,						// Illegal on 6809
+			0xFD,	"STQ",		Extended,		0,		8,		4,		2,	true,	Fixed,						// Illegal on 6809
 			0xFE,	"LDS",		Extended,		7,		6,		4,		2,	false,	Fixed,
 			0xFF,	"STS",		Extended,		7,		6,		4,		2,	false,	Fixed,
 		};
@@ -984,4 +986,6 @@ namespace VCC::Debugger
 	};
 }
 
+#ifdef _MSC_VER
 #pragma warning(pop)
+#endif
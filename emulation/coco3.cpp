@@ -16,6 +16,7 @@ This file is part of VCC (Virtual Color Computer).
     along with VCC (Virtual Color Computer).  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 #include <cstring>
@@ -34,6 +35,8 @@ This file is part of VCC (Virtual Color Computer).
 #include "cutie/audio.h"
 #include "coco3.h"
 #include "tcc1014mmu.h"
+#include "cutie/perfcounters.h"
+#include "cutie/timeline.h"
 #include "vcc/utils/logger.h"
 
 // Debug audio tape support disabled for Qt port
@@ -81,6 +84,21 @@ double TimeToHSYNCLow = 0;
 double TimeToHSYNCHigh = 0;
 static unsigned char LastMotorState;
 static int AudioFreeBlockCount;
+// Beam position for the register write timeline
+static unsigned short BeamLine=0;
+static int LineCycles=0;
+static unsigned char CPURunning=0;
+static uint64_t CyclesRun=0;		// Since power on, for timing cassette output
+// Coalesced fields, see RunCoalescedField()
+static bool CoalesceLines=true;
+static bool FieldCoalesced=false;	// The CPU is running through several lines at once
+static bool FieldEnding=false;		// and has been asked to stop
+static bool FieldDraw=false;
+static SystemState *FieldState=nullptr;
+static unsigned short FieldFirstLine=0;
+static unsigned int FieldLines=0;
+static unsigned int FieldStep=0;	// HSYNC edges caught up, two per line
+static double FieldDrift=0;			// Cycles owed to the CPU when the run started
 
 static int clipcycle = 1, cyclewait=2000;
 bool codepaste, PasteWithNew = false; 
@@ -95,6 +113,8 @@ void (*UpdateScreen[4]) (SystemState *)={UpdateScreen8,UpdateScreen16,UpdateScre
 void HLINE();
 void VSYNC(unsigned char level);
 void HSYNC(unsigned char level);
+static bool CanCoalesceField();
+static bool RunCoalescedField(SystemState *RFState, bool Draw);
 
 using namespace std;
 
@@ -182,6 +202,8 @@ float RenderFrame (SystemState *RFState)
 
 //********************************Start of frame Render*****************************************************
 
+	BeamLine = 0;
+
 	// Blink state toggle
 	if (BlinkPhase++ > RENDERS_PER_BLINK_TOGGLE) {
 		TogBlinkState();
@@ -206,56 +228,78 @@ float RenderFrame (SystemState *RFState)
 		HLINE();
 	}
 
-	// Top Border actually begins here, but is offscreen
-	for (RFState->LineCounter = 0; RFState->LineCounter < TopOffScreen; RFState->LineCounter++)
-	{
-		HLINE();
-	}
-
-	if (!(FrameCounter % RFState->FrameSkip))
+	if (CanCoalesceField())
 	{
-		if (LockScreen())
+		if (!RunCoalescedField(RFState, !(FrameCounter % RFState->FrameSkip)))
 			return 0;
 	}
-
-	// Visible Top Border begins here. (Remove 4 lines for centering)
-	RFState->Debugger.TraceCaptureScreenEvent(VCC::TraceEvent::ScreenTopBorder, 0);
-	for (RFState->LineCounter = 0; RFState->LineCounter < TopBoarder; RFState->LineCounter++)
+	else
 	{
-		HLINE();
-		if (!(FrameCounter % RFState->FrameSkip))
-			DrawTopBoarder[RFState->BitDepth](RFState);
-	}
+		// Top Border actually begins here, but is offscreen
+		for (RFState->LineCounter = 0; RFState->LineCounter < TopOffScreen; RFState->LineCounter++)
+		{
+			HLINE();
+		}
 
-	// Main Screen begins here: LPF = 192, 200 (actually 199), 225
-	RFState->Debugger.TraceCaptureScreenEvent(VCC::TraceEvent::ScreenRender, 0);
-	for (RFState->LineCounter = 0; RFState->LineCounter < LinesperScreen; RFState->LineCounter++)		
-	{
-		HLINE();
 		if (!(FrameCounter % RFState->FrameSkip))
-			UpdateScreen[RFState->BitDepth](RFState);
-	}
+		{
+			if (LockScreen())
+				return 0;
+		}
+
+		// Visible Top Border begins here. (Remove 4 lines for centering)
+		RFState->Debugger.TraceCaptureScreenEvent(VCC::TraceEvent::ScreenTopBorder, 0);
+		for (RFState->LineCounter = 0; RFState->LineCounter < TopBoarder; RFState->LineCounter++)
+		{
+			HLINE();
+			if (!(FrameCounter % RFState->FrameSkip))
+			{
+				SwitchPerfPhase(cutie::PerfPhase::Render);
+				DrawTopBoarder[RFState->BitDepth](RFState);
+				SwitchPerfPhase(cutie::PerfPhase::Cpu);
+			}
+		}
+
+		// Main Screen begins here: LPF = 192, 200 (actually 199), 225
+		RFState->Debugger.TraceCaptureScreenEvent(VCC::TraceEvent::ScreenRender, 0);
+		for (RFState->LineCounter = 0; RFState->LineCounter < LinesperScreen; RFState->LineCounter++)		
+		{
+			HLINE();
+			if (!(FrameCounter % RFState->FrameSkip))
+			{
+				SwitchPerfPhase(cutie::PerfPhase::Render);
+				UpdateScreen[RFState->BitDepth](RFState);
+				SwitchPerfPhase(cutie::PerfPhase::Cpu);
+			}
+		}
+
+		// Bottom Border begins here.
+		RFState->Debugger.TraceCaptureScreenEvent(VCC::TraceEvent::ScreenBottomBorder, 0);
+		for (RFState->LineCounter=0;RFState->LineCounter < BottomBoarder;RFState->LineCounter++)
+		{
+			HLINE();
+			if (!(FrameCounter % RFState->FrameSkip))
+			{
+				SwitchPerfPhase(cutie::PerfPhase::Render);
+				DrawBottomBoarder[RFState->BitDepth](RFState);
+				SwitchPerfPhase(cutie::PerfPhase::Cpu);
+			}
+		}
 
-	// Bottom Border begins here.
-	RFState->Debugger.TraceCaptureScreenEvent(VCC::TraceEvent::ScreenBottomBorder, 0);
-	for (RFState->LineCounter=0;RFState->LineCounter < BottomBoarder;RFState->LineCounter++)
-	{
-		HLINE();
 		if (!(FrameCounter % RFState->FrameSkip))
+		{
+			SwitchPerfPhase(cutie::PerfPhase::Render);
 			DrawBottomBoarder[RFState->BitDepth](RFState);
-	}
-
-	if (!(FrameCounter % RFState->FrameSkip))
-	{
-		DrawBottomBoarder[RFState->BitDepth](RFState);
-		UnlockScreen(RFState);
-		SetBoarderChange();
-	}
+			UnlockScreen(RFState);
+			SetBoarderChange();
+			SwitchPerfPhase(cutie::PerfPhase::Cpu);
+		}
 
-	// Bottom Border continues but is offscreen
-	for (RFState->LineCounter = 0; RFState->LineCounter < BottomOffScreen; RFState->LineCounter++)
-	{
-		HLINE();
+		// Bottom Border continues but is offscreen
+		for (RFState->LineCounter = 0; RFState->LineCounter < BottomOffScreen; RFState->LineCounter++)
+		{
+			HLINE();
+		}
 	}
 
 	switch (SoundOutputMode)
@@ -271,6 +315,8 @@ float RenderFrame (SystemState *RFState)
 
 	DebugDrawAudio();
 
+	cutie::getRegisterTimeline().endFrame();
+
 	// Only affect frame rate if a debug window is open.
 	RFState->Debugger.Update();
 
@@ -376,6 +422,7 @@ DisplayDetails GetDisplayDetails(const int clientWidth, const int clientHeight)
 inline void HLINE()
 {
 	UpdateAudio();
+	pia0_scan_keyboard();
 
 	// First part of the line
 	CPUCycle(NanosPerLine - HSYNCWidthInNanos);
@@ -389,6 +436,65 @@ inline void HLINE()
 
 	// HSYNC goes high
 	HSYNC(1);
+
+	BeamLine++;
+	LineCycles = 0;
+}
+
+// Runs the CPU and keeps count of the cycles spent on this scanline
+static inline int RunCPU(int Cycles)
+{
+	CPURunning = 1;
+	const int Over = CPUExec(Cycles);
+	CPURunning = 0;
+	LineCycles += Cycles - Over;
+	CyclesRun += Cycles - Over;
+	return Over;
+}
+
+// Cycles run since the start of the line, or of the coalesced run
+static int BeamCycles()
+{
+	int Cycles = LineCycles;
+	if (CPURunning)
+		Cycles += (CPUExec == HD6309Exec) ? HD6309SliceCycles() : MC6809SliceCycles();
+	return Cycles;
+}
+
+// Cycles the CPU has run into a coalesced run when HSYNC edge Step goes by.
+// These are the targets CPUCycle() would have stopped the CPU at.
+static double FieldEdgeCycles(unsigned int Step)
+{
+	double Nanos = (Step / 2) * NanosPerLine + NanosPerLine;
+	if (!(Step & 1))
+		Nanos -= HSYNCWidthInNanos;
+	return floor(FieldDrift + Nanos * CyclesPerLine * OverClock / NanosPerLine);
+}
+
+// CPU cycles run since power on, including the slice in progress
+uint64_t GetCpuCycleCount()
+{
+	uint64_t Cycles = CyclesRun;
+	if (CPURunning)
+		Cycles += (CPUExec == HD6309Exec) ? HD6309SliceCycles() : MC6809SliceCycles();
+	return Cycles;
+}
+
+void GetBeamPosition(unsigned short &Line, unsigned short &Cycle)
+{
+	int Cycles = BeamCycles();
+	Line = BeamLine;
+	if (FieldCoalesced)
+	{
+		// Find the line from its end, HSYNC going high
+		unsigned int Step = FieldStep | 1;
+		while (Step < 2 * FieldLines && FieldEdgeCycles(Step) <= Cycles)
+			Step += 2;
+		Line = FieldFirstLine + Step / 2;
+		if (Step > 1)
+			Cycles -= (int)FieldEdgeCycles(Step - 2);
+	}
+	Cycle = (unsigned short)Cycles;
 }
 
 inline void CPUCycle(double NanosToRun)
@@ -405,8 +511,14 @@ inline void CPUCycle(double NanosToRun)
 	while (NanosThisLine >= 1)
 	{
 		StateSwitch = 0;
-		if ((NanosToInterrupt <= NanosThisLine) & IntEnable)	//Does this iteration need to Timer Interupt
-			StateSwitch = 1;
+		// A masked timer is not a deadline; its count runs on in NanosToInterrupt
+		if (IntEnable & TimerInteruptEnabled)
+		{
+			if (NanosToInterrupt < 0)	// Fell due inside the last slice
+				NanosToInterrupt = 0;
+			if (NanosToInterrupt <= NanosThisLine)	//Does this iteration need to Timer Interupt
+				StateSwitch = 1;
+		}
 		if ((NanosToSoundSample <= NanosThisLine) & SndEnable)//Does it need to collect an Audio sample
 			StateSwitch += 2;
 		switch (StateSwitch)
@@ -414,7 +526,7 @@ inline void CPUCycle(double NanosToRun)
 		case 0:		//No interupts this line
 			CyclesThisLine = CycleDrift + (NanosThisLine * CyclesPerLine * OverClock / NanosPerLine);
 			if (CyclesThisLine >= 1)	//Avoid un-needed CPU engine calls
-				CycleDrift = CPUExec((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
+				CycleDrift = RunCPU((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
 			else
 				CycleDrift = CyclesThisLine;
 			EmuState.Debugger.TraceEmulatorCycle(VCC::TraceEvent::EmulatorCycle, StateSwitch, NanosThisLine, NanosToInterrupt, NanosToSoundSample, CyclesThisLine, CycleDrift);
@@ -429,7 +541,7 @@ inline void CPUCycle(double NanosToRun)
 			NanosThisLine -= NanosToInterrupt;
 			CyclesThisLine = CycleDrift + (NanosToInterrupt * CyclesPerLine * OverClock / NanosPerLine);
 			if (CyclesThisLine >= 1)
-				CycleDrift = CPUExec((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
+				CycleDrift = RunCPU((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
 			else
 				CycleDrift = CyclesThisLine;
 			EmuState.Debugger.TraceEmulatorCycle(VCC::TraceEvent::EmulatorCycle, StateSwitch, NanosThisLine, NanosToInterrupt, NanosToSoundSample, CyclesThisLine, CycleDrift);
@@ -444,7 +556,7 @@ inline void CPUCycle(double NanosToRun)
 			NanosThisLine -= NanosToSoundSample;
 			CyclesThisLine = CycleDrift + (NanosToSoundSample * CyclesPerLine * OverClock / NanosPerLine);
 			if (CyclesThisLine >= 1)
-				CycleDrift = CPUExec((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
+				CycleDrift = RunCPU((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
 			else
 				CycleDrift = CyclesThisLine;
 			EmuState.Debugger.TraceEmulatorCycle(VCC::TraceEvent::EmulatorCycle, StateSwitch, NanosThisLine, NanosToInterrupt, NanosToSoundSample, CyclesThisLine, CycleDrift);
@@ -461,7 +573,7 @@ inline void CPUCycle(double NanosToRun)
 				NanosThisLine -= NanosToSoundSample;
 				CyclesThisLine = CycleDrift + (NanosToSoundSample * CyclesPerLine * OverClock / NanosPerLine);
 				if (CyclesThisLine >= 1)
-					CycleDrift = CPUExec((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
+					CycleDrift = RunCPU((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
 				else
 					CycleDrift = CyclesThisLine;
 				EmuState.Debugger.TraceEmulatorCycle(VCC::TraceEvent::EmulatorCycle, 3, NanosThisLine, NanosToInterrupt, NanosToSoundSample, CyclesThisLine, CycleDrift);
@@ -474,7 +586,7 @@ inline void CPUCycle(double NanosToRun)
 
 				CyclesThisLine = CycleDrift + (NanosToInterrupt * CyclesPerLine * OverClock / NanosPerLine);
 				if (CyclesThisLine >= 1)
-					CycleDrift = CPUExec((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
+					CycleDrift = RunCPU((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
 				else
 					CycleDrift = CyclesThisLine;
 				EmuState.Debugger.TraceEmulatorCycle(VCC::TraceEvent::EmulatorCycle, 4, NanosThisLine, NanosToInterrupt, NanosToSoundSample, CyclesThisLine, CycleDrift);
@@ -491,7 +603,7 @@ inline void CPUCycle(double NanosToRun)
 				NanosThisLine -= NanosToInterrupt;
 				CyclesThisLine = CycleDrift + (NanosToInterrupt * CyclesPerLine * OverClock / NanosPerLine);
 				if (CyclesThisLine >= 1)
-					CycleDrift = CPUExec((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
+					CycleDrift = RunCPU((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
 				else
 					CycleDrift = CyclesThisLine;
 				EmuState.Debugger.TraceEmulatorCycle(VCC::TraceEvent::EmulatorCycle, 5, NanosThisLine, NanosToInterrupt, NanosToSoundSample, CyclesThisLine, CycleDrift);
@@ -503,7 +615,7 @@ inline void CPUCycle(double NanosToRun)
 				NanosThisLine -= NanosToSoundSample;
 				CyclesThisLine = CycleDrift + (NanosToSoundSample * CyclesPerLine * OverClock / NanosPerLine);
 				if (CyclesThisLine >= 1)
-					CycleDrift = CPUExec((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
+					CycleDrift = RunCPU((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
 				else
 					CycleDrift = CyclesThisLine;
 				EmuState.Debugger.TraceEmulatorCycle(VCC::TraceEvent::EmulatorCycle, 6, NanosThisLine, NanosToInterrupt, NanosToSoundSample, CyclesThisLine, CycleDrift);
@@ -518,7 +630,7 @@ inline void CPUCycle(double NanosToRun)
 			NanosThisLine -= NanosToInterrupt;
 			CyclesThisLine = CycleDrift + (NanosToSoundSample * CyclesPerLine * OverClock / NanosPerLine);
 			if (CyclesThisLine > 1)
-				CycleDrift = CPUExec((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
+				CycleDrift = RunCPU((int)floor(CyclesThisLine)) + (CyclesThisLine - floor(CyclesThisLine));
 			else
 				CycleDrift = CyclesThisLine;
 			EmuState.Debugger.TraceEmulatorCycle(VCC::TraceEvent::EmulatorCycle, 7, NanosThisLine, NanosToInterrupt, NanosToSoundSample, CyclesThisLine, CycleDrift);
@@ -533,8 +645,271 @@ inline void CPUCycle(double NanosToRun)
 	EmuState.Debugger.TraceEmulatorCycle(VCC::TraceEvent::EmulatorCycle, 20, 0, 0, 0, emulationCycles, emulationDrift);
 }
 
+// Coalesced fields. While nothing can see single scanlines (no HSYNC
+// interrupt from the GIME or PIA, no GIME keyboard interrupt, no trace) the
+// CPU runs from the end of VSYNC to the end of the frame in as few slices as
+// the timer and audio allow. The work HLINE() does between slices, HSYNC
+// edges and drawing, is caught up when the PIA is read and when the run is
+// over. A write that changes the picture or enables a line interrupt catches
+// up and drops back to line by line execution for the rest of the frame.
+// A write to the RAM the picture is read from also catches up first, so the
+// lines the beam has passed keep what they held, as when racing the beam.
+
+void SetLineCoalescing(bool Enabled)
+{
+	CoalesceLines = Enabled;
+}
+
+static bool CanCoalesceField()
+{
+	return CoalesceLines && !HorzInteruptEnabled && !PiaHsyncInteruptEnabled() && !GimeKeyboardInteruptEnabled()
+		&& !EmuState.Debugger.IsTracingEnabled() && !EmuState.Debugger.IsHalted();
+}
+
+// Lines from the end of VSYNC to the end of the frame
+static unsigned int FieldLength()
+{
+	return TopOffScreen + TopBoarder + LinesperScreen + BottomBoarder + BottomOffScreen;
+}
+
+// Draws line Line of the field as the line by line loops in RenderFrame() do
+static void DrawFieldLine(unsigned int Line)
+{
+	SystemState *RFState = FieldState;
+	const unsigned int Top = TopOffScreen;
+	const unsigned int Main = Top + TopBoarder;
+	const unsigned int Bottom = Main + LinesperScreen;
+	const unsigned int End = Bottom + BottomBoarder;
+	if (!FieldDraw || Line < Top || Line >= End)
+		return;
+
+	SwitchPerfPhase(cutie::PerfPhase::Render);
+	if (Line < Main)
+	{
+		RFState->LineCounter = Line - Top;
+		DrawTopBoarder[RFState->BitDepth](RFState);
+	}
+	else if (Line < Bottom)
+	{
+		RFState->LineCounter = Line - Main;
+		UpdateScreen[RFState->BitDepth](RFState);
+	}
+	else
+	{
+		RFState->LineCounter = Line - Bottom;
+		DrawBottomBoarder[RFState->BitDepth](RFState);
+	}
+	if (Line + 1 == End)
+	{
+		RFState->LineCounter = BottomBoarder;
+		DrawBottomBoarder[RFState->BitDepth](RFState);
+		UnlockScreen(RFState);
+		SetBoarderChange();
+	}
+	SwitchPerfPhase(cutie::PerfPhase::Cpu);
+}
+
+// Does what HLINE() would have done between slices up to the CPU's position
+static void CatchUpField(double Cycles)
+{
+	while (FieldStep < 2 * FieldLines && FieldEdgeCycles(FieldStep) <= Cycles)
+	{
+		const unsigned int Line = FieldStep / 2;
+		if (!(FieldStep & 1))
+		{
+			HSYNC(0);
+			PakTimer();
+		}
+		else
+		{
+			HSYNC(1);
+			BeamLine++;
+			DrawFieldLine(Line);
+			if (Line + 1 < FieldLines)
+			{
+				UpdateAudio();
+				pia0_scan_keyboard();
+			}
+		}
+		FieldStep++;
+	}
+}
+
+void CatchUpBeam()
+{
+	if (FieldCoalesced)
+		CatchUpField(BeamCycles());
+}
+
+// Before a write to video RAM, draws the lines that ended before the
+// writing instruction began, as line by line execution would have
+void VideoWatchHit()
+{
+	if (!FieldCoalesced)
+		return;
+	int Cycles = LineCycles;
+	if (CPURunning)
+		Cycles += (CPUExec == HD6309Exec) ? HD6309InstructionCycles() : MC6809InstructionCycles();
+	CatchUpField(Cycles);
+}
+
+void EndCoalescedField()
+{
+	if (!FieldCoalesced)
+		return;
+	CatchUpField(BeamCycles());
+	if (!FieldEnding && CPURunning)
+		(CPUExec == HD6309Exec) ? HD6309EndSlice() : MC6809EndSlice();
+	FieldEnding = true;
+}
+
+// CPUCycle() for a whole run: the same slices and events, but the CPU may
+// stop early. Returns the nanoseconds run from the start of the run.
+static double RunField(double NanosToRun)
+{
+	const double Rate = CyclesPerLine * OverClock / NanosPerLine;
+	const double Residue = NanosThisLine;
+	const double Budget = NanosThisLine + NanosToRun;
+	NanosThisLine = Budget;
+	while (NanosThisLine >= 1 && !FieldEnding)
+	{
+		if (EmuState.Debugger.IsHalted())
+		{
+			FieldEnding = true;
+			break;
+		}
+
+		double Slice = NanosThisLine;
+		bool Timer = false, Sound = false;
+		if (IntEnable & TimerInteruptEnabled)
+		{
+			if (NanosToInterrupt < 0)
+				NanosToInterrupt = 0;
+			if (NanosToInterrupt <= Slice)
+			{
+				Slice = NanosToInterrupt;
+				Timer = true;
+			}
+		}
+		if (SndEnable && NanosToSoundSample <= Slice)
+		{
+			if (NanosToSoundSample < Slice)
+				Timer = false;
+			Slice = NanosToSoundSample;
+			Sound = true;
+		}
+
+		const double Drift = CycleDrift;
+		int Over = 0;
+		CyclesThisLine = CycleDrift + Slice * Rate;
+		if (CyclesThisLine >= 1)
+		{
+			Over = RunCPU((int)floor(CyclesThisLine));
+			CycleDrift = Over + (CyclesThisLine - floor(CyclesThisLine));
+		}
+		else
+			CycleDrift = CyclesThisLine;
+
+		if (Over > 0)
+		{
+			// Stopped early, so only the time the CPU covered has gone by
+			const int Ran = (int)floor(CyclesThisLine) - Over;
+			Slice = std::min(std::max((Ran - Drift) / Rate, 0.0), Slice);
+			CycleDrift = Drift + Slice * Rate - Ran;
+			Timer = Sound = false;
+			FieldEnding = true;
+		}
+
+		NanosThisLine -= Slice;
+		NanosToInterrupt -= Slice;
+		NanosToSoundSample -= Slice;
+		if (Timer)
+		{
+			GimeAssertTimerInterupt();
+			NanosToInterrupt = MasterTickCounter;
+		}
+		if (Sound)
+		{
+			AudioEvent();
+			NanosToSoundSample = SoundInterupt;
+		}
+	}
+
+	const double Reached = Budget - NanosThisLine - Residue;
+	if (FieldEnding)
+		NanosThisLine = 0;
+	return Reached;
+}
+
+// Runs the lines after VSYNC as one run of the CPU, finishing line by line
+// if something needs the lines. Returns false if the screen can't be locked.
+static bool RunCoalescedField(SystemState *RFState, bool Draw)
+{
+	if (Draw && LockScreen())
+		return false;
+
+	FieldState = RFState;
+	FieldDraw = Draw;
+	FieldFirstLine = BeamLine;
+	FieldLines = FieldLength();
+	FieldStep = 0;
+	FieldDrift = CycleDrift + NanosThisLine * CyclesPerLine * OverClock / NanosPerLine;
+	FieldCoalesced = true;
+	FieldEnding = false;
+	LineCycles = 0;
+
+	// Lines already passed must not see later writes to their video RAM
+	unsigned int VideoStart, VideoSize, VideoMask;
+	GetVideoWindow(VideoStart, VideoSize, VideoMask);
+	SetVideoWatch(VideoStart, VideoSize, VideoMask);
+
+	// The start of the first line, as in HLINE()
+	UpdateAudio();
+	pia0_scan_keyboard();
+
+	const double Reached = RunField(FieldLines * NanosPerLine);
+	const bool Ended = FieldEnding;
+	CatchUpField(Ended ? LineCycles : HUGE_VAL);
+	ClearVideoWatch();
+	FieldCoalesced = false;
+	FieldEnding = false;
+
+	unsigned int Line = FieldStep / 2;
+	if (Line < FieldLines)
+	{
+		// Finish the line the CPU stopped in
+		if (Line)
+			LineCycles -= (int)FieldEdgeCycles(2 * Line - 1);
+		const double LineEnd = (Line + 1) * NanosPerLine;
+		if (!(FieldStep & 1))
+		{
+			CPUCycle(LineEnd - HSYNCWidthInNanos - Reached);
+			HSYNC(0);
+			PakTimer();
+			CPUCycle(HSYNCWidthInNanos);
+		}
+		else
+			CPUCycle(LineEnd - Reached);
+		HSYNC(1);
+		BeamLine++;
+		LineCycles = 0;
+		DrawFieldLine(Line);
+
+		while (++Line < FieldLength())
+		{
+			HLINE();
+			DrawFieldLine(Line);
+		}
+	}
+	LineCycles = 0;
+	return true;
+}
+
 void SetTimerInteruptState(unsigned char State)
 {
+	// Skip the expiries nobody could see while the timer was masked
+	if (State && !TimerInteruptEnabled && NanosToInterrupt < 0 && MasterTickCounter > 0)
+		NanosToInterrupt = MasterTickCounter - fmod(-NanosToInterrupt, MasterTickCounter);
 	TimerInteruptEnabled=State;
 	return;
 }
@@ -586,11 +961,35 @@ void MiscReset()
 	CyclesThisLine=0;
 	NanosThisLine=0;
 	IntEnable=0;
+	BlinkPhase=1;
 	AudioIndex=0;
 	ResetAudio();
 	return;
 }
 
+// Frame timing and the GIME timer. The audio rate and overclock are host
+// settings and the audio buffers are drained every frame, so neither is kept.
+template <class StateArchive>
+static void TransferState(StateArchive &state)
+{
+	state(HorzInteruptEnabled)(VertInteruptEnabled)(TimerInteruptEnabled);
+	state(TopBoarder)(BottomBoarder)(TopOffScreen)(BottomOffScreen)(LinesperScreen);
+	state(MasterTimer)(TimerClockRate)(TimerCycleCount)(MasterTickCounter)(UnxlatedTickCounter)(OldMaster);
+	state(NanosThisLine)(NanosToInterrupt)(IntEnable)(BlinkPhase)(LastMotorState);
+	state(NanosToSoundSample)(NanosToAudioSample)(CycleDrift)(CyclesThisLine);
+}
+
+void MiscSaveState(cutie::StateWriter &state)
+{
+	TransferState(state);
+}
+
+bool MiscLoadState(cutie::StateReader &state)
+{
+	TransferState(state);
+	return state.complete();
+}
+
 unsigned int SetAudioRate (unsigned int Rate)
 {
 
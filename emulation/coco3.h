@@ -18,6 +18,8 @@ This file is part of VCC (Virtual Color Computer).
     along with VCC (Virtual Color Computer).  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include "cutie/state.h"
+
 struct DisplayDetails
 {
 	int contentRows = 0;
@@ -37,11 +39,18 @@ void SetHorzInteruptState(unsigned char);
 void SetVertInteruptState(unsigned char);
 void SetSndOutMode(unsigned char);
 float RenderFrame (SystemState *);
+void GetBeamPosition(unsigned short &Line, unsigned short &Cycle);
+uint64_t GetCpuCycleCount();
+void SetLineCoalescing(bool);
+void CatchUpBeam();
+void EndCoalescedField();
 
 void SetTimerInteruptState(unsigned char);
 void SetTimerClockRate (unsigned char);	
 void SetInteruptTimer(unsigned int);
 void MiscReset();
+void MiscSaveState(cutie::StateWriter &);
+bool MiscLoadState(cutie::StateReader &);
 void PasteBASICWithNew();
 void PasteBASIC();
 void PasteText();
@@ -22,10 +22,15 @@ This file is part of VCC (Virtual Color Computer).
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
+#include <array>
 #include "defines.h"
 #include "hd6309.h"
 #include "hd6309defs.h"
 #include "tcc1014mmu.h"
+#include "cutie/reverse.h"
+#include "cutie/cassette.h"
+#include "cutie/romhooks.h"
+#include "cutie/fuzz.h"
 #include "vcc/utils/logger.h"
 // OpDecoder.h removed - not used
 
@@ -40,9 +45,9 @@ This file is part of VCC (Virtual Color Computer).
 #define OVERFLOW16(c,a,b,r) c ^ (((a^b^r)>>15)&1)
 #define ZTEST(r) !r
 
-#define DPADDRESS(r) (dp.Reg |MemRead8(r))
-#define IMMADDRESS(r) MemRead16(r)
-#define INDADDRESS(r) CalculateEA(MemRead8(r))
+#define DPADDRESS(r) (dp.Reg |MemFetch8(r))
+#define IMMADDRESS(r) MemFetch16(r)
+#define INDADDRESS(r) CalculateEA(MemFetch8(r))
 
 #define M65		0
 #define M64		1
@@ -118,6 +123,8 @@ static unsigned char *ureg8[8];
 static unsigned char ccbits,mdbits;
 static unsigned short *xfreg16[8];
 static int CycleCounter=0;
+static bool SliceEnding=false;	// Set by HD6309EndSlice()
+static int InstructionStart=0;	// CycleCounter when the current instruction began
 static unsigned int SyncWaiting=0;
 unsigned short temp16;
 static signed short stemp16;
@@ -208,6 +215,8 @@ unsigned char getmd();
 static void cpu_firq();
 static void cpu_irq();
 static void cpu_nmi();
+static unsigned char PushRegisters(cpuregister &,unsigned char,const cpuregister &,bool=false);
+static unsigned char PullRegisters(cpuregister &,unsigned char,cpuregister &,bool=false);
 unsigned char GetSorceReg(unsigned char);
 void Page_2();
 void Page_3();
@@ -335,6 +344,46 @@ VCC::CPUState HD6309GetState()
 	return regs;
 }
 
+// Loads the registers from a CPUState, as left by a routine run on the
+// CPU's behalf. D follows A and B; MD and the mode it selects are left alone.
+void HD6309SetState(const VCC::CPUState &regs)
+{
+	setcc(regs.CC);
+	DP_REG = regs.DP & 0xff;
+	A_REG = regs.A;
+	B_REG = regs.B;
+	E_REG = regs.E;
+	F_REG = regs.F;
+	X_REG = regs.X;
+	Y_REG = regs.Y;
+	U_REG = regs.U;
+	S_REG = regs.S;
+	V_REG = regs.V;
+	PC_REG = regs.PC;
+}
+
+// Everything that survives between HD6309Exec calls. The native mode cycle
+// counts follow from md and are recomputed on load.
+template <class StateArchive>
+static void TransferState(StateArchive &state)
+{
+	state(q)(pc)(x)(y)(u)(s)(dp)(v)(z)(cc)(ccbits)(md)(mdbits);
+	state(SyncWaiting)(PendingInterupts)(IRQWaiter)(InInterupt)(HaltedInsPending);
+}
+
+void HD6309SaveState(cutie::StateWriter &state)
+{
+	TransferState(state);
+}
+
+bool HD6309LoadState(cutie::StateReader &state)
+{
+	TransferState(state);
+	if (!state.complete())
+		return false;
+	setmd(static_cast<unsigned char>((md[1] << 1) | md[0]));
+	return true;
+}
 
 void HD6309SetBreakpoints(const std::vector<unsigned short>& breakpoints)
 {
@@ -361,7 +410,7 @@ void Neg_D()
 
 void Oim_D()
 {//1 6309
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16 = DPADDRESS(PC_REG++);
 	postbyte|= MemRead8(temp16);
 	MemWrite8(postbyte,temp16);
@@ -373,7 +422,7 @@ void Oim_D()
 
 void Aim_D()
 {//2 Phase 2 6309
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16 = DPADDRESS(PC_REG++);
 	postbyte&= MemRead8(temp16);
 	MemWrite8(postbyte,temp16);
@@ -410,7 +459,7 @@ void Lsr_D()
 
 void Eim_D()
 { //05 6309 Untested
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16 = DPADDRESS(PC_REG++);
 	postbyte^= MemRead8(temp16);
 	MemWrite8(postbyte,temp16);
@@ -485,7 +534,7 @@ void Dec_D()
 
 void Tim_D()
 {	//B 6309 Untested wcreate
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp8=MemRead8(DPADDRESS(PC_REG++));
 	postbyte&=temp8;
 	cc[N] = NTEST8(postbyte);
@@ -516,7 +565,7 @@ void Tst_D()
 
 void Jmp_D()
 {	//E
-	PC_REG = dp.Reg | MemRead8(PC_REG);
+	PC_REG = dp.Reg | MemFetch8(PC_REG);
 	CycleCounter+=NatEmuCycles32;
 }
 
@@ -708,7 +757,7 @@ void Addr()
 { //1030 6309 - WallyZ 2019
 	unsigned char dest8, source8;
 	unsigned short dest16, source16;
-	temp8 = MemRead8(PC_REG++);
+	temp8 = MemFetch8(PC_REG++);
 	Source = temp8 >> 4;
 	Dest = temp8 & 15;
 
@@ -779,7 +828,7 @@ void Adcr()
 { //1031 6309 - WallyZ 2019
 	unsigned char dest8, source8;
 	unsigned short dest16, source16;
-	temp8 = MemRead8(PC_REG++);
+	temp8 = MemFetch8(PC_REG++);
 	Source = temp8 >> 4;
 	Dest = temp8 & 15;
 
@@ -847,7 +896,7 @@ void Subr()
 { //1032 6309 - WallyZ 2019
 	unsigned char dest8, source8;
 	unsigned short dest16, source16;
-	temp8 = MemRead8(PC_REG++);
+	temp8 = MemFetch8(PC_REG++);
 	Source = temp8 >> 4;
 	Dest = temp8 & 15;
 
@@ -916,7 +965,7 @@ void Sbcr()
 { //1033 6309 - WallyZ 2019
 	unsigned char dest8, source8;
 	unsigned short dest16, source16;
-	temp8 = MemRead8(PC_REG++);
+	temp8 = MemFetch8(PC_REG++);
 	Source = temp8 >> 4;
 	Dest = temp8 & 15;
 
@@ -985,7 +1034,7 @@ void Andr()
 { //1034 6309 - WallyZ 2019
 	unsigned char dest8, source8;
 	unsigned short dest16, source16;
-	temp8 = MemRead8(PC_REG++);
+	temp8 = MemFetch8(PC_REG++);
 	Source = temp8 >> 4;
 	Dest = temp8 & 15;
 
@@ -1051,7 +1100,7 @@ void Orr()
 { //1035 6309 - WallyZ 2019
 	unsigned char dest8, source8;
 	unsigned short dest16, source16;
-	temp8 = MemRead8(PC_REG++);
+	temp8 = MemFetch8(PC_REG++);
 	Source = temp8 >> 4;
 	Dest = temp8 & 15;
 
@@ -1117,7 +1166,7 @@ void Eorr()
 { //1036 6309 - WallyZ 2019
 	unsigned char dest8, source8;
 	unsigned short dest16, source16;
-	temp8 = MemRead8(PC_REG++);
+	temp8 = MemFetch8(PC_REG++);
 	Source = temp8 >> 4;
 	Dest = temp8 & 15;
 
@@ -1183,7 +1232,7 @@ void Cmpr()
 { //1037 6309 - WallyZ 2019
 	unsigned char dest8, source8;
 	unsigned short dest16, source16;
-	temp8 = MemRead8(PC_REG++);
+	temp8 = MemFetch8(PC_REG++);
 	Source = temp8 >> 4;
 	Dest = temp8 & 15;
 
@@ -1273,24 +1322,9 @@ void Puluw()
 void Swi2_I()
 { //103F
 	cc[E]=1;
-	MemWrite8( pc.B.lsb,--S_REG);
-	MemWrite8( pc.B.msb,--S_REG);
-	MemWrite8( u.B.lsb,--S_REG);
-	MemWrite8( u.B.msb,--S_REG);
-	MemWrite8( y.B.lsb,--S_REG);
-	MemWrite8( y.B.msb,--S_REG);
-	MemWrite8( x.B.lsb,--S_REG);
-	MemWrite8( x.B.msb,--S_REG);
-	MemWrite8( dp.B.msb,--S_REG);
+	PushRegisters(s,0xFF,u,md[NATIVE6309]);
 	if (md[NATIVE6309])
-	{
-		MemWrite8((F_REG),--S_REG);
-		MemWrite8((E_REG),--S_REG);
 		CycleCounter+=2;
-	}
-	MemWrite8(B_REG,--S_REG);
-	MemWrite8(A_REG,--S_REG);
-	MemWrite8(getcc(),--S_REG);
 	PC_REG=MemRead16(VSWI2);
 	CycleCounter+=20;
 }
@@ -2228,7 +2262,7 @@ void Sts_E()
 
 void Band()
 { //1130 6309 untested
-	postbyte = MemRead8(PC_REG++);
+	postbyte = MemFetch8(PC_REG++);
 	temp8 = MemRead8(DPADDRESS(PC_REG++));
 	Source = (postbyte >> 3) & 7;
 	Dest = postbyte & 7;
@@ -2259,7 +2293,7 @@ void Band()
 
 void Biand()
 { //1131 6309
-	postbyte = MemRead8(PC_REG++);
+	postbyte = MemFetch8(PC_REG++);
 	temp8 = MemRead8(DPADDRESS(PC_REG++));
 	Source = (postbyte >> 3) & 7;
 	Dest = postbyte & 7;
@@ -2290,7 +2324,7 @@ void Biand()
 
 void Bor()
 { //1132 6309
-	postbyte = MemRead8(PC_REG++);
+	postbyte = MemFetch8(PC_REG++);
 	temp8 = MemRead8(DPADDRESS(PC_REG++));
 	Source = (postbyte >> 3) & 7;
 	Dest = postbyte & 7;
@@ -2321,7 +2355,7 @@ void Bor()
 
 void Bior()
 { //1133 6309
-	postbyte = MemRead8(PC_REG++);
+	postbyte = MemFetch8(PC_REG++);
 	temp8 = MemRead8(DPADDRESS(PC_REG++));
 	Source = (postbyte >> 3) & 7;
 	Dest = postbyte & 7;
@@ -2352,7 +2386,7 @@ void Bior()
 
 void Beor()
 { //1134 6309
-	postbyte = MemRead8(PC_REG++);
+	postbyte = MemFetch8(PC_REG++);
 	temp8 = MemRead8(DPADDRESS(PC_REG++));
 	Source = (postbyte >> 3) & 7;
 	Dest = postbyte & 7;
@@ -2382,7 +2416,7 @@ void Beor()
 
 void Bieor()
 { //1135 6309
-	postbyte = MemRead8(PC_REG++);
+	postbyte = MemFetch8(PC_REG++);
 	temp8 = MemRead8(DPADDRESS(PC_REG++));
 	Source = (postbyte >> 3) & 7;
 	Dest = postbyte & 7;
@@ -2412,7 +2446,7 @@ void Bieor()
 
 void Ldbt()
 { //1136 6309
-	postbyte = MemRead8(PC_REG++);
+	postbyte = MemFetch8(PC_REG++);
 	temp8 = MemRead8(DPADDRESS(PC_REG++));
 	Source = (postbyte >> 3) & 7;
 	Dest = postbyte & 7;
@@ -2455,7 +2489,7 @@ void Ldbt()
 
 void Stbt()
 { //1137 6309
-	postbyte = MemRead8(PC_REG++);
+	postbyte = MemFetch8(PC_REG++);
 	temp16 = DPADDRESS(PC_REG++);
 	temp8 = MemRead8(temp16);
 	Source = (postbyte >> 3) & 7;
@@ -2502,7 +2536,7 @@ void Tfm1()
 	}
 	DoingTFM = true;
 
-	postbyte=MemRead8(PC_REG);
+	postbyte=MemFetch8(PC_REG);
 	Source=postbyte>>4;
 	Dest=postbyte&15;
 
@@ -2532,7 +2566,7 @@ void Tfm2()
 	}			
 	DoingTFM = true;
 
-	postbyte=MemRead8(PC_REG);
+	postbyte=MemFetch8(PC_REG);
 	Source=postbyte>>4;
 	Dest=postbyte&15;
 
@@ -2563,7 +2597,7 @@ void Tfm3()
 	}			
 	DoingTFM = true;
 
-	postbyte = MemRead8(PC_REG);
+	postbyte = MemFetch8(PC_REG);
 	Source = postbyte >> 4;
 	Dest = postbyte & 15;
 
@@ -2593,7 +2627,7 @@ void Tfm4()
 	}			
 	DoingTFM = true;
 
-	postbyte=MemRead8(PC_REG);
+	postbyte=MemFetch8(PC_REG);
 	Source=postbyte>>4;
 	Dest=postbyte&15;
 
@@ -2613,7 +2647,7 @@ void Tfm4()
 
 void Bitmd_M()
 { //113C  6309
-	postbyte = MemRead8(PC_REG++) & 0xC0;
+	postbyte = MemFetch8(PC_REG++) & 0xC0;
 	temp8 = getmd() & postbyte;
 	cc[Z] = ZTEST(temp8);
 	if (temp8 & 0x80) md[7] = 0;
@@ -2623,7 +2657,7 @@ void Bitmd_M()
 
 void Ldmd_M()
 { //113D DONE 6309
-	mdbits= MemRead8(PC_REG++)&0x03;
+	mdbits= MemFetch8(PC_REG++)&0x03;
 	setmd(mdbits);
 	CycleCounter+=5;
 }
@@ -2631,24 +2665,9 @@ void Ldmd_M()
 void Swi3_I()
 { //113F
 	cc[E]=1;
-	MemWrite8( pc.B.lsb,--S_REG);
-	MemWrite8( pc.B.msb,--S_REG);
-	MemWrite8( u.B.lsb,--S_REG);
-	MemWrite8( u.B.msb,--S_REG);
-	MemWrite8( y.B.lsb,--S_REG);
-	MemWrite8( y.B.msb,--S_REG);
-	MemWrite8( x.B.lsb,--S_REG);
-	MemWrite8( x.B.msb,--S_REG);
-	MemWrite8( dp.B.msb,--S_REG);
+	PushRegisters(s,0xFF,u,md[NATIVE6309]);
 	if (md[NATIVE6309])
-	{
-		MemWrite8((F_REG),--S_REG);
-		MemWrite8((E_REG),--S_REG);
 		CycleCounter+=2;
-	}
-	MemWrite8(B_REG,--S_REG);
-	MemWrite8(A_REG,--S_REG);
-	MemWrite8(getcc(),--S_REG);
 	PC_REG=MemRead16(VSWI3);
 	CycleCounter+=20;
 }
@@ -2747,7 +2766,7 @@ void Clrf_I()
 
 void Sube_M()
 { //1180 6309 Untested
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16 = E_REG - postbyte;
 	cc[C] =(temp16 & 0x100)>>8; 
 	cc[V] = OVERFLOW8(cc[C],postbyte,temp16,E_REG);
@@ -2759,7 +2778,7 @@ void Sube_M()
 
 void Cmpe_M()
 { //1181 6309
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp8= E_REG-postbyte;
 	cc[C] = temp8 > E_REG;
 	cc[V] = OVERFLOW8(cc[C],postbyte,temp8,E_REG);
@@ -2782,7 +2801,7 @@ void Cmpu_M()
 
 void Lde_M()
 { //1186 6309
-	E_REG= MemRead8(PC_REG++);
+	E_REG= MemFetch8(PC_REG++);
 	cc[Z] = ZTEST(E_REG);
 	cc[N] = NTEST8(E_REG);
 	cc[V] = 0;
@@ -2791,7 +2810,7 @@ void Lde_M()
 
 void Adde_M()
 { //118B 6309
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16=E_REG+postbyte;
 	cc[C] =(temp16 & 0x100)>>8;
 	cc[H] = ((E_REG ^ postbyte ^ temp16) & 0x10)>>4;
@@ -2816,7 +2835,7 @@ void Cmps_M()
 
 void Divd_M()
 { //118D 6309
-	postbyte = MemRead8(PC_REG++);
+	postbyte = MemFetch8(PC_REG++);
 
 	if (postbyte == 0)
 	{
@@ -2858,7 +2877,7 @@ void Divd_M()
 
 void Divq_M()
 { //118E 6309
-	postword = MemRead16(PC_REG);
+	postword = MemFetch16(PC_REG);
 	PC_REG+=2;
 
 	if(postword == 0)
@@ -3428,7 +3447,7 @@ void Muld_E()
 
 void Subf_M()
 { //11C0 6309 Untested
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16 = F_REG - postbyte;
 	cc[C] = (temp16 & 0x100)>>8; 
 	cc[V] = OVERFLOW8(cc[C],postbyte,temp16,F_REG);
@@ -3440,7 +3459,7 @@ void Subf_M()
 
 void Cmpf_M()
 { //11C1 6309
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp8= F_REG-postbyte;
 	cc[C] = temp8 > F_REG;
 	cc[V] = OVERFLOW8(cc[C],postbyte,temp8,F_REG);
@@ -3451,7 +3470,7 @@ void Cmpf_M()
 
 void Ldf_M()
 { //11C6 6309
-	F_REG= MemRead8(PC_REG++);
+	F_REG= MemFetch8(PC_REG++);
 	cc[Z] = ZTEST(F_REG);
 	cc[N] = NTEST8(F_REG);
 	cc[V] = 0;
@@ -3460,7 +3479,7 @@ void Ldf_M()
 
 void Addf_M()
 { //11CB 6309 Untested
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16=F_REG+postbyte;
 	cc[C] = (temp16 & 0x100)>>8;
 	cc[H] = ((F_REG ^ postbyte ^ temp16) & 0x10)>>4;
@@ -3705,7 +3724,7 @@ void Daa_I()
 
 void Orcc_M()
 { //1A
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp8=getcc();
 	temp8 = (temp8 | postbyte);
 	setcc(temp8);
@@ -3714,7 +3733,7 @@ void Orcc_M()
 
 void Andcc_M()
 { //1C
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp8=getcc();
 	temp8 = (temp8 & postbyte);
 	setcc(temp8);
@@ -3731,7 +3750,7 @@ void Sex_I()
 
 void Exg_M()
 { //1E
-	postbyte = MemRead8(PC_REG++);
+	postbyte = MemFetch8(PC_REG++);
 	Source = postbyte >> 4;
 	Dest = postbyte & 15;
 
@@ -3796,7 +3815,7 @@ void Exg_M()
 
 void Tfr_M()
 { //1F
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	Source= postbyte>>4;
 	Dest=postbyte & 15;
 
@@ -3838,7 +3857,7 @@ void Tfr_M()
 
 void Bra_R()
 { //20
-	*spostbyte=MemRead8(PC_REG++);
+	*spostbyte=MemFetch8(PC_REG++);
 	PC_REG+=*spostbyte;
 	CycleCounter+=3;
 }
@@ -3852,7 +3871,7 @@ void Brn_R()
 void Bhi_R()
 { //22
 	if  (!(cc[C] | cc[Z]))
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3860,7 +3879,7 @@ void Bhi_R()
 void Bls_R()
 { //23
 	if (cc[C] | cc[Z])
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3868,7 +3887,7 @@ void Bls_R()
 void Bhs_R()
 { //24
 	if (!cc[C])
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3876,7 +3895,7 @@ void Bhs_R()
 void Blo_R()
 { //25
 	if (cc[C])
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3884,7 +3903,7 @@ void Blo_R()
 void Bne_R()
 { //26
 	if (!cc[Z])
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3892,7 +3911,7 @@ void Bne_R()
 void Beq_R()
 { //27
 	if (cc[Z])
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3900,7 +3919,7 @@ void Beq_R()
 void Bvc_R()
 { //28
 	if (!cc[V])
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3908,7 +3927,7 @@ void Bvc_R()
 void Bvs_R()
 { //29
 	if ( cc[V])
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3916,7 +3935,7 @@ void Bvs_R()
 void Bpl_R()
 { //2A
 	if (!cc[N])
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3924,7 +3943,7 @@ void Bpl_R()
 void Bmi_R()
 { //2B
 	if ( cc[N])
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3932,7 +3951,7 @@ void Bmi_R()
 void Bge_R()
 { //2C
 	if (! (cc[N] ^ cc[V]))
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3940,7 +3959,7 @@ void Bge_R()
 void Blt_R()
 { //2D
 	if ( cc[V] ^ cc[N])
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3948,7 +3967,7 @@ void Blt_R()
 void Bgt_R()
 { //2E
 	if ( !( cc[Z] | (cc[N]^cc[V] ) ))
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3956,7 +3975,7 @@ void Bgt_R()
 void Ble_R()
 { //2F
 	if ( cc[Z] | (cc[N]^cc[V]) )
-		PC_REG+=(signed char)MemRead8(PC_REG);
+		PC_REG+=(signed char)MemFetch8(PC_REG);
 	PC_REG++;
 	CycleCounter+=3;
 }
@@ -3989,202 +4008,29 @@ void Leau_X()
 
 void Pshs_M()
 { //34
-	postbyte=MemRead8(PC_REG++);
-	if (postbyte & 0x80)
-	{
-		MemWrite8( pc.B.lsb,--S_REG);
-		MemWrite8( pc.B.msb,--S_REG);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x40)
-	{
-		MemWrite8( u.B.lsb,--S_REG);
-		MemWrite8( u.B.msb,--S_REG);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x20)
-	{
-		MemWrite8( y.B.lsb,--S_REG);
-		MemWrite8( y.B.msb,--S_REG);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x10)
-	{
-		MemWrite8( x.B.lsb,--S_REG);
-		MemWrite8( x.B.msb,--S_REG);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x08)
-	{
-		MemWrite8( dp.B.msb,--S_REG);
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x04)
-	{
-		MemWrite8(B_REG,--S_REG);
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x02)
-	{
-		MemWrite8(A_REG,--S_REG);
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x01)
-	{
-		MemWrite8(getcc(),--S_REG);
-		CycleCounter+=1;
-	}
-
+	postbyte=MemFetch8(PC_REG++);
+	CycleCounter+=PushRegisters(s,postbyte,u);
 	CycleCounter+=NatEmuCycles54;
 }
 
 void Puls_M()
 { //35
-	postbyte=MemRead8(PC_REG++);
-	if (postbyte & 0x01)
-	{
-		setcc(MemRead8(S_REG++));
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x02)
-	{
-		A_REG=MemRead8(S_REG++);
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x04)
-	{
-		B_REG=MemRead8(S_REG++);
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x08)
-	{
-		dp.B.msb=MemRead8(S_REG++);
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x10)
-	{
-		x.B.msb=MemRead8( S_REG++);
-		x.B.lsb=MemRead8( S_REG++);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x20)
-	{
-		y.B.msb=MemRead8( S_REG++);
-		y.B.lsb=MemRead8( S_REG++);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x40)
-	{
-		u.B.msb=MemRead8( S_REG++);
-		u.B.lsb=MemRead8( S_REG++);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x80)
-	{
-		pc.B.msb=MemRead8( S_REG++);
-		pc.B.lsb=MemRead8( S_REG++);
-		CycleCounter+=2;
-	}
+	postbyte=MemFetch8(PC_REG++);
+	CycleCounter+=PullRegisters(s,postbyte,u);
 	CycleCounter+=NatEmuCycles54;
 }
 
 void Pshu_M()
 { //36
-	postbyte=MemRead8(PC_REG++);
-	if (postbyte & 0x80)
-	{
-		MemWrite8( pc.B.lsb,--U_REG);
-		MemWrite8( pc.B.msb,--U_REG);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x40)
-	{
-		MemWrite8( s.B.lsb,--U_REG);
-		MemWrite8( s.B.msb,--U_REG);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x20)
-	{
-		MemWrite8( y.B.lsb,--U_REG);
-		MemWrite8( y.B.msb,--U_REG);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x10)
-	{
-		MemWrite8( x.B.lsb,--U_REG);
-		MemWrite8( x.B.msb,--U_REG);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x08)
-	{
-		MemWrite8( dp.B.msb,--U_REG);
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x04)
-	{
-		MemWrite8(B_REG,--U_REG);
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x02)
-	{
-		MemWrite8(A_REG,--U_REG);
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x01)
-	{
-		MemWrite8(getcc(),--U_REG);
-		CycleCounter+=1;
-	}
+	postbyte=MemFetch8(PC_REG++);
+	CycleCounter+=PushRegisters(u,postbyte,s);
 	CycleCounter+=NatEmuCycles54;
 }
 
 void Pulu_M()
 { //37
-	postbyte=MemRead8(PC_REG++);
-	if (postbyte & 0x01)
-	{
-		setcc(MemRead8(U_REG++));
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x02)
-	{
-		A_REG=MemRead8(U_REG++);
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x04)
-	{
-		B_REG=MemRead8(U_REG++);
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x08)
-	{
-		dp.B.msb=MemRead8(U_REG++);
-		CycleCounter+=1;
-	}
-	if (postbyte & 0x10)
-	{
-		x.B.msb=MemRead8( U_REG++);
-		x.B.lsb=MemRead8( U_REG++);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x20)
-	{
-		y.B.msb=MemRead8( U_REG++);
-		y.B.lsb=MemRead8( U_REG++);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x40)
-	{
-		s.B.msb=MemRead8( U_REG++);
-		s.B.lsb=MemRead8( U_REG++);
-		CycleCounter+=2;
-	}
-	if (postbyte & 0x80)
-	{
-		pc.B.msb=MemRead8( U_REG++);
-		pc.B.lsb=MemRead8( U_REG++);
-		CycleCounter+=2;
-	}
+	postbyte=MemFetch8(PC_REG++);
+	CycleCounter+=PullRegisters(u,postbyte,s);
 	CycleCounter+=NatEmuCycles54;
 }
 
@@ -4208,30 +4054,17 @@ void Rti_I()
 	InInterupt=0;
 	if (cc[E])
 	{
-		A_REG=MemRead8(S_REG++);
-		B_REG=MemRead8(S_REG++);
+		PullRegisters(s,0x7E,u,md[NATIVE6309]);
 		if (md[NATIVE6309])
-		{
-			(E_REG)=MemRead8(S_REG++);
-			(F_REG)=MemRead8(S_REG++);
 			CycleCounter+=2;
-		}
-		dp.B.msb=MemRead8(S_REG++);
-		x.B.msb=MemRead8(S_REG++);
-		x.B.lsb=MemRead8(S_REG++);
-		y.B.msb=MemRead8(S_REG++);
-		y.B.lsb=MemRead8(S_REG++);
-		u.B.msb=MemRead8(S_REG++);
-		u.B.lsb=MemRead8(S_REG++);
 		CycleCounter+=9;
 	}
-	pc.B.msb=MemRead8(S_REG++);
-	pc.B.lsb=MemRead8(S_REG++);
+	PullRegisters(s,0x80,u);
 }
 
 void Cwai_I()
 { //3C
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	ccbits=getcc();
 	ccbits = ccbits & postbyte;
 	setcc(ccbits);
@@ -4255,24 +4088,9 @@ void Reset() // 3E
 void Swi1_I()
 { //3F
 	cc[E]=1;
-	MemWrite8( pc.B.lsb,--S_REG);
-	MemWrite8( pc.B.msb,--S_REG);
-	MemWrite8( u.B.lsb,--S_REG);
-	MemWrite8( u.B.msb,--S_REG);
-	MemWrite8( y.B.lsb,--S_REG);
-	MemWrite8( y.B.msb,--S_REG);
-	MemWrite8( x.B.lsb,--S_REG);
-	MemWrite8( x.B.msb,--S_REG);
-	MemWrite8( dp.B.msb,--S_REG);
+	PushRegisters(s,0xFF,u,md[NATIVE6309]);
 	if (md[NATIVE6309])
-	{
-		MemWrite8((F_REG),--S_REG);
-		MemWrite8((E_REG),--S_REG);
 		CycleCounter+=2;
-	}
-	MemWrite8(B_REG,--S_REG);
-	MemWrite8(A_REG,--S_REG);
-	MemWrite8(getcc(),--S_REG);
 	PC_REG=MemRead16(VSWI);
 	CycleCounter+=19;
 	cc[I]=1;
@@ -4506,7 +4324,7 @@ void Neg_X()
 
 void Oim_X()
 { //61 6309 DONE
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16=INDADDRESS(PC_REG++);
 	postbyte |= MemRead8(temp16);
 	MemWrite8(postbyte,temp16);
@@ -4518,7 +4336,7 @@ void Oim_X()
 
 void Aim_X()
 { //62 6309 Phase 2
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16=INDADDRESS(PC_REG++);
 	postbyte &= MemRead8(temp16);
 	MemWrite8(postbyte,temp16);
@@ -4555,7 +4373,7 @@ void Lsr_X()
 
 void Eim_X()
 { //65 6309 Untested TESTED NITRO
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16=INDADDRESS(PC_REG++);
 	postbyte ^= MemRead8(temp16);
 	MemWrite8(postbyte,temp16);
@@ -4631,7 +4449,7 @@ void Dec_X()
 
 void Tim_X()
 { //6B 6309
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp8=MemRead8(INDADDRESS(PC_REG++));
 	postbyte&=temp8;
 	cc[N] = NTEST8(postbyte);
@@ -4693,7 +4511,7 @@ void Neg_E()
 
 void Oim_E()
 { //71 6309 Phase 2
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16=IMMADDRESS(PC_REG);
 	postbyte|= MemRead8(temp16);
 	MemWrite8(postbyte,temp16);
@@ -4706,7 +4524,7 @@ void Oim_E()
 
 void Aim_E()
 { //72 6309 Untested CHECK NITRO
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16=IMMADDRESS(PC_REG);
 	postbyte&= MemRead8(temp16);
 	MemWrite8(postbyte,temp16);
@@ -4746,7 +4564,7 @@ void Lsr_E()
 
 void Eim_E()
 { //75 6309 Untested CHECK NITRO
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16=IMMADDRESS(PC_REG);
 	postbyte^= MemRead8(temp16);
 	MemWrite8(postbyte,temp16);
@@ -4828,7 +4646,7 @@ void Dec_E()
 
 void Tim_E()
 { //7B 6309 NITRO 
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16=IMMADDRESS(PC_REG);
 	postbyte&=MemRead8(temp16);
 	cc[N] = NTEST8(postbyte);
@@ -4880,7 +4698,7 @@ void Clr_E()
 
 void Suba_M()
 { //80
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16 = A_REG - postbyte;
 	cc[C] = (temp16 & 0x100)>>8; 
 	cc[V] = OVERFLOW8(cc[C],postbyte,temp16,A_REG);
@@ -4892,7 +4710,7 @@ void Suba_M()
 
 void Cmpa_M()
 { //81
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp8= A_REG-postbyte;
 	cc[C] = temp8 > A_REG;
 	cc[V] = OVERFLOW8(cc[C],postbyte,temp8,A_REG);
@@ -4903,7 +4721,7 @@ void Cmpa_M()
 
 void Sbca_M()
 {  //82
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16=A_REG-postbyte-cc[C];
 	cc[C] = (temp16 & 0x100)>>8;
 	cc[V] = OVERFLOW8(cc[C],postbyte,temp16,A_REG);
@@ -4928,7 +4746,7 @@ void Subd_M()
 
 void Anda_M()
 { //84
-	A_REG = A_REG & MemRead8(PC_REG++);
+	A_REG = A_REG & MemFetch8(PC_REG++);
 	cc[N] = NTEST8(A_REG);
 	cc[Z] = ZTEST(A_REG);
 	cc[V] = 0;
@@ -4937,7 +4755,7 @@ void Anda_M()
 
 void Bita_M()
 { //85
-	temp8 = A_REG & MemRead8(PC_REG++);
+	temp8 = A_REG & MemFetch8(PC_REG++);
 	cc[N] = NTEST8(temp8);
 	cc[Z] = ZTEST(temp8);
 	cc[V] = 0;
@@ -4946,7 +4764,7 @@ void Bita_M()
 
 void Lda_M()
 { //86
-	A_REG = MemRead8(PC_REG++);
+	A_REG = MemFetch8(PC_REG++);
 	cc[Z] = ZTEST(A_REG);
 	cc[N] = NTEST8(A_REG);
 	cc[V] = 0;
@@ -4955,7 +4773,7 @@ void Lda_M()
 
 void Eora_M()
 { //88
-	A_REG = A_REG ^ MemRead8(PC_REG++);
+	A_REG = A_REG ^ MemFetch8(PC_REG++);
 	cc[N] = NTEST8(A_REG);
 	cc[Z] = ZTEST(A_REG);
 	cc[V] = 0;
@@ -4964,7 +4782,7 @@ void Eora_M()
 
 void Adca_M()
 { //89
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16= A_REG + postbyte + cc[C];
 	cc[C] = (temp16 & 0x100)>>8;
 	cc[V] = OVERFLOW8(cc[C],postbyte,temp16,A_REG);
@@ -4977,7 +4795,7 @@ void Adca_M()
 
 void Ora_M()
 { //8A
-	A_REG = A_REG | MemRead8(PC_REG++);
+	A_REG = A_REG | MemFetch8(PC_REG++);
 	cc[N] = NTEST8(A_REG);
 	cc[Z] = ZTEST(A_REG);
 	cc[V] = 0;
@@ -4986,7 +4804,7 @@ void Ora_M()
 
 void Adda_M()
 { //8B
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16=A_REG+postbyte;
 	cc[C] =(temp16 & 0x100)>>8;
 	cc[H] = ((A_REG ^ postbyte ^ temp16) & 0x10)>>4;
@@ -5011,7 +4829,7 @@ void Cmpx_M()
 
 void Bsr_R()
 { //8D
-	*spostbyte=MemRead8(PC_REG++);
+	*spostbyte=MemFetch8(PC_REG++);
 	S_REG--;
 	MemWrite8(pc.B.lsb,S_REG--);
 	MemWrite8(pc.B.msb,S_REG);
@@ -5546,7 +5364,7 @@ void Stx_E()
 
 void Subb_M()
 { //C0
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16 = B_REG - postbyte;
 	cc[C] = (temp16 & 0x100)>>8; 
 	cc[V] = OVERFLOW8(cc[C],postbyte,temp16,B_REG);
@@ -5558,7 +5376,7 @@ void Subb_M()
 
 void Cmpb_M()
 { //C1
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp8= B_REG-postbyte;
 	cc[C] = temp8 > B_REG;
 	cc[V] = OVERFLOW8(cc[C],postbyte,temp8,B_REG);
@@ -5569,7 +5387,7 @@ void Cmpb_M()
 
 void Sbcb_M()
 { //C2
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16=B_REG-postbyte-cc[C];
 	cc[C] = (temp16 & 0x100)>>8;
 	cc[V] = OVERFLOW8(cc[C],postbyte,temp16,B_REG);
@@ -5594,7 +5412,7 @@ void Addd_M()
 
 void Andb_M()
 { //C4 LOOK
-	B_REG = B_REG & MemRead8(PC_REG++);
+	B_REG = B_REG & MemFetch8(PC_REG++);
 	cc[N] = NTEST8(B_REG);
 	cc[Z] = ZTEST(B_REG);
 	cc[V] = 0;
@@ -5603,7 +5421,7 @@ void Andb_M()
 
 void Bitb_M()
 { //C5
-	temp8 = B_REG & MemRead8(PC_REG++);
+	temp8 = B_REG & MemFetch8(PC_REG++);
 	cc[N] = NTEST8(temp8);
 	cc[Z] = ZTEST(temp8);
 	cc[V] = 0;
@@ -5612,7 +5430,7 @@ void Bitb_M()
 
 void Ldb_M()
 { //C6
-	B_REG=MemRead8(PC_REG++);
+	B_REG=MemFetch8(PC_REG++);
 	cc[Z] = ZTEST(B_REG);
 	cc[N] = NTEST8(B_REG);
 	cc[V] = 0;
@@ -5621,7 +5439,7 @@ void Ldb_M()
 
 void Eorb_M()
 { //C8
-	B_REG = B_REG ^ MemRead8(PC_REG++);
+	B_REG = B_REG ^ MemFetch8(PC_REG++);
 	cc[N] =NTEST8(B_REG);
 	cc[Z] =ZTEST(B_REG);
 	cc[V] = 0;
@@ -5630,7 +5448,7 @@ void Eorb_M()
 
 void Adcb_M()
 { //C9
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16= B_REG + postbyte + cc[C];
 	cc[C] = (temp16 & 0x100)>>8;
 	cc[V] = OVERFLOW8(cc[C],postbyte,temp16,B_REG);
@@ -5643,7 +5461,7 @@ void Adcb_M()
 
 void Orb_M()
 { //CA
-	B_REG= B_REG | MemRead8(PC_REG++);
+	B_REG= B_REG | MemFetch8(PC_REG++);
 	cc[N] = NTEST8(B_REG);
 	cc[Z] = ZTEST(B_REG);
 	cc[V] = 0;
@@ -5652,7 +5470,7 @@ void Orb_M()
 
 void Addb_M()
 { //CB
-	postbyte=MemRead8(PC_REG++);
+	postbyte=MemFetch8(PC_REG++);
 	temp16=B_REG+postbyte;
 	cc[C] =(temp16 & 0x100)>>8;
 	cc[H] = ((B_REG ^ postbyte ^ temp16) & 0x10)>>4;
@@ -5932,7 +5750,7 @@ void Ldb_X()
 
 void Stb_X()
 { //E7
-	MemWrite8(B_REG,CalculateEA( MemRead8(PC_REG++)));
+	MemWrite8(B_REG,CalculateEA( MemFetch8(PC_REG++)));
 	cc[Z] = ZTEST(B_REG);
 	cc[N] = NTEST8(B_REG);
 	cc[V] = 0;
@@ -7000,9 +6818,9 @@ void(*JmpVec3[256])() = {
 
 // Stepping check for Tfm and step over it
 void StepIns() {
-	JmpVec1[MemRead8(PC_REG++)]();
+	JmpVec1[MemFetch8(PC_REG++)]();
 	while (DoingTFM)
-		JmpVec1[MemRead8(PC_REG++)]();
+		JmpVec1[MemFetch8(PC_REG++)]();
 }
 
 int HD6309Exec(int CycleFor)
@@ -7010,8 +6828,10 @@ int HD6309Exec(int CycleFor)
     extern int JS_Ramp_Clock;
 	int PrevCycleCount = 0;
 	CycleCounter = 0;
+	SliceEnding = false;
 	gCycleFor = CycleFor;
 	while (CycleCounter < CycleFor) {
+		InstructionStart = CycleCounter;
 
 		// CPU is halted.
 		if (EmuState.Debugger.IsHalted())
@@ -7091,7 +6911,37 @@ int HD6309Exec(int CycleFor)
 			EmuState.Debugger.TraceCaptureBefore(CycleCounter, HD6309GetState());
 		}
 
-		JmpVec1[MemRead8(PC_REG++)](); // Execute instruction pointed to by PC_REG
+		// A fuzzing harness gathers coverage and ends the run at its stop addresses
+		if (FuzzArmed && FuzzInstruction(PC_REG))
+		{
+			break;
+		}
+
+		// Cassette turbo mode runs the ROM's cassette output routines itself
+		if (CassetteTrapsArmed && CassetteTrap(PC_REG))
+		{
+			continue;
+		}
+
+		// Hot BASIC routines can run natively
+		if (RomHooksArmed && RomHookEntry(PC_REG))
+		{
+			const int hooked = RomHook(PC_REG);
+			if (hooked)
+			{
+				CycleCounter += hooked;
+				continue;
+			}
+		}
+
+		// Reverse execution watches instruction boundaries while replaying
+		if (ReplayWatching)
+		{
+			ReplayInstruction(PC_REG);
+		}
+
+		JmpVec1[MemFetch8(PC_REG++)](); // Execute instruction pointed to by PC_REG
+		InstructionsRetired++;
 
 		if (EmuState.Debugger.IsTracing())
 		{
@@ -7103,19 +6953,42 @@ int HD6309Exec(int CycleFor)
 		}
 		PrevCycleCount = CycleCounter;
 
+		// The emulator needs control back before the slice is over
+		if (SliceEnding)
+			break;
+
 	}//End While
 
 	return(CycleFor - CycleCounter);
 }
 
+// Cycles run so far by the HD6309Exec call in progress
+int HD6309SliceCycles()
+{
+	return CycleCounter;
+}
+
+// Cycles run by the HD6309Exec call in progress when the instruction being
+// executed (or the interrupt being taken) began
+int HD6309InstructionCycles()
+{
+	return InstructionStart;
+}
+
+// Stop the HD6309Exec call in progress after the current instruction
+void HD6309EndSlice()
+{
+	SliceEnding = true;
+}
+
 void Page_2() //10
 {
-	JmpVec2[MemRead8(PC_REG++)](); // Execute instruction pointed to by PC_REG
+	JmpVec2[MemFetch8(PC_REG++)](); // Execute instruction pointed to by PC_REG
 }
 
 void Page_3() //11
 {
-	JmpVec3[MemRead8(PC_REG++)](); // Execute instruction pointed to by PC_REG
+	JmpVec3[MemFetch8(PC_REG++)](); // Execute instruction pointed to by PC_REG
 }
 
 void cpu_firq()
@@ -7132,9 +7005,7 @@ void cpu_firq()
 		{
 		case 0:
 			cc[E] = 0; // Turn E flag off
-			MemWrite8(pc.B.lsb, --S_REG);
-			MemWrite8(pc.B.msb, --S_REG);
-			MemWrite8(getcc(), --S_REG);
+			PushRegisters(s,0x81,u);
 			cc[I] = 1;
 			cc[F] = 1;
 			PC_REG = MemRead16(VFIRQ);
@@ -7142,23 +7013,7 @@ void cpu_firq()
 
 		case 1:		//6309
 			cc[E] = 1;
-			MemWrite8(pc.B.lsb, --S_REG);
-			MemWrite8(pc.B.msb, --S_REG);
-			MemWrite8(u.B.lsb, --S_REG);
-			MemWrite8(u.B.msb, --S_REG);
-			MemWrite8(y.B.lsb, --S_REG);
-			MemWrite8(y.B.msb, --S_REG);
-			MemWrite8(x.B.lsb, --S_REG);
-			MemWrite8(x.B.msb, --S_REG);
-			MemWrite8(dp.B.msb, --S_REG);
-			if (md[NATIVE6309])
-			{
-				MemWrite8((F_REG), --S_REG);
-				MemWrite8((E_REG), --S_REG);
-			}
-			MemWrite8(B_REG, --S_REG);
-			MemWrite8(A_REG, --S_REG);
-			MemWrite8(getcc(), --S_REG);
+			PushRegisters(s,0xFF,u,md[NATIVE6309]);
 			cc[I] = 1;
 			cc[F] = 1;
 			PC_REG = MemRead16(VFIRQ);
@@ -7192,23 +7047,7 @@ void cpu_irq()
 			EmuState.Debugger.TraceCaptureInterruptServicing(IRQ, CycleCounter, HD6309GetState());
 		}
 	cc[E] = 1;
-	MemWrite8(pc.B.lsb, --S_REG);
-	MemWrite8(pc.B.msb, --S_REG);
-	MemWrite8(u.B.lsb, --S_REG);
-	MemWrite8(u.B.msb, --S_REG);
-	MemWrite8(y.B.lsb, --S_REG);
-	MemWrite8(y.B.msb, --S_REG);
-	MemWrite8(x.B.lsb, --S_REG);
-	MemWrite8(x.B.msb, --S_REG);
-	MemWrite8(dp.B.msb, --S_REG);
-	if (md[NATIVE6309])
-	{
-		MemWrite8((F_REG), --S_REG);
-		MemWrite8((E_REG), --S_REG);
-	}
-	MemWrite8(B_REG, --S_REG);
-	MemWrite8(A_REG, --S_REG);
-	MemWrite8(getcc(), --S_REG);
+	PushRegisters(s,0xFF,u,md[NATIVE6309]);
 	PC_REG = MemRead16(VIRQ);
 	cc[I] = 1;
 	if (EmuState.Debugger.IsTracing())
@@ -7235,23 +7074,7 @@ void cpu_nmi()
 	}
 
 	cc[E] = 1;
-	MemWrite8(pc.B.lsb, --S_REG);
-	MemWrite8(pc.B.msb, --S_REG);
-	MemWrite8(u.B.lsb, --S_REG);
-	MemWrite8(u.B.msb, --S_REG);
-	MemWrite8(y.B.lsb, --S_REG);
-	MemWrite8(y.B.msb, --S_REG);
-	MemWrite8(x.B.lsb, --S_REG);
-	MemWrite8(x.B.msb, --S_REG);
-	MemWrite8(dp.B.msb, --S_REG);
-	if (md[NATIVE6309])
-	{
-		MemWrite8((F_REG), --S_REG);
-		MemWrite8((E_REG), --S_REG);
-	}
-	MemWrite8(B_REG, --S_REG);
-	MemWrite8(A_REG, --S_REG);
-	MemWrite8(getcc(), --S_REG);
+	PushRegisters(s,0xFF,u,md[NATIVE6309]);
 	cc[I] = 1;
 	cc[F] = 1;
 	PC_REG = MemRead16(VNMI);
@@ -7265,254 +7088,176 @@ void cpu_nmi()
 	return;
 }
 
-static unsigned short CalculateEA(unsigned char postbyte)
-{
-	static unsigned short int ea = 0;
-	static signed char byte = 0;
-	static unsigned char Register;
-
-	Register = ((postbyte >> 5) & 3) + 1;
-
-	if (postbyte & 0x80)
-	{
-		switch (postbyte & 0x1F)
-		{
-		case 0: // Post inc by 1
-			ea = (*xfreg16[Register]);
-			(*xfreg16[Register])++;
-			CycleCounter += NatEmuCycles21;
-			break;
-
-		case 1: // post in by 2
-			ea = (*xfreg16[Register]);
-			(*xfreg16[Register]) += 2;
-			CycleCounter += NatEmuCycles32;
-			break;
-
-		case 2: // pre dec by 1
-			(*xfreg16[Register]) -= 1;
-			ea = (*xfreg16[Register]);
-			CycleCounter += NatEmuCycles21;
-			break;
-
-		case 3: // pre dec by 2
-			(*xfreg16[Register]) -= 2;
-			ea = (*xfreg16[Register]);
-			CycleCounter += NatEmuCycles32;
-			break;
-
-		case 4: // no offset
-			ea = (*xfreg16[Register]);
-			break;
+// Indexed addressing postbyte decode. Every postbyte is resolved at compile
+// time to the way its effective address is formed, so CalculateEA is a single
+// table lookup plus the handler for that addressing mode. Both CPU cores have
+// their own table, so the types stay local to this file.
+namespace {
 
-		case 5: // B reg offset
-			ea = (*xfreg16[Register]) + ((signed char)B_REG);
-			CycleCounter += 1;
-			break;
-
-		case 6: // A reg offset
-			ea = (*xfreg16[Register]) + ((signed char)A_REG);
-			CycleCounter += 1;
-			break;
-
-		case 7: // E reg offset 
-			ea = (*xfreg16[Register]) + ((signed char)E_REG);
-			CycleCounter += 1;
-			break;
-
-		case 8: // 8 bit offset
-			ea = (*xfreg16[Register]) + (signed char)MemRead8(PC_REG++);
-			CycleCounter += 1;
-			break;
-
-		case 9: // 16 bit offset
-			ea = (*xfreg16[Register]) + IMMADDRESS(PC_REG);
-			CycleCounter += NatEmuCycles43;
-			PC_REG += 2;
-			break;
-
-		case 10: // F reg offset
-			ea = (*xfreg16[Register]) + ((signed char)F_REG);
-			CycleCounter += 1;
-			break;
-
-		case 11: // D reg offset 
-			ea = (*xfreg16[Register]) + D_REG; //Changed to unsigned 03/14/2005 NG Was signed
-			CycleCounter += NatEmuCycles42;
-			break;
-
-		case 12: // 8 bit PC relative
-			ea = (signed short)PC_REG + (signed char)MemRead8(PC_REG) + 1;
-			CycleCounter += 1;
-			PC_REG++;
-			break;
-
-		case 13: // 16 bit PC relative
-			ea = PC_REG + IMMADDRESS(PC_REG) + 2;
-			CycleCounter += NatEmuCycles53;
-			PC_REG += 2;
-			break;
-
-		case 14: // W reg offset
-			ea = (*xfreg16[Register]) + W_REG;
-			CycleCounter += 4;
-			break;
-
-		case 15: // W reg
-			byte = (postbyte >> 5) & 3;
-			switch (byte)
-			{
-			case 0: // No offset from W reg
-				ea = W_REG;
-				break;
-			case 1: // 16 bit offset from W reg
-				ea = W_REG + IMMADDRESS(PC_REG);
-				PC_REG += 2;
-				CycleCounter += 2;
-				break;
-			case 2: // Post inc by 2 from W reg
-				ea = W_REG;
-				W_REG += 2;
-				CycleCounter += 1;
-				break;
-			case 3: // Pre dec by 2 from W reg
-				W_REG -= 2;
-				ea = W_REG;
-				CycleCounter += 1;
-				break;
-			}
-			break;
-
-		case 16: // W reg
-			byte = (postbyte >> 5) & 3;
-			switch (byte)
-			{
-			case 0: // Indirect no offset from W reg
-				ea = MemRead16(W_REG);
-				CycleCounter += 3;
-				break;
-			case 1: // Indirect 16 bit offset from W reg
-				ea = MemRead16(W_REG + IMMADDRESS(PC_REG));
-				PC_REG += 2;
-				CycleCounter += 5;
-				break;
-			case 2: // Indirect post inc by 2 from W reg
-				ea = MemRead16(W_REG);
-				W_REG += 2;
-				CycleCounter += 4;
-				break;
-			case 3: // Indirect pre dec by 2 from W reg
-				W_REG -= 2;
-				ea = MemRead16(W_REG);
-				CycleCounter += 4;
-				break;
-			}
-			break;
-
-		case 17: // Indirect post inc by 2 
-			ea = (*xfreg16[Register]);
-			(*xfreg16[Register]) += 2;
-			ea = MemRead16(ea);
-			CycleCounter += 6;
-			break;
-
-		case 18: // possibly illegal instruction
-			CycleCounter += 6;
-			break;
-
-		case 19: // Indirect pre dec by 2
-			(*xfreg16[Register]) -= 2;
-			ea = (*xfreg16[Register]);
-			ea = MemRead16(ea);
-			CycleCounter += 6;
-			break;
-
-		case 20: // Indirect no offset 
-			ea = (*xfreg16[Register]);
-			ea = MemRead16(ea);
-			CycleCounter += 3;
-			break;
-
-		case 21: // Indirect B reg offset
-			ea = (*xfreg16[Register]) + ((signed char)B_REG);
-			ea = MemRead16(ea);
-			CycleCounter += 4;
-			break;
-
-		case 22: // indirect A reg offset
-			ea = (*xfreg16[Register]) + ((signed char)A_REG);
-			ea = MemRead16(ea);
-			CycleCounter += 4;
-			break;
-
-		case 23: // indirect E reg offset
-			ea = (*xfreg16[Register]) + ((signed char)E_REG);
-			ea = MemRead16(ea);
-			CycleCounter += 4;
-			break;
-
-		case 24: // indirect 8 bit offset
-			ea = (*xfreg16[Register]) + (signed char)MemRead8(PC_REG++);
-			ea = MemRead16(ea);
-			CycleCounter += 4;
-			break;
-
-		case 25: // indirect 16 bit offset
-			ea = (*xfreg16[Register]) + IMMADDRESS(PC_REG);
-			ea = MemRead16(ea);
-			CycleCounter += 7;
-			PC_REG += 2;
-			break;
+enum IndexedEAMode : unsigned char
+{
+	EA_OFFSET,		// R + constant or fetched offset (5, 8 and 16 bit, or none)
+	EA_POSTINC1,	// ,R+
+	EA_POSTINC2,	// ,R++
+	EA_PREDEC1,		// ,-R
+	EA_PREDEC2,		// ,--R
+	EA_AOFFSET,		// A,R
+	EA_BOFFSET,		// B,R
+	EA_DOFFSET,		// D,R
+	EA_EOFFSET,		// E,R
+	EA_FOFFSET,		// F,R
+	EA_WOFFSET,		// W,R
+	EA_PCREL,		// n,PCR
+	EA_EXTENDED,	// [n]
+	EA_ILLEGAL		// Undefined postbyte, addresses R
+};
 
-		case 26: // indirect F reg offset
-			ea = (*xfreg16[Register]) + ((signed char)F_REG);
-			ea = MemRead16(ea);
-			CycleCounter += 4;
-			break;
+struct IndexedMode
+{
+	IndexedEAMode Mode;
+	unsigned char Register;		// Index into xfreg16
+	unsigned char Cycles[2];	// Extra cycles beyond the base instruction, emulation/native mode
+	unsigned char OffsetSize;	// Offset bytes following the postbyte
+	bool Indirect;
+	signed char Offset;			// 5 bit offset when OffsetSize is 0
+};
 
-		case 27: // indirect D reg offset
-			ea = (*xfreg16[Register]) + D_REG;
-			ea = MemRead16(ea);
-			CycleCounter += 7;
-			break;
+} // namespace
 
-		case 28: // indirect 8 bit PC relative
-			ea = (signed short)PC_REG + (signed char)MemRead8(PC_REG) + 1;
-			ea = MemRead16(ea);
-			CycleCounter += 4;
-			PC_REG++;
-			break;
+static constexpr IndexedMode DecodeIndexedPostbyte(unsigned char postbyte)
+{
+	const unsigned char Register=((postbyte >> 5) & 3) + 1;
+	const unsigned char WRegister=6;
+	if (!(postbyte & 0x80))
+		return { EA_OFFSET, Register, {1,1}, 0, false, static_cast<signed char>((postbyte & 0x10) ? (postbyte & 0x1F) - 32 : (postbyte & 0x1F)) };
+
+	switch (postbyte & 0x1F)
+	{
+	case 0:  return { EA_POSTINC1, Register, {2,1}, 0, false, 0 };
+	case 1:  return { EA_POSTINC2, Register, {3,2}, 0, false, 0 };
+	case 2:  return { EA_PREDEC1, Register, {2,1}, 0, false, 0 };
+	case 3:  return { EA_PREDEC2, Register, {3,2}, 0, false, 0 };
+	case 4:  return { EA_OFFSET, Register, {0,0}, 0, false, 0 };
+	case 5:  return { EA_BOFFSET, Register, {1,1}, 0, false, 0 };
+	case 6:  return { EA_AOFFSET, Register, {1,1}, 0, false, 0 };
+	case 7:  return { EA_EOFFSET, Register, {1,1}, 0, false, 0 };
+	case 8:  return { EA_OFFSET, Register, {1,1}, 1, false, 0 };
+	case 9:  return { EA_OFFSET, Register, {4,3}, 2, false, 0 };
+	case 10: return { EA_FOFFSET, Register, {1,1}, 0, false, 0 };
+	case 11: return { EA_DOFFSET, Register, {4,2}, 0, false, 0 };
+	case 12: return { EA_PCREL, Register, {1,1}, 1, false, 0 };
+	case 13: return { EA_PCREL, Register, {5,3}, 2, false, 0 };
+	case 14: return { EA_WOFFSET, Register, {4,4}, 0, false, 0 };
+	case 15:	// ,W  n,W  ,W++  ,--W selected by the register bits
+		switch (Register)
+		{
+		case 1:  return { EA_OFFSET, WRegister, {0,0}, 0, false, 0 };
+		case 2:  return { EA_OFFSET, WRegister, {2,2}, 2, false, 0 };
+		case 3:  return { EA_POSTINC2, WRegister, {1,1}, 0, false, 0 };
+		default: return { EA_PREDEC2, WRegister, {1,1}, 0, false, 0 };
+		}
+	case 16:	// Indirect forms of the above
+		switch (Register)
+		{
+		case 1:  return { EA_OFFSET, WRegister, {3,3}, 0, true, 0 };
+		case 2:  return { EA_OFFSET, WRegister, {5,5}, 2, true, 0 };
+		case 3:  return { EA_POSTINC2, WRegister, {4,4}, 0, true, 0 };
+		default: return { EA_PREDEC2, WRegister, {4,4}, 0, true, 0 };
+		}
+	case 17: return { EA_POSTINC2, Register, {6,6}, 0, true, 0 };
+	case 18: return { EA_ILLEGAL, Register, {6,6}, 0, false, 0 };
+	case 19: return { EA_PREDEC2, Register, {6,6}, 0, true, 0 };
+	case 20: return { EA_OFFSET, Register, {3,3}, 0, true, 0 };
+	case 21: return { EA_BOFFSET, Register, {4,4}, 0, true, 0 };
+	case 22: return { EA_AOFFSET, Register, {4,4}, 0, true, 0 };
+	case 23: return { EA_EOFFSET, Register, {4,4}, 0, true, 0 };
+	case 24: return { EA_OFFSET, Register, {4,4}, 1, true, 0 };
+	case 25: return { EA_OFFSET, Register, {7,7}, 2, true, 0 };
+	case 26: return { EA_FOFFSET, Register, {4,4}, 0, true, 0 };
+	case 27: return { EA_DOFFSET, Register, {7,7}, 0, true, 0 };
+	case 28: return { EA_PCREL, Register, {4,4}, 1, true, 0 };
+	case 29: return { EA_PCREL, Register, {8,8}, 2, true, 0 };
+	case 30: return { EA_WOFFSET, Register, {7,7}, 0, true, 0 };
+	default: return { EA_EXTENDED, Register, {8,8}, 2, true, 0 };
+	}
+}
 
-		case 29: //indirect 16 bit PC relative
-			ea = PC_REG + IMMADDRESS(PC_REG) + 2;
-			ea = MemRead16(ea);
-			CycleCounter += 8;
-			PC_REG += 2;
-			break;
+static constexpr std::array<IndexedMode, 256> BuildIndexedModes()
+{
+	std::array<IndexedMode, 256> Modes {};
+	for (unsigned int postbyte=0;postbyte<256;postbyte++)
+		Modes[postbyte]=DecodeIndexedPostbyte(static_cast<unsigned char>(postbyte));
+	return Modes;
+}
 
-		case 30: // indirect W reg offset
-			ea = (*xfreg16[Register]) + W_REG;
-			ea = MemRead16(ea);
-			CycleCounter += 7;
-			break;
+static constexpr std::array<IndexedMode, 256> IndexedModes=BuildIndexedModes();
 
-		case 31: // extended indirect
-			ea = IMMADDRESS(PC_REG);
-			ea = MemRead16(ea);
-			CycleCounter += 8;
-			PC_REG += 2;
-			break;
+static unsigned short CalculateEA(unsigned char postbyte)
+{
+	const IndexedMode &Mode=IndexedModes[postbyte];
+	unsigned short &Register=*xfreg16[Mode.Register];
+	unsigned short Offset=static_cast<unsigned short>(Mode.Offset);
+	unsigned short ea;
 
-		} //END Switch
-	}
-	else // 5 bit offset
+	if (Mode.OffsetSize==1)
+		Offset=static_cast<unsigned short>((signed char)MemFetch8(PC_REG++));
+	else if (Mode.OffsetSize==2)
 	{
-		byte = (postbyte & 31);
-		byte = (byte << 3);
-		byte = byte / 8;
-		ea = *xfreg16[Register] + byte; //Was signed
-		CycleCounter += 1;
+		Offset=IMMADDRESS(PC_REG);
+		PC_REG+=2;
 	}
+
+	switch (Mode.Mode)
+	{
+	case EA_OFFSET:
+		ea=Register+Offset;
+		break;
+	case EA_POSTINC1:
+		ea=Register++;
+		break;
+	case EA_POSTINC2:
+		ea=Register;
+		Register+=2;
+		break;
+	case EA_PREDEC1:
+		ea=--Register;
+		break;
+	case EA_PREDEC2:
+		Register-=2;
+		ea=Register;
+		break;
+	case EA_AOFFSET:
+		ea=Register+((signed char)A_REG);
+		break;
+	case EA_BOFFSET:
+		ea=Register+((signed char)B_REG);
+		break;
+	case EA_DOFFSET:
+		ea=Register+D_REG; //Changed to unsigned 03/14/2005 NG Was signed
+		break;
+	case EA_EOFFSET:
+		ea=Register+((signed char)E_REG);
+		break;
+	case EA_FOFFSET:
+		ea=Register+((signed char)F_REG);
+		break;
+	case EA_WOFFSET:
+		ea=Register+W_REG;
+		break;
+	case EA_PCREL:
+		ea=PC_REG+Offset;
+		break;
+	case EA_EXTENDED:
+		ea=Offset;
+		break;
+	default:
+		ea=Register;
+		break;
+	}
+
+	if (Mode.Indirect)
+		ea=MemRead16(ea);
+	CycleCounter+=Mode.Cycles[md[NATIVE6309]];
 	return ea;
 }
 
@@ -7594,29 +7339,111 @@ void DivbyZero()
 void ErrorVector()
 {
 	cc[E]=1;
-	MemWrite8( pc.B.lsb,--S_REG);
-	MemWrite8( pc.B.msb,--S_REG);
-	MemWrite8( u.B.lsb,--S_REG);
-	MemWrite8( u.B.msb,--S_REG);
-	MemWrite8( y.B.lsb,--S_REG);
-	MemWrite8( y.B.msb,--S_REG);
-	MemWrite8( x.B.lsb,--S_REG);
-	MemWrite8( x.B.msb,--S_REG);
-	MemWrite8( dp.B.msb,--S_REG);
+	PushRegisters(s,0xFF,u,md[NATIVE6309]);
 	if (md[NATIVE6309])
-	{
-		MemWrite8((F_REG),--S_REG);
-		MemWrite8((E_REG),--S_REG);
 		CycleCounter+=2;
-	}
-	MemWrite8(B_REG,--S_REG);
-	MemWrite8(A_REG,--S_REG);
-	MemWrite8(getcc(),--S_REG);
 	PC_REG=MemRead16(VTRAP);
 	CycleCounter+=(12 + NatEmuCycles54);	//One for each byte +overhead? Guessing from PSHS
 	return;
 }
 
+// Number of stack bytes moved for each nibble of a PSH/PUL postbyte
+static const unsigned char StackNibbleBytes[16]={0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4};
+
+// Stacks the registers selected by postbyte (PSHS/PSHU layout) below sp as one
+// block. other is the opposite stack pointer, U when stacking on S and S when
+// stacking on U. withW adds E and F between DP and B as native mode interrupt
+// entry does. Returns the number of bytes pushed.
+unsigned char PushRegisters(cpuregister &sp,unsigned char postbyte,const cpuregister &other,bool withW)
+{
+	unsigned char Bytes[14];
+	unsigned char Bottom=sizeof(Bytes);
+	if (postbyte & 0x80)
+	{
+		Bytes[--Bottom]=pc.B.lsb;
+		Bytes[--Bottom]=pc.B.msb;
+	}
+	if (postbyte & 0x40)
+	{
+		Bytes[--Bottom]=other.B.lsb;
+		Bytes[--Bottom]=other.B.msb;
+	}
+	if (postbyte & 0x20)
+	{
+		Bytes[--Bottom]=y.B.lsb;
+		Bytes[--Bottom]=y.B.msb;
+	}
+	if (postbyte & 0x10)
+	{
+		Bytes[--Bottom]=x.B.lsb;
+		Bytes[--Bottom]=x.B.msb;
+	}
+	if (postbyte & 0x08)
+		Bytes[--Bottom]=dp.B.msb;
+	if (withW)
+	{
+		Bytes[--Bottom]=F_REG;
+		Bytes[--Bottom]=E_REG;
+	}
+	if (postbyte & 0x04)
+		Bytes[--Bottom]=B_REG;
+	if (postbyte & 0x02)
+		Bytes[--Bottom]=A_REG;
+	if (postbyte & 0x01)
+		Bytes[--Bottom]=getcc();
+
+	const unsigned char Count=sizeof(Bytes)-Bottom;
+	MemPushBlock(Bytes+Bottom,Count,sp.Reg);
+	sp.Reg-=Count;
+	return Count;
+}
+
+// Unstacks the registers selected by postbyte (PULS/PULU layout) from sp,
+// with E and F following B when withW is set. Returns the number of bytes pulled.
+unsigned char PullRegisters(cpuregister &sp,unsigned char postbyte,cpuregister &other,bool withW)
+{
+	unsigned char Bytes[14];
+	const unsigned char Count=StackNibbleBytes[postbyte & 0x0F]+2*StackNibbleBytes[postbyte>>4]+(withW ? 2 : 0);
+	MemPullBlock(Bytes,Count,sp.Reg);
+	sp.Reg+=Count;
+
+	unsigned char Index=0;
+	if (postbyte & 0x01)
+		setcc(Bytes[Index++]);
+	if (postbyte & 0x02)
+		A_REG=Bytes[Index++];
+	if (postbyte & 0x04)
+		B_REG=Bytes[Index++];
+	if (withW)
+	{
+		E_REG=Bytes[Index++];
+		F_REG=Bytes[Index++];
+	}
+	if (postbyte & 0x08)
+		dp.B.msb=Bytes[Index++];
+	if (postbyte & 0x10)
+	{
+		x.B.msb=Bytes[Index++];
+		x.B.lsb=Bytes[Index++];
+	}
+	if (postbyte & 0x20)
+	{
+		y.B.msb=Bytes[Index++];
+		y.B.lsb=Bytes[Index++];
+	}
+	if (postbyte & 0x40)
+	{
+		other.B.msb=Bytes[Index++];
+		other.B.lsb=Bytes[Index++];
+	}
+	if (postbyte & 0x80)
+	{
+		pc.B.msb=Bytes[Index++];
+		pc.B.lsb=Bytes[Index++];
+	}
+	return Count;
+}
+
 unsigned char GetSorceReg(unsigned char Tmp)
 {
 	unsigned char Source=(Tmp>>4);
@@ -20,14 +20,21 @@ This file is part of VCC (Virtual Color Computer).
 
 #include <vector>
 #include "cutie/compat.h"  // For VCC::CPUState
+#include "cutie/state.h"
 
 void HD6309Init();
 int  HD6309Exec( int);
+int  HD6309SliceCycles();
+int  HD6309InstructionCycles();
+void HD6309EndSlice();
 void HD6309Reset();
 void HD6309AssertInterupt(unsigned char,unsigned char);
 void HD6309DeAssertInterupt(unsigned char);// 4 nmi 2 firq 1 irq
 void HD6309ForcePC(unsigned short);
 VCC::CPUState HD6309GetState();
+void HD6309SetState(const VCC::CPUState &);
+void HD6309SaveState(cutie::StateWriter &);
+bool HD6309LoadState(cutie::StateReader &);
 void HD6309SetBreakpoints(const std::vector<unsigned short>& breakpoints);
 void HD6309SetTraceTriggers(const std::vector<unsigned short>& triggers);
 
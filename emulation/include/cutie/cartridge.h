@@ -97,6 +97,16 @@ public:
      */
     void reset();
 
+    /**
+     * @brief Currently selected ROM bank, for save states
+     */
+    uint8_t bankSelect() const;
+
+    /**
+     * @brief Restore the selected ROM bank from a save state
+     */
+    void setBankSelect(uint8_t bank);
+
     /**
      * @brief Get last error message
      */
@@ -0,0 +1,145 @@
+#ifndef CUTIE_CASSETTE_H
+#define CUTIE_CASSETTE_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace cutie {
+
+/**
+ * @brief Records cassette output straight to a .cas file
+ *
+ * The ROM writes each bit as one cycle of a sine wave on the 6-bit DAC,
+ * 1200 Hz for a 0 and 2400 Hz for a 1, least significant bit first. The
+ * recorder watches the DAC writes while the motor is on and times the high
+ * half of each cycle in CPU cycles, so no audio needs to be rendered. Bits
+ * are meaningless until a run of $55 leader bytes followed by the $3C sync
+ * byte gives the byte boundaries; from there every eight bits are written
+ * to the file as they complete. A gap in the signal or the motor turning
+ * off loses sync until the next leader.
+ *
+ * In turbo mode the ROM's WRTLDR and BLKOUT routines are not run at all:
+ * when the CPU reaches them the bytes they would have sent are written
+ * directly, the registers and memory are left as the routine leaves them
+ * and the CPU returns to the caller. CSAVE then takes no emulated time.
+ *
+ * Timing assumes the normal 0.89 MHz CPU clock, which the ROM selects
+ * before using the cassette.
+ *
+ * Not thread safe: use from the emulation thread, between frames.
+ */
+class CassetteRecorder {
+public:
+    /**
+     * @brief Start recording to a new file, replacing any existing one
+     * @param turbo Capture the ROM's cassette output routines directly
+     * @return false if the file could not be created
+     */
+    bool open(const std::filesystem::path& path, bool turbo = false);
+
+    /**
+     * @brief Stop recording and close the file
+     *
+     * A byte still being decoded is dropped.
+     */
+    void close();
+
+    bool isOpen() const { return m_file.is_open(); }
+    bool isTurbo() const { return m_turbo; }
+
+    /**
+     * @brief Bytes written to the file since it was opened
+     */
+    uint64_t bytesWritten() const { return m_written; }
+
+    std::string getLastError() const { return m_lastError; }
+
+    /**
+     * @brief The cassette motor relay switched
+     * @param cycle CPU cycles since power on
+     */
+    void motor(bool on, uint64_t cycle);
+
+    /**
+     * @brief The CPU wrote the DAC
+     * @param value Byte written to $FF20; the DAC is the top six bits
+     * @param cycle CPU cycles since power on
+     */
+    void output(uint8_t value, uint64_t cycle);
+
+    /**
+     * @brief Write bytes that need no decoding, as turbo mode does
+     *
+     * Any decoding in progress loses sync.
+     */
+    void write(const uint8_t* data, size_t length);
+
+    // Length of the high half of a bit's cycle, in CPU cycles
+    static constexpr uint64_t ShortestHalf = 100;   // 2400 Hz is about 186
+    static constexpr uint64_t OneZeroSplit = 280;   // 1200 Hz is about 373
+    static constexpr uint64_t LongestHalf = 1000;
+    // Longest low period between bits before sync is lost
+    static constexpr uint64_t GapCycles = 3000;
+
+private:
+    void bit(bool one);
+    void emit(uint8_t byte);
+    void unsync();
+
+    std::ofstream m_file;
+    std::string m_lastError;
+    bool m_turbo = false;
+    uint64_t m_written = 0;
+
+    bool m_motor = false;
+    bool m_high = false;
+    uint64_t m_rise = 0;       // Cycle the output last went high
+    uint64_t m_fall = 0;       // and low
+
+    // Bits and byte boundaries
+    uint8_t m_shift = 0;       // The last eight bits, the newest in bit 7
+    bool m_synced = false;
+    unsigned m_bits = 0;       // Bits into the byte, or seen before sync
+    unsigned m_leader = 0;     // Eight bit windows in a row that were leader
+    unsigned m_sinceLeader = 0;
+};
+
+/**
+ * @brief Global cassette recorder, fed by the PIA and the CPU cores
+ */
+CassetteRecorder& getCassetteRecorder();
+
+} // namespace cutie
+
+// Called by the PIA when the DAC or the motor relay bit is written
+void CassetteOutput(unsigned char value);
+void Motor(unsigned char state);
+
+// Set while a turbo recording is open; the CPU cores then call
+// CassetteTrap() before each instruction. It returns true if it ran the
+// routine at pc and returned from it, in which case the instruction is
+// not executed.
+extern bool CassetteTrapsArmed;
+bool CassetteTrap(unsigned short pc);
+
+#endif // CUTIE_CASSETTE_H
@@ -0,0 +1,184 @@
+#ifndef CUTIE_CONTROL_H
+#define CUTIE_CONTROL_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "memorysearch.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cutie {
+
+class CocoEmulator;
+class StateStore;
+
+/**
+ * @brief JSON-RPC control channel for driving an emulator from another process
+ *
+ * Requests are JSON-RPC 2.0 objects, one per line, read from a Unix domain
+ * socket or a loopback TCP port. Each request gets one response line.
+ *
+ * Bulk data never goes through JSON. A response whose result carries a
+ * "binary" member is followed on the same connection by exactly that many
+ * raw bytes; writeMemory likewise expects "length" raw bytes straight after
+ * its request line. Framebuffers are sent as RGBA rows of "pitch" pixels.
+ * A refused writeMemory still has its payload skipped; one without a
+ * readable length closes the connection, as the stream cannot be resynced.
+ *
+ * Methods:
+ * - load {path}: insert a cartridge and reset
+ * - reset {hard}: press the reset button, or power cycle if hard is true
+ * - runFrames {count}: run whole video frames
+ * - input {type:"key", row, col, pressed}
+ *   | {type:"axis", joystick, axis, value}
+ *   | {type:"button", joystick, button, pressed}
+ * - readMemory {address, length}: CPU address space, binary result
+ * - writeMemory {address, length} + binary payload
+ * - screenshot: binary RGBA framebuffer with width, height and pitch
+ * - saveState: write the machine to the state store, result {id}
+ * - loadState {id}: restore a state from the state store
+ * - searchStart {width}: start a RAM search over bytes (1) or big endian
+ *   words (2), result {candidates}
+ * - searchFilter {compare, value}: keep candidates that compare eq, ne, lt,
+ *   le, gt or ge with value; without value, with their previous value plus
+ *   an optional delta. Result {candidates}
+ * - searchResults {limit}: up to limit candidate addresses in physical RAM
+ * - quit: ask the runner to exit
+ *
+ * The server is single threaded. poll() services the sockets and runs each
+ * request on the calling thread, which must be the one that owns the
+ * emulator, so no request ever races emulation.
+ *
+ * With fork per connection set, every accepted connection is served by a
+ * child process forked from the caller instead (POSIX only). The child
+ * starts from the machine exactly as the parent left it, sharing its memory
+ * copy-on-write, so a runner can boot once to a checkpoint and hand each job
+ * a fresh instance of it. Nothing a child does reaches the parent or other
+ * children; quit ends only the child, which exits when its client hangs up.
+ */
+class ControlServer {
+public:
+    explicit ControlServer(CocoEmulator& emulator);
+    ~ControlServer();
+
+    ControlServer(const ControlServer&) = delete;
+    ControlServer& operator=(const ControlServer&) = delete;
+
+    /**
+     * @brief Listen on a Unix domain socket
+     *
+     * A stale socket file at the path is replaced.
+     *
+     * @return true if the socket is listening
+     */
+    bool listenUnix(const std::filesystem::path& path);
+
+    /**
+     * @brief Listen on a TCP port bound to the loopback interface
+     * @param port Port to bind, or 0 to pick a free one (see port())
+     * @return true if the socket is listening
+     */
+    bool listenTcp(uint16_t port);
+
+    /**
+     * @brief Port the TCP listener is bound to, or 0 if there is none
+     */
+    uint16_t port() const { return m_port; }
+
+    /**
+     * @brief Store used by saveState and loadState
+     *
+     * The store is not owned and must outlive the server. Without one those
+     * methods fail.
+     */
+    void setStateStore(StateStore* store) { m_stateStore = store; }
+
+    /**
+     * @brief Serve requests from an already connected socket
+     *
+     * Ownership of the descriptor passes to this object.
+     *
+     * @return true if the connection was added
+     */
+    bool addConnection(int fd);
+
+    /**
+     * @brief Serve each accepted connection from a forked child process
+     *
+     * Only affects connections accepted from the listeners afterwards.
+     * Connections passed to addConnection() are always served in process.
+     */
+    void setForkPerConnection(bool enabled) { m_forkPerConnection = enabled; }
+    bool forkPerConnection() const { return m_forkPerConnection; }
+
+    /**
+     * @brief Forked children that have not been reaped yet
+     *
+     * Children that have exited are reaped by the next poll().
+     */
+    size_t childCount() const { return m_children.size(); }
+
+    /**
+     * @brief Accept connections and run any complete requests
+     * @param timeoutMs Longest time to wait for activity (-1 waits forever)
+     * @return false once a quit request has been served
+     */
+    bool poll(int timeoutMs);
+
+    /**
+     * @brief Close the listeners and all connections
+     */
+    void close();
+
+    /**
+     * @brief Number of open client connections
+     */
+    size_t connectionCount() const { return m_connections.size(); }
+
+    /**
+     * @brief true once a client has asked the runner to quit
+     */
+    bool quitRequested() const { return m_quitRequested; }
+
+private:
+    struct Connection;
+
+    bool listenOn(int fd);
+    void serveForked(int fd);
+    void reapChildren();
+    bool service(Connection& connection);
+    bool dispatch(Connection& connection, const std::string& line, size_t& payloadSize);
+
+    CocoEmulator& m_emulator;
+    StateStore* m_stateStore = nullptr;
+    MemorySearch m_search;
+    std::vector<int> m_listeners;
+    std::vector<std::unique_ptr<Connection>> m_connections;
+    std::vector<int> m_children;
+    std::filesystem::path m_socketPath;
+    uint16_t m_port = 0;
+    bool m_quitRequested = false;
+    bool m_forkPerConnection = false;
+};
+
+} // namespace cutie
+
+#endif // CUTIE_CONTROL_H
@@ -0,0 +1,120 @@
+#ifndef CUTIE_DISASSEMBLER_H
+#define CUTIE_DISASSEMBLER_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cutie {
+
+/**
+ * @brief One decoded instruction
+ */
+struct DisassembledLine {
+    uint16_t address = 0;   // CPU address of the first byte
+    uint8_t length = 1;     // 1 to 5 bytes
+    uint8_t bytes[5] = {};
+    std::string mnemonic;   // FCB for a byte that is not an instruction
+    std::string operand;    // Branch and PC relative targets are absolute
+};
+
+/**
+ * @brief Disassembles the CPU's view of memory, keeping what it decoded
+ *
+ * Instructions are cached by where their first byte physically lives, as
+ * MemLocate() reports it, so scrolling back over code costs a lookup and
+ * code the MMU maps out and back in is still there. An entry is checked
+ * against the MMU's write count for the RAM banks it sits in: until
+ * something writes to those banks it is used as is, after that its bytes
+ * are read again and it is decoded only if they changed. Remapping the
+ * address to other memory simply finds another entry. Cartridge ROM has no
+ * write count and is always compared, and I/O is never cached.
+ *
+ * A walk forward with lines() stays on instruction boundaries by
+ * construction; previous() finds the boundary before an address by walking
+ * forward from a little way back.
+ *
+ * Not thread safe: use from the emulation thread, between frames.
+ */
+class DisassemblyCache {
+public:
+    explicit DisassemblyCache(bool hd6309 = false) : m_hd6309(hd6309) {}
+
+    /**
+     * @brief Decode the HD6309 instructions too; drops everything cached
+     */
+    void setHD6309(bool hd6309);
+    bool isHD6309() const { return m_hd6309; }
+
+    /**
+     * @brief The instruction at address as the CPU would see it now
+     *
+     * The reference is valid until the next call on this cache.
+     */
+    const DisassembledLine& at(uint16_t address);
+
+    /**
+     * @brief count instructions in a row, starting at address
+     */
+    std::vector<DisassembledLine> lines(uint16_t address, size_t count);
+
+    /**
+     * @brief Start of the instruction that ends just before address
+     */
+    uint16_t previous(uint16_t address);
+
+    void clear();
+
+    /**
+     * @brief Instructions held in the cache
+     */
+    size_t size() const { return m_lines.size(); }
+
+    /**
+     * @brief Instructions decoded since the cache was created
+     */
+    uint64_t decodes() const { return m_decodes; }
+
+    static constexpr unsigned MaxLength = 5;
+
+private:
+    struct Entry {
+        DisassembledLine line;
+        unsigned long last = 0;             // Where the last byte lives
+        unsigned long long firstWrites = 0; // Write counts of the banks holding
+        unsigned long long lastWrites = 0;  // the first and last bytes
+        unsigned int epoch = 0;
+    };
+
+    bool isCurrent(Entry& entry, unsigned long location, uint16_t address);
+    void remember(Entry& entry, unsigned long location);
+    void decode(uint16_t address, DisassembledLine& line);
+
+    bool m_hd6309;
+    std::unordered_map<unsigned long, Entry> m_lines;  // By MemLocate() of the first byte
+    DisassembledLine m_uncached;
+    uint64_t m_decodes = 0;
+};
+
+} // namespace cutie
+
+#endif // CUTIE_DISASSEMBLER_H
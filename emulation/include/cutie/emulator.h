@@ -18,11 +18,13 @@ This file is part of CutieCoCo.
     along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include "cutie/hostmemory.h"
 #include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <string>
 #include <utility>  // for std::pair
+#include <vector>
 
 namespace cutie {
 
@@ -58,6 +60,26 @@ struct EmulatorConfig {
     CpuType cpuType = CpuType::MC6809;
     std::filesystem::path systemRomPath;
     uint32_t audioSampleRate = 44100;
+
+    // Run frames that no HSYNC interrupt or mid-frame video register write
+    // can observe as one CPU slice, drawing the lines afterwards. Writes to
+    // video RAM draw the lines already passed first, so the picture is the
+    // same as line by line.
+    bool coalesceScanlines = true;
+
+    // Answer guest calls for host services at $FF88-$FF8B (see hostcall.h).
+    // File services use hostCallDirectory and are refused while it is empty.
+    bool hostCalls = false;
+    std::filesystem::path hostCallDirectory;
+
+    // Run hot Color BASIC routines natively when the stock CoCo 3 ROM is
+    // loaded (see romhooks.h). Results and cycle counts are unchanged.
+    bool romHooks = false;
+
+    // Huge pages and NUMA node for guest RAM, the frame buffer and the
+    // thread that calls init(). What the host granted is reported by
+    // getMemoryPolicyReport().
+    MemoryPolicy memoryPolicy;
 };
 
 /**
@@ -84,6 +106,22 @@ struct AudioInfo {
     size_t samplesPerFrame() const { return sampleRate / 60; }
 };
 
+/**
+ * @brief Snapshot of the whole machine, taken between frames
+ *
+ * RAM is kept apart from the device state so that stores can share pages
+ * between snapshots. Device blobs are only meaningful to the build that
+ * wrote them and are restored only into an emulator with the same CPU,
+ * memory size and system ROM.
+ */
+struct MachineState {
+    CpuType cpuType = CpuType::MC6809;
+    MemorySize memorySize = MemorySize::Mem512K;
+    uint64_t systemRomHash = 0;
+    std::vector<uint8_t> ram;
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> devices;  // Name and blob
+};
+
 /**
  * @brief CoCo 3 Emulator - Public API
  *
@@ -147,13 +185,24 @@ public:
     virtual bool init() = 0;
 
     /**
-     * @brief Reset the emulator to power-on state
+     * @brief Press the reset button
      *
-     * Resets CPU, clears RAM, reloads ROM vectors.
-     * Does not reload ROM from disk.
+     * Resets the CPU, GIME, SAM and timers. RAM keeps its contents, so
+     * BASIC warm starts; see hardReset() for a cold start.
      */
     virtual void reset() = 0;
 
+    /**
+     * @brief Power cycle the machine
+     *
+     * RAM gets its power-on pattern back and the system ROM image is
+     * restored, then everything is reset as by reset(). The RAM and ROM
+     * buffers are reused and the ROM is copied from memory unless its file
+     * has changed, so this is cheap enough to run before every test.
+     * A memory size from setMemorySize() takes effect here.
+     */
+    virtual void hardReset() = 0;
+
     /**
      * @brief Shut down the emulator
      *
@@ -290,6 +339,81 @@ public:
      */
     virtual std::string getCartridgeName() const = 0;
 
+    // ========================================================================
+    // Memory
+    // ========================================================================
+
+    /**
+     * @brief Read memory as the CPU currently sees it
+     *
+     * Addresses are translated through the current MMU map and wrap at
+     * $FFFF. Reads have no side effects: the PIA, GIME and SAM registers
+     * at $FF00-$FFFF return their current values without acknowledging
+     * interrupts, and cartridge and expansion ports read as $FF.
+     *
+     * @param address First CPU address to read
+     * @param data Destination buffer
+     * @param length Number of bytes to read
+     */
+    virtual void readMemory(uint16_t address, uint8_t* data, size_t length) const = 0;
+
+    /**
+     * @brief Write memory as the CPU would
+     *
+     * Writes go through the MMU, so writes to ROM are ignored and writes
+     * to $FF00-$FFFF reach the I/O devices.
+     *
+     * @param address First CPU address to write
+     * @param data Bytes to write
+     * @param length Number of bytes to write
+     */
+    virtual void writeMemory(uint16_t address, const uint8_t* data, size_t length) = 0;
+
+    /**
+     * @brief Physical RAM
+     *
+     * MMU block n, masked to the installed memory size, starts at n * $2000.
+     * This is the memory MemorySearch works on. The contents change as
+     * frames run; the pointer stays valid until shutdown().
+     *
+     * @return Pointer and size in bytes, or {nullptr, 0} if not initialized
+     */
+    virtual std::pair<const uint8_t*, size_t> getRam() const = 0;
+
+    // ========================================================================
+    // Save States
+    // ========================================================================
+
+    /**
+     * @brief Capture the machine state
+     *
+     * Must be called between frames (not from inside runFrame()).
+     *
+     * @param state Receives RAM and the state of every device
+     * @return true if the emulator is initialized and the state was captured
+     */
+    virtual bool saveState(MachineState& state) const = 0;
+
+    /**
+     * @brief Restore a previously captured machine state
+     *
+     * Nothing is changed unless the state matches this emulator's CPU type,
+     * memory size and system ROM and every device blob is intact.
+     *
+     * @return true if the state was restored
+     */
+    virtual bool loadState(const MachineState& state) = 0;
+
+    /**
+     * @brief Restore the devices of a captured state, leaving RAM alone
+     *
+     * For callers that put RAM back themselves, a page at a time. The state
+     * must match as for loadState(), but a damaged blob is not rolled back.
+     *
+     * @return true if every device was restored
+     */
+    virtual bool loadDeviceState(const MachineState& state) = 0;
+
     // ========================================================================
     // Configuration & State
     // ========================================================================
@@ -309,6 +433,16 @@ public:
      */
     virtual MemorySize getMemorySize() const = 0;
 
+    /**
+     * @brief Set memory size (requires hardReset() to take effect)
+     */
+    virtual void setMemorySize(MemorySize size) = 0;
+
+    /**
+     * @brief The host memory policy that took effect for this instance
+     */
+    virtual MemoryPolicyReport getMemoryPolicyReport() const = 0;
+
     /**
      * @brief Check if emulator is initialized and ready
      */
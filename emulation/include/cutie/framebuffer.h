@@ -18,9 +18,10 @@ This file is part of CutieCoCo.
     along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include "cutie/hostmemory.h"
 #include <cstdint>
 #include <cstring>
-#include <vector>
+#include <new>
 
 namespace cutie {
 
@@ -105,24 +106,33 @@ public:
      * @brief Create a frame buffer with specified dimensions
      * @param width Width in pixels
      * @param height Height in pixels
+     * @param policy Host memory the pixels are placed in
      */
-    FrameBuffer(int width, int height)
+    FrameBuffer(int width, int height, const MemoryPolicy& policy = MemoryPolicy())
         : m_width(width)
         , m_height(height)
-        , m_buffer(static_cast<size_t>(width) * height, 0xFF000000)
     {
+        if (!m_buffer.allocate(static_cast<size_t>(width) * height * sizeof(uint32_t), policy)) {
+            throw std::bad_alloc();
+        }
+        clear();
     }
 
-    uint32_t* pixels() override { return m_buffer.data(); }
-    const uint32_t* pixels() const override { return m_buffer.data(); }
+    uint32_t* pixels() override { return reinterpret_cast<uint32_t*>(m_buffer.data()); }
+    const uint32_t* pixels() const override { return reinterpret_cast<const uint32_t*>(m_buffer.data()); }
     int width() const override { return m_width; }
     int height() const override { return m_height; }
     int pitch() const override { return m_width; }  // Packed, no padding
 
+    /**
+     * @brief The allocation behind the pixels, for the policy it was given
+     */
+    const HostBuffer& buffer() const { return m_buffer; }
+
 private:
     int m_width;
     int m_height;
-    std::vector<uint32_t> m_buffer;
+    HostBuffer m_buffer;
 };
 
 /**
@@ -0,0 +1,171 @@
+#ifndef CUTIE_FUZZ_H
+#define CUTIE_FUZZ_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "emulator.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cutie {
+
+/**
+ * @brief Runs guest code over and over on fuzzer supplied inputs
+ *
+ * begin() snapshots the machine with the program counter moved to the
+ * target's entry point. Each run() puts back the device state and only the
+ * 8 KB RAM pages written since the last run, writes the input into guest
+ * memory, and runs the CPU alone until it reaches an exit or crash address
+ * or uses up its cycle budget. The instruction at a stop address is not run.
+ *
+ * Edge coverage is gathered at instruction boundaries into a 64 KB map laid
+ * out like AFL's: each pair of consecutive instructions bumps one counter,
+ * chosen from hashes of their addresses. The map can be the harness's own
+ * or one the fuzzer provides, such as AFL's shared memory or libFuzzer's
+ * extra counters.
+ *
+ * Nothing but the CPU runs: no video, timers or interrupts are generated,
+ * so the code under test should not wait for them. Interrupts pending in
+ * the snapshot are taken at the start of every run.
+ *
+ * Only one harness can be active at a time. Call begin() again after
+ * resetting or loading a state into the emulator.
+ */
+class FuzzHarness {
+public:
+    static constexpr size_t MapSize = 65536;
+    static constexpr uint64_t DefaultMaxCycles = 1000000;
+
+    struct Target {
+        uint16_t entry = 0;             // Program counter at the start of each run
+        uint16_t inputAddress = 0;      // CPU address the input is written to
+        uint16_t inputCapacity = 0;     // Longer inputs are cut to this size
+        uint16_t lengthAddress = 0;     // Big endian input length goes here, 0 for none
+        std::vector<uint16_t> exits;    // A run that reaches one of these ends normally
+        std::vector<uint16_t> crashes;  // A run that reaches one of these has found a bug
+        uint64_t maxCycles = DefaultMaxCycles;  // Runs that go on longer are hangs
+    };
+
+    enum class Outcome { Exit, Crash, Hang };
+
+    struct Result {
+        Outcome outcome = Outcome::Hang;
+        uint16_t pc = 0;      // Where the run stopped
+        uint64_t cycles = 0;  // CPU cycles the run took
+    };
+
+    struct Stats {
+        uint64_t runs = 0;
+        uint64_t pagesRestored = 0;  // RAM pages put back before runs
+    };
+
+    explicit FuzzHarness(CocoEmulator& emulator);
+    ~FuzzHarness();
+
+    FuzzHarness(const FuzzHarness&) = delete;
+    FuzzHarness& operator=(const FuzzHarness&) = delete;
+
+    /**
+     * @brief Take the entry snapshot and start watching the CPU
+     *
+     * Must be called between frames on an initialized emulator.
+     *
+     * @return false if the emulator is not ready, the target has no exit
+     *         or another harness is active
+     */
+    bool begin(const Target& target);
+
+    /**
+     * @brief Stop watching the CPU; the machine is left as the last run left it
+     */
+    void end();
+
+    bool isActive() const { return m_active; }
+
+    /**
+     * @brief Run the target once on an input
+     *
+     * The coverage map is cleared first.
+     */
+    Result run(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Gather coverage into a map of MapSize bytes owned by the caller
+     * @param map The map, or nullptr to go back to the harness's own
+     */
+    void setCoverageMap(uint8_t* map);
+    const uint8_t* coverage() const { return m_map; }
+
+    /**
+     * @brief Number of nonzero counters in the coverage map
+     */
+    size_t edgeCount() const;
+
+    Stats stats() const { return m_stats; }
+
+    std::string getLastError() const { return m_lastError; }
+
+    /// Called by the CPU cores through FuzzStop()
+    void onStop(uint16_t pc);
+
+private:
+    void restore();
+
+    CocoEmulator& m_emulator;
+    Target m_target;
+    MachineState m_snapshot;
+    std::vector<unsigned long long> m_pageWrites;  // MemBankWrites() after the last restore
+    std::vector<uint8_t> m_ownMap;
+    uint8_t* m_map;
+    Result m_result;
+    bool m_stopped = false;
+    bool m_active = false;
+    Stats m_stats;
+    std::string m_lastError;
+};
+
+} // namespace cutie
+
+// Set while a harness is active. The CPU cores then call FuzzInstruction()
+// before every instruction and stop the slice, without running it, if it
+// returns true.
+extern bool FuzzArmed;
+extern unsigned char* FuzzCoverage;
+extern unsigned short FuzzPreviousLocation;
+extern unsigned char FuzzStops[0x2000];
+void FuzzStop(unsigned short pc);
+
+inline bool FuzzInstruction(unsigned short pc)
+{
+    // Odd multipliers spread neighbouring addresses across the map; the
+    // counter skips zero when it wraps so a hot edge never looks unvisited
+    const unsigned short location = static_cast<unsigned short>(pc * 0x9E37u);
+    unsigned char& counter = FuzzCoverage[location ^ FuzzPreviousLocation];
+    counter = static_cast<unsigned char>(counter + 1 + (counter == 0xFF));
+    FuzzPreviousLocation = location >> 1;
+
+    if ((FuzzStops[pc >> 3] >> (pc & 7)) & 1) {
+        FuzzStop(pc);
+        return true;
+    }
+    return false;
+}
+
+#endif // CUTIE_FUZZ_H
@@ -0,0 +1,185 @@
+#ifndef CUTIE_GAMEPAD_H
+#define CUTIE_GAMEPAD_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/joystick.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cutie {
+
+/**
+ * @brief Input event codes understood by the gamepad mapper
+ *
+ * These match the Linux evdev values (linux/input-event-codes.h) so that
+ * recorded event streams can be replayed on any platform.
+ */
+constexpr uint16_t GAMEPAD_EV_SYN = 0x00;
+constexpr uint16_t GAMEPAD_EV_KEY = 0x01;
+constexpr uint16_t GAMEPAD_EV_ABS = 0x03;
+
+constexpr uint16_t GAMEPAD_ABS_X = 0x00;
+constexpr uint16_t GAMEPAD_ABS_Y = 0x01;
+constexpr uint16_t GAMEPAD_ABS_HAT0X = 0x10;
+constexpr uint16_t GAMEPAD_ABS_HAT0Y = 0x11;
+
+constexpr uint16_t GAMEPAD_BTN_TRIGGER = 0x120;  // Joystick primary
+constexpr uint16_t GAMEPAD_BTN_THUMB = 0x121;    // Joystick secondary
+constexpr uint16_t GAMEPAD_BTN_SOUTH = 0x130;    // Gamepad A / Cross
+constexpr uint16_t GAMEPAD_BTN_EAST = 0x131;     // Gamepad B / Circle
+
+/**
+ * @brief A single input event, laid out like the evdev event payload
+ */
+struct GamepadEvent {
+    uint16_t type = 0;
+    uint16_t code = 0;
+    int32_t value = 0;
+};
+
+/**
+ * @brief Range of a raw analog axis as reported by the device
+ *
+ * Raw values inside the flat zone around the midpoint read as centered;
+ * the rest of the travel is spread linearly over the CoCo's 0-63 range.
+ */
+struct AxisCalibration {
+    int32_t minimum = -32768;
+    int32_t maximum = 32767;
+    int32_t flat = 0;
+};
+
+/**
+ * @brief Map a raw axis value to the CoCo joystick range
+ * @param raw Raw device value
+ * @param calibration Device range and dead zone for the axis
+ * @return Axis value (0-63, 32=center)
+ */
+int mapAxisValue(int32_t raw, const AxisCalibration& calibration);
+
+/**
+ * @brief Translates one device's events into CoCo joystick state
+ *
+ * The left analog stick (or D-pad) drives the axes. The first face or
+ * trigger button is button 1 and the second is button 2.
+ */
+class GamepadMapper {
+public:
+    /**
+     * @param joystick CoCo joystick driven by this device (0=left, 1=right)
+     * @param x Calibration of the horizontal axis
+     * @param y Calibration of the vertical axis
+     */
+    GamepadMapper(int joystick, const AxisCalibration& x = {}, const AxisCalibration& y = {});
+
+    /**
+     * @brief Apply one event to the joystick state
+     */
+    void apply(const GamepadEvent& event, Joystick& target) const;
+
+    int joystick() const { return m_joystick; }
+
+private:
+    int m_joystick;
+    std::array<AxisCalibration, AXIS_COUNT> m_calibration;
+};
+
+/**
+ * @brief Native gamepad input on a dedicated thread
+ *
+ * On Linux, evdev devices that report an X axis and a gamepad or joystick
+ * button are read with epoll on a background thread and mapped straight
+ * into the Joystick. The first device drives the right CoCo joystick and
+ * the second the left one. The emulation thread never waits on this
+ * thread; it only sees the values the Joystick publishes.
+ *
+ * On other platforms no devices can be opened and start() returns false.
+ */
+class GamepadInput {
+public:
+    explicit GamepadInput(Joystick& target);
+    ~GamepadInput();
+
+    GamepadInput(const GamepadInput&) = delete;
+    GamepadInput& operator=(const GamepadInput&) = delete;
+
+    /**
+     * @brief Open the gamepads attached to the system
+     * @return Number of devices opened
+     */
+    size_t openAttachedDevices();
+
+    /**
+     * @brief Start the input thread
+     *
+     * Devices may be added before or after the thread starts.
+     *
+     * @return true if the input thread is running
+     */
+    bool start();
+
+    /**
+     * @brief Stop the input thread and close all devices
+     */
+    void stop();
+
+    /**
+     * @brief Read events from an already open descriptor
+     *
+     * The descriptor must deliver raw evdev event records, either from an
+     * event device or a replayed recording (e.g. a pipe). Ownership of the
+     * descriptor passes to this object.
+     *
+     * @return true if the descriptor was added
+     */
+    bool addDevice(int fd, const GamepadMapper& mapper);
+
+    /**
+     * @brief Number of devices currently being read
+     */
+    size_t deviceCount() const;
+
+    /**
+     * @brief Number of events applied since start, for diagnostics
+     */
+    uint64_t eventCount() const { return m_eventCount.load(std::memory_order_acquire); }
+
+private:
+    struct Device;
+
+    void run();
+
+    Joystick& m_target;
+    int m_epollFd = -1;
+    int m_wakeFd = -1;
+    std::thread m_thread;
+    std::atomic<uint64_t> m_eventCount{0};
+
+    mutable std::mutex m_devicesMutex;  // Guards m_devices, never taken by the event loop
+    std::vector<std::unique_ptr<Device>> m_devices;
+};
+
+} // namespace cutie
+
+#endif // CUTIE_GAMEPAD_H
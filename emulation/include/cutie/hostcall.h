@@ -0,0 +1,128 @@
+#ifndef CUTIE_HOSTCALL_H
+#define CUTIE_HOSTCALL_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdint>
+#include <filesystem>
+
+namespace cutie {
+
+/**
+ * @brief Paravirtual device that lets guest code call host services
+ *
+ * The device has no hardware counterpart and is off unless
+ * EmulatorConfig::hostCalls is set; its ports then stop going to the
+ * cartridge. Guest code stores the CPU address of a parameter block in
+ * $FF8A-$FF8B and writes a command to $FF88. The command runs to completion
+ * before the write returns, in no emulated time, and its status is read
+ * back from $FF88. $FF89 reads as 'H' so that code can check the device is
+ * there. shared/guest/hostcall.asm has the 6809 side.
+ *
+ * The parameter block is big endian. Addresses in it are physical RAM
+ * offsets, 0 up to the installed size, and a range that does not fit is
+ * refused rather than wrapped.
+ *
+ *   +0  address  (4)   Clock: seconds since 1970, UTC (out)
+ *   +4  length   (4)   Clock: year (2), month, day, hour, minute, second,
+ *                      local time (out)
+ *   +8  Copy: source address (4)
+ *       Fill: value (1)
+ *       Crc16: CRC-16/CCITT so far (2, in and out), $FFFF to start
+ *       Crc32: CRC-32 so far (4, in and out), 0 to start
+ *       ReadFile, WriteFile: offset in the file (4)
+ *   +12 ReadFile, WriteFile, FileSize: CPU address of the file name (2)
+ *
+ * ReadFile and WriteFile leave the bytes transferred in length, and
+ * FileSize leaves the file's size there. Files live in one host directory
+ * and are named by a plain name of letters, digits, '.', '-' and '_' that
+ * does not start with '.'; anything else is refused.
+ */
+class HostCallDevice {
+public:
+    enum Command : uint8_t {
+        Copy = 0x01,       // Copy length bytes from source to address
+        Fill = 0x02,       // Set length bytes at address to value
+        Crc16 = 0x03,
+        Crc32 = 0x04,
+        ReadFile = 0x05,   // Read up to length bytes of a file to address
+        WriteFile = 0x06,  // Write length bytes at address to a file, creating it
+        FileSize = 0x07,
+        Clock = 0x08
+    };
+
+    enum Status : uint8_t {
+        Ok = 0x00,
+        BadCommand = 0x01,
+        BadAddress = 0x02,  // A range past the end of RAM
+        NoDirectory = 0x03, // File commands without a directory to use
+        BadName = 0x04,
+        FileError = 0x05    // Missing file, or the host refused
+    };
+
+    // Ports, as offsets from $FF00
+    static constexpr uint8_t CommandPort = 0x88;  // Write a command, read its status
+    static constexpr uint8_t IdPort = 0x89;
+    static constexpr uint8_t BlockPort = 0x8A;    // Parameter block address, high then low
+    static constexpr uint8_t LastPort = 0x8B;
+    static constexpr uint8_t Id = 'H';
+
+    static constexpr unsigned MaxNameLength = 64;
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * @brief Directory the file commands work in; empty refuses them
+     */
+    void setDirectory(const std::filesystem::path& directory) { m_directory = directory; }
+    const std::filesystem::path& directory() const { return m_directory; }
+
+    uint8_t read(uint8_t port) const;
+    void write(uint8_t port, uint8_t data);
+
+    /**
+     * @brief Commands run since the device was enabled
+     */
+    uint64_t calls() const { return m_calls; }
+
+private:
+    uint8_t run(uint8_t command);
+    uint8_t runFile(uint8_t command, uint32_t address, uint32_t& length, uint32_t offset, uint16_t name);
+
+    bool m_enabled = false;
+    std::filesystem::path m_directory;
+    uint16_t m_block = 0;
+    uint8_t m_status = Ok;
+    uint64_t m_calls = 0;
+};
+
+/**
+ * @brief Global host call device, reached through the I/O bus
+ */
+HostCallDevice& getHostCallDevice();
+
+} // namespace cutie
+
+// Set while the device is enabled; the I/O bus then sends $FF88-$FF8B to
+// the calls below instead of the cartridge
+extern bool HostCallsEnabled;
+unsigned char HostCallRead(unsigned char port);
+void HostCallWrite(unsigned char port, unsigned char data);
+
+#endif // CUTIE_HOSTCALL_H
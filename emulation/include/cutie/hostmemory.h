@@ -0,0 +1,124 @@
+#ifndef CUTIE_HOSTMEMORY_H
+#define CUTIE_HOSTMEMORY_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cutie {
+
+/**
+ * @brief How host memory for guest RAM and frame buffers is backed
+ */
+enum class HugePages {
+    Off,          // Ordinary pages
+    Transparent,  // madvise(MADV_HUGEPAGE); the kernel promotes pages as it can
+    Explicit,     // MAP_HUGETLB from the pool in /proc/sys/vm/nr_hugepages
+};
+
+/**
+ * @brief What an emulator instance asks of host memory
+ */
+struct MemoryPolicy {
+    HugePages hugePages = HugePages::Off;
+    int numaNode = -1;  // Node to bind memory and the emulation thread to, -1 for none
+};
+
+const char* hugePagesName(HugePages hugePages);
+
+/**
+ * @brief Page aligned buffer allocated under a MemoryPolicy
+ *
+ * Requests that the host cannot honour are stepped down rather than
+ * failed: explicit huge pages fall back to transparent ones when the pool
+ * is empty, transparent ones to ordinary pages when the kernel has them
+ * disabled, and a NUMA binding is dropped if the node does not exist or
+ * the kernel refuses it. hugePages() and numaNode() tell what was granted.
+ *
+ * On hosts without mmap this is a plain heap allocation and the policy is
+ * ignored. The contents start out zeroed.
+ */
+class HostBuffer {
+public:
+    HostBuffer() = default;
+    ~HostBuffer();
+
+    HostBuffer(HostBuffer&& other) noexcept;
+    HostBuffer& operator=(HostBuffer&& other) noexcept;
+    HostBuffer(const HostBuffer&) = delete;
+    HostBuffer& operator=(const HostBuffer&) = delete;
+
+    /**
+     * @brief Replace the buffer with a new one of size bytes
+     * @return false if no memory could be had at all
+     */
+    bool allocate(size_t size, const MemoryPolicy& policy);
+    void release();
+
+    uint8_t* data() { return m_data; }
+    const uint8_t* data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+    HugePages hugePages() const { return m_hugePages; }
+    int numaNode() const { return m_numaNode; }
+
+    /**
+     * @brief Bytes of the buffer currently backed by huge pages
+     *
+     * Read from /proc/self/smaps, so it reflects what the kernel actually
+     * did; 0 where that is not available.
+     */
+    size_t hugePageBytes() const;
+
+private:
+    uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    void* m_mapping = nullptr;  // Start and length of what was mapped
+    size_t m_mappedSize = 0;
+    HugePages m_hugePages = HugePages::Off;
+    int m_numaNode = -1;
+};
+
+/**
+ * @brief Restrict the calling thread to the CPUs of a NUMA node
+ * @return true if the thread is now bound to the node
+ */
+bool bindThreadToNumaNode(int node);
+
+/**
+ * @brief The memory policy an emulator instance ended up with
+ */
+struct MemoryPolicyReport {
+    MemoryPolicy requested;
+    HugePages ramHugePages = HugePages::Off;
+    HugePages framebufferHugePages = HugePages::Off;
+    int ramNode = -1;
+    int framebufferNode = -1;
+    int threadNode = -1;  // Node the emulation thread is bound to, -1 for none
+
+    /**
+     * @brief One line summary, e.g. for a runner's log
+     */
+    std::string describe() const;
+};
+
+} // namespace cutie
+
+#endif // CUTIE_HOSTMEMORY_H
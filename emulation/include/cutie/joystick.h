@@ -20,7 +20,7 @@ This file is part of CutieCoCo.
 
 #include <cstdint>
 #include <array>
-#include <mutex>
+#include <atomic>
 
 namespace cutie {
 
@@ -68,7 +68,9 @@ constexpr int BUTTON_COUNT = 2;
  * - Bit 2: Right joystick button 2 (shared with keyboard row 3)
  * - Bit 3: Left joystick button 2 (shared with keyboard row 4)
  *
- * Thread-safe for use between Qt UI thread and emulation.
+ * State is held in relaxed atomics so input threads (Qt UI, gamepads) can
+ * publish values while the emulation thread samples them on every $FF00
+ * read without taking a lock.
  */
 class Joystick {
 public:
@@ -149,15 +151,13 @@ public:
 
 private:
     // Axis values for each joystick [joystick][axis]
-    std::array<std::array<int, AXIS_COUNT>, JOYSTICK_COUNT> m_axes;
+    std::array<std::array<std::atomic<uint8_t>, AXIS_COUNT>, JOYSTICK_COUNT> m_axes;
 
     // Button states for each joystick [joystick][button]
-    std::array<std::array<bool, BUTTON_COUNT>, JOYSTICK_COUNT> m_buttons;
+    std::array<std::array<std::atomic<bool>, BUTTON_COUNT>, JOYSTICK_COUNT> m_buttons;
 
     // Current DAC ramp value (6-bit, 0-63)
-    uint8_t m_dacValue = 0;
-
-    mutable std::mutex m_mutex;
+    std::atomic<uint8_t> m_dacValue{0};
 };
 
 /**
@@ -108,6 +108,24 @@ public:
      */
     bool isPressed(CocoKey key) const;
 
+    /**
+     * @brief Follow the row returns for the GIME keyboard interrupt
+     *
+     * The GIME interrupts when any of PA0-PA6 goes low, which happens when
+     * a strobed column has a key down (or a joystick button is pressed).
+     * Called from the emulation thread only.
+     *
+     * @param rows Row returns as the PIA sees them (0 = low)
+     * @return true if a row return went low since the last call
+     */
+    bool updateRowLines(uint8_t rows);
+
+    /**
+     * @brief Row returns from the last updateRowLines() call, for save states
+     */
+    uint8_t rowLines() const { return m_rowLines; }
+    void setRowLines(uint8_t rows) { m_rowLines = rows; }
+
 private:
     // Matrix state: 7 rows x 8 columns
     // Each byte represents a row, with bits indicating pressed columns
@@ -115,6 +133,10 @@ private:
 
     mutable std::mutex m_mutex;
 
+    // Row returns last seen by the interrupt edge detector, all low while
+    // the interrupt is off so that enabling it with a key held is quiet
+    uint8_t m_rowLines = 0;
+
     // Get row and column for a key
     static void getRowCol(CocoKey key, uint8_t& row, uint8_t& col);
 };
@@ -129,9 +151,10 @@ Keyboard& getKeyboard();
 
 } // namespace cutie
 
-// C-compatible function for legacy code (mc6821.cpp)
+// C-compatible functions for legacy code (mc6821.cpp)
 extern "C" {
     unsigned char vccKeyboardGetScan(unsigned char colMask);
+    void vccKeyboardUpdateInterrupt(unsigned char colMask, unsigned char joyButtons);
 }
 
 #endif // CUTIE_KEYBOARD_H
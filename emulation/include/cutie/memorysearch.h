@@ -0,0 +1,120 @@
+#ifndef CUTIE_MEMORYSEARCH_H
+#define CUTIE_MEMORYSEARCH_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace cutie {
+
+/**
+ * @brief Size of the values a search looks at
+ */
+enum class SearchWidth {
+    Byte,
+    Word  // Big endian, like the 6809, at every byte offset
+};
+
+/**
+ * @brief Unsigned comparison of a value against the reference
+ */
+enum class SearchCompare {
+    Equal,
+    NotEqual,
+    Less,
+    LessOrEqual,
+    Greater,
+    GreaterOrEqual
+};
+
+/**
+ * @brief Narrows down the RAM addresses that hold a value of interest
+ *
+ * start() makes every address a candidate. Each filter pass compares the
+ * value at every remaining candidate, either with a constant or with the
+ * value it had at the previous pass, and drops those that fail. Candidates
+ * are kept as a bitmap with one bit per address, and the comparison runs
+ * on 16 addresses at a time with SSE2 where available, skipping 64-address
+ * groups with no candidates left.
+ *
+ * The memory passed to each call must be the same size as the memory
+ * passed to start(); normally it is CocoEmulator::getRam().
+ */
+class MemorySearch {
+public:
+    /**
+     * @brief Make every address a candidate and remember its value
+     */
+    void start(const uint8_t* memory, size_t size, SearchWidth width = SearchWidth::Byte);
+
+    /**
+     * @brief Keep the candidates whose value compares true with a constant
+     * @return Candidates left
+     */
+    size_t filter(const uint8_t* memory, SearchCompare compare, uint16_t value);
+
+    /**
+     * @brief Keep the candidates whose value compares true with the value
+     *        at the previous pass plus delta
+     *
+     * The sum wraps at the value width, so Equal with a delta of -1 keeps
+     * values that went down by exactly one.
+     *
+     * @return Candidates left
+     */
+    size_t filterRelative(const uint8_t* memory, SearchCompare compare, int delta = 0);
+
+    /**
+     * @brief Number of candidates left
+     */
+    size_t count() const { return m_count; }
+
+    SearchWidth width() const { return m_width; }
+
+    /**
+     * @brief Size of the memory being searched, or 0 before start()
+     */
+    size_t memorySize() const { return m_size; }
+
+    /**
+     * @brief Candidate addresses in ascending order
+     */
+    std::vector<uint32_t> candidates(size_t limit = std::numeric_limits<size_t>::max()) const;
+
+    /**
+     * @brief Value a candidate had at the last pass
+     */
+    uint16_t previousValue(uint32_t address) const;
+
+private:
+    size_t pass(const uint8_t* memory, SearchCompare compare, uint16_t reference, bool relative);
+
+    SearchWidth m_width = SearchWidth::Byte;
+    size_t m_size = 0;      // Bytes of memory
+    size_t m_values = 0;    // Addresses that hold a whole value
+    size_t m_count = 0;
+    std::vector<uint64_t> m_candidates;  // One bit per address
+    std::vector<uint8_t> m_previous;     // Valid in groups that hold candidates
+};
+
+} // namespace cutie
+
+#endif // CUTIE_MEMORYSEARCH_H
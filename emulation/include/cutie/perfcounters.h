@@ -0,0 +1,160 @@
+#ifndef CUTIE_PERFCOUNTERS_H
+#define CUTIE_PERFCOUNTERS_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace cutie {
+
+/**
+ * @brief Parts of a frame that host counters are charged to
+ */
+enum class PerfPhase {
+    Cpu,       // CPUCycle and the rest of the scanline loop
+    Render,    // Scanline and border rendering
+    Audio,     // Converting the frame's audio samples
+    Frontend,  // Frontend work such as texture and audio upload, which
+               // follows endFrame() and lands in the next frame
+    Other,     // Everything outside the phases above
+    Count
+};
+
+/**
+ * @brief Host events counted per phase
+ */
+enum class PerfEvent {
+    Instructions,
+    Cycles,
+    BranchMisses,
+    L1DataMisses,
+    LastLevelMisses,
+    Nanoseconds,  // Wall clock time, always available
+    Count
+};
+
+constexpr size_t PerfPhaseCount = static_cast<size_t>(PerfPhase::Count);
+constexpr size_t PerfEventCount = static_cast<size_t>(PerfEvent::Count);
+
+/**
+ * @brief Counts for one frame, by phase and event
+ */
+struct PerfFrame {
+    std::array<std::array<uint64_t, PerfEventCount>, PerfPhaseCount> counts{};
+
+    uint64_t get(PerfPhase phase, PerfEvent event) const {
+        return counts[static_cast<size_t>(phase)][static_cast<size_t>(event)];
+    }
+};
+
+/**
+ * @brief Host performance counters attributed to emulation phases
+ *
+ * On Linux the hardware events come from perf_event_open as one group,
+ * counting user space only for the calling thread, which must be the
+ * emulation thread. Events the host does not offer (no PMU in a VM,
+ * perf_event_paranoid too high, no LLC event) are left out and read as
+ * zero; check hasEvent(). Elapsed time comes from the steady clock and is
+ * counted everywhere.
+ *
+ * switchTo() reads every counter and charges the difference to the phase
+ * being left. With hardware events that costs a read() system call, and
+ * the scanline loop switches twice per rendered line, so expect the frame
+ * rate to drop while they are enabled.
+ */
+class PerfCounters {
+public:
+    PerfCounters() = default;
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * @brief Start counting
+     *
+     * Elapsed time is always counted. If no hardware event could be opened
+     * getLastError() says why.
+     *
+     * @return true if hardware events are being counted as well
+     */
+    bool enable();
+
+    /**
+     * @brief Close the counters
+     */
+    void disable();
+
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * @brief Whether an event is being counted
+     */
+    bool hasEvent(PerfEvent event) const { return (m_eventMask >> static_cast<int>(event)) & 1; }
+
+    /**
+     * @brief Charge the counts since the last switch to the current phase
+     *        and make another phase current
+     */
+    void switchTo(PerfPhase phase);
+
+    /**
+     * @brief End a frame
+     *
+     * Charges the current phase and makes the counts since the previous
+     * call available through lastFrame().
+     */
+    void endFrame();
+
+    /**
+     * @brief Counts for the frame most recently ended
+     */
+    const PerfFrame& lastFrame() const { return m_lastFrame; }
+
+    std::string getLastError() const { return m_lastError; }
+
+private:
+    void read(std::array<uint64_t, PerfEventCount>& values) const;
+
+    int m_hardwareFd = -1;  // Group leader for the hardware events
+    std::array<int, PerfEventCount> m_fds{};
+    std::array<PerfEvent, PerfEventCount> m_hardwareOrder{};  // Order of the group's values
+    size_t m_hardwareCount = 0;
+    unsigned m_eventMask = 0;
+    std::array<uint64_t, PerfEventCount> m_last{};
+    PerfPhase m_phase = PerfPhase::Other;
+    PerfFrame m_frame;
+    PerfFrame m_lastFrame;
+    bool m_enabled = false;
+    std::string m_lastError;
+};
+
+/**
+ * @brief Global performance counters for the emulation thread
+ */
+PerfCounters& getPerfCounters();
+
+} // namespace cutie
+
+// Called by the scanline loop around rendering
+void SwitchPerfPhase(cutie::PerfPhase phase);
+
+#endif // CUTIE_PERFCOUNTERS_H
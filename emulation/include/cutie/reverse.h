@@ -0,0 +1,212 @@
+#ifndef CUTIE_REVERSE_H
+#define CUTIE_REVERSE_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "emulator.h"
+#include "types.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cutie {
+
+/**
+ * @brief The machine as the debugger sees it before an instruction runs
+ */
+struct ExecutionPoint {
+    uint64_t instruction = 0;     // Instructions retired since recording started
+    uint64_t frame = 0;           // Frame the instruction runs in
+    CPUState registers;
+    std::vector<uint8_t> memory;  // CPU address space, $0000-$FFFF
+};
+
+/**
+ * @brief Step-back and reverse-continue over a recorded run
+ *
+ * While recording, every frame goes through runFrame(). A checkpoint of
+ * the machine (a MachineState, see CocoEmulator::saveState()) is taken
+ * every checkpointInterval frames, and the keyboard and joystick state is
+ * logged at each frame boundary where it changed, so input from any
+ * frontend is captured. Only the newest maxCheckpoints checkpoints are
+ * kept; history before the oldest one is dropped.
+ *
+ * Going back restores the nearest checkpoint and replays the logged frames
+ * at full speed, watching instruction boundaries only in the frame that
+ * holds the target, so a step back costs at most checkpointInterval frames
+ * of emulation. Afterwards the emulator is left at the start of that frame
+ * and the ExecutionPoint describes the machine at the target instruction.
+ * Replay is deterministic, so the next runFrame() passes through exactly
+ * that point.
+ *
+ * Running forward from the past replays the recorded input. Changing the
+ * input first discards the recorded future and records from there on.
+ * Reset, loadState() and cartridge changes are not recorded; stop and
+ * start again around them.
+ *
+ * Use from the emulation thread, between frames.
+ */
+class ReverseDebugger {
+public:
+    static constexpr int DefaultCheckpointInterval = 60;
+    static constexpr size_t DefaultMaxCheckpoints = 32;
+
+    explicit ReverseDebugger(CocoEmulator& emulator,
+        int checkpointInterval = DefaultCheckpointInterval,
+        size_t maxCheckpoints = DefaultMaxCheckpoints);
+    ~ReverseDebugger();
+
+    ReverseDebugger(const ReverseDebugger&) = delete;
+    ReverseDebugger& operator=(const ReverseDebugger&) = delete;
+
+    /**
+     * @brief Start recording at the current frame boundary
+     *
+     * Discards any earlier recording and restarts the frame and
+     * instruction counts.
+     *
+     * @return true if the first checkpoint was taken
+     */
+    bool start();
+
+    /**
+     * @brief Stop recording and release the checkpoints
+     */
+    void stop();
+
+    bool isRecording() const { return m_recording; }
+
+    /**
+     * @brief Run one frame, recording it or replaying it
+     */
+    void runFrame();
+
+    /**
+     * @brief Frame the emulator will run next
+     */
+    uint64_t frame() const { return m_frame; }
+
+    /**
+     * @brief Frames recorded so far
+     */
+    uint64_t recordedFrames() const { return m_head; }
+
+    /**
+     * @brief Instructions retired up to the current position
+     */
+    uint64_t instruction() const { return m_cursor; }
+
+    /**
+     * @brief Oldest instruction still reachable
+     */
+    uint64_t firstInstruction() const { return m_frameStarts.empty() ? 0 : m_frameStarts.front(); }
+
+    size_t checkpointCount() const { return m_checkpoints.size(); }
+
+    /**
+     * @brief Go back one instruction
+     * @return false at the start of the recorded history
+     */
+    bool stepBack(ExecutionPoint& point);
+
+    /**
+     * @brief Go back to the last instruction before the current position
+     *        whose address is one of the breakpoints
+     *
+     * If no breakpoint was hit in the recorded history the position moves
+     * to the start of the history and false is returned.
+     */
+    bool reverseContinue(const std::vector<uint16_t>& breakpoints, ExecutionPoint& point);
+
+    /**
+     * @brief Go to any recorded instruction
+     * @param instruction Position from firstInstruction() up to, but not
+     *        including, the end of the last recorded frame
+     */
+    bool seek(uint64_t instruction, ExecutionPoint& point);
+
+    std::string getLastError() const { return m_lastError; }
+
+    /// Called by the CPU cores through ReplayInstruction()
+    void onInstruction(uint16_t pc);
+
+private:
+    // Keyboard matrix and joysticks, sampled between frames
+    struct InputState {
+        uint64_t keys = 0;
+        std::array<uint8_t, 4> axes{};
+        uint8_t buttons = 0;
+
+        static InputState capture();
+        void apply() const;
+        bool operator==(const InputState& other) const {
+            return keys == other.keys && axes == other.axes && buttons == other.buttons;
+        }
+        bool operator!=(const InputState& other) const { return !(*this == other); }
+    };
+
+    struct Checkpoint {
+        uint64_t frame;
+        MachineState state;
+    };
+
+    uint64_t frameStart(uint64_t frame) const { return m_frameStarts[frame - m_firstFrame]; }
+    const InputState& recordedInput(uint64_t frame) const;
+    void takeCheckpoint();
+    void discardFuture();
+    bool restoreCheckpoint(size_t index);
+    void replayFrame();
+    void watch(bool enabled);
+
+    CocoEmulator& m_emulator;
+    int m_checkpointInterval;
+    size_t m_maxCheckpoints;
+    std::string m_lastError;
+    bool m_recording = false;
+
+    std::deque<Checkpoint> m_checkpoints;
+    std::vector<uint64_t> m_frameStarts;  // Instructions retired before each frame, up to the head
+    std::vector<std::pair<uint64_t, InputState>> m_inputLog;  // Input from that frame on
+    InputState m_lastInput;  // Input the machine ran the last frame with
+    uint64_t m_firstFrame = 0;
+    uint64_t m_frame = 0;
+    uint64_t m_head = 0;
+    uint64_t m_cursor = 0;
+
+    // Watching instruction boundaries during a replay
+    uint64_t m_target = 0;
+    ExecutionPoint* m_point = nullptr;
+    std::vector<uint16_t> m_breakpoints;  // Sorted
+    uint64_t m_searchEnd = 0;
+    uint64_t m_lastHit = 0;
+    bool m_hit = false;
+};
+
+} // namespace cutie
+
+// Maintained by the CPU cores: instructions retired, and whether to call
+// ReplayInstruction() before each one
+extern uint64_t InstructionsRetired;
+extern bool ReplayWatching;
+void ReplayInstruction(unsigned short pc);
+
+#endif // CUTIE_REVERSE_H
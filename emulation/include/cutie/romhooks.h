@@ -0,0 +1,118 @@
+#ifndef CUTIE_ROMHOOKS_H
+#define CUTIE_ROMHOOKS_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cutie {
+
+/**
+ * @brief Native stand-ins for hot Color BASIC routines
+ *
+ * When enabled, and the loaded system ROM is the stock CoCo 3 image (by
+ * GetSystemRomHash()), an instruction fetch at a hooked entry point runs
+ * the routine in C++ instead: registers, flags, memory and the cycle
+ * count end up as the ROM code would leave them, and the CPU carries on
+ * at the caller.
+ *
+ * BASIC normally runs from the copy the CoCo 3 makes of its ROM in RAM,
+ * so before a hook runs the bytes it stands in for are compared with the
+ * ROM image. The result is kept until a write lands in the bank holding
+ * them. A routine that has been patched, or that is not mapped at all,
+ * runs on the CPU as usual, and so does everything while a 6309 is in
+ * native mode, where the cycle counts differ.
+ *
+ * Hooked routines run as one step, and loops a slice of a few hundred
+ * cycles at a time: interrupts are taken between them, and breakpoints
+ * inside them are not hit.
+ */
+class RomHooks {
+public:
+    struct Routine {
+        const char* name;
+        uint16_t entry;
+        uint16_t end;   // One past the last byte of ROM code it stands in for
+    };
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * @brief True when enabled and the loaded ROM is the one the hooks know
+     */
+    bool isActive() const;
+
+    /**
+     * @brief Runs the routine at pc if there is a hook for it
+     * @return Cycles the routine took, or 0 if the CPU should run it
+     */
+    int run(uint16_t pc);
+
+    /**
+     * @brief Routines run natively since the hooks were enabled
+     */
+    uint64_t calls() const { return m_calls; }
+
+    static const Routine& routine(size_t index);
+    static size_t routineCount();
+    static constexpr size_t MaxRoutines = 16;
+
+    // FNV-1a hash of the CoCo 3 ROM the entry points belong to
+    static constexpr unsigned long long StockRomHash = 0x789374CF0F1B2DBCull;
+
+private:
+    bool verify(size_t index);
+
+    // Code check results, valid while the bank writes and epoch are unchanged
+    struct Check {
+        unsigned long location = 0;
+        unsigned long long firstWrites = 0;
+        unsigned long long lastWrites = 0;
+        unsigned int epoch = 0;
+        bool valid = false;
+        bool matches = false;
+    };
+
+    bool m_enabled = false;
+    uint64_t m_calls = 0;
+    Check m_checks[MaxRoutines];
+};
+
+/**
+ * @brief Global hooks, called by the CPU cores
+ */
+RomHooks& getRomHooks();
+
+} // namespace cutie
+
+// Set while the hooks are enabled; the CPU cores then call RomHook() before
+// an instruction at an entry point marked in RomHookEntries. It returns the
+// cycles used if it ran the routine at pc, in which case the instruction is
+// not executed, and 0 otherwise.
+extern bool RomHooksArmed;
+extern unsigned char RomHookEntries[0x2000];
+int RomHook(unsigned short pc);
+
+inline bool RomHookEntry(unsigned short pc)
+{
+    return (RomHookEntries[pc >> 3] >> (pc & 7)) & 1;
+}
+
+#endif // CUTIE_ROMHOOKS_H
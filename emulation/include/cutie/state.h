@@ -0,0 +1,110 @@
+#ifndef CUTIE_STATE_H
+#define CUTIE_STATE_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace cutie {
+
+/**
+ * @brief Appends a device's variables to a state blob
+ *
+ * Devices describe their state once, in a template that applies an archive
+ * to each variable, and use it with both StateWriter and StateReader:
+ *
+ * @code
+ * template <class StateArchive>
+ * static void TransferState(StateArchive& state)
+ * {
+ *     state(pc)(x)(y)(cc);
+ * }
+ * @endcode
+ *
+ * Values are stored in host byte order; blobs are for snapshots taken and
+ * restored by the same build, not an interchange format.
+ */
+class StateWriter {
+public:
+    explicit StateWriter(std::vector<uint8_t>& blob) : m_blob(blob) {}
+
+    template <typename T>
+    StateWriter& operator()(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "State variables must be plain data");
+        bytes(&value, sizeof(T));
+        return *this;
+    }
+
+    void bytes(const void* data, size_t size) {
+        const auto* first = static_cast<const uint8_t*>(data);
+        m_blob.insert(m_blob.end(), first, first + size);
+    }
+
+private:
+    std::vector<uint8_t>& m_blob;
+};
+
+/**
+ * @brief Reads a device's variables back from a state blob
+ *
+ * Reads past the end of the blob leave the variable untouched and mark the
+ * reader as failed.
+ */
+class StateReader {
+public:
+    explicit StateReader(const std::vector<uint8_t>& blob)
+        : m_data(blob.data())
+        , m_size(blob.size())
+    {
+    }
+
+    template <typename T>
+    StateReader& operator()(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "State variables must be plain data");
+        bytes(&value, sizeof(T));
+        return *this;
+    }
+
+    void bytes(void* data, size_t size) {
+        if (!m_good || size > m_size - m_offset) {
+            m_good = false;
+            return;
+        }
+        std::memcpy(data, m_data + m_offset, size);
+        m_offset += size;
+    }
+
+    /**
+     * @brief true if every read succeeded and the whole blob was consumed
+     */
+    bool complete() const { return m_good && m_offset == m_size; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_offset = 0;
+    bool m_good = true;
+};
+
+} // namespace cutie
+
+#endif // CUTIE_STATE_H
@@ -0,0 +1,102 @@
+#ifndef CUTIE_STATESTORE_H
+#define CUTIE_STATESTORE_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/emulator.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace cutie {
+
+/**
+ * @brief Content-addressed directory of save states
+ *
+ * RAM is cut into 8 KB pages and every page and device blob is stored once,
+ * named by its SHA-256, under objects/. A state is a short text manifest of
+ * those hashes under states/, named by the hash of the manifest itself, so
+ * saving the same machine twice yields the same id and a new checkpoint
+ * only costs the pages that changed.
+ *
+ * Files are written to a temporary name and renamed into place, so several
+ * processes may share a store. Objects are never deleted.
+ */
+class StateStore {
+public:
+    static constexpr size_t PageSize = 8192;
+
+    /**
+     * @brief Counters since the store was opened
+     */
+    struct Stats {
+        size_t objectsWritten = 0;  // Objects that were new to the store
+        size_t objectsReused = 0;   // Objects that were already present
+        size_t bytesWritten = 0;    // Object and manifest bytes written
+    };
+
+    explicit StateStore(std::filesystem::path root);
+
+    StateStore(const StateStore&) = delete;
+    StateStore& operator=(const StateStore&) = delete;
+
+    /**
+     * @brief Write a state to the store
+     * @return Id of the state (64 hex digits), or empty on failure
+     */
+    std::string save(const MachineState& state);
+
+    /**
+     * @brief Read a state back from the store
+     *
+     * Every object is checked against its hash as it is read.
+     *
+     * @return true if the state was found and intact
+     */
+    bool load(const std::string& id, MachineState& state);
+
+    /**
+     * @brief Check whether a state id is in the store
+     */
+    bool contains(const std::string& id) const;
+
+    const std::filesystem::path& root() const { return m_root; }
+
+    Stats stats() const;
+
+    std::string getLastError() const { return m_lastError; }
+
+private:
+    std::filesystem::path objectPath(const std::string& hash) const;
+    std::filesystem::path statePath(const std::string& id) const;
+    bool writeObject(const std::string& hash, const uint8_t* data, size_t size);
+    bool writeFile(const std::filesystem::path& path, const void* data, size_t size);
+
+    std::filesystem::path m_root;
+    std::string m_lastError;
+    std::string m_tempTag;
+    std::atomic<size_t> m_objectsWritten{0};
+    std::atomic<size_t> m_objectsReused{0};
+    std::atomic<size_t> m_bytesWritten{0};
+    std::atomic<unsigned> m_tempCounter{0};
+};
+
+} // namespace cutie
+
+#endif // CUTIE_STATESTORE_H
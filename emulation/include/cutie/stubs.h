@@ -24,14 +24,13 @@ See EmulationContext for injecting platform-specific implementations.
 
 // ============================================================================
 // Cassette stubs (was in Cassette.h)
-// Note: GetCasSample, SetCassetteSample defined in mc6821.cpp
+// Note: GetCasSample, SetCassetteSample defined in mc6821.cpp, Motor in cassette.cpp
 // ============================================================================
 
 inline uint8_t GetMotorState() { return 0; }
 inline void FlushCassetteBuffer(unsigned char*, unsigned int*) {}
 inline void LoadCassetteBuffer(unsigned char*, unsigned int*) {}
 inline unsigned int GetTapeRate() { return 44100; }
-inline void Motor(unsigned char) {}  // Cassette motor control
 
 // ============================================================================
 // DirectDraw/Display stubs (was in DirectDrawInterface.h)
@@ -0,0 +1,118 @@
+#ifndef CUTIE_TIMELINE_H
+#define CUTIE_TIMELINE_H
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cutie {
+
+/**
+ * @brief One guest write to a PIA or GIME register
+ */
+struct RegisterWrite {
+    uint32_t frame;     // Frames completed since the timeline was enabled
+    uint16_t line;      // Scanline, counted from the start of VSYNC
+    uint16_t cycle;     // CPU cycles since the start of the scanline
+    uint16_t address;   // $FF00-$FF03, $FF20-$FF23 or $FF90-$FFBF
+    uint8_t value;
+};
+
+/**
+ * @brief Recorder of PIA and GIME register writes stamped with the beam position
+ *
+ * Covers the PIAs and every GIME register, including the MMU bank
+ * registers and the palette. Writes go into a ring that is allocated when
+ * the timeline is enabled, so recording never allocates; if the ring is
+ * not drained in time the oldest writes are overwritten and counted in
+ * lost().
+ *
+ * Not thread safe: record, drain and enable from the emulation thread,
+ * between frames for anything other than record.
+ */
+class RegisterTimeline {
+public:
+    static constexpr size_t DefaultCapacity = 16384;
+
+    /**
+     * @brief Start recording into a ring of at least the given size
+     *
+     * Discards anything already recorded and restarts the frame count.
+     */
+    void enable(size_t capacity = DefaultCapacity);
+
+    /**
+     * @brief Stop recording and release the ring
+     */
+    void disable();
+
+    bool isEnabled() const { return m_enabled; }
+
+    /**
+     * @brief Record a write at the current beam position
+     */
+    void record(uint16_t address, uint8_t value);
+
+    /**
+     * @brief Mark the end of a video frame
+     */
+    void endFrame() { ++m_frame; }
+
+    /**
+     * @brief Move the writes recorded since the last drain to a vector
+     *
+     * Writes are appended oldest first; each frame's writes follow the
+     * previous frame's.
+     *
+     * @return Number of writes appended
+     */
+    size_t drain(std::vector<RegisterWrite>& writes);
+
+    /**
+     * @brief Writes overwritten before they were drained
+     */
+    uint64_t lost() const { return m_lost; }
+
+    /**
+     * @brief Frames completed since the timeline was enabled
+     */
+    uint32_t frame() const { return m_frame; }
+
+private:
+    std::vector<RegisterWrite> m_ring;
+    size_t m_mask = 0;
+    uint64_t m_recorded = 0;
+    uint64_t m_drained = 0;
+    uint64_t m_lost = 0;
+    uint32_t m_frame = 0;
+    bool m_enabled = false;
+};
+
+/**
+ * @brief Global register timeline, fed by the legacy register write paths
+ */
+RegisterTimeline& getRegisterTimeline();
+
+} // namespace cutie
+
+// Called by GimeWrite and the PIA write handlers
+void RecordRegisterWrite(unsigned short address, unsigned char value);
+
+#endif // CUTIE_TIMELINE_H
@@ -24,6 +24,7 @@ This file is part of VCC (Virtual Color Computer).
 // pakinterface.h removed - stubs provide PakReadPort/PakWritePort
 #include "tcc1014registers.h"
 #include "tcc1014mmu.h"
+#include "cutie/hostcall.h"
 #include "vcc/utils/logger.h"
 unsigned char port_read(unsigned short addr)
 {
@@ -152,12 +153,40 @@ unsigned char port_read(unsigned short addr)
 		case 0xBF:
 			temp=GimeRead(port);
 		break;
+
+		case 0x88:					// Host call device, when it is enabled
+		case 0x89:
+		case 0x8A:
+		case 0x8B:
+			if (HostCallsEnabled)
+				temp=HostCallRead(port);
+			else
+				temp=PakReadPort (port);
+		break;
 		default:
 			temp=PakReadPort (port);
 		}
 	return temp;
 }
 
+// What a CPU read of the port would return, without side effects. Cartridge
+// and expansion ports may act on reads, so they are not read at all.
+unsigned char port_peek(unsigned short addr)
+{
+	unsigned char port = (addr & 0xFF);
+
+	if (port<=0x03)
+		return pia0_peek(port);
+	if ((port>=0x20) && (port<=0x23))
+		return pia1_peek(port);
+	if ((port>=0x90) && (port<=0xBF))
+		return GimePeek(port);
+	if (HostCallsEnabled && (port>=0x88) && (port<=0x8B))
+		return HostCallRead(port);
+	if (port>=0xC0)
+		return sam_read(port);
+	return 0xFF;
+}
 
 void port_write(unsigned char data,unsigned short addr)
 {
@@ -266,6 +295,16 @@ void port_write(unsigned char data,unsigned short addr)
 		case 0xBF:
 			GimeWrite(port,data);
 		break;
+
+		case 0x88:					// Host call device, when it is enabled
+		case 0x89:
+		case 0x8A:
+		case 0x8B:
+			if (HostCallsEnabled)
+				HostCallWrite(port,data);
+			else
+				PakWritePort (port,data);
+		break;
 		default:
 			PakWritePort (port,data);
 	}
@@ -17,6 +17,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "vcc/detail/exports.h"
+#include <cstddef>
 
 
 namespace vcc::bus
@@ -30,6 +31,18 @@ namespace vcc::bus
 	/// emulation of the system.
 	class LIBCOMMON_EXPORT expansion_port_bus
 	{
+	public:
+
+		/// @brief Specifies the type used to store a size or length.
+		using size_type = std::size_t;
+		/// @brief Specifies the type used to store an address in physical RAM.
+		using physical_address_type = std::size_t;
+
+		/// @brief The size of the CPU address space pages the default span transfers
+		/// split a range into. This is the size of an MMU bank.
+		static constexpr size_type memory_page_size = 0x2000;
+
+
 	public:
 
 		virtual ~expansion_port_bus() = default;
@@ -78,7 +91,63 @@ namespace vcc::bus
 		/// @param address The address to read the value from.
 		/// 
 		/// @return The value at the specified address.
-		virtual [[nodiscard]] unsigned char read_memory_byte(unsigned short address) = 0;
+		[[nodiscard]] virtual unsigned char read_memory_byte(unsigned short address) = 0;
+
+		/// @brief Read a range of the CPU address space.
+		/// 
+		/// Reads the bytes as the CPU would see them with the current MMU mapping. The
+		/// range wraps at the end of the address space. The default implementation splits the
+		/// range into runs within one page and copies each run mapped by map_memory_page
+		/// directly. Other runs are read with read_memory_byte one byte at a time.
+		/// 
+		/// @param address The address of the first byte.
+		/// @param buffer The buffer that receives the bytes.
+		/// @param size The number of bytes to read.
+		virtual void read_memory(unsigned short address, unsigned char* buffer, size_type size);
+
+		/// @brief Write a range of the CPU address space.
+		/// 
+		/// Writes the bytes as the CPU would with the current MMU mapping, so writes to
+		/// ROM are dropped and writes to I/O addresses reach the devices. The range wraps
+		/// at the end of the address space. The default implementation splits the
+		/// range into runs within one page and copies each run mapped by map_memory_page
+		/// directly. Other runs are written with write_memory_byte one byte at a time.
+		/// 
+		/// @param address The address of the first byte.
+		/// @param buffer The bytes to write.
+		/// @param size The number of bytes to write.
+		virtual void write_memory(unsigned short address, const unsigned char* buffer, size_type size);
+
+		/// @brief Retrieves the memory behind a page of the CPU address space.
+		/// 
+		/// Used by the default read_memory and write_memory to copy whole runs at once.
+		/// Pages that must be accessed a byte at a time, such as those holding I/O
+		/// registers, or ROM when writing, return null. The default implementation
+		/// returns null for every page.
+		/// 
+		/// @param address The address in the CPU address space.
+		/// @param for_write `true` if the bytes will be written; `false` if read.
+		/// 
+		/// @return A pointer to the byte at `address`, contiguous with the bytes up to
+		/// the end of its page, or null if the page cannot be accessed directly.
+		[[nodiscard]] virtual unsigned char* map_memory_page(unsigned short address, bool for_write);
+
+		/// @brief Read a range of physical RAM.
+		/// 
+		/// Physical addresses are those the MMU maps the CPU address space onto, with
+		/// 8K block N starting at N * 8192. The range wraps at the installed RAM size.
+		/// 
+		/// @param address The physical address of the first byte.
+		/// @param buffer The buffer that receives the bytes.
+		/// @param size The number of bytes to read.
+		virtual void read_physical_memory(physical_address_type address, unsigned char* buffer, size_type size) = 0;
+
+		/// @brief Write a range of physical RAM.
+		/// 
+		/// @param address The physical address of the first byte.
+		/// @param buffer The bytes to write.
+		/// @param size The number of bytes to write.
+		virtual void write_physical_memory(physical_address_type address, const unsigned char* buffer, size_type size) = 0;
 	};
 
 }
@@ -43,7 +43,11 @@ namespace vcc::media
 		/// not exist.
 		invalid_sector,
 		/// @brief The operation failed because the disk is write protected.
-		write_protected
+		write_protected,
+		/// @brief The buffer supplied for the sector data is smaller than the sector.
+		buffer_too_small,
+		/// @brief The disk image could not be read from or written to.
+		io_error
 	};
 
 }
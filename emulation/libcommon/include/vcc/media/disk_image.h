@@ -20,6 +20,7 @@
 #include "vcc/media/sector_record.h"
 #include "vcc/detail/exports.h"
 #include "vcc/media/disk_error_id.h"
+#include "vcc/media/sector_span.h"
 #include <optional>
 #include <vector>
 
@@ -46,6 +47,10 @@ namespace vcc::media
 		using sector_record_header_type = sector_record_header;
 		/// @brief The type of buffer used to store sector data.
 		using buffer_type = std::vector<unsigned char>;
+		/// @brief The type of caller supplied memory that sector data is read into.
+		using sector_span_type = ::vcc::media::sector_span;
+		/// @brief The type of caller supplied memory that sector data is written from.
+		using const_sector_span_type = ::vcc::media::const_sector_span;
 		/// @brief The type of a vector of sector records.
 		using sector_record_vector = std::vector<sector_record_type>;
 		/// @brief Type alias for error codes returned by various functions.
@@ -54,6 +59,10 @@ namespace vcc::media
 
 	public:
 
+		/// @brief The largest sector any disk image holds. A buffer of this size can
+		/// receive any sector.
+		static constexpr size_type max_sector_size = 1024;
+
 		/// @brief Constructs a Disk Image.
 		/// 
 		/// @todo this should thrown if either the track or head is 0.
@@ -223,8 +232,9 @@ namespace vcc::media
 		/// @brief Reads a sector from the disk.
 		/// 
 		/// Reads the first sector on a specified head and track of the disk that matches the
-		/// specific set of head, track, and sector identifiers, resizing the data buffer to
-		/// the exact size of the sector.
+		/// specific set of head, track, and sector identifiers into a caller supplied buffer.
+		/// This is the path disk controllers use for every sector and it neither allocates
+		/// memory nor throws; all failures are reported through the returned error code.
 		/// 
 		/// @param disk_head The head the sector is stored on.
 		/// @param disk_track The track the sector is stored in.
@@ -232,22 +242,25 @@ namespace vcc::media
 		/// @param track_id The track identifier assigned to the sector to read.
 		/// @param sector_id The sector identifier assigned to the sector to read.
 		/// @param data_buffer The buffer to store the sector data in.
+		/// @param bytes_read Receives the size of the sector on success.
 		/// 
-		/// @throws std::invalid_argument if the head specified in `disk_head` does not exist.
-		/// @throws std::invalid_argument if the track specified in `disk_track` does not exist.
-		/// @throws std::invalid_argument if a sector record matching the head, track, and sector identifiers
+		/// @return `success` if the sector was read, `invalid_head`, `invalid_track` or
+		/// `invalid_sector` if it does not exist, `buffer_too_small` if the buffer cannot
+		/// hold the sector, or `io_error` if the image could not be read.
 		[[nodiscard]] virtual error_id_type read_sector(
 			size_type disk_head,
 			size_type disk_track,
 			size_type head_id,
 			size_type track_id,
 			size_type sector_id,
-			buffer_type& data_buffer) = 0;
+			sector_span_type data_buffer,
+			size_type& bytes_read) noexcept = 0;
 
 		/// @brief Writes a sector to the disk.
 		/// 
 		/// Writes a block of data to the first sector on a specified head and track of the
-		/// disk that matches the specific set of head, track, and sector identifiers.
+		/// disk that matches the specific set of head, track, and sector identifiers. Like
+		/// read_sector this neither allocates memory nor throws.
 		/// 
 		/// @param disk_head The head the sector is stored on.
 		/// @param disk_track The track the sector is stored in.
@@ -256,26 +269,17 @@ namespace vcc::media
 		/// @param sector_id The sector identifier assigned to the sector to write.
 		/// @param data_buffer The buffer containing the data to write to the sector.
 		/// 
-		/// @throws std::invalid_argument if the head specified in `disk_head` does not exist.
-		/// @throws std::invalid_argument if the track specified in `disk_track` does not
-		/// exist.
-		/// @throws std::invalid_argument if a sector record matching the head, track,
-		/// and sector identifiers.
-		/// @throws vcc::media::buffer_size_error if the sector buffer is smaller than the
-		/// sector it is being written to.
-		/// @throws vcc::media::fatal_io_error If the file position of the sector data cannot
-		/// be access.
-		/// @throws vcc::media::write_protect_error If the disk image has its write protect
-		/// flag enabled.
-		/// @throws vcc::media::fatal_io_error If an IO error occurs while reading the sector
-		/// data.
+		/// @return `success` if the sector was written, `invalid_head`, `invalid_track` or
+		/// `invalid_sector` if it does not exist, `buffer_too_small` if the buffer is
+		/// smaller than the sector, `write_protected` if the disk is write protected, or
+		/// `io_error` if the image could not be written.
 		[[nodiscard]] virtual error_id_type write_sector(
 			size_type disk_head,
 			size_type disk_track,
 			size_type head_id,
 			size_type track_id,
 			size_type sector_id,
-			const buffer_type& data_buffer) = 0;
+			const_sector_span_type data_buffer) noexcept = 0;
 
 		/// @brief Reads an entire set of sector records from a track on the disk.
 		/// 
@@ -18,7 +18,6 @@
 #pragma once
 #include "vcc/media/disk_image.h"
 #include "vcc/media/geometry/generic_disk_geometry.h"
-#include <Windows.h>
 #include <iostream>
 #include <memory>
 
@@ -95,7 +94,8 @@ namespace vcc::media::disk_images
 			size_type head_id,
 			size_type track_id,
 			size_type sector_id,
-			buffer_type& data_buffer) override;
+			sector_span_type data_buffer,
+			size_type& bytes_read) noexcept override;
 
 		/// @inheritdoc
 		[[nodiscard]] LIBCOMMON_EXPORT error_id_type write_sector(
@@ -104,7 +104,7 @@ namespace vcc::media::disk_images
 			size_type head_id,
 			size_type track_id,
 			size_type sector_id,
-			const buffer_type& data_buffer) override;
+			const_sector_span_type data_buffer) noexcept override;
 
 		/// @inheritdoc
 		[[nodiscard]] LIBCOMMON_EXPORT sector_record_vector read_track(
@@ -130,7 +130,7 @@ namespace vcc::media::disk_images
 		/// @param position The position to move to.
 		/// 
 		/// @return `true` if the file pointer was successfully changed; `false` otherwise.
-		[[nodiscard]] LIBCOMMON_EXPORT bool seek(const position_type& position);
+		[[nodiscard]] LIBCOMMON_EXPORT bool seek(const position_type& position) noexcept;
 
 		/// @brief Calculates the file position of a specific sector on the disk.
 		/// 
@@ -86,7 +86,8 @@ namespace vcc::media::disk_images
 			size_type head_id,
 			size_type track_id,
 			size_type sector_id,
-			buffer_type& data_buffer) override;
+			sector_span_type data_buffer,
+			size_type& bytes_read) noexcept override;
 
 		/// @inheritdoc
 		[[nodiscard]] LIBCOMMON_EXPORT error_id_type write_sector(
@@ -95,7 +96,7 @@ namespace vcc::media::disk_images
 			size_type head_id,
 			size_type track_id,
 			size_type sector_id,
-			const buffer_type& data_buffer) override;
+			const_sector_span_type data_buffer) noexcept override;
 
 		/// @inheritdoc
 		[[nodiscard]] LIBCOMMON_EXPORT sector_record_vector read_track(
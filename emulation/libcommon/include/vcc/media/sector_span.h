@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+//	Copyright 2015 by Joseph Forgione
+//	This file is part of VCC (Virtual Color Computer).
+//	
+//	VCC (Virtual Color Computer) is free software: you can redistribute itand/or
+//	modify it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or (at your
+//	option) any later version.
+//	
+//	VCC (Virtual Color Computer) is distributed in the hope that it will be
+//	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+//	Public License for more details.
+//	
+//	You should have received a copy of the GNU General Public License along with
+//	VCC (Virtual Color Computer). If not, see <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <cstddef>
+
+
+namespace vcc::media
+{
+
+	/// @brief A caller owned block of memory that sector data is read into or written
+	/// from.
+	///
+	/// The span does not own or allocate the memory it refers to, so a disk controller can
+	/// keep one fixed size buffer for the life of the device and pass it on every sector
+	/// transfer.
+	///
+	/// @tparam ValueType The type of byte in the block; `const unsigned char` for data that
+	/// is only read.
+	template<class ValueType>
+	class basic_sector_span
+	{
+	public:
+
+		/// @brief Type alias to lengths, 1 dimension sizes, and indexes.
+		using size_type = std::size_t;
+		/// @brief The type of each byte in the span.
+		using value_type = ValueType;
+
+
+	public:
+
+		/// @brief Construct an empty span.
+		constexpr basic_sector_span() noexcept = default;
+
+		/// @brief Construct a span over a block of memory.
+		///
+		/// @param data The first byte of the block.
+		/// @param size The number of bytes in the block.
+		constexpr basic_sector_span(value_type* data, size_type size) noexcept
+			: data_(data), size_(size)
+		{}
+
+		/// @brief Construct a span over the contents of a contiguous container such as a
+		/// `std::array` or `std::vector`.
+		///
+		/// @param container The container holding the bytes.
+		template<class ContainerType>
+		constexpr basic_sector_span(ContainerType& container) noexcept
+			: data_(container.data()), size_(container.size())
+		{}
+
+		/// @brief Retrieves the first byte of the span.
+		[[nodiscard]] constexpr value_type* data() const noexcept
+		{
+			return data_;
+		}
+
+		/// @brief Retrieves the number of bytes in the span.
+		[[nodiscard]] constexpr size_type size() const noexcept
+		{
+			return size_;
+		}
+
+
+	private:
+
+		/// @brief The first byte of the span.
+		value_type* data_ = nullptr;
+		/// @brief The number of bytes in the span.
+		size_type size_ = 0;
+	};
+
+	/// @brief A span that receives sector data.
+	using sector_span = basic_sector_span<unsigned char>;
+	/// @brief A span that supplies sector data.
+	using const_sector_span = basic_sector_span<const unsigned char>;
+
+}
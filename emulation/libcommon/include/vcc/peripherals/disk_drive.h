@@ -4,6 +4,7 @@
 #include <vcc/media/disk_geometry.h>
 #include <vcc/media/disk_error_id.h>
 #include <vcc/media/sector_record.h>
+#include <vcc/media/sector_span.h>
 #include <filesystem>
 #include <vector>
 #include <optional>
@@ -36,6 +37,10 @@ namespace vcc::peripherals
 		using sector_record_vector = std::vector<sector_record_type>;
 		/// @brief TYpe alias for the buffer used to store and transfer sector data.
 		using buffer_type = std::vector<unsigned char>;
+		/// @brief Type alias for caller supplied memory that sector data is read into.
+		using sector_span_type = ::vcc::media::sector_span;
+		/// @brief Type alias for caller supplied memory that sector data is written from.
+		using const_sector_span_type = ::vcc::media::const_sector_span;
 		/// @brief Type alias for error codes returned by various functions.
 		using error_id_type = ::vcc::media::disk_error_id;
 
@@ -188,42 +193,46 @@ namespace vcc::peripherals
 
 		/// @brief Reads a sector from the disk.
 		/// 
-		/// Reads the first sector on a specified head and track of the disk that matches the
-		/// specific set of head, track, and sector identifiers, resizing the data buffer to
-		/// the exact size of the sector.
-		/// 
-		/// @todo this may need some throws added.
+		/// Reads the first sector on a specified head and the current track of the disk that
+		/// matches the specific set of head, track, and sector identifiers into a caller
+		/// supplied buffer. Neither allocates memory nor throws.
 		/// 
 		/// @param drive_head The head the sector is stored on.
 		/// @param head_id The head identifier assigned to the sector to read.
 		/// @param track_id The track identifier assigned to the sector to read.
 		/// @param sector_id The sector identifier assigned to the sector to read.
-		/// @param data_buffer The buffer to store the sector data in.
+		/// @param data_buffer The buffer to store the sector data in. A buffer of
+		/// `disk_image::max_sector_size` bytes can hold any sector.
+		/// @param bytes_read Receives the size of the sector on success.
+		/// 
+		/// @return The result of the read, see `disk_image::read_sector`.
 		virtual error_id_type read_sector(
 			size_type drive_head,
 			size_type head_id,
 			size_type track_id,
 			size_type sector_id,
-			buffer_type& data_buffer) const = 0;
+			sector_span_type data_buffer,
+			size_type& bytes_read) const noexcept = 0;
 
 		/// @brief Writes a sector to the disk.
 		/// 
-		/// Writes a block of data to the first sector on a specified head and track of the
-		/// disk that matches the specific set of head, track, and sector identifiers.
-		/// 
-		/// @todo this may need some throws added.
+		/// Writes a block of data to the first sector on a specified head and the current
+		/// track of the disk that matches the specific set of head, track, and sector
+		/// identifiers. Neither allocates memory nor throws.
 		/// 
 		/// @param drive_head The head the sector is stored on.
 		/// @param head_id The head identifier assigned to the sector to write.
 		/// @param track_id The track identifier assigned to the sector to write.
 		/// @param sector_id The sector identifier assigned to the sector to write.
 		/// @param data_buffer The buffer containing the data to write to the sector.
+		/// 
+		/// @return The result of the write, see `disk_image::write_sector`.
 		virtual error_id_type write_sector(
 			size_type drive_head,
 			size_type head_id,
 			size_type track_id,
 			size_type sector_id,
-			const buffer_type& data_buffer) const = 0;
+			const_sector_span_type data_buffer) const noexcept = 0;
 
 		/// @brief Reads an entire set of sector records from a track on the disk.
 		/// 
@@ -127,7 +127,8 @@ namespace vcc::peripherals::disk_drives
 			size_type head_id,
 			size_type track_id,
 			size_type sector_id,
-			buffer_type& data_buffer) const override;
+			sector_span_type data_buffer,
+			size_type& bytes_read) const noexcept override;
 
 		/// @inheritdoc
 		[[nodiscard]] LIBCOMMON_EXPORT error_id_type write_sector(
@@ -135,7 +136,7 @@ namespace vcc::peripherals::disk_drives
 			size_type head_id,
 			size_type track_id,
 			size_type sector_id,
-			const buffer_type& data_buffer) const override;
+			const_sector_span_type data_buffer) const noexcept override;
 
 		/// @inheritdoc
 		[[nodiscard]] LIBCOMMON_EXPORT sector_record_vector read_track(size_type drive_head) const override;
@@ -0,0 +1,239 @@
+////////////////////////////////////////////////////////////////////////////////
+//	Copyright 2015 by Joseph Forgione
+//	This file is part of VCC (Virtual Color Computer).
+//
+//	VCC (Virtual Color Computer) is free software: you can redistribute itand/or
+//	modify it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or (at your
+//	option) any later version.
+//
+//	VCC (Virtual Color Computer) is distributed in the hope that it will be
+//	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+//	Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License along with
+//	VCC (Virtual Color Computer). If not, see <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////
+#pragma once
+/// @file
+///
+/// @brief Random access to disk images stored in compressed containers.
+#include "vcc/detail/exports.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <streambuf>
+#include <vector>
+
+
+namespace vcc::utils
+{
+
+	/// @brief A stream buffer providing seekable access to a compressed disk image.
+	///
+	/// The image is divided into independently compressed blocks that are only
+	/// decompressed when a read touches them. Recently used blocks are kept in a small
+	/// LRU cache. Writes are copied into a sparse overlay of modified blocks and are
+	/// never written back to the container, so the archive on disk is left untouched.
+	///
+	/// The following containers are supported:
+	/// - Blocked gzip (BGZF, as written by `bgzip`). Each gzip member holds at most
+	///   64 KiB of the image and is located from its `BC` extra field without
+	///   inflating the rest of the file.
+	/// - Zip archives. The first entry with a `.dsk` extension (or the first file entry
+	///   when there is none) is opened. Stored entries are split into fixed size
+	///   blocks. A deflate stream cannot be entered part way through on its own, so
+	///   deflated entries are inflated once when the archive is opened and a
+	///   checkpoint is recorded at a deflate block boundary about every 64 KiB of
+	///   output. A checkpoint holds the bit position in the entry and the 32 KiB of
+	///   output before it, which is enough to restart inflation there; each one costs
+	///   32 KiB of memory for as long as the image is open.
+	class compressed_image_buffer : public std::streambuf
+	{
+	public:
+
+		/// @brief The type used to represent paths.
+		using path_type = std::filesystem::path;
+		/// @brief Type alias to lengths, 1 dimension sizes, and indexes.
+		using size_type = std::size_t;
+
+		/// @brief The number of decompressed blocks kept in the cache.
+		static constexpr size_type cache_capacity = 8;
+
+
+	public:
+
+		/// @brief Opens a compressed image.
+		///
+		/// @param path The path of the compressed image.
+		LIBCOMMON_EXPORT explicit compressed_image_buffer(const path_type& path);
+
+		/// @brief Determines if the container was opened and its block index built.
+		///
+		/// @return `true` if the image can be read; `false` otherwise.
+		[[nodiscard]] bool is_open() const noexcept
+		{
+			return !blocks_.empty();
+		}
+
+		/// @brief Retrieve the size of the decompressed image.
+		///
+		/// @return The size in bytes of the decompressed image.
+		[[nodiscard]] size_type size() const noexcept
+		{
+			return image_size_;
+		}
+
+		/// @brief Retrieve the number of independently readable blocks in the image.
+		///
+		/// @return The number of blocks in the block index.
+		[[nodiscard]] size_type block_count() const noexcept
+		{
+			return blocks_.size();
+		}
+
+		/// @brief Retrieve the number of blocks that have been modified.
+		///
+		/// @return The number of blocks held in the write overlay.
+		[[nodiscard]] size_type modified_block_count() const noexcept
+		{
+			return overlay_.size();
+		}
+
+		/// @brief Determines if a file is held in a container this buffer can open.
+		///
+		/// Only the file signature is checked.
+		///
+		/// @param path The path of the file to check.
+		///
+		/// @return `true` if the file is a blocked gzip file or zip archive; `false`
+		/// otherwise.
+		[[nodiscard]] static LIBCOMMON_EXPORT bool is_compressed_image(const path_type& path);
+
+
+	protected:
+
+		/// @inheritdoc
+		LIBCOMMON_EXPORT int_type underflow() override;
+		/// @inheritdoc
+		LIBCOMMON_EXPORT int_type overflow(int_type value) override;
+		/// @inheritdoc
+		LIBCOMMON_EXPORT std::streamsize xsputn(const char_type* data, std::streamsize count) override;
+		/// @inheritdoc
+		LIBCOMMON_EXPORT pos_type seekoff(
+			off_type offset,
+			std::ios_base::seekdir direction,
+			std::ios_base::openmode mode) override;
+		/// @inheritdoc
+		LIBCOMMON_EXPORT pos_type seekpos(pos_type position, std::ios_base::openmode mode) override;
+
+
+	private:
+
+		/// @brief Describes how a block is encoded in the container.
+		enum class block_encoding
+		{
+			stored,
+			gzip_member,
+			deflate_checkpoint
+		};
+
+		/// @brief Location of a block in the container and in the decompressed image.
+		struct block_descriptor
+		{
+			block_encoding encoding;
+			std::streamoff container_offset;
+			size_type container_size;
+			size_type image_offset;
+			size_type image_size;
+			/// @brief The number of high bits of the first container byte that begin
+			/// the block (checkpoints only).
+			int prime_bits = 0;
+			/// @brief The output preceding the block (checkpoints only).
+			std::shared_ptr<const std::vector<unsigned char>> window;
+		};
+
+		using block_data_type = std::vector<char_type>;
+
+		[[nodiscard]] bool index_gzip_blocks();
+		[[nodiscard]] bool index_zip_entry();
+		[[nodiscard]] bool index_deflate_checkpoints(
+			std::streamoff container_offset,
+			size_type container_size,
+			size_type image_size);
+		void add_block(
+			block_encoding encoding,
+			std::streamoff container_offset,
+			size_type container_size,
+			size_type image_size);
+
+		[[nodiscard]] size_type find_block(size_type image_offset) const;
+		[[nodiscard]] std::shared_ptr<block_data_type> load_block(size_type index);
+		[[nodiscard]] std::shared_ptr<block_data_type> decompress_block(size_type index);
+		[[nodiscard]] size_type current_position() const;
+		void set_position(size_type position);
+
+
+	private:
+
+		/// @brief The container file.
+		std::ifstream file_;
+		/// @brief The block index, ordered by image offset.
+		std::vector<block_descriptor> blocks_;
+		/// @brief The size of the decompressed image.
+		size_type image_size_ = 0;
+		/// @brief The read/write position when the get area is empty.
+		size_type position_ = 0;
+		/// @brief The image offset of the block backing the get area.
+		size_type get_area_offset_ = 0;
+		/// @brief The block backing the get area, kept alive while it is in use.
+		std::shared_ptr<block_data_type> get_area_block_;
+		/// @brief Recently decompressed blocks, most recently used first.
+		std::list<std::pair<size_type, std::shared_ptr<block_data_type>>> cache_;
+		/// @brief Modified blocks indexed by block number.
+		std::map<size_type, std::shared_ptr<block_data_type>> overlay_;
+	};
+
+
+	/// @brief An IO stream that owns a compressed image buffer.
+	class compressed_image_stream : public std::iostream
+	{
+	public:
+
+		/// @brief Opens a compressed image.
+		///
+		/// If the image cannot be opened the stream's fail state is set.
+		///
+		/// @param path The path of the compressed image.
+		explicit compressed_image_stream(const std::filesystem::path& path)
+			:
+			std::iostream(nullptr),
+			buffer_(path)
+		{
+			rdbuf(&buffer_);
+			if (!buffer_.is_open())
+			{
+				setstate(std::ios::failbit);
+			}
+		}
+
+		/// @brief Determines if the image was opened.
+		///
+		/// @return `true` if the image can be read; `false` otherwise.
+		[[nodiscard]] bool is_open() const noexcept
+		{
+			return buffer_.is_open();
+		}
+
+
+	private:
+
+		/// @brief The buffer providing access to the image.
+		compressed_image_buffer buffer_;
+	};
+
+}
@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+//	Copyright 2015 by Joseph Forgione
+//	This file is part of VCC (Virtual Color Computer).
+//	
+//	VCC (Virtual Color Computer) is free software: you can redistribute itand/or
+//	modify it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or (at your
+//	option) any later version.
+//	
+//	VCC (Virtual Color Computer) is distributed in the hope that it will be
+//	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+//	Public License for more details.
+//	
+//	You should have received a copy of the GNU General Public License along with
+//	VCC (Virtual Color Computer). If not, see <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////
+#include "vcc/bus/expansion_port_bus.h"
+#include <cstring>
+
+
+namespace vcc::bus
+{
+
+	namespace
+	{
+
+		/// @brief Returns the number of bytes from `address` to the end of its page, or
+		/// `size` if that is fewer.
+		expansion_port_bus::size_type page_run(unsigned short address, expansion_port_bus::size_type size)
+		{
+			const auto to_page_end = expansion_port_bus::memory_page_size
+				- address % expansion_port_bus::memory_page_size;
+
+			return size < to_page_end ? size : to_page_end;
+		}
+
+	}
+
+
+	void expansion_port_bus::read_memory(unsigned short address, unsigned char* buffer, size_type size)
+	{
+		while (size > 0)
+		{
+			const auto run = page_run(address, size);
+			if (const auto* page = map_memory_page(address, false))
+			{
+				std::memcpy(buffer, page, run);
+			}
+			else
+			{
+				for (size_type index = 0; index < run; ++index)
+				{
+					buffer[index] = read_memory_byte(static_cast<unsigned short>(address + index));
+				}
+			}
+
+			buffer += run;
+			address = static_cast<unsigned short>(address + run);
+			size -= run;
+		}
+	}
+
+	void expansion_port_bus::write_memory(unsigned short address, const unsigned char* buffer, size_type size)
+	{
+		while (size > 0)
+		{
+			const auto run = page_run(address, size);
+			if (auto* page = map_memory_page(address, true))
+			{
+				std::memcpy(page, buffer, run);
+			}
+			else
+			{
+				for (size_type index = 0; index < run; ++index)
+				{
+					write_memory_byte(buffer[index], static_cast<unsigned short>(address + index));
+				}
+			}
+
+			buffer += run;
+			address = static_cast<unsigned short>(address + run);
+			size -= run;
+		}
+	}
+
+	unsigned char* expansion_port_bus::map_memory_page(
+		[[maybe_unused]] unsigned short address,
+		[[maybe_unused]] bool for_write)
+	{
+		return nullptr;
+	}
+
+}
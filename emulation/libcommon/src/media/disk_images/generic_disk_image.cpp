@@ -161,7 +161,8 @@ namespace vcc::media::disk_images
 		size_type head_id,
 		size_type track_id,
 		size_type sector_id,
-		buffer_type& data_buffer)
+		sector_span_type data_buffer,
+		size_type& bytes_read) noexcept
 	{
 		if (!is_valid_disk_head(disk_head) || !is_valid_disk_head(head_id))
 		{
@@ -178,27 +179,24 @@ namespace vcc::media::disk_images
 			return error_id_type::invalid_sector;
 		}
 
-		if (!seek(calculate_sector_offset_unchecked(disk_head, disk_track, head_id, track_id, sector_id)))
+		if (sector_size_ > data_buffer.size())
 		{
-			throw fatal_io_error("Cannot read sector. Fatal IO error encountered while seeking to sector position.");
+			return error_id_type::buffer_too_small;
 		}
 
-		// TODO-CHET: There needs to be unchecked versions of sector_size() and other similar
-		// functions since we're already checking the input parameters here.
-		data_buffer.resize(get_sector_size(
-			disk_head,
-			disk_track,
-			head_id,
-			track_id,
-			sector_id));
+		if (!seek(calculate_sector_offset_unchecked(disk_head, disk_track, head_id, track_id, sector_id)))
+		{
+			return error_id_type::io_error;
+		}
 
-		stream_.clear();
-		stream_.read(reinterpret_cast<char*>(data_buffer.data()), data_buffer.size());
-		if (stream_.bad())
+		stream_.read(reinterpret_cast<char*>(data_buffer.data()), sector_size_);
+		if (static_cast<size_type>(stream_.gcount()) != sector_size_)
 		{
-			throw fatal_io_error("Cannot read sector. Fatal IO error encountered while reading sector data.");
+			// The image ends part way through the sector
+			return error_id_type::io_error;
 		}
 
+		bytes_read = sector_size_;
 		return error_id_type::success;
 	}
 
@@ -208,7 +206,7 @@ namespace vcc::media::disk_images
 		size_type head_id,
 		size_type track_id,
 		size_type sector_id,
-		const buffer_type& data_buffer)
+		const_sector_span_type data_buffer) noexcept
 	{
 		if (!is_valid_disk_head(disk_head) || !is_valid_disk_head(head_id))
 		{
@@ -225,29 +223,28 @@ namespace vcc::media::disk_images
 			return error_id_type::invalid_sector;
 		}
 
-		const auto sector_size(get_sector_size(disk_head, disk_track, head_id, track_id, sector_id));
-		if (sector_size > data_buffer.size())
+		if (sector_size_ > data_buffer.size())
 		{
 			// TODO-CHET: Determine if we should write a partial sector here or if a write_partial_sector
 			// should be added and used by the client.
-			throw buffer_size_error("Cannot write sector. Sector buffer is smaller than the sector.");
+			return error_id_type::buffer_too_small;
 		}
 
-		if (!seek(calculate_sector_offset_unchecked(disk_head, disk_track, head_id, track_id, sector_id)))
+		if (is_write_protected())
 		{
-			throw fatal_io_error("Cannot write sector. Fatal IO error encountered while seeking to sector position.");
+			return error_id_type::write_protected;
 		}
 
-		if (is_write_protected())
+		if (!seek(calculate_sector_offset_unchecked(disk_head, disk_track, head_id, track_id, sector_id)))
 		{
-			return error_id_type::write_protected;
+			return error_id_type::io_error;
 		}
 
-		stream_.write(reinterpret_cast<const char*>(data_buffer.data()), sector_size);
+		stream_.write(reinterpret_cast<const char*>(data_buffer.data()), sector_size_);
 		stream_.flush();
-		if (stream_.bad())
+		if (stream_.fail())
 		{
-			throw fatal_io_error("Cannot write sector. Fatal IO error encountered while writing sector.");
+			return error_id_type::io_error;
 		}
 
 		return error_id_type::success;
@@ -314,7 +311,7 @@ namespace vcc::media::disk_images
 				sector.header.head_id,
 				sector.header.track_id,
 				sector.header.sector_id,
-				sector.data));
+				const_sector_span_type(sector.data)));
 			if (result != error_id_type::success)
 			{
 				last_result = result;
@@ -333,11 +330,19 @@ namespace vcc::media::disk_images
 	}
 
 
-	bool generic_disk_image::seek(const position_type& position)
+	bool generic_disk_image::seek(const position_type& position) noexcept
 	{
 		stream_.clear();
-		return !stream_.seekg(position, std::ios::beg).bad()
-			&& !stream_.seekp(position, std::ios::beg).bad();
+		if (stream_.seekg(position, std::ios::beg).fail())
+		{
+			return false;
+		}
+
+		// A stream opened only for reading has no put position to move. Writing to it
+		// fails later on its own, so that is not an error for reads.
+		stream_.seekp(position, std::ios::beg);
+		stream_.clear(stream_.rdstate() & ~std::ios::failbit);
+		return !stream_.bad();
 	}
 
 
@@ -116,7 +116,8 @@ namespace vcc::media::disk_images
 		[[maybe_unused]] size_type head_id,
 		[[maybe_unused]] size_type track_id,
 		[[maybe_unused]] size_type sector_id,
-		[[maybe_unused]] buffer_type& data_buffer)
+		[[maybe_unused]] sector_span_type data_buffer,
+		[[maybe_unused]] size_type& bytes_read) noexcept
 	{
 		return error_id_type::empty;
 	}
@@ -127,7 +128,7 @@ namespace vcc::media::disk_images
 		[[maybe_unused]] size_type head_id,
 		[[maybe_unused]] size_type track_id,
 		[[maybe_unused]] size_type sector_id,
-		[[maybe_unused]] const buffer_type& data_buffer)
+		[[maybe_unused]] const_sector_span_type data_buffer) noexcept
 	{
 		return error_id_type::empty;
 	}
@@ -124,15 +124,17 @@ namespace vcc::peripherals::disk_drives
 		size_type head_id,
 		size_type track_id,
 		size_type sector_id,
-		buffer_type& data_buffer) const
+		sector_span_type data_buffer,
+		size_type& bytes_read) const noexcept
 	{
 		return disk_image_->read_sector(
 			drive_head,
-			head_position(),
+			head_position_,
 			head_id,
 			track_id,
 			sector_id,
-			data_buffer);
+			data_buffer,
+			bytes_read);
 	}
 
 	generic_disk_drive::error_id_type generic_disk_drive::write_sector(
@@ -140,11 +142,11 @@ namespace vcc::peripherals::disk_drives
 		size_type head_id,
 		size_type track_id,
 		size_type sector_id,
-		const buffer_type& data_buffer) const
+		const_sector_span_type data_buffer) const noexcept
 	{
 		return disk_image_->write_sector(
 			drive_head,
-			head_position(),
+			head_position_,
 			head_id,
 			track_id,
 			sector_id,
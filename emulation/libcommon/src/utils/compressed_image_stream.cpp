@@ -0,0 +1,707 @@
+////////////////////////////////////////////////////////////////////////////////
+//	Copyright 2015 by Joseph Forgione
+//	This file is part of VCC (Virtual Color Computer).
+//
+//	VCC (Virtual Color Computer) is free software: you can redistribute itand/or
+//	modify it under the terms of the GNU General Public License as published by
+//	the Free Software Foundation, either version 3 of the License, or (at your
+//	option) any later version.
+//
+//	VCC (Virtual Color Computer) is distributed in the hope that it will be
+//	useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+//	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+//	Public License for more details.
+//
+//	You should have received a copy of the GNU General Public License along with
+//	VCC (Virtual Color Computer). If not, see <http://www.gnu.org/licenses/>.
+////////////////////////////////////////////////////////////////////////////////
+#include "vcc/utils/compressed_image_stream.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <zlib.h>
+
+
+namespace vcc::utils
+{
+
+	namespace
+	{
+
+		constexpr std::size_t gzip_header_size = 12;
+		constexpr std::size_t zip_stored_block_size = 64 * 1024;
+		constexpr std::size_t deflate_checkpoint_span = 64 * 1024;
+		constexpr std::size_t deflate_window_size = 32 * 1024;
+		constexpr std::size_t deflate_read_size = 16 * 1024;
+		constexpr std::size_t zip_end_record_size = 22;
+		constexpr std::size_t zip_central_entry_size = 46;
+		constexpr std::size_t zip_local_header_size = 30;
+		constexpr std::size_t zip_max_comment_size = 0xffff;
+
+		constexpr std::uint32_t zip_local_header_signature = 0x04034b50;
+		constexpr std::uint32_t zip_central_entry_signature = 0x02014b50;
+		constexpr std::uint32_t zip_end_record_signature = 0x06054b50;
+
+		constexpr unsigned zip_method_stored = 0;
+		constexpr unsigned zip_method_deflated = 8;
+
+		std::uint16_t read_le16(const unsigned char* data)
+		{
+			return static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+		}
+
+		std::uint32_t read_le32(const unsigned char* data)
+		{
+			return data[0]
+				| (static_cast<std::uint32_t>(data[1]) << 8)
+				| (static_cast<std::uint32_t>(data[2]) << 16)
+				| (static_cast<std::uint32_t>(data[3]) << 24);
+		}
+
+		bool read_at(std::ifstream& file, std::streamoff offset, void* buffer, std::size_t size)
+		{
+			file.clear();
+			file.seekg(offset);
+			file.read(static_cast<char*>(buffer), static_cast<std::streamsize>(size));
+			return !file.fail();
+		}
+
+		/// Checks for a gzip member header carrying the BGZF block size subfield and
+		/// returns the compressed size of the member, or 0 if it is not a BGZF block.
+		std::size_t read_bgzf_block_size(std::ifstream& file, std::streamoff offset)
+		{
+			std::array<unsigned char, gzip_header_size> header;
+			if (!read_at(file, offset, header.data(), header.size())
+				|| header[0] != 0x1f || header[1] != 0x8b || header[2] != 8
+				|| (header[3] & 0x04) == 0)
+			{
+				return 0;
+			}
+
+			std::vector<unsigned char> extra(read_le16(&header[10]));
+			if (!file.read(reinterpret_cast<char*>(extra.data()), extra.size()))
+			{
+				return 0;
+			}
+
+			for (std::size_t field = 0; field + 4 <= extra.size();)
+			{
+				const auto field_size = read_le16(&extra[field + 2]);
+				if (extra[field] == 'B' && extra[field + 1] == 'C' && field_size == 2
+					&& field + 6 <= extra.size())
+				{
+					return read_le16(&extra[field + 4]) + 1u;
+				}
+
+				field += 4u + field_size;
+			}
+
+			return 0;
+		}
+
+		bool is_disk_image_name(std::string name)
+		{
+			std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) {
+				return static_cast<char>(std::tolower(c));
+			});
+
+			return name.size() > 4 && name.compare(name.size() - 4, 4, ".dsk") == 0;
+		}
+
+	}
+
+
+	compressed_image_buffer::compressed_image_buffer(const path_type& path)
+		: file_(path, std::ios::binary)
+	{
+		if (!file_.is_open())
+		{
+			return;
+		}
+
+		std::array<unsigned char, 4> signature;
+		if (!read_at(file_, 0, signature.data(), signature.size()))
+		{
+			return;
+		}
+
+		if (read_le32(signature.data()) == zip_local_header_signature)
+		{
+			if (!index_zip_entry())
+			{
+				blocks_.clear();
+			}
+		}
+		else if (!index_gzip_blocks())
+		{
+			blocks_.clear();
+		}
+
+		if (blocks_.empty())
+		{
+			image_size_ = 0;
+		}
+	}
+
+
+	bool compressed_image_buffer::is_compressed_image(const path_type& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		std::array<unsigned char, 4> signature;
+		if (!read_at(file, 0, signature.data(), signature.size()))
+		{
+			return false;
+		}
+
+		return read_le32(signature.data()) == zip_local_header_signature
+			|| read_bgzf_block_size(file, 0) != 0;
+	}
+
+
+	bool compressed_image_buffer::index_gzip_blocks()
+	{
+		file_.clear();
+		file_.seekg(0, std::ios::end);
+		const std::streamoff file_size = file_.tellg();
+
+		for (std::streamoff offset = 0; offset < file_size;)
+		{
+			const auto block_size = read_bgzf_block_size(file_, offset);
+			if (block_size == 0 || offset + static_cast<std::streamoff>(block_size) > file_size)
+			{
+				return false;
+			}
+
+			// The uncompressed size is the last field of the member
+			std::array<unsigned char, 4> trailer;
+			if (!read_at(file_, offset + block_size - trailer.size(), trailer.data(), trailer.size()))
+			{
+				return false;
+			}
+
+			// Empty members include the end of file marker
+			const auto image_size = read_le32(trailer.data());
+			if (image_size != 0)
+			{
+				add_block(block_encoding::gzip_member, offset, block_size, image_size);
+			}
+
+			offset += block_size;
+		}
+
+		return !blocks_.empty();
+	}
+
+
+	bool compressed_image_buffer::index_zip_entry()
+	{
+		file_.clear();
+		file_.seekg(0, std::ios::end);
+		const std::streamoff file_size = file_.tellg();
+		if (file_size < static_cast<std::streamoff>(zip_end_record_size))
+		{
+			return false;
+		}
+
+		// The end of central directory record is followed by a comment of up to 64 KiB
+		const auto tail_size = static_cast<std::size_t>(std::min<std::streamoff>(
+			file_size,
+			zip_end_record_size + zip_max_comment_size));
+		std::vector<unsigned char> tail(tail_size);
+		if (!read_at(file_, file_size - tail_size, tail.data(), tail.size()))
+		{
+			return false;
+		}
+
+		const unsigned char* end_record = nullptr;
+		for (auto offset = tail_size - zip_end_record_size + 1; offset-- > 0;)
+		{
+			if (read_le32(&tail[offset]) == zip_end_record_signature)
+			{
+				end_record = &tail[offset];
+				break;
+			}
+		}
+
+		if (end_record == nullptr)
+		{
+			return false;
+		}
+
+		const auto entry_count = read_le16(end_record + 10);
+		std::vector<unsigned char> directory(read_le32(end_record + 12));
+		if (!read_at(file_, read_le32(end_record + 16), directory.data(), directory.size()))
+		{
+			return false;
+		}
+
+		const unsigned char* selected = nullptr;
+		for (std::size_t entry = 0, offset = 0; entry < entry_count; ++entry)
+		{
+			if (offset + zip_central_entry_size > directory.size()
+				|| read_le32(&directory[offset]) != zip_central_entry_signature)
+			{
+				return false;
+			}
+
+			const auto* record = &directory[offset];
+			const auto name_size = read_le16(record + 28);
+			const auto entry_size = zip_central_entry_size
+				+ name_size
+				+ read_le16(record + 30)
+				+ read_le16(record + 32);
+			if (offset + entry_size > directory.size())
+			{
+				return false;
+			}
+
+			const std::string name(reinterpret_cast<const char*>(record + zip_central_entry_size), name_size);
+			const auto is_file = !name.empty() && name.back() != '/';
+			if (is_file && (selected == nullptr || is_disk_image_name(name)))
+			{
+				selected = record;
+				if (is_disk_image_name(name))
+				{
+					break;
+				}
+			}
+
+			offset += entry_size;
+		}
+
+		if (selected == nullptr)
+		{
+			return false;
+		}
+
+		const auto method = read_le16(selected + 10);
+		const auto container_size = read_le32(selected + 20);
+		const auto image_size = read_le32(selected + 24);
+		if ((method != zip_method_stored && method != zip_method_deflated)
+			|| container_size == std::numeric_limits<std::uint32_t>::max()
+			|| image_size == std::numeric_limits<std::uint32_t>::max())
+		{
+			return false;
+		}
+
+		// The local header may carry a different extra field than the central directory
+		std::array<unsigned char, zip_local_header_size> local_header;
+		const std::streamoff local_offset = read_le32(selected + 42);
+		if (!read_at(file_, local_offset, local_header.data(), local_header.size())
+			|| read_le32(local_header.data()) != zip_local_header_signature)
+		{
+			return false;
+		}
+
+		const std::streamoff data_offset = local_offset
+			+ zip_local_header_size
+			+ read_le16(&local_header[26])
+			+ read_le16(&local_header[28]);
+		if (data_offset + container_size > file_size)
+		{
+			return false;
+		}
+
+		if (method == zip_method_deflated)
+		{
+			return image_size != 0 && index_deflate_checkpoints(data_offset, container_size, image_size);
+		}
+
+		for (std::size_t offset = 0; offset < image_size; offset += zip_stored_block_size)
+		{
+			const auto block_size = std::min<std::size_t>(zip_stored_block_size, image_size - offset);
+			add_block(block_encoding::stored, data_offset + offset, block_size, block_size);
+		}
+
+		return !blocks_.empty();
+	}
+
+
+	bool compressed_image_buffer::index_deflate_checkpoints(
+		std::streamoff container_offset,
+		size_type container_size,
+		size_type image_size)
+	{
+		struct checkpoint
+		{
+			size_type input_offset;
+			int prime_bits;
+			size_type output_offset;
+			std::shared_ptr<const std::vector<unsigned char>> window;
+		};
+
+		z_stream stream{};
+		if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+		{
+			return false;
+		}
+
+		// The output goes round a window sized buffer, so the last 32 KiB of output
+		// is always at hand when a checkpoint is taken
+		std::vector<unsigned char> input(deflate_read_size);
+		std::vector<unsigned char> window(deflate_window_size);
+		std::vector<checkpoint> checkpoints{ { 0, 0, 0, nullptr } };
+		size_type total_in = 0;
+		size_type total_out = 0;
+		size_type read_size = 0;
+
+		file_.clear();
+		file_.seekg(container_offset);
+
+		auto result = Z_OK;
+		while (result != Z_STREAM_END)
+		{
+			// Running out of input is caught by inflate as Z_BUF_ERROR
+			if (stream.avail_in == 0 && read_size < container_size)
+			{
+				const auto chunk_size = std::min(input.size(), container_size - read_size);
+				if (!file_.read(reinterpret_cast<char*>(input.data()), chunk_size))
+				{
+					break;
+				}
+
+				read_size += chunk_size;
+				stream.next_in = input.data();
+				stream.avail_in = static_cast<uInt>(chunk_size);
+			}
+
+			if (stream.avail_out == 0)
+			{
+				stream.next_out = window.data();
+				stream.avail_out = static_cast<uInt>(window.size());
+			}
+
+			// Z_BLOCK returns at the end of every deflate block
+			total_in += stream.avail_in;
+			total_out += stream.avail_out;
+			result = inflate(&stream, Z_BLOCK);
+			total_in -= stream.avail_in;
+			total_out -= stream.avail_out;
+			if (result != Z_OK && result != Z_STREAM_END)
+			{
+				break;
+			}
+
+			const auto at_block_end = (stream.data_type & 128) != 0 && (stream.data_type & 64) == 0;
+			if (at_block_end
+				&& total_out - checkpoints.back().output_offset >= deflate_checkpoint_span
+				&& total_out < image_size)
+			{
+				const auto used = window.size() - stream.avail_out;
+				auto saved = std::make_shared<std::vector<unsigned char>>(window.size());
+				std::copy(window.begin() + used, window.end(), saved->begin());
+				std::copy(window.begin(), window.begin() + used, saved->end() - used);
+
+				checkpoints.push_back({ total_in, stream.data_type & 7, total_out, std::move(saved) });
+			}
+		}
+
+		inflateEnd(&stream);
+
+		if (result != Z_STREAM_END || total_out != image_size)
+		{
+			return false;
+		}
+
+		// A block whose first bits share a byte with the block before starts one
+		// byte early, and the next block begins where this one's input ends
+		for (size_type index = 0; index < checkpoints.size(); ++index)
+		{
+			const auto& start = checkpoints[index];
+			const auto input_begin = start.input_offset - (start.prime_bits != 0 ? 1 : 0);
+			const auto is_last = index + 1 == checkpoints.size();
+			const auto input_end = is_last ? total_in : checkpoints[index + 1].input_offset;
+			const auto output_end = is_last ? total_out : checkpoints[index + 1].output_offset;
+
+			add_block(
+				block_encoding::deflate_checkpoint,
+				container_offset + static_cast<std::streamoff>(input_begin),
+				input_end - input_begin,
+				output_end - start.output_offset);
+			blocks_.back().prime_bits = start.prime_bits;
+			blocks_.back().window = start.window;
+		}
+
+		return true;
+	}
+
+
+	void compressed_image_buffer::add_block(
+		block_encoding encoding,
+		std::streamoff container_offset,
+		size_type container_size,
+		size_type image_size)
+	{
+		blocks_.push_back({ encoding, container_offset, container_size, image_size_, image_size, 0, nullptr });
+		image_size_ += image_size;
+	}
+
+
+	compressed_image_buffer::size_type compressed_image_buffer::find_block(size_type image_offset) const
+	{
+		const auto next_block(std::upper_bound(
+			blocks_.begin(),
+			blocks_.end(),
+			image_offset,
+			[](size_type offset, const block_descriptor& block) { return offset < block.image_offset; }));
+
+		return static_cast<size_type>(next_block - blocks_.begin()) - 1;
+	}
+
+
+	std::shared_ptr<compressed_image_buffer::block_data_type> compressed_image_buffer::load_block(size_type index)
+	{
+		if (const auto modified(overlay_.find(index)); modified != overlay_.end())
+		{
+			return modified->second;
+		}
+
+		const auto cached(std::find_if(cache_.begin(), cache_.end(), [index](const auto& entry) {
+			return entry.first == index;
+		}));
+		if (cached != cache_.end())
+		{
+			cache_.splice(cache_.begin(), cache_, cached);
+			return cached->second;
+		}
+
+		auto block(decompress_block(index));
+		if (block)
+		{
+			cache_.emplace_front(index, block);
+			if (cache_.size() > cache_capacity)
+			{
+				cache_.pop_back();
+			}
+		}
+
+		return block;
+	}
+
+
+	std::shared_ptr<compressed_image_buffer::block_data_type> compressed_image_buffer::decompress_block(size_type index)
+	{
+		const auto& descriptor(blocks_[index]);
+
+		block_data_type container_data(descriptor.container_size);
+		if (!read_at(file_, descriptor.container_offset, container_data.data(), container_data.size()))
+		{
+			return {};
+		}
+
+		if (descriptor.encoding == block_encoding::stored)
+		{
+			return std::make_shared<block_data_type>(std::move(container_data));
+		}
+
+		auto block(std::make_shared<block_data_type>(descriptor.image_size));
+
+		z_stream stream{};
+		const auto window_bits = descriptor.encoding == block_encoding::gzip_member
+			? 16 + MAX_WBITS
+			: -MAX_WBITS;
+		if (inflateInit2(&stream, window_bits) != Z_OK)
+		{
+			return {};
+		}
+
+		stream.next_in = reinterpret_cast<Bytef*>(container_data.data());
+		stream.avail_in = static_cast<uInt>(container_data.size());
+		stream.next_out = reinterpret_cast<Bytef*>(block->data());
+		stream.avail_out = static_cast<uInt>(block->size());
+
+		auto result = Z_OK;
+		if (descriptor.encoding == block_encoding::deflate_checkpoint)
+		{
+			if (descriptor.prime_bits != 0 && stream.avail_in != 0)
+			{
+				const auto first = static_cast<unsigned char>(container_data.front());
+				result = inflatePrime(&stream, descriptor.prime_bits, first >> (8 - descriptor.prime_bits));
+				++stream.next_in;
+				--stream.avail_in;
+			}
+
+			if (result == Z_OK && descriptor.window)
+			{
+				result = inflateSetDictionary(
+					&stream,
+					descriptor.window->data(),
+					static_cast<uInt>(descriptor.window->size()));
+			}
+		}
+
+		// Only the last checkpoint runs to the end of the deflate stream
+		if (result == Z_OK)
+		{
+			result = inflate(&stream, Z_FINISH);
+		}
+		const auto inflated_size = stream.total_out;
+		inflateEnd(&stream);
+
+		const auto complete = result == Z_STREAM_END
+			|| (result == Z_BUF_ERROR && descriptor.encoding == block_encoding::deflate_checkpoint);
+		if (!complete || inflated_size != descriptor.image_size)
+		{
+			return {};
+		}
+
+		return block;
+	}
+
+
+	compressed_image_buffer::size_type compressed_image_buffer::current_position() const
+	{
+		if (eback() == nullptr)
+		{
+			return position_;
+		}
+
+		return get_area_offset_ + static_cast<size_type>(gptr() - eback());
+	}
+
+
+	void compressed_image_buffer::set_position(size_type position)
+	{
+		position_ = position;
+		setg(nullptr, nullptr, nullptr);
+		get_area_block_.reset();
+	}
+
+
+	compressed_image_buffer::int_type compressed_image_buffer::underflow()
+	{
+		if (gptr() < egptr())
+		{
+			return traits_type::to_int_type(*gptr());
+		}
+
+		const auto position(current_position());
+		set_position(position);
+		if (position >= image_size_)
+		{
+			return traits_type::eof();
+		}
+
+		const auto index(find_block(position));
+		auto block(load_block(index));
+		if (!block)
+		{
+			return traits_type::eof();
+		}
+
+		const auto& descriptor(blocks_[index]);
+		get_area_block_ = std::move(block);
+		get_area_offset_ = descriptor.image_offset;
+
+		auto* const begin(get_area_block_->data());
+		setg(begin, begin + (position - descriptor.image_offset), begin + get_area_block_->size());
+
+		return traits_type::to_int_type(*gptr());
+	}
+
+
+	compressed_image_buffer::int_type compressed_image_buffer::overflow(int_type value)
+	{
+		if (traits_type::eq_int_type(value, traits_type::eof()))
+		{
+			return traits_type::not_eof(value);
+		}
+
+		const auto data(traits_type::to_char_type(value));
+		return xsputn(&data, 1) == 1 ? value : traits_type::eof();
+	}
+
+
+	std::streamsize compressed_image_buffer::xsputn(const char_type* data, std::streamsize count)
+	{
+		auto position(current_position());
+		set_position(position);
+
+		std::streamsize written = 0;
+		while (written < count && position < image_size_)
+		{
+			const auto index(find_block(position));
+
+			auto modified(overlay_.find(index));
+			if (modified == overlay_.end())
+			{
+				const auto original(load_block(index));
+				if (!original)
+				{
+					break;
+				}
+
+				// The overlay copy replaces the cached block from now on
+				modified = overlay_.emplace(index, std::make_shared<block_data_type>(*original)).first;
+				cache_.remove_if([index](const auto& entry) { return entry.first == index; });
+			}
+
+			const auto& descriptor(blocks_[index]);
+			const auto block_offset(position - descriptor.image_offset);
+			const auto chunk_size(std::min<size_type>(
+				descriptor.image_size - block_offset,
+				static_cast<size_type>(count - written)));
+
+			std::memcpy(modified->second->data() + block_offset, data + written, chunk_size);
+			written += static_cast<std::streamsize>(chunk_size);
+			position += chunk_size;
+		}
+
+		position_ = position;
+
+		return written;
+	}
+
+
+	compressed_image_buffer::pos_type compressed_image_buffer::seekoff(
+		off_type offset,
+		std::ios_base::seekdir direction,
+		std::ios_base::openmode)
+	{
+		off_type base = 0;
+		switch (direction)
+		{
+		case std::ios_base::beg:
+			break;
+
+		case std::ios_base::cur:
+			base = static_cast<off_type>(current_position());
+			break;
+
+		case std::ios_base::end:
+			base = static_cast<off_type>(image_size_);
+			break;
+
+		default:
+			return pos_type(off_type(-1));
+		}
+
+		const auto position(base + offset);
+		if (position < 0 || position > static_cast<off_type>(image_size_))
+		{
+			return pos_type(off_type(-1));
+		}
+
+		set_position(static_cast<size_type>(position));
+
+		return pos_type(position);
+	}
+
+
+	compressed_image_buffer::pos_type compressed_image_buffer::seekpos(
+		pos_type position,
+		std::ios_base::openmode mode)
+	{
+		return seekoff(off_type(position), std::ios_base::beg, mode);
+	}
+
+}
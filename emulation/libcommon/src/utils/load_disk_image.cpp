@@ -1,6 +1,7 @@
 #include <vcc/media/geometry_calculators/floppy_disk_geometry_calculator.h>
 #include <vcc/media/disk_images/generic_disk_image.h>
 #include <vcc/media/geometry/generic_disk_geometry.h>
+#include <vcc/utils/compressed_image_stream.h>
 #include <vcc/utils/disk_image_loader.h>
 #include <vcc/utils/streams.h>
 #include <array>
@@ -16,21 +17,38 @@ namespace vcc::utils
 		using geometry_calculator_type = ::vcc::media::geometry_calculators::floppy_disk_geometry_calculator;
 
 		auto write_protected = false;
-		auto image_stream(std::make_unique<std::fstream>());
+		std::unique_ptr<std::iostream> image_stream;
 
-		// Read the header
-		image_stream->open(file_path, std::ios::binary | std::ios::in | std::ios::out);
-		if (!image_stream->is_open())
-		{	//Can't open read/write might be read only
-			image_stream->open(file_path, std::ios::binary | std::ios::in);
-			if (!image_stream->is_open())
+		if (compressed_image_buffer::is_compressed_image(file_path))
+		{	// Writes to compressed images are kept in memory for the session
+			auto compressed_stream(std::make_unique<compressed_image_stream>(file_path));
+			if (!compressed_stream->is_open())
 			{
 				return {};
 			}
 
-			write_protected = true;
+			image_stream = move(compressed_stream);
+		}
+		else
+		{
+			auto file_stream(std::make_unique<std::fstream>());
+
+			file_stream->open(file_path, std::ios::binary | std::ios::in | std::ios::out);
+			if (!file_stream->is_open())
+			{	//Can't open read/write might be read only
+				file_stream->open(file_path, std::ios::binary | std::ios::in);
+				if (!file_stream->is_open())
+				{
+					return {};
+				}
+
+				write_protected = true;
+			}
+
+			image_stream = move(file_stream);
 		}
 
+		// Read the header
 		geometry_calculator_type::header_buffer_type header_buffer;
 		const auto file_size(::vcc::utils::get_stream_size(*image_stream.get()));
 		if (file_size < header_buffer.size() || file_size > std::numeric_limits<std::size_t>::max())
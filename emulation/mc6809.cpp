@@ -22,6 +22,10 @@ This file is part of VCC (Virtual Color Computer).
 #include "mc6809.h"
 #include "mc6809defs.h"
 #include "tcc1014mmu.h"
+#include "cutie/reverse.h"
+#include "cutie/cassette.h"
+#include "cutie/romhooks.h"
+#include "cutie/fuzz.h"
 // OpDecoder.h removed - not used
 
 //Global variables for CPU Emulation-----------------------
@@ -54,6 +58,8 @@ typedef union
 static cpuregister pc,x,y,u,s,dp,d;
 static std::array<bool, 8> cc;
 static int CycleCounter=0;
+static bool SliceEnding=false;	// Set by MC6809EndSlice()
+static int InstructionStart=0;	// CycleCounter when the current instruction began
 static unsigned int SyncWaiting=0;
 static unsigned int temp32;
 static unsigned short temp16;
@@ -79,6 +85,8 @@ static unsigned char get_cc_flags();
 static void cpu_firq();
 static void cpu_irq();
 static void cpu_nmi();
+static unsigned char PushRegisters(cpuregister &,unsigned char,const cpuregister &);
+static unsigned char PullRegisters(cpuregister &,unsigned char,cpuregister &);
 static void Do_Opcode(int);
 static void P2_Opcode();
 static void P3_Opcode();
@@ -128,6 +136,41 @@ VCC::CPUState MC6809GetState()
 	return regs;
 }
 
+// Loads the registers from a CPUState, as left by a routine run on the
+// CPU's behalf. D follows A and B.
+void MC6809SetState(const VCC::CPUState &regs)
+{
+	set_cc_flags(regs.CC);
+	DP_REG = regs.DP & 0xff;
+	A_REG = regs.A;
+	B_REG = regs.B;
+	X_REG = regs.X;
+	Y_REG = regs.Y;
+	U_REG = regs.U;
+	S_REG = regs.S;
+	PC_REG = regs.PC;
+}
+
+// Everything that survives between MC6809Exec calls. CycleCounter and the
+// decode temporaries are rebuilt by the next call.
+template <class StateArchive>
+static void TransferState(StateArchive &state)
+{
+	state(pc)(x)(y)(u)(s)(dp)(d)(cc);
+	state(SyncWaiting)(PendingInterupts)(IRQWaiter)(InInterupt)(HaltedInsPending);
+}
+
+void MC6809SaveState(cutie::StateWriter &state)
+{
+	TransferState(state);
+}
+
+bool MC6809LoadState(cutie::StateReader &state)
+{
+	TransferState(state);
+	return state.complete();
+}
+
 void MC6809SetBreakpoints(const std::vector<unsigned short>& breakpoints)
 {
 	CPUBreakpoints = breakpoints;
@@ -331,9 +374,11 @@ int MC6809Exec(int CycleFor)
 	extern int JS_Ramp_Clock;
 	int PrevCycleCount = 0;
 	CycleCounter=0;
+	SliceEnding=false;
 
 	// Instruction Loop
 	while (CycleCounter<CycleFor) {
+		InstructionStart=CycleCounter;
 
 		// CPU is halted.
 		if (EmuState.Debugger.IsHalted()) {
@@ -399,8 +444,30 @@ int MC6809Exec(int CycleFor)
 			EmuState.Debugger.TraceCaptureBefore(CycleCounter, MC6809GetState());
 		}
 
+		// A fuzzing harness gathers coverage and ends the run at its stop addresses
+		if (FuzzArmed && FuzzInstruction(pc.Reg))
+			break;
+
+		// Cassette turbo mode runs the ROM's cassette output routines itself
+		if (CassetteTrapsArmed && CassetteTrap(pc.Reg))
+			continue;
+
+		// Hot BASIC routines can run natively
+		if (RomHooksArmed && RomHookEntry(pc.Reg)) {
+			const int hooked = RomHook(pc.Reg);
+			if (hooked) {
+				CycleCounter += hooked;
+				continue;
+			}
+		}
+
+		// Reverse execution watches instruction boundaries while replaying
+		if (ReplayWatching)
+			ReplayInstruction(pc.Reg);
+
 		// Do an instruction
 		Do_Opcode(CycleFor);
+		InstructionsRetired++;
 
 		// After instruction trace capture
 		if (EmuState.Debugger.IsTracing()) {
@@ -413,22 +480,45 @@ int MC6809Exec(int CycleFor)
 
 		PrevCycleCount = CycleCounter;
 
+		// The emulator needs control back before the slice is over
+		if (SliceEnding)
+			break;
+
 	} // End instruction loop
 
 	return(CycleFor-CycleCounter);
 
 } // End MC6809Exec
 
+// Cycles run so far by the MC6809Exec call in progress
+int MC6809SliceCycles()
+{
+	return CycleCounter;
+}
+
+// Cycles run by the MC6809Exec call in progress when the instruction being
+// executed (or the interrupt being taken) began
+int MC6809InstructionCycles()
+{
+	return InstructionStart;
+}
+
+// Stop the MC6809Exec call in progress after the current instruction
+void MC6809EndSlice()
+{
+	SliceEnding = true;
+}
+
 
 // Execute an instruction
 void Do_Opcode(int CycleFor)
 {
 	static unsigned char msn,lsn; //Most signifcant, least significant nibbles
 
-	switch (MemRead8(pc.Reg++)) {
+	switch (MemFetch8(pc.Reg++)) {
 
 	case NEG_D: //0
-		temp16=(dp.Reg |MemRead8(pc.Reg++));
+		temp16=(dp.Reg |MemFetch8(pc.Reg++));
 		postbyte=MemRead8(temp16);
 		temp8=0-postbyte;
 		cc[C]=temp8>0;
@@ -440,7 +530,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case COM_D: //3
-		temp16=(dp.Reg |MemRead8(pc.Reg++));
+		temp16=(dp.Reg |MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16);
 		temp8=0xFF-temp8;
 		cc[Z]= ZTEST(temp8);
@@ -452,7 +542,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LSR_D: //4
-		temp16=(dp.Reg |MemRead8(pc.Reg++));
+		temp16=(dp.Reg |MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16);
 		cc[C]= temp8 & 1;
 		temp8= temp8 >>1;
@@ -463,7 +553,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ROR_D: //6
-		temp16=(dp.Reg |MemRead8(pc.Reg++));
+		temp16=(dp.Reg |MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16);
 		postbyte= cc[C]<<7;
 		cc[C]= temp8 & 1;
@@ -475,7 +565,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ASR_D: //7
-		temp16=(dp.Reg |MemRead8(pc.Reg++));
+		temp16=(dp.Reg |MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16);
 		cc[C]= temp8 & 1;
 		temp8 = (temp8 & 0x80) | (temp8 >>1);
@@ -486,7 +576,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ASL_D: //8
-		temp16=(dp.Reg |MemRead8(pc.Reg++));
+		temp16=(dp.Reg |MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16);
 		cc[C]= (temp8 & 0x80) >>7;
 		cc[V]= cc[C] ^ ((temp8 & 0x40) != 0);
@@ -498,7 +588,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ROL_D:	//9
-		temp16=(dp.Reg |MemRead8(pc.Reg++));
+		temp16=(dp.Reg |MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16);
 		postbyte=cc[C];
 		cc[C]=(temp8 & 0x80)>>7;
@@ -511,7 +601,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case DEC_D: //A
-		temp16=(dp.Reg |MemRead8(pc.Reg++));
+		temp16=(dp.Reg |MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16)-1;
 		cc[Z]= ZTEST(temp8);
 		cc[N]= NTEST8(temp8);
@@ -521,7 +611,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case INC_D: //C
-		temp16=(dp.Reg |MemRead8(pc.Reg++));
+		temp16=(dp.Reg |MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16)+1;
 		cc[Z]= ZTEST(temp8);
 		cc[V]= temp8==0x80;
@@ -531,7 +621,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case TST_D: //D
-		temp8=MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		temp8=MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		cc[Z]= ZTEST(temp8);
 		cc[N]= NTEST8(temp8);
 		cc[V] = false;
@@ -539,12 +629,12 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case JMP_D: //E
-		pc.Reg = dp.Reg | MemRead8(pc.Reg);
+		pc.Reg = dp.Reg | MemFetch8(pc.Reg);
 		CycleCounter+=3;
 		break;
 
 	case CLR_D: //F
-		MemWrite8(0,(dp.Reg |MemRead8(pc.Reg++)));
+		MemWrite8(0,(dp.Reg |MemFetch8(pc.Reg++)));
 		cc[Z]=true;
 		cc[N]=false;
 		cc[V] = false;
@@ -581,14 +671,14 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LBRA_R: //16
-		*spostword=MemRead16(pc.Reg);
+		*spostword=MemFetch16(pc.Reg);
 		pc.Reg+=2;
 		pc.Reg+=*spostword;
 		CycleCounter+=5;
 		break;
 
 	case LBSR_R: //17
-		*spostword=MemRead16(pc.Reg);
+		*spostword=MemFetch16(pc.Reg);
 		pc.Reg+=2;
 		s.Reg--;
 		MemWrite8(pc.B.lsb,s.Reg--);
@@ -619,7 +709,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ORCC_M: //1A
-		postbyte=MemRead8(pc.Reg++);
+		postbyte=MemFetch8(pc.Reg++);
 		temp8=get_cc_flags();
 		temp8 = (temp8 | postbyte);
 		set_cc_flags(temp8);
@@ -627,7 +717,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ANDCC_M: //1C
-		postbyte=MemRead8(pc.Reg++);
+		postbyte=MemFetch8(pc.Reg++);
 		temp8=get_cc_flags();
 		temp8 = (temp8 & postbyte);
 		set_cc_flags(temp8);
@@ -642,7 +732,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case EXG_M: //1E
-		postbyte=MemRead8(pc.Reg);
+		postbyte=MemFetch8(pc.Reg);
 		++pc.Reg;
 		{
 			// Get the indexes of the first and second registers.
@@ -675,7 +765,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case TFR_M: //1F
-		postbyte = MemRead8(pc.Reg);
+		postbyte = MemFetch8(pc.Reg);
 		++pc.Reg;
 		{
 			Source = postbyte >> 4; // Source register
@@ -690,7 +780,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case BRA_R: //20
-		*spostbyte=MemRead8(pc.Reg++);
+		*spostbyte=MemFetch8(pc.Reg++);
 		pc.Reg+=*spostbyte;
 		CycleCounter+=3;
 		break;
@@ -702,319 +792,142 @@ void Do_Opcode(int CycleFor)
 
 	case BHI_R: //22
 		if  (!(cc[C] | cc[Z]))
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case BLS_R: //23
 		if (cc[C] | cc[Z])
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case BHS_R: //24
 		if (!cc[C])
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case BLO_R: //25
 		if (cc[C])
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case BNE_R: //26
 		if (!cc[Z])
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case BEQ_R: //27
 		if (cc[Z])
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case BVC_R: //28
 		if (!cc[V])
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case BVS_R: //29
 		if ( cc[V])
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case BPL_R: //2A
 		if (!cc[N])
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case BMI_R: //2B
 		if ( cc[N])
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case BGE_R: //2C
 		if (! (cc[N] ^ cc[V]))
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case BLT_R: //2D
 		if ( cc[V] ^ cc[N])
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case BGT_R: //2E
 		if ( !( cc[Z] | (cc[N]^cc[V] ) ))
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case BLE_R: //2F
 		if ( cc[Z] | (cc[N]^cc[V]) )
-			pc.Reg+=(signed char)MemRead8(pc.Reg);
+			pc.Reg+=(signed char)MemFetch8(pc.Reg);
 		pc.Reg++;
 		CycleCounter+=3;
 		break;
 
 	case LEAX_X: //30
-		x.Reg=CalculateEA(MemRead8(pc.Reg++));
+		x.Reg=CalculateEA(MemFetch8(pc.Reg++));
 		cc[Z]= ZTEST(x.Reg);
 		CycleCounter+=4;
 		break;
 
 	case LEAY_X: //31
-		y.Reg=CalculateEA(MemRead8(pc.Reg++));
+		y.Reg=CalculateEA(MemFetch8(pc.Reg++));
 		cc[Z]= ZTEST(y.Reg);
 		CycleCounter+=4;
 		break;
 
 	case LEAS_X: //32
-		s.Reg=CalculateEA(MemRead8(pc.Reg++));
+		s.Reg=CalculateEA(MemFetch8(pc.Reg++));
 		CycleCounter+=4;
 		break;
 
 	case LEAU_X: //33
-		u.Reg=CalculateEA(MemRead8(pc.Reg++));
+		u.Reg=CalculateEA(MemFetch8(pc.Reg++));
 		CycleCounter+=4;
 		break;
 
 	case PSHS_M: //34
-		postbyte=MemRead8(pc.Reg++);
-		if (postbyte & 0x80)
-		{
-			MemWrite8( pc.B.lsb,--s.Reg);
-			MemWrite8( pc.B.msb,--s.Reg);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x40)
-		{
-			MemWrite8( u.B.lsb,--s.Reg);
-			MemWrite8( u.B.msb,--s.Reg);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x20)
-		{
-			MemWrite8( y.B.lsb,--s.Reg);
-			MemWrite8( y.B.msb,--s.Reg);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x10)
-		{
-			MemWrite8( x.B.lsb,--s.Reg);
-			MemWrite8( x.B.msb,--s.Reg);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x08)
-		{
-			MemWrite8( dp.B.msb,--s.Reg);
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x04)
-		{
-			MemWrite8(B_REG,--s.Reg);
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x02)
-		{
-			MemWrite8(A_REG,--s.Reg);
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x01)
-		{
-			MemWrite8(get_cc_flags(),--s.Reg);
-			CycleCounter+=1;
-		}
-
-		CycleCounter+=5;
+		postbyte=MemFetch8(pc.Reg++);
+		CycleCounter+=PushRegisters(s,postbyte,u)+5;
 		break;
 
 	case PULS_M: //35
-		postbyte=MemRead8(pc.Reg++);
-		if (postbyte & 0x01)
-		{
-			set_cc_flags(MemRead8(s.Reg++));
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x02)
-		{
-			A_REG=MemRead8(s.Reg++);
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x04)
-		{
-			B_REG=MemRead8(s.Reg++);
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x08)
-		{
-			dp.B.msb=MemRead8(s.Reg++);
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x10)
-		{
-			x.B.msb=MemRead8( s.Reg++);
-			x.B.lsb=MemRead8( s.Reg++);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x20)
-		{
-			y.B.msb=MemRead8( s.Reg++);
-			y.B.lsb=MemRead8( s.Reg++);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x40)
-		{
-			u.B.msb=MemRead8( s.Reg++);
-			u.B.lsb=MemRead8( s.Reg++);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x80)
-		{
-			pc.B.msb=MemRead8( s.Reg++);
-			pc.B.lsb=MemRead8( s.Reg++);
-			CycleCounter+=2;
-		}
-		CycleCounter+=5;
+		postbyte=MemFetch8(pc.Reg++);
+		CycleCounter+=PullRegisters(s,postbyte,u)+5;
 		break;
 
 	case PSHU_M: //36
-		postbyte=MemRead8(pc.Reg++);
-		if (postbyte & 0x80)
-		{
-			MemWrite8( pc.B.lsb,--u.Reg);
-			MemWrite8( pc.B.msb,--u.Reg);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x40)
-		{
-			MemWrite8( s.B.lsb,--u.Reg);
-			MemWrite8( s.B.msb,--u.Reg);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x20)
-		{
-			MemWrite8( y.B.lsb,--u.Reg);
-			MemWrite8( y.B.msb,--u.Reg);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x10)
-		{
-			MemWrite8( x.B.lsb,--u.Reg);
-			MemWrite8( x.B.msb,--u.Reg);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x08)
-		{
-			MemWrite8( dp.B.msb,--u.Reg);
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x04)
-		{
-			MemWrite8(B_REG,--u.Reg);
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x02)
-		{
-			MemWrite8(A_REG,--u.Reg);
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x01)
-		{
-			MemWrite8(get_cc_flags(),--u.Reg);
-			CycleCounter+=1;
-		}
-		CycleCounter+=5;
+		postbyte=MemFetch8(pc.Reg++);
+		CycleCounter+=PushRegisters(u,postbyte,s)+5;
 		break;
 
 	case PULU_M: //37
-		postbyte=MemRead8(pc.Reg++);
-		if (postbyte & 0x01)
-		{
-			set_cc_flags(MemRead8(u.Reg++));
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x02)
-		{
-			A_REG=MemRead8(u.Reg++);
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x04)
-		{
-			B_REG=MemRead8(u.Reg++);
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x08)
-		{
-			dp.B.msb=MemRead8(u.Reg++);
-			CycleCounter+=1;
-		}
-		if (postbyte & 0x10)
-		{
-			x.B.msb=MemRead8( u.Reg++);
-			x.B.lsb=MemRead8( u.Reg++);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x20)
-		{
-			y.B.msb=MemRead8( u.Reg++);
-			y.B.lsb=MemRead8( u.Reg++);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x40)
-		{
-			s.B.msb=MemRead8( u.Reg++);
-			s.B.lsb=MemRead8( u.Reg++);
-			CycleCounter+=2;
-		}
-		if (postbyte & 0x80)
-		{
-			pc.B.msb=MemRead8( u.Reg++);
-			pc.B.lsb=MemRead8( u.Reg++);
-			CycleCounter+=2;
-		}
-		CycleCounter+=5;
+		postbyte=MemFetch8(pc.Reg++);
+		CycleCounter+=PullRegisters(u,postbyte,s)+5;
 		break;
 
 	case RTS_I: //39
@@ -1034,23 +947,14 @@ void Do_Opcode(int CycleFor)
 		InInterupt=0;
 		if (cc[E])
 		{
-			A_REG=MemRead8(s.Reg++);
-			B_REG=MemRead8(s.Reg++);
-			dp.B.msb=MemRead8(s.Reg++);
-			x.B.msb=MemRead8(s.Reg++);
-			x.B.lsb=MemRead8(s.Reg++);
-			y.B.msb=MemRead8(s.Reg++);
-			y.B.lsb=MemRead8(s.Reg++);
-			u.B.msb=MemRead8(s.Reg++);
-			u.B.lsb=MemRead8(s.Reg++);
+			PullRegisters(s,0x7E,u);
 			CycleCounter+=9;
 		}
-		pc.B.msb=MemRead8(s.Reg++);
-		pc.B.lsb=MemRead8(s.Reg++);
+		PullRegisters(s,0x80,u);
 		break;
 
 	case CWAI_I: //3C
-		postbyte=MemRead8(pc.Reg++);
+		postbyte=MemFetch8(pc.Reg++);
 		set_cc_flags(get_cc_flags() & postbyte);
 		CycleCounter=CycleFor;
 		SyncWaiting=1;
@@ -1069,18 +973,7 @@ void Do_Opcode(int CycleFor)
 
 	case SWI1_I: //3F
 		cc[E]=true;
-		MemWrite8( pc.B.lsb,--s.Reg);
-		MemWrite8( pc.B.msb,--s.Reg);
-		MemWrite8( u.B.lsb,--s.Reg);
-		MemWrite8( u.B.msb,--s.Reg);
-		MemWrite8( y.B.lsb,--s.Reg);
-		MemWrite8( y.B.msb,--s.Reg);
-		MemWrite8( x.B.lsb,--s.Reg);
-		MemWrite8( x.B.msb,--s.Reg);
-		MemWrite8( dp.B.msb,--s.Reg);
-		MemWrite8(B_REG,--s.Reg);
-		MemWrite8(A_REG,--s.Reg);
-		MemWrite8(get_cc_flags(),--s.Reg);
+		PushRegisters(s,0xFF,u);
 		pc.Reg=MemRead16(VSWI);
 		CycleCounter+=19;
 		cc[I]=true;
@@ -1278,7 +1171,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case NEG_X: //60
-		temp16=CalculateEA(MemRead8(pc.Reg++));
+		temp16=CalculateEA(MemFetch8(pc.Reg++));
 		postbyte=MemRead8(temp16);
 		temp8= 0-postbyte;
 		cc[C]= temp8>0;
@@ -1290,7 +1183,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case COM_X: //63
-		temp16=CalculateEA(MemRead8(pc.Reg++));
+		temp16=CalculateEA(MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16);
 		temp8= 0xFF-temp8;
 		cc[Z]= ZTEST(temp8);
@@ -1302,7 +1195,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LSR_X: //64
-		temp16=CalculateEA(MemRead8(pc.Reg++));
+		temp16=CalculateEA(MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16);
 		cc[C]= temp8 & 1;
 		temp8= temp8 >>1;
@@ -1313,7 +1206,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ROR_X: //66
-		temp16=CalculateEA(MemRead8(pc.Reg++));
+		temp16=CalculateEA(MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16);
 		postbyte=cc[C]<<7;
 		cc[C]= (temp8 & 1);
@@ -1325,7 +1218,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ASR_X: //67
-		temp16=CalculateEA(MemRead8(pc.Reg++));
+		temp16=CalculateEA(MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16);
 		cc[C]= temp8 & 1;
 		temp8= (temp8 & 0x80) | (temp8 >>1);
@@ -1336,7 +1229,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ASL_X: //68
-		temp16=CalculateEA(MemRead8(pc.Reg++));
+		temp16=CalculateEA(MemFetch8(pc.Reg++));
 		temp8= MemRead8(temp16);
 		cc[C]= temp8 > 0x7F;
 		cc[V]= cc[C] ^ ((temp8 & 0x40) != 0);
@@ -1348,7 +1241,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ROL_X: //69
-		temp16=CalculateEA(MemRead8(pc.Reg++));
+		temp16=CalculateEA(MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16);
 		postbyte=cc[C];
 		cc[C]= temp8 > 0x7F;
@@ -1361,7 +1254,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case DEC_X: //6A
-		temp16=CalculateEA(MemRead8(pc.Reg++));
+		temp16=CalculateEA(MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16);
 		temp8--;
 		cc[Z]= ZTEST(temp8);
@@ -1372,7 +1265,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case INC_X: //6C
-		temp16=CalculateEA(MemRead8(pc.Reg++));
+		temp16=CalculateEA(MemFetch8(pc.Reg++));
 		temp8=MemRead8(temp16);
 		temp8++;
 		cc[V]= (temp8 == 0x80);
@@ -1383,7 +1276,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case TST_X: //6D
-		temp8=MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		temp8=MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(temp8);
 		cc[N]= NTEST8(temp8);
 		cc[V]= false;
@@ -1391,12 +1284,12 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case JMP_X: //6E
-		pc.Reg=CalculateEA(MemRead8(pc.Reg++));
+		pc.Reg=CalculateEA(MemFetch8(pc.Reg++));
 		CycleCounter+=3;
 		break;
 
 	case CLR_X: //6F
-		MemWrite8(0,CalculateEA(MemRead8(pc.Reg++)));
+		MemWrite8(0,CalculateEA(MemFetch8(pc.Reg++)));
 		cc[C]= false;
 		cc[N]= false;
 		cc[V]= false;
@@ -1405,7 +1298,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case NEG_E: //70
-		temp16=MemRead16(pc.Reg);
+		temp16=MemFetch16(pc.Reg);
 		postbyte=MemRead8(temp16);
 		temp8=0-postbyte;
 		cc[C]= temp8>0;
@@ -1418,7 +1311,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case COM_E: //73
-		temp16=MemRead16(pc.Reg);
+		temp16=MemFetch16(pc.Reg);
 		temp8=MemRead8(temp16);
 		temp8=0xFF-temp8;
 		cc[Z]= ZTEST(temp8);
@@ -1431,7 +1324,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LSR_E:  //74
-		temp16=MemRead16(pc.Reg);
+		temp16=MemFetch16(pc.Reg);
 		temp8=MemRead8(temp16);
 		cc[C]= temp8 & 1;
 		temp8= temp8>>1;
@@ -1443,7 +1336,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ROR_E: //76
-		temp16=MemRead16(pc.Reg);
+		temp16=MemFetch16(pc.Reg);
 		temp8=MemRead8(temp16);
 		postbyte=cc[C]<<7;
 		cc[C]= temp8 & 1;
@@ -1456,7 +1349,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ASR_E: //77
-		temp16=MemRead16(pc.Reg);
+		temp16=MemFetch16(pc.Reg);
 		temp8=MemRead8(temp16);
 		cc[C]= temp8 & 1;
 		temp8= (temp8 & 0x80) | (temp8 >>1);
@@ -1468,7 +1361,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ASL_E: //78
-		temp16=MemRead16(pc.Reg);
+		temp16=MemFetch16(pc.Reg);
 		temp8= MemRead8(temp16);
 		cc[C]= temp8 > 0x7F;
 		cc[V]= cc[C] ^ ((temp8 & 0x40) != 0);
@@ -1481,7 +1374,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ROL_E: //79
-		temp16=MemRead16(pc.Reg);
+		temp16=MemFetch16(pc.Reg);
 		temp8=MemRead8(temp16);
 		postbyte=cc[C];
 		cc[C]= temp8 > 0x7F;
@@ -1495,7 +1388,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case DEC_E: //7A
-		temp16=MemRead16(pc.Reg);
+		temp16=MemFetch16(pc.Reg);
 		temp8=MemRead8(temp16);
 		temp8--;
 		cc[Z]= ZTEST(temp8);
@@ -1507,7 +1400,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case INC_E: //7C
-		temp16=MemRead16(pc.Reg);
+		temp16=MemFetch16(pc.Reg);
 		temp8=MemRead8(temp16);
 		temp8++;
 		cc[Z]= ZTEST(temp8);
@@ -1519,7 +1412,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case TST_E: //7D
-		temp8=MemRead8(MemRead16(pc.Reg));
+		temp8=MemRead8(MemFetch16(pc.Reg));
 		cc[Z]= ZTEST(temp8);
 		cc[N]= NTEST8(temp8);
 		cc[V]= false;
@@ -1528,12 +1421,12 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case JMP_E: //7E
-		pc.Reg=MemRead16(pc.Reg);
+		pc.Reg=MemFetch16(pc.Reg);
 		CycleCounter+=4;
 		break;
 
 	case CLR_E: //7F
-		MemWrite8(0,MemRead16(pc.Reg));
+		MemWrite8(0,MemFetch16(pc.Reg));
 		cc[C]= false;
 		cc[N]= false;
 		cc[V]= false;
@@ -1543,7 +1436,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SUBA_M: //80
-		postbyte=MemRead8(pc.Reg++);
+		postbyte=MemFetch8(pc.Reg++);
 		temp16 = A_REG - postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,A_REG);
@@ -1554,7 +1447,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case CMPA_M: //81
-		postbyte=MemRead8(pc.Reg++);
+		postbyte=MemFetch8(pc.Reg++);
 		temp8= A_REG-postbyte;
 		cc[C]= temp8 > A_REG;
 		cc[V]= OTEST8(cc[C],postbyte,temp8,A_REG);
@@ -1564,7 +1457,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SBCA_M:  //82
-		postbyte=MemRead8(pc.Reg++);
+		postbyte=MemFetch8(pc.Reg++);
 		temp16=A_REG-postbyte-cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,A_REG);
@@ -1575,7 +1468,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SUBD_M: //83
-		temp16=MemRead16(pc.Reg);
+		temp16=MemFetch16(pc.Reg);
 		temp32=D_REG-temp16;
 		cc[C]=(temp32 & 0x10000)>>16;
 		cc[V]=OTEST16(cc[C],temp32,temp16,D_REG);
@@ -1587,7 +1480,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ANDA_M: //84
-		A_REG = A_REG & MemRead8(pc.Reg++);
+		A_REG = A_REG & MemFetch8(pc.Reg++);
 		cc[N]= NTEST8(A_REG);
 		cc[Z]= ZTEST(A_REG);
 		cc[V]= false;
@@ -1595,7 +1488,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case BITA_M: //85
-		temp8= A_REG & MemRead8(pc.Reg++);
+		temp8= A_REG & MemFetch8(pc.Reg++);
 		cc[N]= NTEST8(temp8);
 		cc[Z]= ZTEST(temp8);
 		cc[V]= false;
@@ -1603,7 +1496,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDA_M: //86
-		A_REG= MemRead8(pc.Reg++);
+		A_REG= MemFetch8(pc.Reg++);
 		cc[Z]= ZTEST(A_REG);
 		cc[N]= NTEST8(A_REG);
 		cc[V]= false;
@@ -1611,7 +1504,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case EORA_M: //88
-		A_REG= A_REG ^ MemRead8(pc.Reg++);
+		A_REG= A_REG ^ MemFetch8(pc.Reg++);
 		cc[N]= NTEST8(A_REG);
 		cc[Z]= ZTEST(A_REG);
 		cc[V]= false;
@@ -1619,7 +1512,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADCA_M: //89
-		postbyte=MemRead8(pc.Reg++);
+		postbyte=MemFetch8(pc.Reg++);
 		temp16= A_REG + postbyte + cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,A_REG);
@@ -1631,7 +1524,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ORA_M: //8A
-		A_REG = A_REG | MemRead8(pc.Reg++);
+		A_REG = A_REG | MemFetch8(pc.Reg++);
 		cc[N]= NTEST8(A_REG);
 		cc[Z]= ZTEST(A_REG);
 		cc[V]= false;
@@ -1639,7 +1532,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADDA_M: //8B
-		postbyte=MemRead8(pc.Reg++);
+		postbyte=MemFetch8(pc.Reg++);
 		temp16=A_REG+postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[H]= ((A_REG ^ postbyte ^ temp16) & 0x10)>>4;
@@ -1651,7 +1544,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case CMPX_M: //8C
-		postword=MemRead16(pc.Reg);
+		postword=MemFetch16(pc.Reg);
 		temp16 = x.Reg-postword;
 		cc[C]= temp16 > x.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,X_REG);
@@ -1662,7 +1555,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case BSR_R: //8D
-		*spostbyte=MemRead8(pc.Reg++);
+		*spostbyte=MemFetch8(pc.Reg++);
 		s.Reg--;
 		MemWrite8(pc.B.lsb,s.Reg--);
 		MemWrite8(pc.B.msb,s.Reg);
@@ -1671,7 +1564,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDX_M: //8E
-		x.Reg= MemRead16(pc.Reg);
+		x.Reg= MemFetch16(pc.Reg);
 		cc[Z]= ZTEST(x.Reg);
 		cc[N]= NTEST16(x.Reg);
 		cc[V]= false;
@@ -1680,7 +1573,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SUBA_D: //90
-		postbyte=MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		postbyte=MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		temp16 = A_REG - postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,A_REG);
@@ -1691,7 +1584,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case CMPA_D: //91
-		postbyte=MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		postbyte=MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		temp8= A_REG-postbyte;
 		cc[C]= temp8 > A_REG;
 		cc[V]= OTEST8(cc[C],postbyte,temp8,A_REG);
@@ -1701,7 +1594,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SBCA_D: //92
-		postbyte=MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		postbyte=MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		temp16=A_REG-postbyte-cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,A_REG);
@@ -1712,7 +1605,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SUBD_D: //93
-		temp16=MemRead16(dp.Reg |MemRead8(pc.Reg++));
+		temp16=MemRead16(dp.Reg |MemFetch8(pc.Reg++));
 		temp32=D_REG-temp16;
 		cc[C]=(temp32 & 0x10000)>>16;
 		cc[V]= OTEST16(cc[C],temp32,temp16,D_REG);
@@ -1723,7 +1616,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ANDA_D: //94
-		A_REG = A_REG & MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		A_REG = A_REG & MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		cc[N]= NTEST8(A_REG);
 		cc[Z]= ZTEST(A_REG);
 		cc[V]= false;
@@ -1731,7 +1624,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case BITA_D: //95
-		temp8 = A_REG & MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		temp8 = A_REG & MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		cc[N]= NTEST8(temp8);
 		cc[Z]= ZTEST(temp8);
 		cc[V]= false;
@@ -1739,7 +1632,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDA_D: //96
-		A_REG= MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		A_REG= MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		cc[Z]= ZTEST(A_REG);
 		cc[N]= NTEST8(A_REG);
 		cc[V]= false;
@@ -1747,7 +1640,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STA_D: //97
-		MemWrite8( A_REG,(dp.Reg |MemRead8(pc.Reg++)));
+		MemWrite8( A_REG,(dp.Reg |MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(A_REG);
 		cc[N]= NTEST8(A_REG);
 		cc[V]= false;
@@ -1755,7 +1648,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case EORA_D: //98
-		A_REG= A_REG ^ MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		A_REG= A_REG ^ MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		cc[N]= NTEST8(A_REG);
 		cc[Z]= ZTEST(A_REG);
 		cc[V]= false;
@@ -1763,7 +1656,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADCA_D: //99
-		postbyte=MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		postbyte=MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		temp16= A_REG + postbyte + cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,A_REG);
@@ -1775,7 +1668,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ORA_D: //9A
-		A_REG = A_REG | MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		A_REG = A_REG | MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		cc[N]= NTEST8(A_REG);
 		cc[Z]= ZTEST(A_REG);
 		cc[V]= false;
@@ -1783,7 +1676,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADDA_D: //9B
-		postbyte=MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		postbyte=MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		temp16=A_REG+postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[H]= ((A_REG ^ postbyte ^ temp16) & 0x10)>>4;
@@ -1795,7 +1688,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case CMPX_D: //9C
-		postword=MemRead16(dp.Reg |MemRead8(pc.Reg++));
+		postword=MemRead16(dp.Reg |MemFetch8(pc.Reg++));
 		temp16= x.Reg - postword ;
 		cc[C]= temp16 > x.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,X_REG);
@@ -1805,7 +1698,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case BSR_D: //9D
-		temp16=(dp.Reg |MemRead8(pc.Reg++));
+		temp16=(dp.Reg |MemFetch8(pc.Reg++));
 		s.Reg--;
 		MemWrite8(pc.B.lsb,s.Reg--);
 		MemWrite8(pc.B.msb,s.Reg);
@@ -1814,7 +1707,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDX_D: //9E
-		x.Reg=MemRead16(dp.Reg |MemRead8(pc.Reg++));
+		x.Reg=MemRead16(dp.Reg |MemFetch8(pc.Reg++));
 		cc[Z]= ZTEST(x.Reg);
 		cc[N]= NTEST16(x.Reg);
 		cc[V]= false;
@@ -1822,7 +1715,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STX_D: //9F
-		MemWrite16(x.Reg,(dp.Reg |MemRead8(pc.Reg++)));
+		MemWrite16(x.Reg,(dp.Reg |MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(x.Reg);
 		cc[N]= NTEST16(x.Reg);
 		cc[V]= false;
@@ -1830,7 +1723,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SUBA_X: //A0
-		postbyte=MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		postbyte=MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		temp16 = A_REG - postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,A_REG);
@@ -1841,7 +1734,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case CMPA_X: //A1
-		postbyte=MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		postbyte=MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		temp8= A_REG-postbyte;
 		cc[C]= temp8 > A_REG;
 		cc[V]= OTEST8(cc[C],postbyte,temp8,A_REG);
@@ -1851,7 +1744,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SBCA_X: //A2
-		postbyte=MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		postbyte=MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		temp16=A_REG-postbyte-cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,A_REG);
@@ -1862,7 +1755,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SUBD_X: //A3
-		temp16=MemRead16(CalculateEA(MemRead8(pc.Reg++)));
+		temp16=MemRead16(CalculateEA(MemFetch8(pc.Reg++)));
 		temp32=D_REG-temp16;
 		cc[C]= (temp32 & 0x10000)>>16;
 		cc[V]= OTEST16(cc[C],temp32,temp16,D_REG);
@@ -1873,7 +1766,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ANDA_X: //A4
-		A_REG= A_REG & MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		A_REG= A_REG & MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[N]= NTEST8(A_REG);
 		cc[Z]= ZTEST(A_REG);
 		cc[V]= false;
@@ -1881,7 +1774,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case BITA_X:  //A5
-		temp8 =A_REG & MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		temp8 =A_REG & MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[N]= NTEST8(temp8);
 		cc[Z]= ZTEST(temp8);
 		cc[V]= false;
@@ -1889,7 +1782,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDA_X: //A6
-		A_REG= MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		A_REG= MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(A_REG);
 		cc[N]= NTEST8(A_REG);
 		cc[V]= false;
@@ -1897,7 +1790,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STA_X: //A7
-		MemWrite8(A_REG,CalculateEA(MemRead8(pc.Reg++)));
+		MemWrite8(A_REG,CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(A_REG);
 		cc[N]= NTEST8(A_REG);
 		cc[V]= false;
@@ -1905,7 +1798,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case EORA_X: //A8
-		A_REG= A_REG ^ MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		A_REG= A_REG ^ MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[N]= NTEST8(A_REG);
 		cc[Z]= ZTEST(A_REG);
 		cc[V]= false;
@@ -1913,7 +1806,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADCA_X: //A9
-		postbyte=MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		postbyte=MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		temp16= A_REG + postbyte + cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,A_REG);
@@ -1925,7 +1818,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ORA_X: //AA
-		A_REG= A_REG | MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		A_REG= A_REG | MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[N]= NTEST8(A_REG);
 		cc[Z]= ZTEST(A_REG);
 		cc[V]= false;
@@ -1933,7 +1826,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADDA_X: //AB
-		postbyte=MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		postbyte=MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		temp16=A_REG+postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[H]= ((A_REG ^ postbyte ^ temp16) & 0x10)>>4;
@@ -1945,7 +1838,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case CMPX_X: //AC
-		postword=MemRead16(CalculateEA(MemRead8(pc.Reg++)));
+		postword=MemRead16(CalculateEA(MemFetch8(pc.Reg++)));
 		temp16= x.Reg - postword ;
 		cc[C]= temp16 > x.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,X_REG);
@@ -1955,7 +1848,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case BSR_X: //AD
-		temp16=CalculateEA(MemRead8(pc.Reg++));
+		temp16=CalculateEA(MemFetch8(pc.Reg++));
 
 		s.Reg--;
 		MemWrite8(pc.B.lsb,s.Reg--);
@@ -1965,7 +1858,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDX_X: //AE
-		x.Reg=MemRead16(CalculateEA(MemRead8(pc.Reg++)));
+		x.Reg=MemRead16(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(x.Reg);
 		cc[N]= NTEST16(x.Reg);
 		cc[V]= false;
@@ -1973,7 +1866,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STX_X: //AF
-		MemWrite16(x.Reg,CalculateEA(MemRead8(pc.Reg++)));
+		MemWrite16(x.Reg,CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(x.Reg);
 		cc[N]= NTEST16(x.Reg);
 		cc[V] = false;
@@ -1981,7 +1874,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SUBA_E: //B0
-		postbyte=MemRead8(MemRead16(pc.Reg));
+		postbyte=MemRead8(MemFetch16(pc.Reg));
 		temp16 = A_REG - postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,A_REG);
@@ -1993,7 +1886,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case	CMPA_E: //B1
-		postbyte=MemRead8(MemRead16(pc.Reg));
+		postbyte=MemRead8(MemFetch16(pc.Reg));
 		temp8= A_REG-postbyte;
 		cc[C]= temp8 > A_REG;
 		cc[V]= OTEST8(cc[C],postbyte,temp8,A_REG);
@@ -2004,7 +1897,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SBCA_E: //B2
-		postbyte=MemRead8(MemRead16(pc.Reg));
+		postbyte=MemRead8(MemFetch16(pc.Reg));
 		temp16=A_REG-postbyte-cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,A_REG);
@@ -2016,7 +1909,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SUBD_E: //B3
-		temp16=MemRead16(MemRead16(pc.Reg));
+		temp16=MemRead16(MemFetch16(pc.Reg));
 		temp32=D_REG-temp16;
 		cc[C]= (temp32 & 0x10000)>>16;
 		cc[V]= OTEST16(cc[C],temp32,temp16,D_REG);
@@ -2028,7 +1921,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ANDA_E: //B4
-		postbyte=MemRead8(MemRead16(pc.Reg));
+		postbyte=MemRead8(MemFetch16(pc.Reg));
 		A_REG = A_REG & postbyte;
 		cc[N]= NTEST8(A_REG);
 		cc[Z]= ZTEST(A_REG);
@@ -2038,7 +1931,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case BITA_E: //B5
-		temp8 = A_REG & MemRead8(MemRead16(pc.Reg));
+		temp8 = A_REG & MemRead8(MemFetch16(pc.Reg));
 		cc[N]= NTEST8(temp8);
 		cc[Z]= ZTEST(temp8);
 		cc[V]= false;
@@ -2047,7 +1940,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDA_E: //B6
-		A_REG= MemRead8(MemRead16(pc.Reg));
+		A_REG= MemRead8(MemFetch16(pc.Reg));
 		cc[Z]= ZTEST(A_REG);
 		cc[N]= NTEST8(A_REG);
 		cc[V]= false;
@@ -2056,7 +1949,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STA_E: //B7
-		MemWrite8(A_REG,MemRead16(pc.Reg));
+		MemWrite8(A_REG,MemFetch16(pc.Reg));
 		cc[Z]= ZTEST(A_REG);
 		cc[N]= NTEST8(A_REG);
 		cc[V]= false;
@@ -2065,7 +1958,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case EORA_E:  //B8
-		A_REG = A_REG ^ MemRead8(MemRead16(pc.Reg));
+		A_REG = A_REG ^ MemRead8(MemFetch16(pc.Reg));
 		cc[N]= NTEST8(A_REG);
 		cc[Z]= ZTEST(A_REG);
 		cc[V]= false;
@@ -2074,7 +1967,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADCA_E: //B9
-		postbyte=MemRead8(MemRead16(pc.Reg));
+		postbyte=MemRead8(MemFetch16(pc.Reg));
 		temp16= A_REG + postbyte + cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,A_REG);
@@ -2087,7 +1980,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ORA_E: //BA
-		A_REG = A_REG | MemRead8(MemRead16(pc.Reg));
+		A_REG = A_REG | MemRead8(MemFetch16(pc.Reg));
 		cc[N]= NTEST8(A_REG);
 		cc[Z]= ZTEST(A_REG);
 		cc[V]= false;
@@ -2096,7 +1989,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADDA_E: //BB
-		postbyte=MemRead8(MemRead16(pc.Reg));
+		postbyte=MemRead8(MemFetch16(pc.Reg));
 		temp16=A_REG+postbyte;
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[H]= ((A_REG ^ postbyte ^ temp16) & 0x10)>>4;
@@ -2109,7 +2002,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case CMPX_E: //BC
-		postword=MemRead16(MemRead16(pc.Reg));
+		postword=MemRead16(MemFetch16(pc.Reg));
 		temp16 = x.Reg-postword;
 		cc[C]= temp16 > x.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,X_REG);
@@ -2120,7 +2013,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case BSR_E: //BD
-		postword=MemRead16(pc.Reg);
+		postword=MemFetch16(pc.Reg);
 		pc.Reg+=2;
 		s.Reg--;
 		MemWrite8(pc.B.lsb,s.Reg--);
@@ -2130,7 +2023,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDX_E: //BE
-		x.Reg=MemRead16(MemRead16(pc.Reg));
+		x.Reg=MemRead16(MemFetch16(pc.Reg));
 		cc[Z]= ZTEST(x.Reg);
 		cc[N]= NTEST16(x.Reg);
 		cc[V]= false;
@@ -2139,7 +2032,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STX_E: //BF
-		MemWrite16(x.Reg,MemRead16(pc.Reg));
+		MemWrite16(x.Reg,MemFetch16(pc.Reg));
 		cc[Z]= ZTEST(x.Reg);
 		cc[N]= NTEST16(x.Reg);
 		cc[V]= false;
@@ -2148,7 +2041,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SUBB_M: //C0
-		postbyte=MemRead8(pc.Reg++);
+		postbyte=MemFetch8(pc.Reg++);
 		temp16 = B_REG - postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,B_REG);
@@ -2159,7 +2052,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case CMPB_M: //C1
-		postbyte=MemRead8(pc.Reg++);
+		postbyte=MemFetch8(pc.Reg++);
 		temp8= B_REG-postbyte;
 		cc[C]= temp8 > B_REG;
 		cc[V]= OTEST8(cc[C],postbyte,temp8,B_REG);
@@ -2169,7 +2062,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SBCB_M: //C3
-		postbyte=MemRead8(pc.Reg++);
+		postbyte=MemFetch8(pc.Reg++);
 		temp16=B_REG-postbyte-cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,B_REG);
@@ -2180,7 +2073,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADDD_M: //C3
-		temp16=MemRead16(pc.Reg);
+		temp16=MemFetch16(pc.Reg);
 		temp32= D_REG+ temp16;
 		cc[C]= (temp32 & 0x10000)>>16;
 		cc[V]= OTEST16(cc[C],temp32,temp16,D_REG);
@@ -2192,7 +2085,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ANDB_M: //C4
-		B_REG = B_REG & MemRead8(pc.Reg++);
+		B_REG = B_REG & MemFetch8(pc.Reg++);
 		cc[N]= NTEST8(B_REG);
 		cc[Z]= ZTEST(B_REG);
 		cc[V] = false;
@@ -2200,7 +2093,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case BITB_M: //C5
-		temp8 = B_REG & MemRead8(pc.Reg++);
+		temp8 = B_REG & MemFetch8(pc.Reg++);
 		cc[N]= NTEST8(temp8);
 		cc[Z]= ZTEST(temp8);
 		cc[V]= false;
@@ -2208,7 +2101,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDB_M: //C6
-		B_REG=MemRead8(pc.Reg++);
+		B_REG=MemFetch8(pc.Reg++);
 		cc[Z]= ZTEST(B_REG);
 		cc[N]= NTEST8(B_REG);
 		cc[V]= false;
@@ -2216,7 +2109,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case EORB_M: //C8
-		B_REG = B_REG ^ MemRead8(pc.Reg++);
+		B_REG = B_REG ^ MemFetch8(pc.Reg++);
 		cc[N]=NTEST8(B_REG);
 		cc[Z] = ZTEST(B_REG);
 		cc[V] = false;
@@ -2224,7 +2117,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADCB_M: //C9
-		postbyte=MemRead8(pc.Reg++);
+		postbyte=MemFetch8(pc.Reg++);
 		temp16= B_REG + postbyte + cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,B_REG);
@@ -2236,7 +2129,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ORB_M: //CA
-		B_REG = B_REG | MemRead8(pc.Reg++);
+		B_REG = B_REG | MemFetch8(pc.Reg++);
 		cc[N]= NTEST8(B_REG);
 		cc[Z] = ZTEST(B_REG);
 		cc[V] = false;
@@ -2244,7 +2137,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADDB_M: //CB
-		postbyte=MemRead8(pc.Reg++);
+		postbyte=MemFetch8(pc.Reg++);
 		temp16=B_REG+postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[H]= ((B_REG ^ postbyte ^ temp16) & 0x10)>>4;
@@ -2256,7 +2149,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDD_M: //CC
-		D_REG=MemRead16(pc.Reg);
+		D_REG=MemFetch16(pc.Reg);
 		cc[Z]= ZTEST(D_REG);
 		cc[N]= NTEST16(D_REG);
 		cc[V]= false;
@@ -2265,7 +2158,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDU_M: //CE
-		u.Reg=MemRead16(pc.Reg);
+		u.Reg=MemFetch16(pc.Reg);
 		cc[Z]= ZTEST(u.Reg);
 		cc[N]= NTEST16(u.Reg);
 		cc[V]= false;
@@ -2274,7 +2167,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SUBB_D: //D0
-		postbyte=MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		postbyte=MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		temp16 = B_REG - postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,B_REG);
@@ -2285,7 +2178,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case CMPB_D: //D1
-		postbyte=MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		postbyte=MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		temp8= B_REG-postbyte;
 		cc[C]= temp8 > B_REG;
 		cc[V]= OTEST8(cc[C],postbyte,temp8,B_REG);
@@ -2295,7 +2188,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SBCB_D: //D2
-		postbyte=MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		postbyte=MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		temp16=B_REG-postbyte-cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,B_REG);
@@ -2306,7 +2199,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADDD_D: //D3
-		temp16=MemRead16(dp.Reg |MemRead8(pc.Reg++));
+		temp16=MemRead16(dp.Reg |MemFetch8(pc.Reg++));
 		temp32= D_REG+ temp16;
 		cc[C]=(temp32 & 0x10000)>>16;
 		cc[V]= OTEST16(cc[C],temp32,temp16,D_REG);
@@ -2317,7 +2210,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ANDB_D: //D4
-		B_REG = B_REG & MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		B_REG = B_REG & MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		cc[N]=NTEST8(B_REG);
 		cc[Z] = ZTEST(B_REG);
 		cc[V] = false;
@@ -2325,7 +2218,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case BITB_D: //D5
-		temp8 = B_REG & MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		temp8 = B_REG & MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		cc[N]= NTEST8(temp8);
 		cc[Z] = ZTEST(temp8);
 		cc[V] = false;
@@ -2333,7 +2226,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDB_D: //D6
-		B_REG=MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		B_REG=MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		cc[Z] = ZTEST(B_REG);
 		cc[N]= NTEST8(B_REG);
 		cc[V] = false;
@@ -2341,7 +2234,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STB_D: //D7
-		MemWrite8( B_REG,(dp.Reg |MemRead8(pc.Reg++)));
+		MemWrite8( B_REG,(dp.Reg |MemFetch8(pc.Reg++)));
 		cc[Z] = ZTEST(B_REG);
 		cc[N]= NTEST8(B_REG);
 		cc[V] = false;
@@ -2349,7 +2242,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case EORB_D: //D8
-		B_REG = B_REG ^ MemRead8(dp.Reg | MemRead8(pc.Reg++));
+		B_REG = B_REG ^ MemRead8(dp.Reg | MemFetch8(pc.Reg++));
 		cc[N]= NTEST8(B_REG);
 		cc[Z] = ZTEST(B_REG);
 		cc[V] = false;
@@ -2357,7 +2250,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADCB_D: //D9
-		postbyte=MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		postbyte=MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		temp16= B_REG + postbyte + cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,B_REG);
@@ -2369,7 +2262,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ORB_D: //DA
-		B_REG = B_REG | MemRead8(dp.Reg | MemRead8(pc.Reg++));
+		B_REG = B_REG | MemRead8(dp.Reg | MemFetch8(pc.Reg++));
 		cc[N]= NTEST8(B_REG);
 		cc[Z] = ZTEST(B_REG);
 		cc[V] = false;
@@ -2377,7 +2270,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADDB_D: //DB
-		postbyte=MemRead8(dp.Reg |MemRead8(pc.Reg++));
+		postbyte=MemRead8(dp.Reg |MemFetch8(pc.Reg++));
 		temp16=B_REG+postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[H]= ((B_REG ^ postbyte ^ temp16) & 0x10)>>4;
@@ -2389,7 +2282,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDD_D: //DC
-		D_REG=MemRead16(dp.Reg | MemRead8(pc.Reg++));
+		D_REG=MemRead16(dp.Reg | MemFetch8(pc.Reg++));
 		cc[Z]= ZTEST(D_REG);
 		cc[N]= NTEST16(D_REG);
 		cc[V]= false;
@@ -2397,7 +2290,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STD_D: //DD
-		MemWrite16(D_REG,(dp.Reg |MemRead8(pc.Reg++)));
+		MemWrite16(D_REG,(dp.Reg |MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(D_REG);
 		cc[N]= NTEST16(D_REG);
 		cc[V]= false;
@@ -2405,7 +2298,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDU_D: //DE
-		u.Reg=MemRead16(dp.Reg |MemRead8(pc.Reg++));
+		u.Reg=MemRead16(dp.Reg |MemFetch8(pc.Reg++));
 		cc[Z]= ZTEST(u.Reg);
 		cc[N]= NTEST16(u.Reg);
 		cc[V]= false;
@@ -2413,7 +2306,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STU_D: //DF
-		MemWrite16(u.Reg,(dp.Reg |MemRead8(pc.Reg++)));
+		MemWrite16(u.Reg,(dp.Reg |MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(u.Reg);
 		cc[N]= NTEST16(u.Reg);
 		cc[V]= false;
@@ -2421,7 +2314,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SUBB_X: //E0
-		postbyte=MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		postbyte=MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		temp16 = B_REG - postbyte;
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,B_REG);
@@ -2432,7 +2325,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case CMPB_X: //E1
-		postbyte=MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		postbyte=MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		temp8= B_REG-postbyte;
 		cc[C]= temp8 > B_REG;
 		cc[V]= OTEST8(cc[C],postbyte,temp8,B_REG);
@@ -2442,7 +2335,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SBCB_X: //E2
-		postbyte=MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		postbyte=MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		temp16=B_REG-postbyte-cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,B_REG);
@@ -2453,7 +2346,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADDD_X: //E3
-		temp16=MemRead16(CalculateEA(MemRead8(pc.Reg++)));
+		temp16=MemRead16(CalculateEA(MemFetch8(pc.Reg++)));
 		temp32= D_REG+ temp16;
 		cc[C]=(temp32 & 0x10000)>>16;
 		cc[V]= OTEST16(cc[C],temp32,temp16,D_REG);
@@ -2464,7 +2357,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ANDB_X: //E4
-		B_REG = B_REG & MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		B_REG = B_REG & MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[N]= NTEST8(B_REG);
 		cc[Z]= ZTEST(B_REG);
 		cc[V]= false;
@@ -2472,7 +2365,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case BITB_X: //E5
-		temp8 = B_REG & MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		temp8 = B_REG & MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[N]= NTEST8(temp8);
 		cc[Z]= ZTEST(temp8);
 		cc[V] = false;
@@ -2480,7 +2373,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDB_X: //E6
-		B_REG=MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		B_REG=MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(B_REG);
 		cc[N]= NTEST8(B_REG);
 		cc[V]= false;
@@ -2488,7 +2381,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STB_X: //E7
-		MemWrite8(B_REG,CalculateEA(MemRead8(pc.Reg++)));
+		MemWrite8(B_REG,CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(B_REG);
 		cc[N]= NTEST8(B_REG);
 		cc[V]= false;
@@ -2496,7 +2389,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case EORB_X: //E8
-		temp8=MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		temp8=MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		B_REG= B_REG ^ temp8;
 		cc[N]= NTEST8(B_REG);
 		cc[Z] = ZTEST(B_REG);
@@ -2505,7 +2398,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADCB_X: //E9
-		postbyte=MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		postbyte=MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		temp16= B_REG + postbyte + cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,B_REG);
@@ -2517,7 +2410,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ORB_X: //EA
-		B_REG = B_REG | MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		B_REG = B_REG | MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[N]= NTEST8(B_REG);
 		cc[Z] = ZTEST(B_REG);
 		cc[V] = false;
@@ -2525,7 +2418,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADDB_X: //EB
-		postbyte=MemRead8(CalculateEA(MemRead8(pc.Reg++)));
+		postbyte=MemRead8(CalculateEA(MemFetch8(pc.Reg++)));
 		temp16=B_REG+postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[H]= ((B_REG ^ postbyte ^ temp16) & 0x10)>>4;
@@ -2537,7 +2430,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDD_X: //EC
-		temp16=CalculateEA(MemRead8(pc.Reg++));
+		temp16=CalculateEA(MemFetch8(pc.Reg++));
 		D_REG=MemRead16(temp16);
 		cc[Z]= ZTEST(D_REG);
 		cc[N]= NTEST16(D_REG);
@@ -2546,7 +2439,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STD_X: //ED
-		MemWrite16(D_REG,CalculateEA(MemRead8(pc.Reg++)));
+		MemWrite16(D_REG,CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(D_REG);
 		cc[N]= NTEST16(D_REG);
 		cc[V] = false;
@@ -2554,7 +2447,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDU_X: //EE
-		u.Reg=MemRead16(CalculateEA(MemRead8(pc.Reg++)));
+		u.Reg=MemRead16(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z] = ZTEST(u.Reg);
 		cc[N]=NTEST16(u.Reg);
 		cc[V] = false;
@@ -2562,7 +2455,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STU_X: //EF
-		MemWrite16(u.Reg,CalculateEA(MemRead8(pc.Reg++)));
+		MemWrite16(u.Reg,CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z] = ZTEST(u.Reg);
 		cc[N]=NTEST16(u.Reg);
 		cc[V] = false;
@@ -2570,7 +2463,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SUBB_E: //F0
-		postbyte=MemRead8(MemRead16(pc.Reg));
+		postbyte=MemRead8(MemFetch16(pc.Reg));
 		temp16 = B_REG - postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,B_REG);
@@ -2582,7 +2475,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case CMPB_E: //F1
-		postbyte=MemRead8(MemRead16(pc.Reg));
+		postbyte=MemRead8(MemFetch16(pc.Reg));
 		temp8= B_REG-postbyte;
 		cc[C]= temp8 > B_REG;
 		cc[V]= OTEST8(cc[C],postbyte,temp8,B_REG);
@@ -2593,7 +2486,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case SBCB_E: //F2
-		postbyte=MemRead8(MemRead16(pc.Reg));
+		postbyte=MemRead8(MemFetch16(pc.Reg));
 		temp16=B_REG-postbyte-cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,B_REG);
@@ -2605,7 +2498,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADDD_E: //F3
-		temp16=MemRead16(MemRead16(pc.Reg));
+		temp16=MemRead16(MemFetch16(pc.Reg));
 		temp32= D_REG+ temp16;
 		cc[C]=(temp32 & 0x10000)>>16;
 		cc[V]= OTEST16(cc[C],temp32,temp16,D_REG);
@@ -2617,7 +2510,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ANDB_E:  //F4
-		B_REG = B_REG & MemRead8(MemRead16(pc.Reg));
+		B_REG = B_REG & MemRead8(MemFetch16(pc.Reg));
 		cc[N]= NTEST8(B_REG);
 		cc[Z]= ZTEST(B_REG);
 		cc[V]= false;
@@ -2626,7 +2519,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case BITB_E: //F5
-		temp8 = B_REG & MemRead8(MemRead16(pc.Reg));
+		temp8 = B_REG & MemRead8(MemFetch16(pc.Reg));
 		cc[N]= NTEST8(temp8);
 		cc[Z]= ZTEST(temp8);
 		cc[V]= false;
@@ -2635,7 +2528,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDB_E: //F6
-		B_REG=MemRead8(MemRead16(pc.Reg));
+		B_REG=MemRead8(MemFetch16(pc.Reg));
 		cc[Z] = ZTEST(B_REG);
 		cc[N]= NTEST8(B_REG);
 		cc[V] = false;
@@ -2644,7 +2537,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STB_E: //F7
-		MemWrite8(B_REG,MemRead16(pc.Reg));
+		MemWrite8(B_REG,MemFetch16(pc.Reg));
 		cc[Z] = ZTEST(B_REG);
 		cc[N] = NTEST8(B_REG);
 		cc[V] = false;
@@ -2653,7 +2546,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case EORB_E: //F8
-		B_REG = B_REG ^ MemRead8(MemRead16(pc.Reg));
+		B_REG = B_REG ^ MemRead8(MemFetch16(pc.Reg));
 		cc[N]= NTEST8(B_REG);
 		cc[Z] = ZTEST(B_REG);
 		cc[V] = false;
@@ -2662,7 +2555,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADCB_E: //F9
-		postbyte=MemRead8(MemRead16(pc.Reg));
+		postbyte=MemRead8(MemFetch16(pc.Reg));
 		temp16= B_REG + postbyte + cc[C];
 		cc[C]= (temp16 & 0x100)>>8;
 		cc[V]= OTEST8(cc[C],postbyte,temp16,B_REG);
@@ -2675,7 +2568,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ORB_E: //FA
-		B_REG = B_REG | MemRead8(MemRead16(pc.Reg));
+		B_REG = B_REG | MemRead8(MemFetch16(pc.Reg));
 		cc[N]= NTEST8(B_REG);
 		cc[Z] = ZTEST(B_REG);
 		cc[V] = false;
@@ -2684,7 +2577,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case ADDB_E: //FB
-		postbyte=MemRead8(MemRead16(pc.Reg));
+		postbyte=MemRead8(MemFetch16(pc.Reg));
 		temp16=B_REG+postbyte;
 		cc[C]=(temp16 & 0x100)>>8;
 		cc[H]= ((B_REG ^ postbyte ^ temp16) & 0x10)>>4;
@@ -2697,7 +2590,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDD_E: //FC
-		D_REG=MemRead16(MemRead16(pc.Reg));
+		D_REG=MemRead16(MemFetch16(pc.Reg));
 		cc[Z]= ZTEST(D_REG);
 		cc[N]= NTEST16(D_REG);
 		cc[V]= false;
@@ -2706,7 +2599,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STD_E: //FD
-		MemWrite16(D_REG,MemRead16(pc.Reg));
+		MemWrite16(D_REG,MemFetch16(pc.Reg));
 		cc[Z]= ZTEST(D_REG);
 		cc[N]=NTEST16(D_REG);
 		cc[V] = false;
@@ -2715,7 +2608,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case LDU_E: //FE
-		u.Reg=MemRead16(MemRead16(pc.Reg));
+		u.Reg=MemRead16(MemFetch16(pc.Reg));
 		cc[Z] = ZTEST(u.Reg);
 		cc[N]= NTEST16(u.Reg);
 		cc[V] = false;
@@ -2724,7 +2617,7 @@ void Do_Opcode(int CycleFor)
 		break;
 
 	case STU_E: //FF
-		MemWrite16(u.Reg,MemRead16(pc.Reg));
+		MemWrite16(u.Reg,MemFetch16(pc.Reg));
 		cc[Z] = ZTEST(u.Reg);
 		cc[N]= NTEST16(u.Reg);
 		cc[V] = false;
@@ -2741,12 +2634,12 @@ void Do_Opcode(int CycleFor)
 
 void P2_Opcode()
 {
-	switch (MemRead8(pc.Reg++)) {
+	switch (MemFetch8(pc.Reg++)) {
 
 	case LBEQ_R: //1027
 		if (cc[Z])
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2762,7 +2655,7 @@ void P2_Opcode()
 	case LBHI_R: //1022
 		if  (!(cc[C] | cc[Z]))
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2773,7 +2666,7 @@ void P2_Opcode()
 	case LBLS_R: //1023
 		if (cc[C] | cc[Z])
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2784,7 +2677,7 @@ void P2_Opcode()
 	case LBHS_R: //1024
 		if (!cc[C])
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2795,7 +2688,7 @@ void P2_Opcode()
 	case LBCS_R: //1025
 		if (cc[C])
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2806,7 +2699,7 @@ void P2_Opcode()
 	case LBNE_R: //1026
 		if (!cc[Z])
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2817,7 +2710,7 @@ void P2_Opcode()
 	case LBVC_R: //1028
 		if ( !cc[V])
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2828,7 +2721,7 @@ void P2_Opcode()
 	case LBVS_R: //1029
 		if ( cc[V])
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2839,7 +2732,7 @@ void P2_Opcode()
 	case LBPL_R: //102A
 		if (!cc[N])
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2850,7 +2743,7 @@ void P2_Opcode()
 	case LBMI_R: //102B
 		if ( cc[N])
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2861,7 +2754,7 @@ void P2_Opcode()
 	case LBGE_R: //102C
 		if (! (cc[N] ^ cc[V]))
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2872,7 +2765,7 @@ void P2_Opcode()
 	case LBLT_R: //102D
 		if ( cc[V] ^ cc[N])
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2883,7 +2776,7 @@ void P2_Opcode()
 	case LBGT_R: //102E
 		if ( !( cc[Z] | (cc[N]^cc[V] ) ))
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2894,7 +2787,7 @@ void P2_Opcode()
 	case LBLE_R:	//102F
 		if ( cc[Z] | (cc[N]^cc[V]) )
 		{
-			*spostword=MemRead16(pc.Reg);
+			*spostword=MemFetch16(pc.Reg);
 			pc.Reg+=*spostword;
 			CycleCounter+=1;
 		}
@@ -2904,24 +2797,13 @@ void P2_Opcode()
 
 	case SWI2_I: //103F
 		cc[E]=true;
-		MemWrite8( pc.B.lsb,--s.Reg);
-		MemWrite8( pc.B.msb,--s.Reg);
-		MemWrite8( u.B.lsb,--s.Reg);
-		MemWrite8( u.B.msb,--s.Reg);
-		MemWrite8( y.B.lsb,--s.Reg);
-		MemWrite8( y.B.msb,--s.Reg);
-		MemWrite8( x.B.lsb,--s.Reg);
-		MemWrite8( x.B.msb,--s.Reg);
-		MemWrite8( dp.B.msb,--s.Reg);
-		MemWrite8(B_REG,--s.Reg);
-		MemWrite8(A_REG,--s.Reg);
-		MemWrite8(get_cc_flags(),--s.Reg);
+		PushRegisters(s,0xFF,u);
 		pc.Reg=MemRead16(VSWI2);
 		CycleCounter+=20;
 		break;
 
 	case CMPD_M: //1083
-		postword=MemRead16(pc.Reg);
+		postword=MemFetch16(pc.Reg);
 		temp16 = D_REG-postword;
 		cc[C]= temp16 > D_REG;
 		cc[V]= OTEST16(cc[C],postword,temp16,D_REG);
@@ -2932,7 +2814,7 @@ void P2_Opcode()
 		break;
 
 	case CMPY_M: //108C
-		postword=MemRead16(pc.Reg);
+		postword=MemFetch16(pc.Reg);
 		temp16 = y.Reg-postword;
 		cc[C]= temp16 > y.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,y.Reg);
@@ -2943,7 +2825,7 @@ void P2_Opcode()
 		break;
 
 	case LDY_M: //108E
-		y.Reg= MemRead16(pc.Reg);
+		y.Reg= MemFetch16(pc.Reg);
 		cc[Z]= ZTEST(y.Reg);
 		cc[N]= NTEST16(y.Reg);
 		cc[V]= false;
@@ -2952,7 +2834,7 @@ void P2_Opcode()
 		break;
 
 	case CMPD_D: //1093
-		postword=MemRead16(dp.Reg |MemRead8(pc.Reg++));
+		postword=MemRead16(dp.Reg |MemFetch8(pc.Reg++));
 		temp16= D_REG - postword ;
 		cc[C]= temp16 > D_REG;
 		cc[V]= OTEST16(cc[C],postword,temp16,D_REG);
@@ -2962,7 +2844,7 @@ void P2_Opcode()
 		break;
 
 	case CMPY_D:	//109C
-		postword=MemRead16(dp.Reg |MemRead8(pc.Reg++));
+		postword=MemRead16(dp.Reg |MemFetch8(pc.Reg++));
 		temp16= y.Reg - postword ;
 		cc[C]= temp16 > y.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,y.Reg);
@@ -2972,7 +2854,7 @@ void P2_Opcode()
 		break;
 
 	case LDY_D: //109E
-		y.Reg=MemRead16(dp.Reg |MemRead8(pc.Reg++));
+		y.Reg=MemRead16(dp.Reg |MemFetch8(pc.Reg++));
 		cc[Z]= ZTEST(y.Reg);
 		cc[N]= NTEST16(y.Reg);
 		cc[V]= false;
@@ -2980,7 +2862,7 @@ void P2_Opcode()
 		break;
 
 	case STY_D: //109F
-		MemWrite16(y.Reg,(dp.Reg |MemRead8(pc.Reg++)));
+		MemWrite16(y.Reg,(dp.Reg |MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(y.Reg);
 		cc[N]= NTEST16(y.Reg);
 		cc[V]= false;
@@ -2988,7 +2870,7 @@ void P2_Opcode()
 		break;
 
 	case CMPD_X: //10A3
-		postword=MemRead16(CalculateEA(MemRead8(pc.Reg++)));
+		postword=MemRead16(CalculateEA(MemFetch8(pc.Reg++)));
 		temp16= D_REG - postword ;
 		cc[C]= temp16 > D_REG;
 		cc[V]= OTEST16(cc[C],postword,temp16,D_REG);
@@ -2998,7 +2880,7 @@ void P2_Opcode()
 		break;
 
 	case CMPY_X: //10AC
-		postword=MemRead16(CalculateEA(MemRead8(pc.Reg++)));
+		postword=MemRead16(CalculateEA(MemFetch8(pc.Reg++)));
 		temp16= y.Reg - postword ;
 		cc[C]= temp16 > y.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,Y_REG);
@@ -3008,7 +2890,7 @@ void P2_Opcode()
 		break;
 
 	case LDY_X: //10AE
-		y.Reg=MemRead16(CalculateEA(MemRead8(pc.Reg++)));
+		y.Reg=MemRead16(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(y.Reg);
 		cc[N]= NTEST16(y.Reg);
 		cc[V]= false;
@@ -3016,7 +2898,7 @@ void P2_Opcode()
 		break;
 
 	case STY_X: //10AF
-		MemWrite16(y.Reg,CalculateEA(MemRead8(pc.Reg++)));
+		MemWrite16(y.Reg,CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(y.Reg);
 		cc[N]= NTEST16(y.Reg);
 		cc[V]= false;
@@ -3024,7 +2906,7 @@ void P2_Opcode()
 		break;
 
 	case CMPD_E: //10B3
-		postword=MemRead16(MemRead16(pc.Reg));
+		postword=MemRead16(MemFetch16(pc.Reg));
 		temp16 = D_REG-postword;
 		cc[C]= temp16 > D_REG;
 		cc[V]= OTEST16(cc[C],postword,temp16,D_REG);
@@ -3035,7 +2917,7 @@ void P2_Opcode()
 		break;
 
 	case CMPY_E: //10BC
-		postword=MemRead16(MemRead16(pc.Reg));
+		postword=MemRead16(MemFetch16(pc.Reg));
 		temp16 = y.Reg-postword;
 		cc[C]= temp16 > y.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,Y_REG);
@@ -3046,7 +2928,7 @@ void P2_Opcode()
 		break;
 
 	case LDY_E: //10BE
-		y.Reg=MemRead16(MemRead16(pc.Reg));
+		y.Reg=MemRead16(MemFetch16(pc.Reg));
 		cc[Z]= ZTEST(y.Reg);
 		cc[N]= NTEST16(y.Reg);
 		cc[V]= false;
@@ -3055,7 +2937,7 @@ void P2_Opcode()
 		break;
 
 	case STY_E: //10BF
-		MemWrite16(y.Reg,MemRead16(pc.Reg));
+		MemWrite16(y.Reg,MemFetch16(pc.Reg));
 		cc[Z]= ZTEST(y.Reg);
 		cc[N]= NTEST16(y.Reg);
 		cc[V]= false;
@@ -3064,7 +2946,7 @@ void P2_Opcode()
 		break;
 
 	case LDS_I:  //10CE
-		s.Reg=MemRead16(pc.Reg);
+		s.Reg=MemFetch16(pc.Reg);
 		cc[Z]= ZTEST(s.Reg);
 		cc[N]= NTEST16(s.Reg);
 		cc[V] = false;
@@ -3073,7 +2955,7 @@ void P2_Opcode()
 		break;
 
 	case LDS_D: //10DE
-		s.Reg=MemRead16(dp.Reg |MemRead8(pc.Reg++));
+		s.Reg=MemRead16(dp.Reg |MemFetch8(pc.Reg++));
 		cc[Z]= ZTEST(s.Reg);
 		cc[N]= NTEST16(s.Reg);
 		cc[V] = false;
@@ -3081,7 +2963,7 @@ void P2_Opcode()
 		break;
 
 	case STS_D: //10DF
-		MemWrite16(s.Reg,(dp.Reg |MemRead8(pc.Reg++)));
+		MemWrite16(s.Reg,(dp.Reg |MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(s.Reg);
 		cc[N]= NTEST16(s.Reg);
 		cc[V]= false;
@@ -3089,7 +2971,7 @@ void P2_Opcode()
 		break;
 
 	case LDS_X: //10EE
-		s.Reg=MemRead16(CalculateEA(MemRead8(pc.Reg++)));
+		s.Reg=MemRead16(CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(s.Reg);
 		cc[N]= NTEST16(s.Reg);
 		cc[V]= false;
@@ -3097,7 +2979,7 @@ void P2_Opcode()
 		break;
 
 	case STS_X: //10EF
-		MemWrite16(s.Reg,CalculateEA(MemRead8(pc.Reg++)));
+		MemWrite16(s.Reg,CalculateEA(MemFetch8(pc.Reg++)));
 		cc[Z]= ZTEST(s.Reg);
 		cc[N]= NTEST16(s.Reg);
 		cc[V]= false;
@@ -3105,7 +2987,7 @@ void P2_Opcode()
 		break;
 
 	case LDS_E: //10FE
-		s.Reg=MemRead16(MemRead16(pc.Reg));
+		s.Reg=MemRead16(MemFetch16(pc.Reg));
 		cc[Z]= ZTEST(s.Reg);
 		cc[N]= NTEST16(s.Reg);
 		cc[V]= false;
@@ -3114,7 +2996,7 @@ void P2_Opcode()
 		break;
 
 	case STS_E: //10FF
-		MemWrite16(s.Reg,MemRead16(pc.Reg));
+		MemWrite16(s.Reg,MemFetch16(pc.Reg));
 		cc[Z] = ZTEST(s.Reg);
 		cc[N]= NTEST16(s.Reg);
 		cc[V] = false;
@@ -3130,7 +3012,7 @@ void P2_Opcode()
 void P3_Opcode()
 {
 
-	switch (MemRead8(pc.Reg++)) {
+	switch (MemFetch8(pc.Reg++)) {
 
 	case BREAK: //113E
 		if (EmuState.Debugger.Break_Enabled()) {
@@ -3143,24 +3025,13 @@ void P3_Opcode()
 
 	case SWI3_I: //113F
 		cc[E]=true;
-		MemWrite8( pc.B.lsb,--s.Reg);
-		MemWrite8( pc.B.msb,--s.Reg);
-		MemWrite8( u.B.lsb,--s.Reg);
-		MemWrite8( u.B.msb,--s.Reg);
-		MemWrite8( y.B.lsb,--s.Reg);
-		MemWrite8( y.B.msb,--s.Reg);
-		MemWrite8( x.B.lsb,--s.Reg);
-		MemWrite8( x.B.msb,--s.Reg);
-		MemWrite8( dp.B.msb,--s.Reg);
-		MemWrite8(B_REG,--s.Reg);
-		MemWrite8(A_REG,--s.Reg);
-		MemWrite8(get_cc_flags(),--s.Reg);
+		PushRegisters(s,0xFF,u);
 		pc.Reg=MemRead16(VSWI3);
 		CycleCounter+=20;
 		break;
 
 	case CMPU_M: //1183
-		postword=MemRead16(pc.Reg);
+		postword=MemFetch16(pc.Reg);
 		temp16 = u.Reg-postword;
 		cc[C]= temp16 > u.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,U_REG);
@@ -3171,7 +3042,7 @@ void P3_Opcode()
 		break;
 
 	case CMPS_M: //118C
-		postword=MemRead16(pc.Reg);
+		postword=MemFetch16(pc.Reg);
 		temp16 = s.Reg-postword;
 		cc[C]= temp16 > s.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,S_REG);
@@ -3182,7 +3053,7 @@ void P3_Opcode()
 		break;
 
 	case CMPU_D: //1193
-		postword=MemRead16(dp.Reg |MemRead8(pc.Reg++));
+		postword=MemRead16(dp.Reg |MemFetch8(pc.Reg++));
 		temp16= u.Reg - postword ;
 		cc[C]= temp16 > u.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,U_REG);
@@ -3192,7 +3063,7 @@ void P3_Opcode()
 		break;
 
 	case CMPS_D: //119C
-		postword=MemRead16(dp.Reg |MemRead8(pc.Reg++));
+		postword=MemRead16(dp.Reg |MemFetch8(pc.Reg++));
 		temp16= s.Reg - postword ;
 		cc[C]= temp16 > s.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,S_REG);
@@ -3202,7 +3073,7 @@ void P3_Opcode()
 		break;
 
 	case CMPU_X: //11A3
-		postword=MemRead16(CalculateEA(MemRead8(pc.Reg++)));
+		postword=MemRead16(CalculateEA(MemFetch8(pc.Reg++)));
 		temp16= u.Reg - postword ;
 		cc[C]= temp16 > u.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,U_REG);
@@ -3212,7 +3083,7 @@ void P3_Opcode()
 		break;
 
 	case CMPS_X:  //11AC
-		postword=MemRead16(CalculateEA(MemRead8(pc.Reg++)));
+		postword=MemRead16(CalculateEA(MemFetch8(pc.Reg++)));
 		temp16= s.Reg - postword ;
 		cc[C]= temp16 > s.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,S_REG);
@@ -3222,7 +3093,7 @@ void P3_Opcode()
 		break;
 
 	case CMPU_E: //11B3
-		postword=MemRead16(MemRead16(pc.Reg));
+		postword=MemRead16(MemFetch16(pc.Reg));
 		temp16 = u.Reg-postword;
 		cc[C]= temp16 > u.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,U_REG);
@@ -3233,7 +3104,7 @@ void P3_Opcode()
 		break;
 
 	case CMPS_E: //11BC
-		postword=MemRead16(MemRead16(pc.Reg));
+		postword=MemRead16(MemFetch16(pc.Reg));
 		temp16 = s.Reg-postword;
 		cc[C]= temp16 > s.Reg;
 		cc[V]= OTEST16(cc[C],postword,temp16,S_REG);
@@ -3261,9 +3132,7 @@ void cpu_firq()
 
 		InInterupt=1; //Flag to indicate FIRQ has been asserted
 		cc[E]=0; // Turn E flag off
-		MemWrite8( pc.B.lsb,--s.Reg);
-		MemWrite8( pc.B.msb,--s.Reg);
-		MemWrite8(get_cc_flags(),--s.Reg);
+		PushRegisters(s,0x81,u);
 		cc[I]=1;
 		cc[F]=1;
 		pc.Reg=MemRead16(VFIRQ);
@@ -3299,18 +3168,7 @@ void cpu_irq()
 		}
 
 		cc[E]=1;
-		MemWrite8( pc.B.lsb,--s.Reg);
-		MemWrite8( pc.B.msb,--s.Reg);
-		MemWrite8( u.B.lsb,--s.Reg);
-		MemWrite8( u.B.msb,--s.Reg);
-		MemWrite8( y.B.lsb,--s.Reg);
-		MemWrite8( y.B.msb,--s.Reg);
-		MemWrite8( x.B.lsb,--s.Reg);
-		MemWrite8( x.B.msb,--s.Reg);
-		MemWrite8( dp.B.msb,--s.Reg);
-		MemWrite8(B_REG,--s.Reg);
-		MemWrite8(A_REG,--s.Reg);
-		MemWrite8(get_cc_flags(),--s.Reg);
+		PushRegisters(s,0xFF,u);
 
 		pc.Reg=MemRead16(VIRQ);
 		cc[I]=1;
@@ -3341,18 +3199,7 @@ void cpu_nmi()
 	}
 
 	cc[E]=1;
-	MemWrite8( pc.B.lsb,--s.Reg);
-	MemWrite8( pc.B.msb,--s.Reg);
-	MemWrite8( u.B.lsb,--s.Reg);
-	MemWrite8( u.B.msb,--s.Reg);
-	MemWrite8( y.B.lsb,--s.Reg);
-	MemWrite8( y.B.msb,--s.Reg);
-	MemWrite8( x.B.lsb,--s.Reg);
-	MemWrite8( x.B.msb,--s.Reg);
-	MemWrite8( dp.B.msb,--s.Reg);
-	MemWrite8(B_REG,--s.Reg);
-	MemWrite8(A_REG,--s.Reg);
-	MemWrite8(get_cc_flags(),--s.Reg);
+	PushRegisters(s,0xFF,u);
 	cc[I]=1;
 	cc[F]=1;
 	pc.Reg=MemRead16(VNMI);
@@ -3368,6 +3215,92 @@ void cpu_nmi()
 	return;
 }
 
+// Number of stack bytes moved for each nibble of a PSH/PUL postbyte
+static const unsigned char StackNibbleBytes[16]={0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4};
+
+// Stacks the registers selected by postbyte (PSHS/PSHU layout) below sp as one
+// block. other is the opposite stack pointer, U when stacking on S and S when
+// stacking on U. Returns the number of bytes pushed.
+unsigned char PushRegisters(cpuregister &sp,unsigned char postbyte,const cpuregister &other)
+{
+	unsigned char Bytes[12];
+	unsigned char Bottom=sizeof(Bytes);
+	if (postbyte & 0x80)
+	{
+		Bytes[--Bottom]=pc.B.lsb;
+		Bytes[--Bottom]=pc.B.msb;
+	}
+	if (postbyte & 0x40)
+	{
+		Bytes[--Bottom]=other.B.lsb;
+		Bytes[--Bottom]=other.B.msb;
+	}
+	if (postbyte & 0x20)
+	{
+		Bytes[--Bottom]=y.B.lsb;
+		Bytes[--Bottom]=y.B.msb;
+	}
+	if (postbyte & 0x10)
+	{
+		Bytes[--Bottom]=x.B.lsb;
+		Bytes[--Bottom]=x.B.msb;
+	}
+	if (postbyte & 0x08)
+		Bytes[--Bottom]=dp.B.msb;
+	if (postbyte & 0x04)
+		Bytes[--Bottom]=B_REG;
+	if (postbyte & 0x02)
+		Bytes[--Bottom]=A_REG;
+	if (postbyte & 0x01)
+		Bytes[--Bottom]=get_cc_flags();
+
+	const unsigned char Count=sizeof(Bytes)-Bottom;
+	MemPushBlock(Bytes+Bottom,Count,sp.Reg);
+	sp.Reg-=Count;
+	return Count;
+}
+
+// Unstacks the registers selected by postbyte (PULS/PULU layout) from sp.
+// Returns the number of bytes pulled.
+unsigned char PullRegisters(cpuregister &sp,unsigned char postbyte,cpuregister &other)
+{
+	unsigned char Bytes[12];
+	const unsigned char Count=StackNibbleBytes[postbyte & 0x0F]+2*StackNibbleBytes[postbyte>>4];
+	MemPullBlock(Bytes,Count,sp.Reg);
+	sp.Reg+=Count;
+
+	unsigned char Index=0;
+	if (postbyte & 0x01)
+		set_cc_flags(Bytes[Index++]);
+	if (postbyte & 0x02)
+		A_REG=Bytes[Index++];
+	if (postbyte & 0x04)
+		B_REG=Bytes[Index++];
+	if (postbyte & 0x08)
+		dp.B.msb=Bytes[Index++];
+	if (postbyte & 0x10)
+	{
+		x.B.msb=Bytes[Index++];
+		x.B.lsb=Bytes[Index++];
+	}
+	if (postbyte & 0x20)
+	{
+		y.B.msb=Bytes[Index++];
+		y.B.lsb=Bytes[Index++];
+	}
+	if (postbyte & 0x40)
+	{
+		other.B.msb=Bytes[Index++];
+		other.B.lsb=Bytes[Index++];
+	}
+	if (postbyte & 0x80)
+	{
+		pc.B.msb=Bytes[Index++];
+		pc.B.lsb=Bytes[Index++];
+	}
+	return Count;
+}
+
 void set_cc_flags (unsigned char bincc)
 {
 	unsigned char bit;
@@ -3412,6 +3345,92 @@ void MC6809ForcePC(unsigned short NewPC)
 	return;
 }
 
+// Indexed addressing postbyte decode. Every postbyte is resolved at compile
+// time to the way its effective address is formed, so CalculateEA is a single
+// table lookup plus the handler for that addressing mode. Both CPU cores have
+// their own table, so the types stay local to this file.
+namespace {
+
+enum IndexedEAMode : unsigned char
+{
+	EA_OFFSET,		// R + constant or fetched offset (5, 8 and 16 bit, or none)
+	EA_POSTINC1,	// ,R+
+	EA_POSTINC2,	// ,R++
+	EA_PREDEC1,		// ,-R
+	EA_PREDEC2,		// ,--R
+	EA_AOFFSET,		// A,R
+	EA_BOFFSET,		// B,R
+	EA_DOFFSET,		// D,R
+	EA_PCREL,		// n,PCR
+	EA_EXTENDED,	// [n]
+	EA_ILLEGAL		// Undefined postbyte, addresses R
+};
+
+struct IndexedMode
+{
+	IndexedEAMode Mode;
+	unsigned char Register;		// Index into indexableRegisters
+	unsigned char Cycles;		// Extra cycles beyond the base instruction
+	unsigned char OffsetSize;	// Offset bytes following the postbyte
+	bool Indirect;
+	signed char Offset;			// 5 bit offset when OffsetSize is 0
+};
+
+} // namespace
+
+static constexpr IndexedMode DecodeIndexedPostbyte(unsigned char postbyte)
+{
+	const unsigned char Register=(postbyte >> 5) & 3;
+	if (!(postbyte & 0x80))
+		return { EA_OFFSET, Register, 1, 0, false, static_cast<signed char>((postbyte & 0x10) ? (postbyte & 0x1F) - 32 : (postbyte & 0x1F)) };
+
+	switch (postbyte & 0x1F)
+	{
+	case 0:  return { EA_POSTINC1, Register, 2, 0, false, 0 };
+	case 1:  return { EA_POSTINC2, Register, 3, 0, false, 0 };
+	case 2:  return { EA_PREDEC1, Register, 2, 0, false, 0 };
+	case 3:  return { EA_PREDEC2, Register, 3, 0, false, 0 };
+	case 4:  return { EA_OFFSET, Register, 0, 0, false, 0 };
+	case 5:  return { EA_BOFFSET, Register, 1, 0, false, 0 };
+	case 6:  return { EA_AOFFSET, Register, 1, 0, false, 0 };
+	case 7:  return { EA_ILLEGAL, Register, 1, 0, false, 0 };
+	case 8:  return { EA_OFFSET, Register, 1, 1, false, 0 };
+	case 9:  return { EA_OFFSET, Register, 4, 2, false, 0 };
+	case 10: return { EA_ILLEGAL, Register, 1, 0, false, 0 };
+	case 11: return { EA_DOFFSET, Register, 4, 0, false, 0 };
+	case 12: return { EA_PCREL, Register, 1, 1, false, 0 };
+	case 13: return { EA_PCREL, Register, 5, 2, false, 0 };
+	case 14: return { EA_ILLEGAL, Register, 4, 0, false, 0 };
+	case 15:
+	case 16: return { EA_ILLEGAL, Register, 0, static_cast<unsigned char>(Register == 1 ? 2 : 0), false, 0 };
+	case 17: return { EA_POSTINC2, Register, 6, 0, true, 0 };
+	case 18: return { EA_ILLEGAL, Register, 6, 0, false, 0 };
+	case 19: return { EA_PREDEC2, Register, 6, 0, true, 0 };
+	case 20: return { EA_OFFSET, Register, 3, 0, true, 0 };
+	case 21: return { EA_BOFFSET, Register, 4, 0, true, 0 };
+	case 22: return { EA_AOFFSET, Register, 4, 0, true, 0 };
+	case 23: return { EA_ILLEGAL, Register, 4, 0, true, 0 };
+	case 24: return { EA_OFFSET, Register, 4, 1, true, 0 };
+	case 25: return { EA_OFFSET, Register, 7, 2, true, 0 };
+	case 26: return { EA_ILLEGAL, Register, 4, 0, true, 0 };
+	case 27: return { EA_DOFFSET, Register, 7, 0, true, 0 };
+	case 28: return { EA_PCREL, Register, 4, 1, true, 0 };
+	case 29: return { EA_PCREL, Register, 8, 2, true, 0 };
+	case 30: return { EA_ILLEGAL, Register, 7, 0, true, 0 };
+	default: return { EA_EXTENDED, Register, 8, 2, true, 0 };
+	}
+}
+
+static constexpr std::array<IndexedMode, 256> BuildIndexedModes()
+{
+	std::array<IndexedMode, 256> Modes {};
+	for (unsigned int postbyte=0;postbyte<256;postbyte++)
+		Modes[postbyte]=DecodeIndexedPostbyte(static_cast<unsigned char>(postbyte));
+	return Modes;
+}
+
+static constexpr std::array<IndexedMode, 256> IndexedModes=BuildIndexedModes();
+
 static unsigned short CalculateEA(unsigned char postbyte)
 {
 	static const std::array<unsigned short*, 4> indexableRegisters =
@@ -3422,227 +3441,61 @@ static unsigned short CalculateEA(unsigned char postbyte)
 		&S_REG
 	};
 
-	static unsigned short int ea=0;
-	static signed char byte=0;
-	static unsigned char Register;
+	const IndexedMode &Mode=IndexedModes[postbyte];
+	unsigned short &Register=*indexableRegisters[Mode.Register];
+	unsigned short Offset=static_cast<unsigned short>(Mode.Offset);
+	unsigned short ea;
 
-	Register = ((postbyte >> 5) & 3);
-
-	if (postbyte & 0x80)
+	if (Mode.OffsetSize==1)
+		Offset=static_cast<unsigned short>((signed char)MemFetch8(pc.Reg++));
+	else if (Mode.OffsetSize==2)
 	{
-		switch (postbyte & 0x1F)
-		{
-		case 0:
-			ea=(*indexableRegisters[Register]);
-			(*indexableRegisters[Register])++;
-			CycleCounter+=2;
-			break;
-
-		case 1:
-			ea=(*indexableRegisters[Register]);
-			(*indexableRegisters[Register])+=2;
-			CycleCounter+=3;
-			break;
-
-		case 2:
-			(*indexableRegisters[Register])-=1;
-			ea=(*indexableRegisters[Register]);
-			CycleCounter+=2;
-			break;
-
-		case 3:
-			(*indexableRegisters[Register])-=2;
-			ea=(*indexableRegisters[Register]);
-			CycleCounter+=3;
-			break;
-
-		case 4:
-			ea=(*indexableRegisters[Register]);
-			break;
-
-		case 5:
-			ea=(*indexableRegisters[Register])+((signed char)B_REG);
-			CycleCounter+=1;
-			break;
-
-		case 6:
-			ea=(*indexableRegisters[Register])+((signed char)A_REG);
-			CycleCounter+=1;
-			break;
-
-		case 7:
-			CycleCounter+=1;
-			break;
-
-		case 8:
-			ea=(*indexableRegisters[Register])+(signed char)MemRead8(pc.Reg++);
-			CycleCounter+=1;
-			break;
-
-		case 9:
-			ea=(*indexableRegisters[Register])+MemRead16(pc.Reg);
-			CycleCounter+=4;
-			pc.Reg+=2;
-			break;
-
-		case 10:
-			CycleCounter+=1;
-			break;
-
-		case 11:
-			ea=(*indexableRegisters[Register])+D_REG; //Changed to unsigned 03/14/2005 NG Was signed
-			CycleCounter+=4;
-			break;
-
-		case 12:
-			ea=(signed short)pc.Reg+(signed char)MemRead8(pc.Reg)+1;
-			CycleCounter+=1;
-			pc.Reg++;
-			break;
-
-		case 13: //MM
-			ea=pc.Reg+MemRead16(pc.Reg)+2;
-			CycleCounter+=5;
-			pc.Reg+=2;
-			break;
-
-		case 14:
-			CycleCounter+=4;
-			break;
+		Offset=MemFetch16(pc.Reg);
+		pc.Reg+=2;
+	}
 
-		case 15: //01111
-			byte=(postbyte>>5)&3;
-			switch (byte)
-			{
-			case 0:
-				break;
-			case 1:
-				pc.Reg+=2;
-				break;
-			case 2:
-				break;
-			case 3:
-				break;
-			}
+	switch (Mode.Mode)
+	{
+	case EA_OFFSET:
+		ea=Register+Offset;
 		break;
-
-		case 16: //10000
-			byte=(postbyte>>5)&3;
-			switch (byte)
-			{
-			case 0:
-				break;
-			case 1:
-				pc.Reg+=2;
-				break;
-			case 2:
-				break;
-			case 3:
-				break;
-			}
+	case EA_POSTINC1:
+		ea=Register++;
+		break;
+	case EA_POSTINC2:
+		ea=Register;
+		Register+=2;
+		break;
+	case EA_PREDEC1:
+		ea=--Register;
+		break;
+	case EA_PREDEC2:
+		Register-=2;
+		ea=Register;
+		break;
+	case EA_AOFFSET:
+		ea=Register+((signed char)A_REG);
+		break;
+	case EA_BOFFSET:
+		ea=Register+((signed char)B_REG);
+		break;
+	case EA_DOFFSET:
+		ea=Register+D_REG; //Changed to unsigned 03/14/2005 NG Was signed
+		break;
+	case EA_PCREL:
+		ea=pc.Reg+Offset;
+		break;
+	case EA_EXTENDED:
+		ea=Offset;
+		break;
+	default:
+		ea=Register;
 		break;
-
-
-		case 17: //10001
-			ea=(*indexableRegisters[Register]);
-			(*indexableRegisters[Register])+=2;
-			ea=MemRead16(ea);
-			CycleCounter+=6;
-			break;
-
-		case 18: //10010
-			CycleCounter+=6;
-			break;
-
-		case 19: //10011
-			(*indexableRegisters[Register])-=2;
-			ea=(*indexableRegisters[Register]);
-			ea=MemRead16(ea);
-			CycleCounter+=6;
-			break;
-
-		case 20: //10100
-			ea=(*indexableRegisters[Register]);
-			ea=MemRead16(ea);
-			CycleCounter+=3;
-			break;
-
-		case 21: //10101
-			ea=(*indexableRegisters[Register])+((signed char)B_REG);
-			ea=MemRead16(ea);
-			CycleCounter+=4;
-			break;
-
-		case 22: //10110
-			ea=(*indexableRegisters[Register])+((signed char)A_REG);
-			ea=MemRead16(ea);
-			CycleCounter+=4;
-			break;
-
-		case 23: //10111
-			ea=MemRead16(ea);
-			CycleCounter+=4;
-			break;
-
-		case 24: //11000
-			ea=(*indexableRegisters[Register])+(signed char)MemRead8(pc.Reg++);
-			ea=MemRead16(ea);
-			CycleCounter+=4;
-			break;
-
-		case 25: //11001
-			ea=(*indexableRegisters[Register])+MemRead16(pc.Reg);
-			ea=MemRead16(ea);
-			CycleCounter+=7;
-			pc.Reg+=2;
-			break;
-		case 26: //11010
-			ea=MemRead16(ea);
-			CycleCounter+=4;
-			break;
-
-		case 27: //11011
-			ea=(*indexableRegisters[Register])+D_REG;
-			ea=MemRead16(ea);
-			CycleCounter+=7;
-			break;
-
-		case 28: //11100
-			ea=(signed short)pc.Reg+(signed char)MemRead8(pc.Reg)+1;
-			ea=MemRead16(ea);
-			CycleCounter+=4;
-			pc.Reg++;
-			break;
-
-		case 29: //11101
-			ea=pc.Reg+MemRead16(pc.Reg)+2;
-			ea=MemRead16(ea);
-			CycleCounter+=8;
-			pc.Reg+=2;
-			break;
-
-		case 30: //11110
-			ea=MemRead16(ea);
-			CycleCounter+=7;
-			break;
-
-		case 31: //11111
-			ea=MemRead16(pc.Reg);
-			ea=MemRead16(ea);
-			CycleCounter+=8;
-			pc.Reg+=2;
-			break;
-
-		} //END Switch
-	}
-	else
-	{
-		byte= (postbyte & 31);
-		byte= (byte << 3);
-		byte= byte /8;
-		ea= *indexableRegisters[Register]+byte; //Was signed
-		CycleCounter+=1;
 	}
-return ea;
+
+	if (Mode.Indirect)
+		ea=MemRead16(ea);
+	CycleCounter+=Mode.Cycles;
+	return ea;
 }
 
@@ -21,9 +21,13 @@ This file is part of VCC (Virtual Color Computer).
 
 #include <vector>
 #include "cutie/compat.h"  // For VCC::CPUState
+#include "cutie/state.h"
 
 void MC6809Init();
 int  MC6809Exec( int);
+int  MC6809SliceCycles();
+int  MC6809InstructionCycles();
+void MC6809EndSlice();
 void MC6809Reset();
 void MC6809AssertInterupt(unsigned char,unsigned char);
 void MC6809DeAssertInterupt(unsigned char);// 4 nmi 2 firq 1 irq
@@ -31,6 +35,9 @@ void MC6809ForcePC(unsigned short);
 void MC6809SetBreakpoints(const std::vector<unsigned short>& breakpoints);
 void MC6809SetTraceTriggers(const std::vector<unsigned short>& triggers);
 VCC::CPUState MC6809GetState();
+void MC6809SetState(const VCC::CPUState &);
+void MC6809SaveState(cutie::StateWriter &);
+bool MC6809LoadState(cutie::StateReader &);
 
 
 #endif
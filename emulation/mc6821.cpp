@@ -107,6 +107,8 @@ Bit 0 CART FIRQ 0 = FIRQ disabled 1 = enabled
 #include "cutie/stubs.h"
 #include "cutie/keyboard.h"
 #include "cutie/joystick.h"
+#include "cutie/timeline.h"
+#include "cutie/cassette.h"
 #include "mc6821.h"
 #include "hd6309.h"
 #include "tcc1014graphics.h"
@@ -135,26 +137,19 @@ static void WritePrintMon(char *) {}
 static bool MonState = false;
 
 // Shift Row Col
-unsigned char pia0_read(unsigned char port)
+// The peek functions return what a CPU read would see without acknowledging
+// the interrupt flags, for debuggers and remote memory dumps.
+unsigned char pia0_peek(unsigned char port)
 {
-	unsigned char dda,ddb;
-	dda=(rega[1] & 4);
-	ddb=(rega[3] & 4);
-
 	switch (port)
 	{
-		case 1:  // cpu read FF01
+		case 1:  // FF01
+		case 3:  // FF03
 			return(rega[port]);
-		break;
 
-		case 3:  // cpu read FF03
-			return(rega[port]);
-		break;
-
-		case 0:  // cpu read FF00
-			if (dda)
+		case 0:  // FF00
+			if (rega[1] & 4)
 			{
-				rega[1]=(rega[1] & 63);
 				// Get keyboard scan and AND with joystick buttons (both active-low)
 				unsigned char keyData = vccKeyboardGetScan(rega[2]|~rega_dd[2]);
 				unsigned char joyButtons = vccJoystickGetButtonBits();
@@ -164,65 +159,74 @@ unsigned char pia0_read(unsigned char port)
 				result = (result & 0x7F) | vccJoystickGetComparison(GetMuxState());
 				return result;
 			}
-			else
-				return(rega_dd[port]);
-		break;
+			return(rega_dd[port]);
 
-		case 2: // cpu read FF02
-			if (ddb)
-			{
-				rega[3]=(rega[3] & 63);
+		case 2: // FF02
+			if (rega[3] & 4)
 				return(rega[port] & rega_dd[port]);
-			}
-			else
-				return(rega_dd[port]);
-		break;
+			return(rega_dd[port]);
 	}
 	return 0;
 }
 
-unsigned char pia1_read(unsigned char port)
+// Drive the keyboard columns for the GIME keyboard interrupt
+void pia0_scan_keyboard()
 {
-	static unsigned int Flag=0;
-	unsigned char dda,ddb;
-	port-=0x20;
-	dda=(regb[1] & 4);
-	ddb=(regb[3] & 4);
+	vccKeyboardUpdateInterrupt(rega[2]|~rega_dd[2], vccJoystickGetButtonBits());
+}
+
+unsigned char pia0_read(unsigned char port)
+{
+	// The HSYNC flag is read here and cleared by reading $FF00
+	if (port<=1)
+		CatchUpBeam();
+	const unsigned char value=pia0_peek(port);
+
+	// Reading a data register clears the interrupt flags of its control register
+	if (port==0 && (rega[1] & 4))
+		rega[1]=(rega[1] & 63);
+	if (port==2 && (rega[3] & 4))
+		rega[3]=(rega[3] & 63);
+	return value;
+}
 
+unsigned char pia1_peek(unsigned char port)
+{
+	port-=0x20;
 	switch (port)
 	{
-		case 1:   // cpu read FF21
-		case 3:   // cpu read FF23
+		case 1:   // FF21
+		case 3:   // FF23
 			return(regb[port]);
-		break;
 
-		case 2:  // cpu read FF22
-			if (ddb)
-			{
-				regb[3]= (regb[3] & 63);
+		case 2:  // FF22
+			if (regb[3] & 4)
 				return(regb[port] & regb_dd[port]);
-			}
-			else
-				return(regb_dd[port]);
-		break;
+			return(regb_dd[port]);
 
-		case 0:  // cpu read FF20
-			if (dda)
-			{
-				regb[1]=(regb[1] & 63); //Cass In
-				Flag = regb[port];//& regb_dd[port];
-				return Flag;
-			}
-			else
-				return(regb_dd[port]);
-		break;
+		case 0:  // FF20
+			if (regb[1] & 4)
+				return(regb[port]);
+			return(regb_dd[port]);
 	}
 	return 0;
 }
 
+unsigned char pia1_read(unsigned char port)
+{
+	const unsigned char value=pia1_peek(port);
+
+	if (port==0x20 && (regb[1] & 4))
+		regb[1]=(regb[1] & 63); //Cass In
+	if (port==0x22 && (regb[3] & 4))
+		regb[3]=(regb[3] & 63);
+	return value;
+}
+
 void pia0_write(unsigned char data,unsigned char port)
 {
 	unsigned char dda,ddb;
+	RecordRegisterWrite(0xFF00 | port, data);
 	dda=(rega[1] & 4);
 	ddb=(rega[3] & 4);
 
@@ -240,10 +244,14 @@ void pia0_write(unsigned char data,unsigned char port)
 			rega[port]=data;
 		else
 			rega_dd[port]=data;
+		pia0_scan_keyboard();
 		return;
 	break;
 
 	case 1:  // cpu write FF01
+		CatchUpBeam();
+		if (data & 1)	// HSYNC interrupt
+			EndCoalescedField();
 		rega[port]= (data & 0x3F);
 		return;
 	break;
@@ -259,6 +267,7 @@ void pia0_write(unsigned char data,unsigned char port)
 void pia1_write(unsigned char data,unsigned char port)
 {
 	unsigned char dda,ddb;
+	RecordRegisterWrite(0xFF00 | port, data);
 	port-=0x20;
 
 	dda=(regb[1] & 4);
@@ -271,6 +280,7 @@ void pia1_write(unsigned char data,unsigned char port)
 			// Start joystick analog ramp with DAC value
 			vccJoystickStartRamp(data);
 			regb[port]=data;
+			CassetteOutput(data);
 			CaptureBit((regb[0]&2)>>1);
 			if (GetMuxState() == 0)
 			{
@@ -292,6 +302,8 @@ void pia1_write(unsigned char data,unsigned char port)
 	case 2: // cpu write FF22
 		if (ddb)
 		{
+			if (((data & regb_dd[port]) ^ regb[port]) & 248)	// VDG mode
+				EndCoalescedField();
 			regb[port]=(data & regb_dd[port]);
 			SetGimeVdgMode2( (regb[2] & 248) >>3);
 			Ssample=(regb[port] & 2)<<6;
@@ -315,6 +327,11 @@ void pia1_write(unsigned char data,unsigned char port)
 	return;
 }
 
+bool PiaHsyncInteruptEnabled()
+{
+	return rega[1] & 1;
+}
+
 unsigned char VDG_Mode()
 {
 	return( (regb[2] & 248) >>3);
@@ -404,6 +421,24 @@ void PiaReset()
 	}
 }
 
+template <class StateArchive>
+static void TransferState(StateArchive &state)
+{
+	state(rega)(regb)(rega_dd)(regb_dd);
+	state(LeftChannel)(RightChannel)(Asample)(Ssample)(Csample);
+}
+
+void PiaSaveState(cutie::StateWriter &state)
+{
+	TransferState(state);
+}
+
+bool PiaLoadState(cutie::StateReader &state)
+{
+	TransferState(state);
+	return state.complete();
+}
+
 // Get analog I/O select.
 unsigned char GetMuxState()
 {
@@ -18,21 +18,29 @@ This file is part of VCC (Virtual Color Computer).
     along with VCC (Virtual Color Computer).  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include "cutie/state.h"
+
 unsigned char pia0_read(unsigned char port);
+unsigned char pia0_peek(unsigned char port);
 void pia0_write(unsigned char data,unsigned char port);
+void pia0_scan_keyboard();
 unsigned char pia1_read(unsigned char port);
+unsigned char pia1_peek(unsigned char port);
 void pia1_write(unsigned char data,unsigned char port);
 
 void ClosePrintFile();
 void SetSerialParams(unsigned char);
 void SetMonState(bool);
 unsigned char VDG_Mode();
+bool PiaHsyncInteruptEnabled();
 void irq_hs(int);
 void irq_fs(int);
 void AssertCart();
 void SetCart(bool lineState);
 unsigned char SetCartAutoStart(unsigned char);
 void PiaReset();
+void PiaSaveState(cutie::StateWriter &);
+bool PiaLoadState(cutie::StateReader &);
 unsigned char GetMuxState();
 unsigned int DACState();
 unsigned int GetDACSample();
@@ -75,6 +75,26 @@ public:
 		return MemRead8(address);
 	}
 
+	void read_memory(unsigned short address, unsigned char* buffer, size_type size) override
+	{
+		MemReadBlock(buffer, address, static_cast<unsigned int>(size));
+	}
+
+	void write_memory(unsigned short address, const unsigned char* buffer, size_type size) override
+	{
+		MemWriteBlock(buffer, address, static_cast<unsigned int>(size));
+	}
+
+	void read_physical_memory(physical_address_type address, unsigned char* buffer, size_type size) override
+	{
+		MemReadPhysical(buffer, static_cast<unsigned long>(address), static_cast<unsigned int>(size));
+	}
+
+	void write_physical_memory(physical_address_type address, const unsigned char* buffer, size_type size) override
+	{
+		MemWritePhysical(buffer, static_cast<unsigned long>(address), static_cast<unsigned int>(size));
+	}
+
 	void set_cartridge_select_line(bool line_state) override
 	{
 		SetCart(line_state);
@@ -183,6 +183,18 @@ void CartridgeManager::reset()
     m_bankSelect = 0;
 }
 
+uint8_t CartridgeManager::bankSelect() const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return m_bankSelect;
+}
+
+void CartridgeManager::setBankSelect(uint8_t bank)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    m_bankSelect = bank;
+}
+
 std::string CartridgeManager::getLastError() const
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
@@ -0,0 +1,312 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/cassette.h"
+#include "cutie/stubs.h"
+#include "coco3.h"
+#include "mc6809.h"
+#include "hd6309.h"
+#include "mc6821.h"
+#include "tcc1014mmu.h"
+#include <vector>
+
+bool CassetteTrapsArmed = false;
+
+namespace cutie {
+
+namespace {
+    CassetteRecorder g_cassetteRecorder;
+
+    // Color BASIC's cassette output routines. Every instruction is checked
+    // against where they start, and a match must also be where the jump
+    // table points and begin with the routine's first instructions.
+    constexpr uint16_t BlockOutVector = 0xA008;     // BLKOUT
+    constexpr uint16_t WriteLeaderVector = 0xA00C;  // WRTLDR
+    constexpr uint16_t BlockOutEntry = 0xA7F4;
+    constexpr uint16_t WriteLeaderEntry = 0xA7D8;
+    constexpr uint8_t BlockOutCode[] = {0x1A, 0x50, 0xD6, 0x7D, 0xD7, 0x81};
+    constexpr uint8_t WriteLeaderCode[] = {0x1A, 0x50, 0x8D, 0xEE, 0x9E, 0x92};
+
+    // Direct page variables they use
+    constexpr uint8_t BlockType = 0x7C;      // BLKTYP
+    constexpr uint8_t BlockLength = 0x7D;    // BLKLEN
+    constexpr uint8_t BlockAddress = 0x7E;   // CBUFAD
+    constexpr uint8_t BlockChecksum = 0x80;
+    constexpr uint8_t BlockCount = 0x81;
+    constexpr uint8_t LastSample = 0x85;     // DAC value the next byte starts from
+    constexpr uint8_t LeaderLength = 0x92;   // SYNCLN
+
+    // Each bit steps Y through the sine table to its end
+    constexpr uint16_t SineTableEnd = 0xA880;
+
+    constexpr uint8_t LeaderByte = 0x55;
+    constexpr uint8_t SyncByte = 0x3C;
+
+    bool isRoutine(unsigned short pc, uint16_t vector, const uint8_t* code, size_t length)
+    {
+        if (MemRead16(vector) != pc) {
+            return false;
+        }
+        for (size_t i = 0; i < length; ++i) {
+            if (MemRead8(static_cast<unsigned short>(pc + i)) != code[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool isHD6309()
+    {
+        return CPUExec == HD6309Exec;
+    }
+
+    // Leave the machine as the routine does after sending its last byte,
+    // with interrupts masked, and return to the caller
+    void returnFromRoutine(VCC::CPUState regs)
+    {
+        const uint16_t page = static_cast<uint16_t>(regs.DP << 8);
+        MemWrite8(MemRead8(SineTableEnd - 2), 0xFF20);
+        MemWrite8(MemRead8(SineTableEnd - 1), page | LastSample);
+
+        regs.A = LeaderByte;
+        regs.B = 0;
+        regs.D = static_cast<uint16_t>(regs.A << 8 | regs.B);
+        regs.Y = SineTableEnd;
+        regs.CC = (regs.CC & 0xA0) | 0x50 | 0x07;  // ORCC #$50, then ASLB of $80
+        regs.PC = MemRead16(regs.S);
+        regs.S = static_cast<uint16_t>(regs.S + 2);
+        if (isHD6309()) {
+            HD6309SetState(regs);
+        } else {
+            MC6809SetState(regs);
+        }
+    }
+
+    void writeLeader(CassetteRecorder& recorder)
+    {
+        VCC::CPUState regs = isHD6309() ? HD6309GetState() : MC6809GetState();
+        const uint16_t page = static_cast<uint16_t>(regs.DP << 8);
+
+        // Motor on; the delay for it to come up to speed is skipped
+        MemWrite8(MemRead8(0xFF21) | 8, 0xFF21);
+
+        // The count loop runs 65536 times from zero
+        const uint16_t count = MemRead16(page | LeaderLength);
+        const std::vector<uint8_t> leader(count == 0 ? 0x10000 : count, LeaderByte);
+        recorder.write(leader.data(), leader.size());
+
+        regs.X = 0;
+        returnFromRoutine(regs);
+    }
+
+    void blockOut(CassetteRecorder& recorder)
+    {
+        VCC::CPUState regs = isHD6309() ? HD6309GetState() : MC6809GetState();
+        const uint16_t page = static_cast<uint16_t>(regs.DP << 8);
+
+        const uint8_t type = MemRead8(page | BlockType);
+        const uint8_t length = MemRead8(page | BlockLength);
+        const uint16_t address = MemRead16(page | BlockAddress);
+
+        std::vector<uint8_t> block = {LeaderByte, SyncByte, type, length};
+        uint8_t checksum = static_cast<uint8_t>(type + length);
+        for (unsigned i = 0; i < length; ++i) {
+            const uint8_t byte = MemRead8(static_cast<unsigned short>(address + i));
+            block.push_back(byte);
+            checksum = static_cast<uint8_t>(checksum + byte);
+        }
+        block.push_back(checksum);
+        block.push_back(LeaderByte);
+        recorder.write(block.data(), block.size());
+
+        MemWrite8(checksum, page | BlockChecksum);
+        MemWrite8(0, page | BlockCount);
+        regs.X = static_cast<uint16_t>(address + length);
+        returnFromRoutine(regs);
+    }
+}
+
+bool CassetteRecorder::open(const std::filesystem::path& path, bool turbo)
+{
+    close();
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file.is_open()) {
+        m_lastError = "Could not create " + path.string();
+        return false;
+    }
+    m_lastError.clear();
+    m_turbo = turbo;
+    m_written = 0;
+    m_motor = (pia1_peek(0x21) & 8) != 0;
+    m_high = false;
+    unsync();
+
+    CassetteTrapsArmed = turbo && this == &g_cassetteRecorder;
+    return true;
+}
+
+void CassetteRecorder::close()
+{
+    if (this == &g_cassetteRecorder) {
+        CassetteTrapsArmed = false;
+    }
+    if (m_file.is_open()) {
+        m_file.close();
+    }
+    m_turbo = false;
+}
+
+void CassetteRecorder::motor(bool on, uint64_t cycle)
+{
+    if (on == m_motor) {
+        return;
+    }
+    m_motor = on;
+    m_fall = cycle;
+    unsync();
+    if (!on && m_file.is_open()) {
+        m_file.flush();
+    }
+}
+
+void CassetteRecorder::output(uint8_t value, uint64_t cycle)
+{
+    const bool high = value >= 0x80;
+    if (high == m_high) {
+        return;
+    }
+    m_high = high;
+    if (!m_motor || !m_file.is_open()) {
+        return;
+    }
+
+    if (high) {
+        if (cycle - m_fall > GapCycles) {
+            unsync();
+        }
+        m_rise = cycle;
+        return;
+    }
+
+    // The bit is known once its high half is over
+    m_fall = cycle;
+    const uint64_t half = cycle - m_rise;
+    if (half < ShortestHalf || half > LongestHalf) {
+        unsync();
+        return;
+    }
+    bit(half < OneZeroSplit);
+}
+
+void CassetteRecorder::write(const uint8_t* data, size_t length)
+{
+    unsync();
+    if (m_file.is_open()) {
+        m_file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(length));
+        m_written += length;
+    }
+}
+
+void CassetteRecorder::bit(bool one)
+{
+    m_shift = static_cast<uint8_t>(m_shift >> 1 | (one ? 0x80 : 0));
+    if (m_synced) {
+        if (++m_bits == 8) {
+            emit(m_shift);
+            m_bits = 0;
+        }
+        return;
+    }
+
+    // Until sync every eight bit window is a candidate byte. The leader
+    // alternates, so its windows are $55 and $AA in turn; the sync byte
+    // must start right where a $55 window ends.
+    if (m_bits < 8) {
+        ++m_bits;
+    }
+    if (m_bits == 8 && (m_shift == LeaderByte || m_shift == 0xAA)) {
+        ++m_leader;
+        m_sinceLeader = 0;
+        return;
+    }
+    ++m_sinceLeader;
+    if (m_shift == SyncByte && m_leader > 0 && m_sinceLeader == 8) {
+        // A leader of n bytes has 8n - 7 windows
+        for (unsigned i = 0; i < (m_leader + 7) / 8; ++i) {
+            emit(LeaderByte);
+        }
+        emit(SyncByte);
+        m_synced = true;
+        m_bits = 0;
+    } else if (m_sinceLeader >= 8) {
+        m_leader = 0;
+    }
+}
+
+void CassetteRecorder::emit(uint8_t byte)
+{
+    m_file.put(static_cast<char>(byte));
+    ++m_written;
+}
+
+void CassetteRecorder::unsync()
+{
+    m_shift = 0;
+    m_synced = false;
+    m_bits = 0;
+    m_leader = 0;
+    m_sinceLeader = 0;
+}
+
+CassetteRecorder& getCassetteRecorder()
+{
+    return g_cassetteRecorder;
+}
+
+} // namespace cutie
+
+void CassetteOutput(unsigned char value)
+{
+    auto& recorder = cutie::g_cassetteRecorder;
+    if (recorder.isOpen()) {
+        recorder.output(value, GetCpuCycleCount());
+    }
+}
+
+void Motor(unsigned char state)
+{
+    cutie::g_cassetteRecorder.motor(state != 0, GetCpuCycleCount());
+}
+
+bool CassetteTrap(unsigned short pc)
+{
+    auto& recorder = cutie::g_cassetteRecorder;
+    if (pc != cutie::WriteLeaderEntry && pc != cutie::BlockOutEntry) {
+        return false;
+    }
+    if (cutie::isRoutine(pc, cutie::WriteLeaderVector, cutie::WriteLeaderCode, sizeof(cutie::WriteLeaderCode))) {
+        cutie::writeLeader(recorder);
+        return true;
+    }
+    if (cutie::isRoutine(pc, cutie::BlockOutVector, cutie::BlockOutCode, sizeof(cutie::BlockOutCode))) {
+        cutie::blockOut(recorder);
+        return true;
+    }
+    return false;
+}
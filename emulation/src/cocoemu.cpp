@@ -21,16 +21,22 @@ This file is part of CutieCoCo.
 #include "cutie/keyboard.h"
 #include "cutie/joystick.h"
 #include "cutie/cartridge.h"
+#include "cutie/perfcounters.h"
+#include "cutie/hostcall.h"
+#include "cutie/romhooks.h"
 #include "cutie/compat.h"  // For EmuState
 #include "cutie/stubs.h"   // For CPUExec
+#include "cutie/state.h"
 #include "mc6809.h"
 #include "hd6309.h"
+#include "mc6821.h"
 #include "tcc1014mmu.h"
 #include "tcc1014graphics.h"
 #include "tcc1014registers.h"
 #include "coco3.h"
 #include <cstdio>
 #include <cstring>
+#include <optional>
 #include <vector>
 
 namespace cutie {
@@ -60,7 +66,7 @@ class CocoEmulatorImpl : public CocoEmulator {
 public:
     explicit CocoEmulatorImpl(const EmulatorConfig& config)
         : m_config(config)
-        , m_framebuffer(FRAMEBUFFER_WIDTH, FRAMEBUFFER_HEIGHT)
+        , m_framebuffer(FRAMEBUFFER_WIDTH, FRAMEBUFFER_HEIGHT, config.memoryPolicy)
     {
     }
 
@@ -77,7 +83,13 @@ public:
             return true;
         }
 
+        // Bind the thread first, so that nothing it touches lands elsewhere
+        if (m_config.memoryPolicy.numaNode >= 0 && bindThreadToNumaNode(m_config.memoryPolicy.numaNode)) {
+            m_threadNode = m_config.memoryPolicy.numaNode;
+        }
+
         // Initialize memory subsystem
+        SetRamPolicy(m_config.memoryPolicy);
         m_memory = MmuInit(toMmuSize(m_config.memorySize));
         if (m_memory == nullptr) {
             m_lastError = "Failed to initialize MMU";
@@ -112,6 +124,10 @@ public:
         // IMPORTANT: Must be called BEFORE SetAudioRate because MiscReset
         // resets audio timing variables to 0
         MiscReset();
+        SetLineCoalescing(m_config.coalesceScanlines);
+        getHostCallDevice().setDirectory(m_config.hostCallDirectory);
+        getHostCallDevice().setEnabled(m_config.hostCalls);
+        getRomHooks().setEnabled(m_config.romHooks);
 
         // Enable audio at configured sample rate
         // The audio buffer is drained after each frame in runFrame()
@@ -157,12 +173,35 @@ public:
         }
     }
 
+    void hardReset() override {
+        if (!m_ready) {
+            return;
+        }
+
+        // MmuInit() keeps the RAM buffer unless the size or policy changes
+        if (m_nextMemorySize) {
+            m_config.memorySize = *m_nextMemorySize;
+            m_nextMemorySize.reset();
+        }
+        SetRamPolicy(m_config.memoryPolicy);
+        m_memory = MmuInit(toMmuSize(m_config.memorySize));
+        if (m_memory == nullptr) {
+            m_lastError = "Failed to initialize MMU";
+            m_ready = false;
+            return;
+        }
+        EmuState.RamBuffer = m_memory;
+        reset();
+    }
+
     void shutdown() override {
         if (!m_ready) {
             return;
         }
 
         EmuState.EmulationRunning = 0;
+        getHostCallDevice().setEnabled(false);
+        getRomHooks().setEnabled(false);
         m_ready = false;
     }
 
@@ -179,12 +218,19 @@ public:
         EmuState.PTRsurface32 = m_framebuffer.pixels();
         EmuState.SurfacePitch = m_framebuffer.pitch();
 
+        auto& perf = getPerfCounters();
+        perf.switchTo(PerfPhase::Cpu);
+
         // Run one frame of emulation
         RenderFrame(&EmuState);
 
         // Capture audio samples from the legacy buffer
         // This also resets the audio index for the next frame
+        perf.switchTo(PerfPhase::Audio);
         captureAudioSamples();
+
+        perf.switchTo(PerfPhase::Other);
+        perf.endFrame();
     }
 
     void captureAudioSamples() {
@@ -329,6 +375,110 @@ public:
         return getCartridgeManager().getName();
     }
 
+    // ========================================================================
+    // Memory
+    // ========================================================================
+
+    void readMemory(uint16_t address, uint8_t* data, size_t length) const override {
+        for (size_t i = 0; i < length; ++i) {
+            data[i] = m_ready ? SafeMemRead8(static_cast<uint16_t>(address + i)) : 0;
+        }
+    }
+
+    void writeMemory(uint16_t address, const uint8_t* data, size_t length) override {
+        if (!m_ready) {
+            return;
+        }
+        for (size_t i = 0; i < length; ++i) {
+            MemWrite8(data[i], static_cast<uint16_t>(address + i));
+        }
+    }
+
+    std::pair<const uint8_t*, size_t> getRam() const override {
+        if (!m_ready) {
+            return std::make_pair(nullptr, 0);
+        }
+        return std::make_pair(m_memory, static_cast<size_t>(Get_mem_size()));
+    }
+
+    // ========================================================================
+    // Save States
+    // ========================================================================
+
+    bool saveState(MachineState& state) const override {
+        if (!m_ready) {
+            return false;
+        }
+
+        state.cpuType = m_cpuType;
+        state.memorySize = m_config.memorySize;
+        state.systemRomHash = GetSystemRomHash();
+        state.ram.assign(m_memory, m_memory + Get_mem_size());
+        state.devices.clear();
+
+        // applyState() expects the devices in exactly this order
+        auto addDevice = [&state](const char* name, auto save) {
+            state.devices.emplace_back(name, std::vector<uint8_t>());
+            StateWriter writer(state.devices.back().second);
+            save(writer);
+        };
+        addDevice("cpu", m_cpuType == CpuType::HD6309 ? HD6309SaveState : MC6809SaveState);
+        addDevice("mmu", MmuSaveState);
+        addDevice("gime", GimeSaveState);
+        addDevice("video", GimeVideoSaveState);
+        addDevice("pia", PiaSaveState);
+        addDevice("timing", MiscSaveState);
+        addDevice("cartridge", [](StateWriter& writer) {
+            writer(getCartridgeManager().bankSelect());
+        });
+        addDevice("keyboard", [](StateWriter& writer) {
+            writer(getKeyboard().rowLines());
+        });
+        return true;
+    }
+
+    bool loadState(const MachineState& state) override {
+        if (!m_ready) {
+            return false;
+        }
+        if (state.cpuType != m_cpuType || state.memorySize != m_config.memorySize
+            || state.systemRomHash != GetSystemRomHash()) {
+            m_lastError = "Save state was taken on a different machine configuration";
+            return false;
+        }
+        if (state.ram.size() != Get_mem_size()) {
+            m_lastError = "Save state RAM size does not match";
+            return false;
+        }
+
+        // Keep the current state so that a damaged blob cannot leave the
+        // machine half restored
+        MachineState previous;
+        saveState(previous);
+        if (!applyState(state)) {
+            applyState(previous);
+            m_lastError = "Save state is damaged or from an incompatible build";
+            return false;
+        }
+        return true;
+    }
+
+    bool loadDeviceState(const MachineState& state) override {
+        if (!m_ready) {
+            return false;
+        }
+        if (state.cpuType != m_cpuType || state.memorySize != m_config.memorySize
+            || state.systemRomHash != GetSystemRomHash()) {
+            m_lastError = "Save state was taken on a different machine configuration";
+            return false;
+        }
+        if (!applyDevices(state)) {
+            m_lastError = "Save state is damaged or from an incompatible build";
+            return false;
+        }
+        return true;
+    }
+
     // ========================================================================
     // Configuration & State
     // ========================================================================
@@ -360,6 +510,28 @@ public:
         return m_config.memorySize;
     }
 
+    void setMemorySize(MemorySize size) override {
+        if (m_ready) {
+            m_nextMemorySize = size;
+        } else {
+            m_config.memorySize = size;
+        }
+    }
+
+    MemoryPolicyReport getMemoryPolicyReport() const override {
+        MemoryPolicyReport report;
+        report.requested = m_config.memoryPolicy;
+        if (m_ready) {
+            const HostBuffer& ram = GetRamAllocation();
+            report.ramHugePages = ram.hugePages();
+            report.ramNode = ram.numaNode();
+        }
+        report.framebufferHugePages = m_framebuffer.buffer().hugePages();
+        report.framebufferNode = m_framebuffer.buffer().numaNode();
+        report.threadNode = m_threadNode;
+        return report;
+    }
+
     bool isReady() const override {
         return m_ready;
     }
@@ -369,10 +541,63 @@ public:
     }
 
 private:
+    bool applyState(const MachineState& state) {
+        // The MMU map is rebuilt from RAM, so RAM goes first
+        std::memcpy(m_memory, state.ram.data(), state.ram.size());
+        return applyDevices(state);
+    }
+
+    bool applyDevices(const MachineState& state) {
+        using LoadFunction = bool (*)(StateReader&);
+        static const std::pair<const char*, LoadFunction> loaders[] = {
+            {"cpu", nullptr},
+            {"mmu", MmuLoadState},
+            {"gime", GimeLoadState},
+            {"video", GimeVideoLoadState},
+            {"pia", PiaLoadState},
+            {"timing", MiscLoadState},
+            {"cartridge", [](StateReader& reader) {
+                uint8_t bank = 0;
+                reader(bank);
+                if (!reader.complete()) {
+                    return false;
+                }
+                getCartridgeManager().setBankSelect(bank);
+                return true;
+            }},
+            {"keyboard", [](StateReader& reader) {
+                uint8_t rows = 0;
+                reader(rows);
+                if (!reader.complete()) {
+                    return false;
+                }
+                getKeyboard().setRowLines(rows);
+                return true;
+            }},
+        };
+        if (state.devices.size() != std::size(loaders)) {
+            return false;
+        }
+
+        bool ok = true;
+        for (size_t i = 0; i < std::size(loaders); ++i) {
+            const auto& [name, blob] = state.devices[i];
+            LoadFunction load = loaders[i].second;
+            if (i == 0) {
+                load = m_cpuType == CpuType::HD6309 ? HD6309LoadState : MC6809LoadState;
+            }
+            StateReader reader(blob);
+            ok = name == loaders[i].first && load(reader) && ok;
+        }
+        return ok;
+    }
+
     EmulatorConfig m_config;
     FrameBuffer m_framebuffer;
     unsigned char* m_memory = nullptr;
     CpuType m_cpuType = CpuType::MC6809;
+    std::optional<MemorySize> m_nextMemorySize;  // Applied by hardReset()
+    int m_threadNode = -1;  // NUMA node init() bound its thread to
     bool m_ready = false;
     std::string m_lastError;
 
@@ -0,0 +1,871 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/control.h"
+#include "cutie/emulator.h"
+#include "cutie/statestore.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace cutie {
+
+namespace {
+
+// JSON-RPC 2.0 error codes
+constexpr int PARSE_ERROR = -32700;
+constexpr int INVALID_REQUEST = -32600;
+constexpr int METHOD_NOT_FOUND = -32601;
+constexpr int INVALID_PARAMS = -32602;
+constexpr int EMULATOR_ERROR = -32000;
+
+// Requests are small; anything longer is a broken client
+constexpr size_t MAX_REQUEST_LINE = 64 * 1024;
+constexpr size_t MEMORY_SPACE = 0x10000;
+constexpr long long MAX_PAYLOAD_LENGTH = 1LL << 53;  // Largest exact integer in a JSON number
+constexpr long long MAX_FRAMES_PER_REQUEST = 60 * 60 * 60;
+constexpr long long DEFAULT_SEARCH_RESULTS = 256;
+constexpr long long MAX_SEARCH_RESULTS = 65536;
+
+/**
+ * @brief Minimal JSON document model, enough for JSON-RPC requests
+ */
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+
+    const JsonValue* find(const char* key) const {
+        if (type != Type::Object) return nullptr;
+        for (const auto& member : object) {
+            if (member.first == key) return &member.second;
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : m_text(text) {}
+
+    bool parse(JsonValue& value) {
+        if (!parseValue(value, 0)) return false;
+        skipSpace();
+        return m_pos == m_text.size();
+    }
+
+private:
+    static constexpr int MAX_DEPTH = 32;
+
+    void skipSpace() {
+        while (m_pos < m_text.size() && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t'
+            || m_text[m_pos] == '\r' || m_text[m_pos] == '\n')) {
+            ++m_pos;
+        }
+    }
+
+    bool literal(const char* word) {
+        const size_t length = std::strlen(word);
+        if (m_text.compare(m_pos, length, word) != 0) return false;
+        m_pos += length;
+        return true;
+    }
+
+    bool parseValue(JsonValue& value, int depth) {
+        if (depth > MAX_DEPTH) return false;
+        skipSpace();
+        if (m_pos >= m_text.size()) return false;
+
+        switch (m_text[m_pos]) {
+            case '{': return parseObject(value, depth);
+            case '[': return parseArray(value, depth);
+            case '"':
+                value.type = JsonValue::Type::String;
+                return parseString(value.string);
+            case 't':
+                value.type = JsonValue::Type::Bool;
+                value.boolean = true;
+                return literal("true");
+            case 'f':
+                value.type = JsonValue::Type::Bool;
+                value.boolean = false;
+                return literal("false");
+            case 'n':
+                value.type = JsonValue::Type::Null;
+                return literal("null");
+            default:
+                return parseNumber(value);
+        }
+    }
+
+    bool parseObject(JsonValue& value, int depth) {
+        value.type = JsonValue::Type::Object;
+        ++m_pos;
+        skipSpace();
+        if (m_pos < m_text.size() && m_text[m_pos] == '}') {
+            ++m_pos;
+            return true;
+        }
+        for (;;) {
+            skipSpace();
+            std::pair<std::string, JsonValue> member;
+            if (m_pos >= m_text.size() || m_text[m_pos] != '"' || !parseString(member.first)) return false;
+            skipSpace();
+            if (m_pos >= m_text.size() || m_text[m_pos++] != ':') return false;
+            if (!parseValue(member.second, depth + 1)) return false;
+            value.object.push_back(std::move(member));
+            skipSpace();
+            if (m_pos >= m_text.size()) return false;
+            const char next = m_text[m_pos++];
+            if (next == '}') return true;
+            if (next != ',') return false;
+        }
+    }
+
+    bool parseArray(JsonValue& value, int depth) {
+        value.type = JsonValue::Type::Array;
+        ++m_pos;
+        skipSpace();
+        if (m_pos < m_text.size() && m_text[m_pos] == ']') {
+            ++m_pos;
+            return true;
+        }
+        for (;;) {
+            JsonValue element;
+            if (!parseValue(element, depth + 1)) return false;
+            value.array.push_back(std::move(element));
+            skipSpace();
+            if (m_pos >= m_text.size()) return false;
+            const char next = m_text[m_pos++];
+            if (next == ']') return true;
+            if (next != ',') return false;
+        }
+    }
+
+    bool parseHex4(unsigned& code) {
+        if (m_pos + 4 > m_text.size()) return false;
+        code = 0;
+        for (int i = 0; i < 4; ++i) {
+            const char c = m_text[m_pos++];
+            code <<= 4;
+            if (c >= '0' && c <= '9') code |= c - '0';
+            else if (c >= 'a' && c <= 'f') code |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') code |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, unsigned code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    bool parseString(std::string& out) {
+        ++m_pos;  // Opening quote
+        while (m_pos < m_text.size()) {
+            const char c = m_text[m_pos++];
+            if (c == '"') return true;
+            if (static_cast<unsigned char>(c) < 0x20) return false;
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (m_pos >= m_text.size()) return false;
+            switch (m_text[m_pos++]) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    unsigned code;
+                    if (!parseHex4(code)) return false;
+                    if (code >= 0xD800 && code < 0xDC00) {
+                        unsigned low;
+                        if (!literal("\\u") || !parseHex4(low) || low < 0xDC00 || low >= 0xE000) return false;
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        return false;
+    }
+
+    bool parseNumber(JsonValue& value) {
+        const char* begin = m_text.c_str() + m_pos;
+        char* end = nullptr;
+        value.type = JsonValue::Type::Number;
+        value.number = std::strtod(begin, &end);
+        if (end == begin) return false;
+        m_pos += static_cast<size_t>(end - begin);
+        return std::isfinite(value.number);
+    }
+
+    const std::string& m_text;
+    size_t m_pos = 0;
+};
+
+void appendJsonString(std::string& out, const std::string& text)
+{
+    out += '"';
+    for (const char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+                break;
+        }
+    }
+    out += '"';
+}
+
+// Echo the request id back; only strings, numbers and null are valid ids
+void appendJsonId(std::string& out, const JsonValue* id)
+{
+    if (id != nullptr && id->type == JsonValue::Type::String) {
+        appendJsonString(out, id->string);
+    } else if (id != nullptr && id->type == JsonValue::Type::Number) {
+        char number[32];
+        if (id->number == std::floor(id->number) && std::fabs(id->number) < 1e15) {
+            std::snprintf(number, sizeof(number), "%lld", static_cast<long long>(id->number));
+        } else {
+            std::snprintf(number, sizeof(number), "%.17g", id->number);
+        }
+        out += number;
+    } else {
+        out += "null";
+    }
+}
+
+bool getInteger(const JsonValue* params, const char* key, long long minimum, long long maximum, long long& value)
+{
+    const JsonValue* member = params != nullptr ? params->find(key) : nullptr;
+    if (member == nullptr || member->type != JsonValue::Type::Number) return false;
+    if (member->number != std::floor(member->number)) return false;
+    if (member->number < minimum || member->number > maximum) return false;
+    value = static_cast<long long>(member->number);
+    return true;
+}
+
+bool getBool(const JsonValue* params, const char* key, bool& value)
+{
+    const JsonValue* member = params != nullptr ? params->find(key) : nullptr;
+    if (member == nullptr || member->type != JsonValue::Type::Bool) return false;
+    value = member->boolean;
+    return true;
+}
+
+bool getCompare(const JsonValue* params, SearchCompare& compare)
+{
+    static const std::pair<const char*, SearchCompare> names[] = {
+        {"eq", SearchCompare::Equal}, {"ne", SearchCompare::NotEqual},
+        {"lt", SearchCompare::Less}, {"le", SearchCompare::LessOrEqual},
+        {"gt", SearchCompare::Greater}, {"ge", SearchCompare::GreaterOrEqual},
+    };
+    const JsonValue* member = params != nullptr ? params->find("compare") : nullptr;
+    if (member == nullptr || member->type != JsonValue::Type::String) return false;
+    for (const auto& name : names) {
+        if (member->string == name.first) {
+            compare = name.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Outcome of one request, written back as a single line
+ */
+struct Reply {
+    std::string result = "true";   // JSON text of the result member
+    int errorCode = 0;             // Non-zero sends an error instead
+    std::string errorMessage;
+    std::vector<uint8_t> binary;   // Raw bytes sent after the line
+
+    static Reply error(int code, std::string message) {
+        Reply reply;
+        reply.errorCode = code;
+        reply.errorMessage = std::move(message);
+        return reply;
+    }
+};
+
+#ifndef _WIN32
+bool sendAll(int fd, const void* data, size_t size)
+{
+    const auto* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+#ifdef MSG_NOSIGNAL
+        const ssize_t sent = ::send(fd, bytes, size, MSG_NOSIGNAL);
+#else
+        const ssize_t sent = ::send(fd, bytes, size, 0);
+#endif
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        bytes += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+#else
+bool sendAll(int, const void*, size_t)
+{
+    return false;
+}
+#endif
+
+} // namespace
+
+struct ControlServer::Connection {
+    explicit Connection(int descriptor) : fd(descriptor) {}
+
+    int fd;
+    std::string input;
+    size_t discard = 0;   // Payload bytes of a refused writeMemory still to drop
+    bool closing = false; // Close once the current reply is sent
+};
+
+ControlServer::ControlServer(CocoEmulator& emulator)
+    : m_emulator(emulator)
+{
+}
+
+ControlServer::~ControlServer()
+{
+    close();
+}
+
+bool ControlServer::dispatch(Connection& connection, const std::string& line, size_t& payloadSize)
+{
+    payloadSize = 0;
+
+    JsonValue request;
+    const bool parsed = JsonParser(line).parse(request);
+
+    const JsonValue* id = request.find("id");
+    const JsonValue* method = request.find("method");
+    const JsonValue* params = request.find("params");
+    const std::string name = method != nullptr && method->type == JsonValue::Type::String ? method->string : "";
+
+    // writeMemory carries its bytes straight after the request line. A
+    // refused request still has its payload dropped, and one whose length
+    // cannot be read leaves no way to find the next line, so it closes.
+    long long address = 0;
+    long long length = 0;
+    const bool hasLength = getInteger(params, "length", 0, MAX_PAYLOAD_LENGTH, length);
+    const bool hasRange = getInteger(params, "address", 0, MEMORY_SPACE - 1, address)
+        && hasLength && length <= static_cast<long long>(MEMORY_SPACE);
+    if (parsed && name == "writeMemory") {
+        if (hasRange) {
+            payloadSize = static_cast<size_t>(length);
+            const size_t available = connection.input.size() - (line.size() + 1);
+            if (available < payloadSize) {
+                return false;  // Wait for the rest of the payload
+            }
+        } else if (hasLength) {
+            connection.discard = static_cast<size_t>(length);
+        } else {
+            connection.closing = true;
+        }
+    }
+
+    Reply reply;
+    if (!parsed) {
+        reply = Reply::error(PARSE_ERROR, "Parse error");
+    } else if (request.type != JsonValue::Type::Object || method == nullptr || name.empty()) {
+        reply = Reply::error(INVALID_REQUEST, "Invalid request");
+    } else if (params != nullptr && params->type != JsonValue::Type::Object) {
+        reply = Reply::error(INVALID_PARAMS, "params must be an object");
+    } else if (name == "quit") {
+        m_quitRequested = true;
+    } else if (name == "load") {
+        const JsonValue* path = params != nullptr ? params->find("path") : nullptr;
+        if (path == nullptr || path->type != JsonValue::Type::String) {
+            reply = Reply::error(INVALID_PARAMS, "load needs a path");
+        } else if (!m_emulator.loadCartridge(path->string)) {
+            reply = Reply::error(EMULATOR_ERROR, m_emulator.getLastError());
+        }
+    } else if (!m_emulator.isReady()) {
+        reply = name == "reset" || name == "runFrames" || name == "input" || name == "readMemory"
+                || name == "writeMemory" || name == "screenshot" || name == "saveState" || name == "loadState"
+                || name == "searchStart" || name == "searchFilter" || name == "searchResults"
+            ? Reply::error(EMULATOR_ERROR, "Emulator is not initialized")
+            : Reply::error(METHOD_NOT_FOUND, "Method not found");
+    } else if (name == "reset") {
+        bool hard = false;
+        if (params != nullptr && params->find("hard") != nullptr && !getBool(params, "hard", hard)) {
+            reply = Reply::error(INVALID_PARAMS, "hard must be true or false");
+        } else if (hard) {
+            m_emulator.hardReset();
+        } else {
+            m_emulator.reset();
+        }
+    } else if (name == "runFrames") {
+        long long count = 1;
+        if (params != nullptr && params->find("count") != nullptr
+            && !getInteger(params, "count", 0, MAX_FRAMES_PER_REQUEST, count)) {
+            reply = Reply::error(INVALID_PARAMS, "count out of range");
+        } else {
+            for (long long frame = 0; frame < count; ++frame) {
+                m_emulator.runFrame();
+            }
+            reply.result = "{\"frames\":" + std::to_string(count) + "}";
+        }
+    } else if (name == "input") {
+        const JsonValue* type = params != nullptr ? params->find("type") : nullptr;
+        const std::string kind = type != nullptr && type->type == JsonValue::Type::String ? type->string : "";
+        long long joystick = 0, axis = 0, value = 0, row = 0, col = 0, button = 0;
+        bool pressed = false;
+        if (kind == "key" && getInteger(params, "row", 0, 6, row) && getInteger(params, "col", 0, 7, col)
+            && getBool(params, "pressed", pressed)) {
+            m_emulator.setKeyState(static_cast<int>(row), static_cast<int>(col), pressed);
+        } else if (kind == "axis" && getInteger(params, "joystick", 0, 1, joystick)
+            && getInteger(params, "axis", 0, 1, axis) && getInteger(params, "value", 0, 63, value)) {
+            m_emulator.setJoystickAxis(static_cast<int>(joystick), static_cast<int>(axis), static_cast<int>(value));
+        } else if (kind == "button" && getInteger(params, "joystick", 0, 1, joystick)
+            && getInteger(params, "button", 0, 1, button) && getBool(params, "pressed", pressed)) {
+            m_emulator.setJoystickButton(static_cast<int>(joystick), static_cast<int>(button), pressed);
+        } else {
+            reply = Reply::error(INVALID_PARAMS, "Unrecognized input event");
+        }
+    } else if (name == "readMemory" || name == "writeMemory") {
+        if (!hasRange) {
+            reply = Reply::error(INVALID_PARAMS, "address and length are required");
+        } else if (name == "readMemory") {
+            reply.binary.resize(static_cast<size_t>(length));
+            m_emulator.readMemory(static_cast<uint16_t>(address), reply.binary.data(), reply.binary.size());
+            reply.result = "{\"address\":" + std::to_string(address) + ",\"length\":" + std::to_string(length)
+                + ",\"binary\":" + std::to_string(length) + "}";
+        } else {
+            const auto* payload = reinterpret_cast<const uint8_t*>(connection.input.data() + line.size() + 1);
+            m_emulator.writeMemory(static_cast<uint16_t>(address), payload, payloadSize);
+            reply.result = "{\"written\":" + std::to_string(length) + "}";
+        }
+    } else if (name == "screenshot") {
+        const auto info = m_emulator.getFramebufferInfo();
+        const auto pixels = m_emulator.getFramebuffer();
+        reply.binary.assign(pixels.first, pixels.first + pixels.second);
+        reply.result = "{\"width\":" + std::to_string(info.width) + ",\"height\":" + std::to_string(info.height)
+            + ",\"pitch\":" + std::to_string(info.pitch) + ",\"format\":\"RGBA8888\",\"binary\":"
+            + std::to_string(reply.binary.size()) + "}";
+    } else if (name == "searchStart") {
+        long long width = 1;
+        if (params != nullptr && params->find("width") != nullptr && !getInteger(params, "width", 1, 2, width)) {
+            reply = Reply::error(INVALID_PARAMS, "width must be 1 or 2");
+        } else {
+            const auto ram = m_emulator.getRam();
+            m_search.start(ram.first, ram.second, width == 2 ? SearchWidth::Word : SearchWidth::Byte);
+            reply.result = "{\"candidates\":" + std::to_string(m_search.count()) + "}";
+        }
+    } else if (name == "searchFilter" || name == "searchResults") {
+        const auto ram = m_emulator.getRam();
+        SearchCompare compare = SearchCompare::Equal;
+        long long value = 0, delta = 0, limit = DEFAULT_SEARCH_RESULTS;
+        const long long maximum = m_search.width() == SearchWidth::Word ? 0xFFFF : 0xFF;
+        if (m_search.memorySize() == 0 || m_search.memorySize() != ram.second) {
+            reply = Reply::error(EMULATOR_ERROR, "No search in progress; call searchStart first");
+        } else if (name == "searchResults") {
+            if (params != nullptr && params->find("limit") != nullptr
+                && !getInteger(params, "limit", 0, MAX_SEARCH_RESULTS, limit)) {
+                reply = Reply::error(INVALID_PARAMS, "limit out of range");
+            } else {
+                reply.result = "{\"candidates\":" + std::to_string(m_search.count()) + ",\"addresses\":[";
+                const auto addresses = m_search.candidates(static_cast<size_t>(limit));
+                for (size_t i = 0; i < addresses.size(); ++i) {
+                    reply.result += (i > 0 ? "," : "") + std::to_string(addresses[i]);
+                }
+                reply.result += "]}";
+            }
+        } else if (!getCompare(params, compare)) {
+            reply = Reply::error(INVALID_PARAMS, "compare must be eq, ne, lt, le, gt or ge");
+        } else if (params->find("value") != nullptr) {
+            if (!getInteger(params, "value", 0, maximum, value)) {
+                reply = Reply::error(INVALID_PARAMS, "value out of range");
+            } else {
+                m_search.filter(ram.first, compare, static_cast<uint16_t>(value));
+                reply.result = "{\"candidates\":" + std::to_string(m_search.count()) + "}";
+            }
+        } else if (params->find("delta") != nullptr && !getInteger(params, "delta", -maximum, maximum, delta)) {
+            reply = Reply::error(INVALID_PARAMS, "delta out of range");
+        } else {
+            m_search.filterRelative(ram.first, compare, static_cast<int>(delta));
+            reply.result = "{\"candidates\":" + std::to_string(m_search.count()) + "}";
+        }
+    } else if ((name == "saveState" || name == "loadState") && m_stateStore == nullptr) {
+        reply = Reply::error(EMULATOR_ERROR, "No state store is configured");
+    } else if (name == "saveState") {
+        MachineState state;
+        std::string stateId;
+        if (!m_emulator.saveState(state)) {
+            reply = Reply::error(EMULATOR_ERROR, m_emulator.getLastError());
+        } else if ((stateId = m_stateStore->save(state)).empty()) {
+            reply = Reply::error(EMULATOR_ERROR, m_stateStore->getLastError());
+        } else {
+            reply.result = "{\"id\":\"" + stateId + "\"}";
+        }
+    } else if (name == "loadState") {
+        const JsonValue* stateId = params != nullptr ? params->find("id") : nullptr;
+        MachineState state;
+        if (stateId == nullptr || stateId->type != JsonValue::Type::String) {
+            reply = Reply::error(INVALID_PARAMS, "loadState needs an id");
+        } else if (!m_stateStore->load(stateId->string, state)) {
+            reply = Reply::error(EMULATOR_ERROR, m_stateStore->getLastError());
+        } else if (!m_emulator.loadState(state)) {
+            reply = Reply::error(EMULATOR_ERROR, m_emulator.getLastError());
+        }
+    } else {
+        reply = Reply::error(METHOD_NOT_FOUND, "Method not found");
+    }
+
+    // Notifications get no reply at all, binary included
+    if (parsed && id == nullptr && request.type == JsonValue::Type::Object) {
+        return true;
+    }
+
+    std::string text = "{\"jsonrpc\":\"2.0\",\"id\":";
+    appendJsonId(text, id);
+    if (reply.errorCode != 0) {
+        text += ",\"error\":{\"code\":" + std::to_string(reply.errorCode) + ",\"message\":";
+        appendJsonString(text, reply.errorMessage);
+        text += "}}\n";
+        reply.binary.clear();
+    } else {
+        text += ",\"result\":" + reply.result + "}\n";
+    }
+
+    if (sendAll(connection.fd, text.data(), text.size()) && !reply.binary.empty()) {
+        sendAll(connection.fd, reply.binary.data(), reply.binary.size());
+    }
+    return true;
+}
+
+#ifndef _WIN32
+
+bool ControlServer::listenOn(int fd)
+{
+    if (::listen(fd, 4) < 0) {
+        ::close(fd);
+        return false;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    m_listeners.push_back(fd);
+    return true;
+}
+
+bool ControlServer::listenUnix(const std::filesystem::path& path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    const std::string name = path.string();
+    if (name.empty() || name.size() >= sizeof(address.sun_path)) return false;
+    std::memcpy(address.sun_path, name.c_str(), name.size() + 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    ::unlink(name.c_str());
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+        ::close(fd);
+        return false;
+    }
+    if (!listenOn(fd)) return false;
+
+    m_socketPath = path;
+    return true;
+}
+
+bool ControlServer::listenTcp(uint16_t port)
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    const int reuse = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(port);
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) < 0) {
+        ::close(fd);
+        return false;
+    }
+
+    socklen_t length = sizeof(address);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+    if (!listenOn(fd)) return false;
+
+    m_port = ntohs(address.sin_port);
+    return true;
+}
+
+bool ControlServer::addConnection(int fd)
+{
+    if (fd < 0) return false;
+
+    // Disable Nagle so small replies are not held back behind the last one
+    const int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+    m_connections.push_back(std::make_unique<Connection>(fd));
+    return true;
+}
+
+void ControlServer::serveForked(int fd)
+{
+    // Buffered output would otherwise be written once by each process
+    std::fflush(nullptr);
+
+    const pid_t child = ::fork();
+    if (child < 0) {
+        ::close(fd);
+        return;
+    }
+    if (child > 0) {
+        ::close(fd);
+        m_children.push_back(child);
+        return;
+    }
+
+    // The child keeps only its own connection; the socket file stays put
+    for (const int listener : m_listeners) {
+        ::close(listener);
+    }
+    m_listeners.clear();
+    for (const auto& connection : m_connections) {
+        ::close(connection->fd);
+    }
+    m_connections.clear();
+    m_children.clear();
+    m_socketPath.clear();
+
+    addConnection(fd);
+    while (poll(-1) && !m_connections.empty()) {
+    }
+
+    // Skip the parent's atexit handlers and static destructors
+    std::fflush(nullptr);
+    ::_exit(0);
+}
+
+void ControlServer::reapChildren()
+{
+    for (auto it = m_children.begin(); it != m_children.end();) {
+        const pid_t result = ::waitpid(*it, nullptr, WNOHANG);
+        if (result == *it || (result < 0 && errno == ECHILD)) {
+            it = m_children.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool ControlServer::service(Connection& connection)
+{
+    char buffer[64 * 1024];
+    const ssize_t received = ::recv(connection.fd, buffer, sizeof(buffer), 0);
+    if (received < 0) return errno == EINTR || errno == EAGAIN;
+    if (received == 0) return false;
+    connection.input.append(buffer, static_cast<size_t>(received));
+
+    for (;;) {
+        const size_t dropped = std::min(connection.discard, connection.input.size());
+        connection.input.erase(0, dropped);
+        connection.discard -= dropped;
+        if (connection.discard > 0) {
+            return true;
+        }
+
+        const size_t end = connection.input.find('\n');
+        if (end == std::string::npos) {
+            return connection.input.size() <= MAX_REQUEST_LINE;
+        }
+
+        const std::string line = connection.input.substr(0, end);
+        size_t payloadSize = 0;
+        if (!dispatch(connection, line, payloadSize)) {
+            return true;  // Payload still arriving
+        }
+        connection.input.erase(0, end + 1 + payloadSize);
+        if (connection.closing) {
+            return false;
+        }
+    }
+}
+
+bool ControlServer::poll(int timeoutMs)
+{
+    reapChildren();
+
+    std::vector<pollfd> descriptors;
+    descriptors.reserve(m_listeners.size() + m_connections.size());
+    for (const int fd : m_listeners) {
+        descriptors.push_back({fd, POLLIN, 0});
+    }
+    for (const auto& connection : m_connections) {
+        descriptors.push_back({connection->fd, POLLIN, 0});
+    }
+
+    if (!descriptors.empty() && ::poll(descriptors.data(), descriptors.size(), timeoutMs) > 0) {
+        // Serve existing connections first; accepting appends to m_connections
+        const size_t listenerCount = m_listeners.size();
+        size_t index = listenerCount;
+        for (auto it = m_connections.begin(); it != m_connections.end(); ++index) {
+            const auto events = descriptors[index].revents;
+            if (events != 0 && !((events & POLLIN) && service(**it))) {
+                ::close((*it)->fd);
+                it = m_connections.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        for (size_t listener = 0; listener < listenerCount; ++listener) {
+            if (descriptors[listener].revents & POLLIN) {
+                const int fd = ::accept(descriptors[listener].fd, nullptr, nullptr);
+                if (fd >= 0 && m_forkPerConnection) {
+                    serveForked(fd);
+                } else if (fd >= 0) {
+                    fcntl(fd, F_SETFD, FD_CLOEXEC);
+                    addConnection(fd);
+                }
+            }
+        }
+    }
+
+    return !m_quitRequested;
+}
+
+void ControlServer::close()
+{
+    for (const int fd : m_listeners) {
+        ::close(fd);
+    }
+    m_listeners.clear();
+
+    for (const auto& connection : m_connections) {
+        ::close(connection->fd);
+    }
+    m_connections.clear();
+
+    if (!m_socketPath.empty()) {
+        ::unlink(m_socketPath.c_str());
+        m_socketPath.clear();
+    }
+    m_port = 0;
+}
+
+#else
+
+bool ControlServer::listenOn(int)
+{
+    return false;
+}
+
+bool ControlServer::listenUnix(const std::filesystem::path&)
+{
+    return false;
+}
+
+bool ControlServer::listenTcp(uint16_t)
+{
+    return false;
+}
+
+bool ControlServer::addConnection(int)
+{
+    return false;
+}
+
+void ControlServer::serveForked(int)
+{
+}
+
+void ControlServer::reapChildren()
+{
+}
+
+bool ControlServer::service(Connection&)
+{
+    return false;
+}
+
+bool ControlServer::poll(int)
+{
+    return !m_quitRequested;
+}
+
+void ControlServer::close()
+{
+}
+
+#endif
+
+} // namespace cutie
@@ -0,0 +1,341 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/disassembler.h"
+#include "OpCodeTables.h"
+#include "tcc1014mmu.h"
+#include <cstdio>
+
+namespace cutie {
+
+namespace {
+    using OpCodeTables = VCC::Debugger::OpCodeTables;
+    using OpCodeInfo = OpCodeTables::OpCodeInfo;
+
+    // Opcode names, modes and lengths come from the debugger's tables
+    const OpCodeTables& opCodeTables()
+    {
+        static const OpCodeTables tables;
+        return tables;
+    }
+
+    // Register numbers in EXG, TFR, TFM and the 6309 register to register
+    // instructions
+    const char* const InterRegisters[16] = {
+        "D", "X", "Y", "U", "S", "PC", "W", "V", "A", "B", "CC", "DP", "0", "0", "E", "F",
+    };
+    const char* const IndexRegisters[4] = {"X", "Y", "U", "S"};
+    const char* const BitRegisters[4] = {"CC", "A", "B", "?"};
+
+    std::string hex(unsigned value, int digits)
+    {
+        char text[8];
+        std::snprintf(text, sizeof(text), "$%0*X", digits, value);
+        return text;
+    }
+
+    std::string signedHex(int value, int digits)
+    {
+        return value < 0 ? "-" + hex(static_cast<unsigned>(-value), digits) : hex(static_cast<unsigned>(value), digits);
+    }
+
+    // Bytes that follow an indexed postbyte
+    unsigned indexedExtra(uint8_t post, bool hd6309)
+    {
+        if (!(post & 0x80)) {
+            return 0;
+        }
+        if (hd6309 && (post == 0xAF || post == 0xB0)) {  // n,W and [n,W]
+            return 2;
+        }
+        switch (post & 0x0F) {
+        case 0x08:
+        case 0x0C:
+            return 1;
+        case 0x09:
+        case 0x0D:
+            return 2;
+        case 0x0F:
+            return (post & 0x10) ? 2 : 0;  // [n]
+        default:
+            return 0;
+        }
+    }
+
+    std::string indexedOperand(const uint8_t* bytes, unsigned at, uint16_t next, bool hd6309)
+    {
+        const uint8_t post = bytes[at];
+        const std::string reg = IndexRegisters[(post >> 5) & 3];
+        if (!(post & 0x80)) {
+            const int offset = (post & 0x10) ? static_cast<int>(post & 0x1F) - 32 : post & 0x1F;
+            return signedHex(offset, 2) + "," + reg;
+        }
+
+        const int offset8 = static_cast<int8_t>(bytes[at + 1]);
+        const int offset16 = static_cast<int16_t>(bytes[at + 1] << 8 | bytes[at + 2]);
+        if (hd6309) {
+            // The W register takes over postbytes that are unused on the 6809
+            switch (post) {
+            case 0x8F: return ",W";
+            case 0xAF: return signedHex(offset16, 4) + ",W";
+            case 0xCF: return ",W++";
+            case 0xEF: return ",--W";
+            case 0x90: return "[,W]";
+            case 0xB0: return "[" + signedHex(offset16, 4) + ",W]";
+            case 0xD0: return "[,W++]";
+            case 0xF0: return "[,--W]";
+            default: break;
+            }
+        }
+
+        std::string form;
+        switch (post & 0x0F) {
+        case 0x00: form = "," + reg + "+"; break;
+        case 0x01: form = "," + reg + "++"; break;
+        case 0x02: form = ",-" + reg; break;
+        case 0x03: form = ",--" + reg; break;
+        case 0x04: form = "," + reg; break;
+        case 0x05: form = "B," + reg; break;
+        case 0x06: form = "A," + reg; break;
+        case 0x07: form = "E," + reg; break;
+        case 0x08: form = signedHex(offset8, 2) + "," + reg; break;
+        case 0x09: form = signedHex(offset16, 4) + "," + reg; break;
+        case 0x0A: form = "F," + reg; break;
+        case 0x0B: form = "D," + reg; break;
+        case 0x0C: form = hex(static_cast<uint16_t>(next + offset8), 4) + ",PCR"; break;
+        case 0x0D: form = hex(static_cast<uint16_t>(next + offset16), 4) + ",PCR"; break;
+        case 0x0E: form = "W," + reg; break;
+        case 0x0F: form = hex(static_cast<uint16_t>(offset16), 4); break;
+        }
+        return (post & 0x10) ? "[" + form + "]" : form;
+    }
+
+    std::string registerList(uint8_t post, bool userStack)
+    {
+        const char* const names[8] = {"CC", "A", "B", "DP", "X", "Y", userStack ? "S" : "U", "PC"};
+        std::string list;
+        for (int bit = 0; bit < 8; ++bit) {
+            if (post & (1 << bit)) {
+                list += list.empty() ? names[bit] : std::string(",") + names[bit];
+            }
+        }
+        return list;
+    }
+
+    // OIM, AIM, EIM and TIM in their direct, indexed and extended forms
+    bool isImmediateMemory(const OpCodeInfo& info)
+    {
+        const unsigned row = info.opcode >> 4;
+        const unsigned column = info.opcode & 0x0F;
+        return info.oplen == 1 && (row == 0x0 || row == 0x6 || row == 0x7)
+            && (column == 0x1 || column == 0x2 || column == 0x5 || column == 0xB);
+    }
+}
+
+void DisassemblyCache::setHD6309(bool hd6309)
+{
+    if (hd6309 != m_hd6309) {
+        m_hd6309 = hd6309;
+        clear();
+    }
+}
+
+void DisassemblyCache::clear()
+{
+    m_lines.clear();
+}
+
+const DisassembledLine& DisassemblyCache::at(uint16_t address)
+{
+    const unsigned long location = MemLocate(address);
+    if (location != MemIoSpace) {
+        auto found = m_lines.find(location);
+        if (found != m_lines.end() && isCurrent(found->second, location, address)) {
+            return found->second.line;
+        }
+        Entry& entry = found != m_lines.end() ? found->second : m_lines[location];
+        decode(address, entry.line);
+        entry.last = MemLocate(static_cast<uint16_t>(address + entry.line.length - 1));
+        if (entry.last != MemIoSpace) {
+            remember(entry, location);
+            return entry.line;
+        }
+        m_lines.erase(location);
+    }
+    decode(address, m_uncached);
+    return m_uncached;
+}
+
+std::vector<DisassembledLine> DisassemblyCache::lines(uint16_t address, size_t count)
+{
+    std::vector<DisassembledLine> result;
+    result.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        result.push_back(at(address));
+        address = static_cast<uint16_t>(address + result.back().length);
+    }
+    return result;
+}
+
+uint16_t DisassemblyCache::previous(uint16_t address)
+{
+    // Walks from different starting points fall into step within a few
+    // instructions, so the furthest start that lands exactly on address
+    // gives the most likely boundary
+    constexpr unsigned Window = 8 * MaxLength;
+    const unsigned back = address < Window ? address : Window;
+    for (unsigned start = back; start > 0; --start) {
+        unsigned pc = address - start;
+        unsigned last = pc;
+        while (pc < address) {
+            last = pc;
+            pc += at(static_cast<uint16_t>(pc)).length;
+        }
+        if (pc == address) {
+            return static_cast<uint16_t>(last);
+        }
+    }
+    return static_cast<uint16_t>(address - 1);
+}
+
+bool DisassemblyCache::isCurrent(Entry& entry, unsigned long location, uint16_t address)
+{
+    DisassembledLine& line = entry.line;
+    if (line.address != address
+        || MemLocate(static_cast<uint16_t>(address + line.length - 1)) != entry.last) {
+        return false;
+    }
+    const bool rom = (location | entry.last) & MemCartSpace;
+    if (!rom && entry.epoch == MemEpoch() && entry.firstWrites == MemBankWrites(location)
+        && entry.lastWrites == MemBankWrites(entry.last)) {
+        return true;
+    }
+    for (unsigned i = 0; i < line.length; ++i) {
+        if (SafeMemRead8(static_cast<uint16_t>(address + i)) != line.bytes[i]) {
+            return false;
+        }
+    }
+    remember(entry, location);
+    return true;
+}
+
+void DisassemblyCache::remember(Entry& entry, unsigned long location)
+{
+    entry.firstWrites = MemBankWrites(location);
+    entry.lastWrites = MemBankWrites(entry.last);
+    entry.epoch = MemEpoch();
+}
+
+void DisassemblyCache::decode(uint16_t address, DisassembledLine& line)
+{
+    ++m_decodes;
+    const OpCodeTables& tables = opCodeTables();
+    uint8_t* bytes = line.bytes;
+    auto fetch = [&](unsigned count) {
+        for (unsigned i = 0; i < count; ++i) {
+            bytes[i] = SafeMemRead8(static_cast<uint16_t>(address + i));
+        }
+    };
+
+    line.address = address;
+    line.operand.clear();
+    fetch(2);
+    const OpCodeInfo* info = &tables.Page1OpCodes[bytes[0]];
+    if (info->mode == OpCodeTables::OpPage2) {
+        info = &tables.Page2OpCodes[bytes[1]];
+    } else if (info->mode == OpCodeTables::OpPage3) {
+        info = &tables.Page3OpCodes[bytes[1]];
+    }
+    if (info->mode == OpCodeTables::Illegal || (info->only6309 && !m_hd6309)) {
+        line.length = 1;
+        line.mnemonic = "FCB";
+        line.operand = hex(bytes[0], 2);
+        return;
+    }
+
+    // OIM and friends put their immediate byte before the usual operand
+    const unsigned opcodeLength = static_cast<unsigned>(info->oplen);
+    const bool immediateMemory = isImmediateMemory(*info);
+    const unsigned at = opcodeLength + (immediateMemory ? 1 : 0);
+    unsigned length = static_cast<unsigned>(info->numbytes);
+    if (info->mode == OpCodeTables::Indexed) {
+        fetch(at + 1);
+        length += indexedExtra(bytes[at], m_hd6309);
+    }
+    fetch(length);
+    line.length = static_cast<uint8_t>(length);
+    line.mnemonic = info->name;
+
+    const uint16_t next = static_cast<uint16_t>(address + length);
+    const unsigned operandLength = length - at;
+    const unsigned value = operandLength >= 2 ? (bytes[at] << 8 | bytes[at + 1]) : bytes[at];
+    const uint8_t opcode = info->opcode;
+    const bool page1 = opcodeLength == 1;
+    const bool page2 = !page1 && bytes[0] == 0x10;
+    const bool page3 = !page1 && bytes[0] == 0x11;
+
+    switch (info->mode) {
+    case OpCodeTables::Inherent:
+        if (page1 && opcode >= 0x34 && opcode <= 0x37) {
+            line.operand = registerList(bytes[1], opcode >= 0x36);
+        }
+        break;
+    case OpCodeTables::Immediate:
+        if ((page1 && (opcode == 0x1E || opcode == 0x1F))
+            || (page2 && opcode >= 0x30 && opcode <= 0x37)) {
+            line.operand = std::string(InterRegisters[bytes[at] >> 4]) + "," + InterRegisters[bytes[at] & 0x0F];
+        } else if (page3 && opcode >= 0x38 && opcode <= 0x3B) {
+            const char* const forms[4][2] = {{"+", "+"}, {"-", "-"}, {"+", ""}, {"", "+"}};
+            line.operand = std::string(InterRegisters[bytes[at] >> 4]) + forms[opcode - 0x38][0] + ","
+                + InterRegisters[bytes[at] & 0x0F] + forms[opcode - 0x38][1];
+        } else if (operandLength == 4) {
+            line.operand = "#" + hex(value, 4) + hex(bytes[at + 2] << 8 | bytes[at + 3], 4).substr(1);
+        } else {
+            line.operand = "#" + hex(value, operandLength * 2);
+        }
+        break;
+    case OpCodeTables::Direct:
+        if (page3 && opcode >= 0x30 && opcode <= 0x37) {
+            const uint8_t post = bytes[at];
+            line.operand = std::string(BitRegisters[post >> 6]) + "," + std::to_string((post >> 3) & 7) + ","
+                + std::to_string(post & 7) + ",<" + hex(bytes[at + 1], 2);
+        } else {
+            line.operand = "<" + hex(value, 2);
+        }
+        break;
+    case OpCodeTables::Extended:
+        line.operand = hex(value, 4);
+        break;
+    case OpCodeTables::Indexed:
+        line.operand = indexedOperand(bytes, at, next, m_hd6309);
+        break;
+    case OpCodeTables::Relative:
+        line.operand = hex(static_cast<uint16_t>(next + static_cast<int8_t>(value)), 4);
+        break;
+    case OpCodeTables::LongRelative:
+        line.operand = hex(static_cast<uint16_t>(next + value), 4);
+        break;
+    default:
+        break;
+    }
+    if (immediateMemory) {
+        line.operand = "#" + hex(bytes[opcodeLength], 2) + "," + line.operand;
+    }
+}
+
+} // namespace cutie
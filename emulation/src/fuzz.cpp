@@ -0,0 +1,207 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/fuzz.h"
+#include "cutie/stubs.h"
+#include "mc6809.h"
+#include "hd6309.h"
+#include "tcc1014mmu.h"
+#include <algorithm>
+#include <cstring>
+
+bool FuzzArmed = false;
+unsigned char* FuzzCoverage = nullptr;
+unsigned short FuzzPreviousLocation = 0;
+unsigned char FuzzStops[0x2000] = {};
+
+namespace cutie {
+
+namespace {
+    // The harness the CPU cores report to
+    FuzzHarness* g_harness = nullptr;
+
+    constexpr unsigned long PageSize = 0x2000;
+
+    // Cycles per CPUExec() call; the budget is checked between them
+    constexpr int SliceCycles = 20000;
+
+    bool isHD6309()
+    {
+        return CPUExec == HD6309Exec;
+    }
+
+    void markStop(uint16_t pc)
+    {
+        FuzzStops[pc >> 3] |= static_cast<unsigned char>(1 << (pc & 7));
+    }
+}
+
+FuzzHarness::FuzzHarness(CocoEmulator& emulator)
+    : m_emulator(emulator)
+    , m_ownMap(MapSize)
+    , m_map(m_ownMap.data())
+{
+}
+
+FuzzHarness::~FuzzHarness()
+{
+    end();
+}
+
+bool FuzzHarness::begin(const Target& target)
+{
+    if (g_harness != nullptr && g_harness != this) {
+        m_lastError = "Another fuzzing harness is active";
+        return false;
+    }
+    if (!m_emulator.isReady()) {
+        m_lastError = "Emulator is not initialized";
+        return false;
+    }
+    if (target.exits.empty()) {
+        m_lastError = "Target has no exit address";
+        return false;
+    }
+    end();
+
+    // Runs start with the program counter at the entry point
+    VCC::CPUState regs = isHD6309() ? HD6309GetState() : MC6809GetState();
+    regs.PC = target.entry;
+    if (isHD6309()) {
+        HD6309SetState(regs);
+    } else {
+        MC6809SetState(regs);
+    }
+    if (!m_emulator.saveState(m_snapshot)) {
+        m_lastError = m_emulator.getLastError();
+        return false;
+    }
+
+    m_target = target;
+    m_pageWrites.resize(m_snapshot.ram.size() / PageSize);
+    for (size_t page = 0; page < m_pageWrites.size(); ++page) {
+        m_pageWrites[page] = MemBankWrites(page * PageSize);
+    }
+
+    std::memset(FuzzStops, 0, sizeof(FuzzStops));
+    for (const uint16_t pc : target.exits) {
+        markStop(pc);
+    }
+    for (const uint16_t pc : target.crashes) {
+        markStop(pc);
+    }
+    g_harness = this;
+    FuzzCoverage = m_map;
+    FuzzArmed = true;
+    m_active = true;
+    m_stats = Stats();
+    return true;
+}
+
+void FuzzHarness::end()
+{
+    if (!m_active) {
+        return;
+    }
+    FuzzArmed = false;
+    FuzzCoverage = nullptr;
+    g_harness = nullptr;
+    m_active = false;
+}
+
+void FuzzHarness::setCoverageMap(uint8_t* map)
+{
+    m_map = map != nullptr ? map : m_ownMap.data();
+    if (m_active) {
+        FuzzCoverage = m_map;
+    }
+}
+
+size_t FuzzHarness::edgeCount() const
+{
+    return MapSize - static_cast<size_t>(std::count(m_map, m_map + MapSize, 0));
+}
+
+void FuzzHarness::restore()
+{
+    // Every RAM write counts against its bank, so untouched pages are skipped
+    for (size_t page = 0; page < m_pageWrites.size(); ++page) {
+        const unsigned long location = page * PageSize;
+        if (MemBankWrites(location) != m_pageWrites[page]) {
+            MemWritePhysical(m_snapshot.ram.data() + location, location, PageSize);
+            m_pageWrites[page] = MemBankWrites(location);
+            ++m_stats.pagesRestored;
+        }
+    }
+    m_emulator.loadDeviceState(m_snapshot);
+}
+
+FuzzHarness::Result FuzzHarness::run(const uint8_t* data, size_t size)
+{
+    m_result = Result();
+    if (!m_active) {
+        return m_result;
+    }
+
+    restore();
+    const size_t length = std::min(size, static_cast<size_t>(m_target.inputCapacity));
+    m_emulator.writeMemory(m_target.inputAddress, data, length);
+    if (m_target.lengthAddress != 0) {
+        const uint8_t bytes[2] = {static_cast<uint8_t>(length >> 8), static_cast<uint8_t>(length)};
+        m_emulator.writeMemory(m_target.lengthAddress, bytes, sizeof(bytes));
+    }
+
+    std::memset(m_map, 0, MapSize);
+    FuzzPreviousLocation = 0;
+    m_stopped = false;
+    ++m_stats.runs;
+
+    uint64_t cycles = 0;
+    while (!m_stopped && cycles < m_target.maxCycles) {
+        const int slice = static_cast<int>(std::min<uint64_t>(SliceCycles, m_target.maxCycles - cycles));
+        const int used = slice - CPUExec(slice);
+        if (used <= 0) {
+            break;  // Halted by the debugger
+        }
+        cycles += static_cast<uint64_t>(used);
+    }
+
+    m_result.cycles = cycles;
+    if (!m_stopped) {
+        m_result.outcome = Outcome::Hang;
+        m_result.pc = (isHD6309() ? HD6309GetState() : MC6809GetState()).PC;
+    }
+    return m_result;
+}
+
+void FuzzHarness::onStop(uint16_t pc)
+{
+    const bool exit = std::find(m_target.exits.begin(), m_target.exits.end(), pc) != m_target.exits.end();
+    m_result.outcome = exit ? Outcome::Exit : Outcome::Crash;
+    m_result.pc = pc;
+    m_stopped = true;
+}
+
+} // namespace cutie
+
+void FuzzStop(unsigned short pc)
+{
+    if (cutie::g_harness) {
+        cutie::g_harness->onStop(pc);
+    }
+}
@@ -0,0 +1,362 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/gamepad.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef __linux__
+#include <cerrno>
+#include <filesystem>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace cutie {
+
+int mapAxisValue(int32_t raw, const AxisCalibration& calibration)
+{
+    const int64_t minimum = calibration.minimum;
+    const int64_t maximum = calibration.maximum;
+    if (maximum <= minimum) return AXIS_CENTER;
+
+    const int64_t middle = minimum + (maximum - minimum) / 2;
+    const int64_t flat = std::max<int64_t>(calibration.flat, 0);
+    const int64_t value = std::clamp<int64_t>(raw, minimum, maximum);
+
+    // Travel below the dead zone covers 0-32, travel above it 32-63
+    const int64_t lowEnd = middle - flat;
+    const int64_t highStart = middle + flat;
+    if (value < lowEnd) {
+        return static_cast<int>((value - minimum) * AXIS_CENTER / (lowEnd - minimum));
+    }
+    if (value > highStart && maximum > highStart) {
+        return AXIS_CENTER + static_cast<int>(
+            (value - highStart) * (AXIS_MAX - AXIS_CENTER) / (maximum - highStart));
+    }
+    return AXIS_CENTER;
+}
+
+GamepadMapper::GamepadMapper(int joystick, const AxisCalibration& x, const AxisCalibration& y)
+    : m_joystick(joystick)
+    , m_calibration{x, y}
+{
+}
+
+void GamepadMapper::apply(const GamepadEvent& event, Joystick& target) const
+{
+    if (event.type == GAMEPAD_EV_ABS) {
+        switch (event.code) {
+            case GAMEPAD_ABS_X:
+                target.setAxis(m_joystick, AXIS_X, mapAxisValue(event.value, m_calibration[AXIS_X]));
+                break;
+            case GAMEPAD_ABS_Y:
+                target.setAxis(m_joystick, AXIS_Y, mapAxisValue(event.value, m_calibration[AXIS_Y]));
+                break;
+            case GAMEPAD_ABS_HAT0X:
+            case GAMEPAD_ABS_HAT0Y: {
+                // D-pad reports -1, 0 or 1
+                const int value = event.value < 0 ? AXIS_MIN : (event.value > 0 ? AXIS_MAX : AXIS_CENTER);
+                target.setAxis(m_joystick, event.code == GAMEPAD_ABS_HAT0X ? AXIS_X : AXIS_Y, value);
+                break;
+            }
+            default:
+                break;
+        }
+    } else if (event.type == GAMEPAD_EV_KEY) {
+        switch (event.code) {
+            case GAMEPAD_BTN_SOUTH:
+            case GAMEPAD_BTN_TRIGGER:
+                target.setButton(m_joystick, BUTTON_1, event.value != 0);
+                break;
+            case GAMEPAD_BTN_EAST:
+            case GAMEPAD_BTN_THUMB:
+                target.setButton(m_joystick, BUTTON_2, event.value != 0);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+#ifdef __linux__
+
+struct GamepadInput::Device {
+    Device(int descriptor, const GamepadMapper& deviceMapper)
+        : fd(descriptor)
+        , mapper(deviceMapper)
+    {
+    }
+
+    int fd;
+    GamepadMapper mapper;
+    std::atomic<bool> open{true};
+
+    // Pipes may deliver partial records; evdev nodes never do
+    std::array<unsigned char, sizeof(input_event) * 64> buffer{};
+    size_t pending = 0;
+};
+
+namespace {
+
+bool testBit(const std::vector<unsigned long>& bits, unsigned int bit)
+{
+    constexpr unsigned int bitsPerWord = sizeof(unsigned long) * 8;
+    return (bits[bit / bitsPerWord] >> (bit % bitsPerWord)) & 1;
+}
+
+std::vector<unsigned long> eventBits(int fd, unsigned int type, unsigned int maxCode)
+{
+    constexpr unsigned int bitsPerWord = sizeof(unsigned long) * 8;
+    std::vector<unsigned long> bits(maxCode / bitsPerWord + 1, 0);
+    if (ioctl(fd, EVIOCGBIT(type, bits.size() * sizeof(unsigned long)), bits.data()) < 0) {
+        std::fill(bits.begin(), bits.end(), 0);
+    }
+    return bits;
+}
+
+AxisCalibration readCalibration(int fd, unsigned int axis)
+{
+    AxisCalibration calibration;
+    input_absinfo info{};
+    if (ioctl(fd, EVIOCGABS(axis), &info) == 0) {
+        calibration.minimum = info.minimum;
+        calibration.maximum = info.maximum;
+        calibration.flat = info.flat;
+    }
+    return calibration;
+}
+
+} // namespace
+
+GamepadInput::GamepadInput(Joystick& target)
+    : m_target(target)
+{
+    m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (m_epollFd >= 0 && m_wakeFd >= 0) {
+        epoll_event wake{};
+        wake.events = EPOLLIN;
+        wake.data.ptr = nullptr;
+        epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &wake);
+    }
+}
+
+GamepadInput::~GamepadInput()
+{
+    stop();
+    if (m_wakeFd >= 0) close(m_wakeFd);
+    if (m_epollFd >= 0) close(m_epollFd);
+}
+
+size_t GamepadInput::openAttachedDevices()
+{
+    namespace fs = std::filesystem;
+
+    std::error_code error;
+    fs::directory_iterator entries("/dev/input", error);
+    if (error) return 0;
+
+    std::vector<fs::path> candidates;
+    for (const auto& entry : entries) {
+        if (entry.path().filename().string().rfind("event", 0) == 0) {
+            candidates.push_back(entry.path());
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    size_t opened = 0;
+    for (const auto& path : candidates) {
+        if (deviceCount() >= JOYSTICK_COUNT) break;
+
+        const int fd = open(path.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) continue;
+
+        const auto absBits = eventBits(fd, EV_ABS, ABS_MAX);
+        const auto keyBits = eventBits(fd, EV_KEY, KEY_MAX);
+        const bool isGamepad = testBit(absBits, ABS_X)
+            && (testBit(keyBits, BTN_GAMEPAD) || testBit(keyBits, BTN_JOYSTICK));
+        if (!isGamepad) {
+            close(fd);
+            continue;
+        }
+
+        // First device drives the right joystick, which most CoCo games read
+        const int joystick = deviceCount() == 0 ? JOYSTICK_RIGHT : JOYSTICK_LEFT;
+        if (addDevice(fd, GamepadMapper(joystick, readCalibration(fd, ABS_X), readCalibration(fd, ABS_Y)))) {
+            ++opened;
+        }
+    }
+    return opened;
+}
+
+bool GamepadInput::addDevice(int fd, const GamepadMapper& mapper)
+{
+    if (fd < 0) return false;
+    if (m_epollFd < 0) {
+        close(fd);
+        return false;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    auto device = std::make_unique<Device>(fd, mapper);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.ptr = device.get();
+
+    std::lock_guard<std::mutex> lock(m_devicesMutex);
+    if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+        close(fd);
+        return false;
+    }
+    m_devices.push_back(std::move(device));
+    return true;
+}
+
+size_t GamepadInput::deviceCount() const
+{
+    std::lock_guard<std::mutex> lock(m_devicesMutex);
+    return std::count_if(m_devices.begin(), m_devices.end(),
+        [](const auto& device) { return device->open.load(std::memory_order_acquire); });
+}
+
+bool GamepadInput::start()
+{
+    if (m_thread.joinable()) return true;
+    if (m_epollFd < 0 || m_wakeFd < 0) return false;
+
+    m_thread = std::thread(&GamepadInput::run, this);
+    return true;
+}
+
+void GamepadInput::stop()
+{
+    if (m_thread.joinable()) {
+        const uint64_t wake = 1;
+        [[maybe_unused]] auto written = write(m_wakeFd, &wake, sizeof(wake));
+        m_thread.join();
+
+        uint64_t drained = 0;
+        [[maybe_unused]] auto drainedBytes = read(m_wakeFd, &drained, sizeof(drained));
+    }
+
+    std::lock_guard<std::mutex> lock(m_devicesMutex);
+    for (auto& device : m_devices) {
+        if (device->open.exchange(false)) {
+            epoll_ctl(m_epollFd, EPOLL_CTL_DEL, device->fd, nullptr);
+            close(device->fd);
+        }
+    }
+    m_devices.clear();
+}
+
+void GamepadInput::run()
+{
+    epoll_event ready[8];
+
+    for (;;) {
+        const int count = epoll_wait(m_epollFd, ready, 8, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+
+        for (int index = 0; index < count; ++index) {
+            auto* device = static_cast<Device*>(ready[index].data.ptr);
+            if (device == nullptr) return;  // stop() was called
+
+            for (;;) {
+                const ssize_t received = read(device->fd,
+                    device->buffer.data() + device->pending,
+                    device->buffer.size() - device->pending);
+
+                if (received < 0 && errno == EINTR) continue;
+                if (received <= 0) {
+                    // Unplugged or end of a replayed stream
+                    if (received == 0 || errno != EAGAIN) {
+                        epoll_ctl(m_epollFd, EPOLL_CTL_DEL, device->fd, nullptr);
+                        if (device->open.exchange(false, std::memory_order_acq_rel)) {
+                            close(device->fd);
+                        }
+                    }
+                    break;
+                }
+
+                device->pending += static_cast<size_t>(received);
+                size_t offset = 0;
+                for (; offset + sizeof(input_event) <= device->pending; offset += sizeof(input_event)) {
+                    input_event raw;
+                    std::memcpy(&raw, device->buffer.data() + offset, sizeof(raw));
+                    device->mapper.apply({raw.type, raw.code, raw.value}, m_target);
+                    m_eventCount.fetch_add(1, std::memory_order_release);
+                }
+                device->pending -= offset;
+                std::memmove(device->buffer.data(), device->buffer.data() + offset, device->pending);
+            }
+        }
+    }
+}
+
+#else
+
+struct GamepadInput::Device {
+};
+
+GamepadInput::GamepadInput(Joystick& target)
+    : m_target(target)
+{
+}
+
+GamepadInput::~GamepadInput() = default;
+
+size_t GamepadInput::openAttachedDevices()
+{
+    return 0;
+}
+
+bool GamepadInput::addDevice(int, const GamepadMapper&)
+{
+    return false;
+}
+
+size_t GamepadInput::deviceCount() const
+{
+    return 0;
+}
+
+bool GamepadInput::start()
+{
+    return false;
+}
+
+void GamepadInput::stop()
+{
+}
+
+void GamepadInput::run()
+{
+}
+
+#endif
+
+} // namespace cutie
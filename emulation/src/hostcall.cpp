@@ -0,0 +1,297 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/hostcall.h"
+#include "tcc1014mmu.h"
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+bool HostCallsEnabled = false;
+
+namespace cutie {
+
+namespace {
+    HostCallDevice g_hostCallDevice;
+
+    constexpr uint16_t BlockSize = 14;
+
+    uint32_t get32(const uint8_t* bytes)
+    {
+        return uint32_t(bytes[0]) << 24 | uint32_t(bytes[1]) << 16 | uint32_t(bytes[2]) << 8 | bytes[3];
+    }
+
+    void put32(uint8_t* bytes, uint32_t value)
+    {
+        bytes[0] = static_cast<uint8_t>(value >> 24);
+        bytes[1] = static_cast<uint8_t>(value >> 16);
+        bytes[2] = static_cast<uint8_t>(value >> 8);
+        bytes[3] = static_cast<uint8_t>(value);
+    }
+
+    bool fitsRam(uint32_t address, uint32_t length)
+    {
+        const uint32_t size = Get_mem_size();
+        return address <= size && length <= size - address;
+    }
+
+    uint16_t crc16(uint16_t crc, const uint8_t* data, uint32_t length)
+    {
+        for (uint32_t i = 0; i < length; ++i) {
+            crc = static_cast<uint16_t>(crc ^ data[i] << 8);
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = static_cast<uint16_t>(crc & 0x8000 ? crc << 1 ^ 0x1021 : crc << 1);
+            }
+        }
+        return crc;
+    }
+
+    uint32_t crc32(uint32_t crc, const uint8_t* data, uint32_t length)
+    {
+        static const auto table = [] {
+            std::vector<uint32_t> entries(256);
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t value = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    value = value & 1 ? value >> 1 ^ 0xEDB88320u : value >> 1;
+                }
+                entries[i] = value;
+            }
+            return entries;
+        }();
+        crc = ~crc;
+        for (uint32_t i = 0; i < length; ++i) {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ crc >> 8;
+        }
+        return ~crc;
+    }
+
+    bool validName(const std::string& name)
+    {
+        if (name.empty() || name.size() > HostCallDevice::MaxNameLength || name[0] == '.') {
+            return false;
+        }
+        for (char c : name) {
+            const bool letter = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+            const bool digit = c >= '0' && c <= '9';
+            if (!letter && !digit && c != '.' && c != '-' && c != '_') {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+void HostCallDevice::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+    m_block = 0;
+    m_status = Ok;
+    m_calls = 0;
+    if (this == &g_hostCallDevice) {
+        HostCallsEnabled = enabled;
+    }
+}
+
+uint8_t HostCallDevice::read(uint8_t port) const
+{
+    switch (port) {
+    case CommandPort: return m_status;
+    case IdPort: return Id;
+    case BlockPort: return static_cast<uint8_t>(m_block >> 8);
+    case LastPort: return static_cast<uint8_t>(m_block);
+    default: return 0xFF;
+    }
+}
+
+void HostCallDevice::write(uint8_t port, uint8_t data)
+{
+    switch (port) {
+    case CommandPort:
+        m_status = run(data);
+        ++m_calls;
+        break;
+    case BlockPort:
+        m_block = static_cast<uint16_t>(data << 8 | (m_block & 0xFF));
+        break;
+    case LastPort:
+        m_block = static_cast<uint16_t>((m_block & 0xFF00) | data);
+        break;
+    default:
+        break;
+    }
+}
+
+uint8_t HostCallDevice::run(uint8_t command)
+{
+    uint8_t block[BlockSize];
+    MemReadBlock(block, m_block, BlockSize);
+    const uint32_t address = get32(block);
+    uint32_t length = get32(block + 4);
+    const unsigned char* memory = Get_mem_pointer();
+
+    switch (command) {
+    case Copy: {
+        const uint32_t source = get32(block + 8);
+        if (!fitsRam(address, length) || !fitsRam(source, length)) {
+            return BadAddress;
+        }
+        const std::vector<uint8_t> bytes(memory + source, memory + source + length);
+        MemWritePhysical(bytes.data(), address, length);
+        return Ok;
+    }
+    case Fill: {
+        if (!fitsRam(address, length)) {
+            return BadAddress;
+        }
+        const std::vector<uint8_t> bytes(length, block[8]);
+        MemWritePhysical(bytes.data(), address, length);
+        return Ok;
+    }
+    case Crc16: {
+        if (!fitsRam(address, length)) {
+            return BadAddress;
+        }
+        const uint16_t crc = crc16(static_cast<uint16_t>(block[8] << 8 | block[9]), memory + address, length);
+        block[8] = static_cast<uint8_t>(crc >> 8);
+        block[9] = static_cast<uint8_t>(crc);
+        MemWriteBlock(block + 8, static_cast<uint16_t>(m_block + 8), 2);
+        return Ok;
+    }
+    case Crc32: {
+        if (!fitsRam(address, length)) {
+            return BadAddress;
+        }
+        put32(block + 8, crc32(get32(block + 8), memory + address, length));
+        MemWriteBlock(block + 8, static_cast<uint16_t>(m_block + 8), 4);
+        return Ok;
+    }
+    case ReadFile:
+    case WriteFile:
+    case FileSize: {
+        const uint8_t status = runFile(command, address, length, get32(block + 8),
+            static_cast<uint16_t>(block[12] << 8 | block[13]));
+        put32(block + 4, length);
+        MemWriteBlock(block + 4, static_cast<uint16_t>(m_block + 4), 4);
+        return status;
+    }
+    case Clock: {
+        const std::time_t now = std::time(nullptr);
+        std::tm local = {};
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        const int year = local.tm_year + 1900;
+        put32(block, static_cast<uint32_t>(now));
+        block[4] = static_cast<uint8_t>(year >> 8);
+        block[5] = static_cast<uint8_t>(year);
+        block[6] = static_cast<uint8_t>(local.tm_mon + 1);
+        block[7] = static_cast<uint8_t>(local.tm_mday);
+        block[8] = static_cast<uint8_t>(local.tm_hour);
+        block[9] = static_cast<uint8_t>(local.tm_min);
+        block[10] = static_cast<uint8_t>(local.tm_sec);
+        MemWriteBlock(block, m_block, 11);
+        return Ok;
+    }
+    default:
+        return BadCommand;
+    }
+}
+
+uint8_t HostCallDevice::runFile(uint8_t command, uint32_t address, uint32_t& length, uint32_t offset, uint16_t name)
+{
+    const uint32_t requested = length;
+    length = 0;
+    if (m_directory.empty()) {
+        return NoDirectory;
+    }
+
+    std::string fileName;
+    for (unsigned i = 0; i <= MaxNameLength; ++i) {
+        const char c = static_cast<char>(SafeMemRead8(static_cast<uint16_t>(name + i)));
+        if (c == '\0') {
+            break;
+        }
+        fileName += c;
+    }
+    if (!validName(fileName)) {
+        return BadName;
+    }
+    const std::filesystem::path path = m_directory / fileName;
+
+    if (command == FileSize) {
+        std::error_code error;
+        const auto size = std::filesystem::file_size(path, error);
+        if (error || size > UINT32_MAX) {
+            return FileError;
+        }
+        length = static_cast<uint32_t>(size);
+        return Ok;
+    }
+
+    if (!fitsRam(address, requested)) {
+        return BadAddress;
+    }
+    if (command == ReadFile) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open() || !file.seekg(offset)) {
+            return FileError;
+        }
+        std::vector<uint8_t> bytes(requested);
+        file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(requested));
+        length = static_cast<uint32_t>(file.gcount());
+        MemWritePhysical(bytes.data(), address, length);
+        return Ok;
+    }
+
+    // Open for update so that writing at an offset keeps the rest of the file
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file.is_open()) {
+        file.open(path, std::ios::binary | std::ios::out | std::ios::trunc);
+    }
+    if (!file.is_open() || !file.seekp(offset)) {
+        return FileError;
+    }
+    file.write(reinterpret_cast<const char*>(Get_mem_pointer() + address), static_cast<std::streamsize>(requested));
+    if (!file.flush()) {
+        return FileError;
+    }
+    length = requested;
+    return Ok;
+}
+
+HostCallDevice& getHostCallDevice()
+{
+    return g_hostCallDevice;
+}
+
+} // namespace cutie
+
+unsigned char HostCallRead(unsigned char port)
+{
+    return cutie::g_hostCallDevice.read(port);
+}
+
+void HostCallWrite(unsigned char port, unsigned char data)
+{
+    cutie::g_hostCallDevice.write(port, data);
+}
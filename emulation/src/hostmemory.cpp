@@ -0,0 +1,309 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/hostmemory.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cutie {
+
+namespace {
+
+#ifdef __linux__
+    constexpr int BindPolicy = 2;  // MPOL_BIND from <linux/mempolicy.h>
+    constexpr int MaxNumaNode = 1023;
+
+    size_t roundUp(size_t size, size_t unit)
+    {
+        return (size + unit - 1) / unit * unit;
+    }
+
+    // Default huge page size, from /proc/meminfo
+    size_t hugePageSize()
+    {
+        static const size_t size = [] {
+            std::ifstream meminfo("/proc/meminfo");
+            std::string line;
+            while (std::getline(meminfo, line)) {
+                if (line.compare(0, 13, "Hugepagesize:") == 0) {
+                    return static_cast<size_t>(std::strtoull(line.c_str() + 13, nullptr, 10)) * 1024;
+                }
+            }
+            return static_cast<size_t>(2 * 1024 * 1024);
+        }();
+        return size;
+    }
+
+    // madvise(MADV_HUGEPAGE) only has an effect unless THP is set to never
+    bool transparentHugePagesAvailable()
+    {
+        std::ifstream enabled("/sys/kernel/mm/transparent_hugepage/enabled");
+        std::string modes;
+        return std::getline(enabled, modes) && modes.find("[never]") == std::string::npos;
+    }
+
+    bool bindMemory(void* start, size_t length, int node)
+    {
+        if (node < 0 || node > MaxNumaNode) {
+            return false;
+        }
+        unsigned long mask[(MaxNumaNode + 1) / (8 * sizeof(unsigned long))] = {};
+        mask[node / (8 * sizeof(unsigned long))] = 1ul << (node % (8 * sizeof(unsigned long)));
+        return syscall(SYS_mbind, start, length, BindPolicy, mask, MaxNumaNode + 1, 0) == 0;
+    }
+#endif
+
+    std::string nodeName(int node)
+    {
+        return node < 0 ? "unbound" : "node " + std::to_string(node);
+    }
+}
+
+const char* hugePagesName(HugePages hugePages)
+{
+    switch (hugePages) {
+    case HugePages::Transparent:
+        return "transparent";
+    case HugePages::Explicit:
+        return "explicit";
+    default:
+        return "off";
+    }
+}
+
+HostBuffer::~HostBuffer()
+{
+    release();
+}
+
+HostBuffer::HostBuffer(HostBuffer&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+HostBuffer& HostBuffer::operator=(HostBuffer&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        std::swap(m_mapping, other.m_mapping);
+        std::swap(m_mappedSize, other.m_mappedSize);
+        std::swap(m_hugePages, other.m_hugePages);
+        std::swap(m_numaNode, other.m_numaNode);
+    }
+    return *this;
+}
+
+#ifdef __linux__
+
+bool HostBuffer::allocate(size_t size, const MemoryPolicy& policy)
+{
+    release();
+    if (size == 0) {
+        return false;
+    }
+
+    const size_t hugeSize = hugePageSize();
+    void* mapping = MAP_FAILED;
+    size_t mappedSize = 0;
+    HugePages granted = HugePages::Off;
+
+    if (policy.hugePages == HugePages::Explicit) {
+        mappedSize = roundUp(size, hugeSize);
+        mapping = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        granted = HugePages::Explicit;
+    }
+
+    if (mapping == MAP_FAILED && policy.hugePages != HugePages::Off) {
+        // Map a huge page more than needed and trim it, so that the buffer
+        // starts on a huge page boundary and every part of it can be promoted
+        mappedSize = roundUp(size, hugeSize);
+        void* raw = mmap(nullptr, mappedSize + hugeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw != MAP_FAILED) {
+            const uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+            const uintptr_t aligned = roundUp(start, hugeSize);
+            if (aligned > start) {
+                munmap(raw, aligned - start);
+            }
+            if (hugeSize > aligned - start) {
+                munmap(reinterpret_cast<void*>(aligned + mappedSize), hugeSize - (aligned - start));
+            }
+            mapping = reinterpret_cast<void*>(aligned);
+            granted = transparentHugePagesAvailable() && madvise(mapping, mappedSize, MADV_HUGEPAGE) == 0
+                ? HugePages::Transparent
+                : HugePages::Off;
+        }
+    }
+
+    if (mapping == MAP_FAILED) {
+        mappedSize = roundUp(size, static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+        mapping = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        granted = HugePages::Off;
+        if (mapping == MAP_FAILED) {
+            return false;
+        }
+    }
+
+    // Binding before the first touch places every page on the node
+    m_numaNode = policy.numaNode >= 0 && bindMemory(mapping, mappedSize, policy.numaNode) ? policy.numaNode : -1;
+    m_mapping = mapping;
+    m_mappedSize = mappedSize;
+    m_data = static_cast<uint8_t*>(mapping);
+    m_size = size;
+    m_hugePages = granted;
+    return true;
+}
+
+void HostBuffer::release()
+{
+    if (m_mapping != nullptr) {
+        munmap(m_mapping, m_mappedSize);
+    }
+    m_mapping = nullptr;
+    m_mappedSize = 0;
+    m_data = nullptr;
+    m_size = 0;
+    m_hugePages = HugePages::Off;
+    m_numaNode = -1;
+}
+
+size_t HostBuffer::hugePageBytes() const
+{
+    if (m_mapping == nullptr) {
+        return 0;
+    }
+
+    // Sum the huge page fields of every mapping that overlaps the buffer
+    const uintptr_t first = reinterpret_cast<uintptr_t>(m_mapping);
+    const uintptr_t last = first + m_mappedSize;
+    std::ifstream smaps("/proc/self/smaps");
+    std::string line;
+    bool inside = false;
+    size_t bytes = 0;
+    while (std::getline(smaps, line)) {
+        const char lead = line.empty() ? '\0' : line[0];
+        if ((lead >= '0' && lead <= '9') || (lead >= 'a' && lead <= 'f')) {
+            char* end = nullptr;
+            const uintptr_t start = std::strtoull(line.c_str(), &end, 16);
+            const uintptr_t stop = std::strtoull(end + 1, nullptr, 16);
+            inside = start < last && stop > first;
+        } else if (inside && (line.compare(0, 14, "AnonHugePages:") == 0
+                       || line.compare(0, 16, "Private_Hugetlb:") == 0
+                       || line.compare(0, 15, "Shared_Hugetlb:") == 0)) {
+            bytes += static_cast<size_t>(std::strtoull(line.c_str() + line.find(':') + 1, nullptr, 10)) * 1024;
+        }
+    }
+    return bytes;
+}
+
+bool bindThreadToNumaNode(int node)
+{
+    if (node < 0 || node > MaxNumaNode) {
+        return false;
+    }
+    std::ifstream list("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string cpus;
+    if (!std::getline(list, cpus)) {
+        return false;
+    }
+
+    // A list of ranges such as 0-3,8-11
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    const char* next = cpus.c_str();
+    while (*next >= '0' && *next <= '9') {
+        char* end = nullptr;
+        const unsigned long first = std::strtoul(next, &end, 10);
+        unsigned long last = first;
+        if (*end == '-') {
+            last = std::strtoul(end + 1, &end, 10);
+        }
+        for (unsigned long cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu) {
+            CPU_SET(cpu, &set);
+        }
+        next = *end == ',' ? end + 1 : end;
+    }
+    return CPU_COUNT(&set) > 0 && sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+#else
+
+bool HostBuffer::allocate(size_t size, const MemoryPolicy&)
+{
+    release();
+    if (size == 0) {
+        return false;
+    }
+    m_mapping = std::calloc(size, 1);
+    if (m_mapping == nullptr) {
+        return false;
+    }
+    m_mappedSize = size;
+    m_data = static_cast<uint8_t*>(m_mapping);
+    m_size = size;
+    return true;
+}
+
+void HostBuffer::release()
+{
+    std::free(m_mapping);
+    m_mapping = nullptr;
+    m_mappedSize = 0;
+    m_data = nullptr;
+    m_size = 0;
+    m_hugePages = HugePages::Off;
+    m_numaNode = -1;
+}
+
+size_t HostBuffer::hugePageBytes() const
+{
+    return 0;
+}
+
+bool bindThreadToNumaNode(int)
+{
+    return false;
+}
+
+#endif
+
+std::string MemoryPolicyReport::describe() const
+{
+    std::string text = "huge pages ";
+    text += hugePagesName(requested.hugePages);
+    text += " requested: ram ";
+    text += hugePagesName(ramHugePages);
+    text += ", framebuffer ";
+    text += hugePagesName(framebufferHugePages);
+    text += "; NUMA " + nodeName(requested.numaNode) + " requested: ram " + nodeName(ramNode)
+        + ", framebuffer " + nodeName(framebufferNode) + ", thread " + nodeName(threadNode);
+    return text;
+}
+
+} // namespace cutie
@@ -26,14 +26,14 @@ Joystick::Joystick()
     // Initialize all axes to center (32)
     for (auto& stick : m_axes) {
         for (auto& axis : stick) {
-            axis = AXIS_CENTER;
+            axis.store(AXIS_CENTER, std::memory_order_relaxed);
         }
     }
 
     // Initialize all buttons to not pressed
     for (auto& stick : m_buttons) {
         for (auto& button : stick) {
-            button = false;
+            button.store(false, std::memory_order_relaxed);
         }
     }
 }
@@ -46,8 +46,7 @@ void Joystick::setAxis(int joystick, int axis, int value)
     // Clamp value to valid range
     value = std::clamp(value, AXIS_MIN, AXIS_MAX);
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_axes[joystick][axis] = value;
+    m_axes[joystick][axis].store(static_cast<uint8_t>(value), std::memory_order_relaxed);
 }
 
 int Joystick::getAxis(int joystick, int axis) const
@@ -55,8 +54,7 @@ int Joystick::getAxis(int joystick, int axis) const
     if (joystick < 0 || joystick >= JOYSTICK_COUNT) return AXIS_CENTER;
     if (axis < 0 || axis >= AXIS_COUNT) return AXIS_CENTER;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_axes[joystick][axis];
+    return m_axes[joystick][axis].load(std::memory_order_relaxed);
 }
 
 void Joystick::setButton(int joystick, int button, bool pressed)
@@ -64,8 +62,7 @@ void Joystick::setButton(int joystick, int button, bool pressed)
     if (joystick < 0 || joystick >= JOYSTICK_COUNT) return;
     if (button < 0 || button >= BUTTON_COUNT) return;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-    m_buttons[joystick][button] = pressed;
+    m_buttons[joystick][button].store(pressed, std::memory_order_relaxed);
 }
 
 bool Joystick::getButton(int joystick, int button) const
@@ -73,14 +70,11 @@ bool Joystick::getButton(int joystick, int button) const
     if (joystick < 0 || joystick >= JOYSTICK_COUNT) return false;
     if (button < 0 || button >= BUTTON_COUNT) return false;
 
-    std::lock_guard<std::mutex> lock(m_mutex);
-    return m_buttons[joystick][button];
+    return m_buttons[joystick][button].load(std::memory_order_relaxed);
 }
 
 uint8_t Joystick::getButtonBits() const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
     // Build the button bits for PIA $FF00:
     // Bit 0: Right joystick button 1
     // Bit 1: Left joystick button 1
@@ -90,26 +84,23 @@ uint8_t Joystick::getButtonBits() const
 
     uint8_t bits = 0x0F;  // All buttons released (high)
 
-    if (m_buttons[JOYSTICK_RIGHT][BUTTON_1]) bits &= ~0x01;  // Clear bit 0
-    if (m_buttons[JOYSTICK_LEFT][BUTTON_1])  bits &= ~0x02;  // Clear bit 1
-    if (m_buttons[JOYSTICK_RIGHT][BUTTON_2]) bits &= ~0x04;  // Clear bit 2
-    if (m_buttons[JOYSTICK_LEFT][BUTTON_2])  bits &= ~0x08;  // Clear bit 3
+    if (m_buttons[JOYSTICK_RIGHT][BUTTON_1].load(std::memory_order_relaxed)) bits &= ~0x01;  // Clear bit 0
+    if (m_buttons[JOYSTICK_LEFT][BUTTON_1].load(std::memory_order_relaxed))  bits &= ~0x02;  // Clear bit 1
+    if (m_buttons[JOYSTICK_RIGHT][BUTTON_2].load(std::memory_order_relaxed)) bits &= ~0x04;  // Clear bit 2
+    if (m_buttons[JOYSTICK_LEFT][BUTTON_2].load(std::memory_order_relaxed))  bits &= ~0x08;  // Clear bit 3
 
     return bits;
 }
 
 void Joystick::startRamp(uint8_t dacValue)
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
     // The DAC value from $FF20 is in bits 7-2, giving us 6 bits
     // We shift right by 2 to get the 0-63 range
-    m_dacValue = dacValue >> 2;
+    m_dacValue.store(dacValue >> 2, std::memory_order_relaxed);
 }
 
 bool Joystick::getComparisonResult(int muxState) const
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
-
     // MUX state determines which analog input is being read:
     // 0 = Right joystick X
     // 1 = Right joystick Y
@@ -138,7 +129,7 @@ bool Joystick::getComparisonResult(int muxState) const
             return false;  // Invalid mux state
     }
 
-    int potValue = m_axes[joystick][axis];
+    int potValue = m_axes[joystick][axis].load(std::memory_order_relaxed);
 
     // The comparison works like this:
     // - The DAC outputs a voltage based on m_dacValue
@@ -146,15 +137,14 @@ bool Joystick::getComparisonResult(int muxState) const
     // - The comparator returns 1 if DAC voltage > pot voltage
     // - Since higher DAC value = higher voltage, and higher pot = higher voltage:
     //   Return true (bit 7 high) when m_dacValue > potValue
-    return m_dacValue > potValue;
+    return m_dacValue.load(std::memory_order_relaxed) > potValue;
 }
 
 void Joystick::centerAll()
 {
-    std::lock_guard<std::mutex> lock(m_mutex);
     for (auto& stick : m_axes) {
         for (auto& axis : stick) {
-            axis = AXIS_CENTER;
+            axis.store(AXIS_CENTER, std::memory_order_relaxed);
         }
     }
 }
@@ -17,6 +17,7 @@ This file is part of CutieCoCo.
 */
 
 #include "cutie/keyboard.h"
+#include "tcc1014registers.h"
 #include <algorithm>
 
 namespace cutie {
@@ -106,6 +107,14 @@ bool Keyboard::isPressed(CocoKey key) const
     return (m_matrix[row] & (1 << col)) != 0;
 }
 
+bool Keyboard::updateRowLines(uint8_t rows)
+{
+    rows &= 0x7F;
+    const bool fell = (m_rowLines & ~rows) != 0;
+    m_rowLines = rows;
+    return fell;
+}
+
 Keyboard& getKeyboard()
 {
     static Keyboard keyboard;
@@ -119,3 +128,20 @@ unsigned char vccKeyboardGetScan(unsigned char colMask)
 {
     return cutie::getKeyboard().scan(colMask);
 }
+
+// Called by the PIA whenever the column strobe changes and once per scanline,
+// so key events from the host are seen at a fixed point in the frame
+void vccKeyboardUpdateInterrupt(unsigned char colMask, unsigned char joyButtons)
+{
+    auto& keyboard = cutie::getKeyboard();
+    if (!GimeKeyboardInteruptEnabled()) {
+        keyboard.setRowLines(0);
+        return;
+    }
+
+    // Bits 0-3 are shared with the joystick buttons, as in pia0_peek()
+    const unsigned char keyData = keyboard.scan(colMask);
+    if (keyboard.updateRowLines((keyData & 0xF0) | (keyData & joyButtons & 0x0F))) {
+        GimeAssertKeyboardInterupt();
+    }
+}
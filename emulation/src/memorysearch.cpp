@@ -0,0 +1,247 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/memorysearch.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CUTIE_SEARCH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace cutie {
+
+namespace {
+    constexpr size_t GroupSize = 64;  // Addresses per bitmap word
+
+    size_t popcount(uint64_t bits)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<size_t>(__builtin_popcountll(bits));
+#else
+        size_t count = 0;
+        for (; bits != 0; bits &= bits - 1) {
+            ++count;
+        }
+        return count;
+#endif
+    }
+
+    template <SearchWidth Width>
+    uint16_t valueAt(const uint8_t* memory)
+    {
+        if constexpr (Width == SearchWidth::Word) {
+            return static_cast<uint16_t>(memory[0] << 8 | memory[1]);
+        } else {
+            return memory[0];
+        }
+    }
+
+    template <SearchWidth Width>
+    uint16_t wrap(unsigned value)
+    {
+        return Width == SearchWidth::Word ? static_cast<uint16_t>(value) : static_cast<uint8_t>(value);
+    }
+
+    uint64_t select(SearchCompare compare, uint64_t equal, uint64_t greater)
+    {
+        switch (compare) {
+        case SearchCompare::Equal: return equal;
+        case SearchCompare::NotEqual: return ~equal;
+        case SearchCompare::Less: return ~(equal | greater);
+        case SearchCompare::LessOrEqual: return ~greater;
+        case SearchCompare::Greater: return greater;
+        case SearchCompare::GreaterOrEqual: return equal | greater;
+        }
+        return 0;
+    }
+
+#ifdef CUTIE_SEARCH_SSE2
+    __m128i load(const uint8_t* memory)
+    {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(memory));
+    }
+
+    // The big endian words at 16 consecutive byte offsets, eight per register
+    void loadWords(const uint8_t* memory, __m128i& first, __m128i& second)
+    {
+        const __m128i high = load(memory);
+        const __m128i low = load(memory + 1);
+        first = _mm_unpacklo_epi8(low, high);
+        second = _mm_unpackhi_epi8(low, high);
+    }
+
+    // Equal and greater masks for 16 addresses. SSE2 only compares signed
+    // values, so both sides are biased by half the range first.
+    template <SearchWidth Width, bool Relative>
+    void compare16(const uint8_t* memory, const uint8_t* previous, __m128i reference,
+        uint32_t& equal, uint32_t& greater)
+    {
+        if constexpr (Width == SearchWidth::Word) {
+            const __m128i bias = _mm_set1_epi16(static_cast<short>(0x8000));
+            __m128i value0, value1;
+            loadWords(memory, value0, value1);
+            __m128i other0 = reference;
+            __m128i other1 = reference;
+            if constexpr (Relative) {
+                loadWords(previous, other0, other1);
+                other0 = _mm_add_epi16(other0, reference);
+                other1 = _mm_add_epi16(other1, reference);
+            }
+            equal = static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(
+                _mm_cmpeq_epi16(value0, other0), _mm_cmpeq_epi16(value1, other1))));
+            greater = static_cast<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(
+                _mm_cmpgt_epi16(_mm_xor_si128(value0, bias), _mm_xor_si128(other0, bias)),
+                _mm_cmpgt_epi16(_mm_xor_si128(value1, bias), _mm_xor_si128(other1, bias)))));
+        } else {
+            const __m128i bias = _mm_set1_epi8(static_cast<char>(0x80));
+            const __m128i value = load(memory);
+            const __m128i other = Relative ? _mm_add_epi8(load(previous), reference) : reference;
+            equal = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(value, other)));
+            greater = static_cast<uint32_t>(_mm_movemask_epi8(
+                _mm_cmpgt_epi8(_mm_xor_si128(value, bias), _mm_xor_si128(other, bias))));
+        }
+    }
+#endif
+
+    template <SearchWidth Width, bool Relative>
+    size_t filterGroups(const uint8_t* memory, size_t size, size_t values, SearchCompare compare,
+        uint16_t reference, std::vector<uint64_t>& candidates, std::vector<uint8_t>& previous)
+    {
+#ifdef CUTIE_SEARCH_SSE2
+        // A constant that no byte can reach is left to the scalar loop
+        const bool vector = Width == SearchWidth::Word || Relative || reference <= 0xFF;
+        const __m128i splat = Width == SearchWidth::Word
+            ? _mm_set1_epi16(static_cast<short>(reference))
+            : _mm_set1_epi8(static_cast<char>(reference));
+#endif
+
+        // A word at the end of a group reads the first byte of the next one,
+        // whose snapshot must not change until that group has been compared
+        size_t count = 0;
+        bool carry = false;
+        for (size_t group = 0; group < candidates.size(); ++group) {
+            uint64_t& bits = candidates[group];
+            const size_t base = group * GroupSize;
+            const uint8_t* current = memory + base;
+            if (bits != 0) {
+                const uint8_t* before = previous.data() + base;
+                uint64_t equal = 0;
+                uint64_t greater = 0;
+#ifdef CUTIE_SEARCH_SSE2
+                if (vector && base + GroupSize <= values) {
+                    for (size_t part = 0; part < GroupSize; part += 16) {
+                        uint32_t partEqual, partGreater;
+                        compare16<Width, Relative>(current + part, before + part, splat, partEqual, partGreater);
+                        equal |= uint64_t(partEqual) << part;
+                        greater |= uint64_t(partGreater) << part;
+                    }
+                } else
+#endif
+                {
+                    const size_t last = std::min(GroupSize, values - base);
+                    for (size_t i = 0; i < last; ++i) {
+                        const uint16_t value = valueAt<Width>(current + i);
+                        const uint16_t other = Relative ? wrap<Width>(valueAt<Width>(before + i) + reference) : reference;
+                        equal |= uint64_t(value == other) << i;
+                        greater |= uint64_t(value > other) << i;
+                    }
+                }
+                bits &= select(compare, equal, greater);
+            }
+
+            // Relative passes only ever look back at surviving groups
+            if (bits != 0) {
+                count += popcount(bits);
+                std::memcpy(previous.data() + base, current, std::min(GroupSize, size - base));
+            } else if (carry) {
+                previous[base] = *current;
+            }
+            carry = Width == SearchWidth::Word && bits != 0;
+        }
+
+        const size_t end = candidates.size() * GroupSize;
+        if (carry && end < size) {
+            previous[end] = memory[end];
+        }
+        return count;
+    }
+}
+
+void MemorySearch::start(const uint8_t* memory, size_t size, SearchWidth width)
+{
+    m_width = width;
+    m_size = size;
+    m_values = width == SearchWidth::Word ? (size > 0 ? size - 1 : 0) : size;
+    m_count = m_values;
+
+    m_candidates.assign((m_values + GroupSize - 1) / GroupSize, ~uint64_t(0));
+    if (m_values % GroupSize != 0) {
+        m_candidates.back() = (uint64_t(1) << (m_values % GroupSize)) - 1;
+    }
+    m_previous.assign(memory, memory + size);
+}
+
+size_t MemorySearch::filter(const uint8_t* memory, SearchCompare compare, uint16_t value)
+{
+    return pass(memory, compare, value, false);
+}
+
+size_t MemorySearch::filterRelative(const uint8_t* memory, SearchCompare compare, int delta)
+{
+    return pass(memory, compare, static_cast<uint16_t>(delta), true);
+}
+
+size_t MemorySearch::pass(const uint8_t* memory, SearchCompare compare, uint16_t reference, bool relative)
+{
+    if (m_width == SearchWidth::Word) {
+        m_count = relative
+            ? filterGroups<SearchWidth::Word, true>(memory, m_size, m_values, compare, reference, m_candidates, m_previous)
+            : filterGroups<SearchWidth::Word, false>(memory, m_size, m_values, compare, reference, m_candidates, m_previous);
+    } else {
+        m_count = relative
+            ? filterGroups<SearchWidth::Byte, true>(memory, m_size, m_values, compare, reference, m_candidates, m_previous)
+            : filterGroups<SearchWidth::Byte, false>(memory, m_size, m_values, compare, reference, m_candidates, m_previous);
+    }
+    return m_count;
+}
+
+std::vector<uint32_t> MemorySearch::candidates(size_t limit) const
+{
+    std::vector<uint32_t> addresses;
+    addresses.reserve(std::min(limit, m_count));
+    for (size_t group = 0; group < m_candidates.size() && addresses.size() < limit; ++group) {
+        for (uint64_t bits = m_candidates[group]; bits != 0 && addresses.size() < limit; bits &= bits - 1) {
+            const size_t bit = popcount((bits & (~bits + 1)) - 1);  // Index of the lowest set bit
+            addresses.push_back(static_cast<uint32_t>(group * GroupSize + bit));
+        }
+    }
+    return addresses;
+}
+
+uint16_t MemorySearch::previousValue(uint32_t address) const
+{
+    if (address >= m_values) {
+        return 0;
+    }
+    return m_width == SearchWidth::Word ? valueAt<SearchWidth::Word>(m_previous.data() + address)
+                                        : valueAt<SearchWidth::Byte>(m_previous.data() + address);
+}
+
+} // namespace cutie
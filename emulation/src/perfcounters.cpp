@@ -0,0 +1,181 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/perfcounters.h"
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace cutie {
+
+namespace {
+    PerfCounters g_perfCounters;
+
+#ifdef __linux__
+    struct EventConfig {
+        PerfEvent event;
+        uint32_t type;
+        uint64_t config;
+    };
+
+    const EventConfig HardwareEvents[] = {
+        {PerfEvent::Instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PerfEvent::Cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PerfEvent::BranchMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PerfEvent::L1DataMisses, PERF_TYPE_HW_CACHE,
+            PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {PerfEvent::LastLevelMisses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    };
+
+    // Counts user space only, for this thread on any CPU. A group leader
+    // starts disabled so that its members start counting together.
+    int openEvent(uint32_t type, uint64_t config, int group)
+    {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = group == -1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+    }
+
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+    disable();
+}
+
+bool PerfCounters::enable()
+{
+    disable();
+
+#ifdef __linux__
+    int error = 0;
+    for (const auto& event : HardwareEvents) {
+        const int fd = openEvent(event.type, event.config, m_hardwareFd);
+        if (fd < 0) {
+            error = errno;
+            continue;
+        }
+        if (m_hardwareFd < 0) {
+            m_hardwareFd = fd;
+        }
+        m_fds[m_hardwareCount] = fd;
+        m_hardwareOrder[m_hardwareCount++] = event.event;
+        m_eventMask |= 1u << static_cast<int>(event.event);
+    }
+
+    if (m_hardwareFd >= 0) {
+        ioctl(m_hardwareFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        m_lastError.clear();
+    } else {
+        m_lastError = std::string("perf_event_open failed: ") + std::strerror(error);
+    }
+#else
+    m_lastError = "Hardware performance counters are only available on Linux";
+#endif
+
+    m_eventMask |= 1u << static_cast<int>(PerfEvent::Nanoseconds);
+    m_enabled = true;
+    m_phase = PerfPhase::Other;
+    m_frame = {};
+    m_lastFrame = {};
+    read(m_last);
+    return m_hardwareFd >= 0;
+}
+
+void PerfCounters::disable()
+{
+#ifdef __linux__
+    for (size_t i = 0; i < m_hardwareCount; ++i) {
+        close(m_fds[i]);
+    }
+#endif
+    m_hardwareFd = -1;
+    m_hardwareCount = 0;
+    m_eventMask = 0;
+    m_enabled = false;
+}
+
+void PerfCounters::read(std::array<uint64_t, PerfEventCount>& values) const
+{
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    values[static_cast<size_t>(PerfEvent::Nanoseconds)] =
+        static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+
+#ifdef __linux__
+    // One read returns the whole group: the count, then a value per event
+    uint64_t buffer[1 + PerfEventCount] = {};
+    if (m_hardwareFd >= 0
+        && ::read(m_hardwareFd, buffer, sizeof(buffer)) >= static_cast<ssize_t>(sizeof(uint64_t) * (1 + m_hardwareCount))) {
+        for (size_t i = 0; i < m_hardwareCount && i < buffer[0]; ++i) {
+            values[static_cast<size_t>(m_hardwareOrder[i])] = buffer[1 + i];
+        }
+    }
+#endif
+}
+
+void PerfCounters::switchTo(PerfPhase phase)
+{
+    if (m_enabled) {
+        auto now = m_last;
+        read(now);
+        auto& counts = m_frame.counts[static_cast<size_t>(m_phase)];
+        for (size_t event = 0; event < PerfEventCount; ++event) {
+            counts[event] += now[event] - m_last[event];
+        }
+        m_last = now;
+    }
+    m_phase = phase;
+}
+
+void PerfCounters::endFrame()
+{
+    if (!m_enabled) {
+        return;
+    }
+    switchTo(m_phase);
+    m_lastFrame = m_frame;
+    m_frame = {};
+}
+
+PerfCounters& getPerfCounters()
+{
+    return g_perfCounters;
+}
+
+} // namespace cutie
+
+void SwitchPerfPhase(cutie::PerfPhase phase)
+{
+    if (cutie::g_perfCounters.isEnabled()) {
+        cutie::g_perfCounters.switchTo(phase);
+    }
+}
@@ -0,0 +1,370 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/reverse.h"
+#include "cutie/keyboard.h"
+#include "cutie/joystick.h"
+#include "mc6809.h"
+#include "hd6309.h"
+#include <algorithm>
+
+uint64_t InstructionsRetired = 0;
+bool ReplayWatching = false;
+
+namespace cutie {
+
+namespace {
+    // The debugger whose replay is being watched
+    ReverseDebugger* g_watcher = nullptr;
+}
+
+ReverseDebugger::InputState ReverseDebugger::InputState::capture()
+{
+    InputState input;
+    const auto& keyboard = getKeyboard();
+    for (int key = 0; key < static_cast<int>(CocoKey::Count); ++key) {
+        if (keyboard.isPressed(static_cast<CocoKey>(key))) {
+            input.keys |= uint64_t(1) << key;
+        }
+    }
+
+    const auto& joystick = getJoystick();
+    for (int stick = 0; stick < 2; ++stick) {
+        for (int i = 0; i < 2; ++i) {
+            input.axes[stick * 2 + i] = static_cast<uint8_t>(joystick.getAxis(stick, i));
+            if (joystick.getButton(stick, i)) {
+                input.buttons |= 1 << (stick * 2 + i);
+            }
+        }
+    }
+    return input;
+}
+
+void ReverseDebugger::InputState::apply() const
+{
+    auto& keyboard = getKeyboard();
+    for (int key = 0; key < static_cast<int>(CocoKey::Count); ++key) {
+        if ((keys >> key) & 1) {
+            keyboard.keyDown(static_cast<CocoKey>(key));
+        } else {
+            keyboard.keyUp(static_cast<CocoKey>(key));
+        }
+    }
+
+    auto& joystick = getJoystick();
+    for (int stick = 0; stick < 2; ++stick) {
+        for (int i = 0; i < 2; ++i) {
+            joystick.setAxis(stick, i, axes[stick * 2 + i]);
+            joystick.setButton(stick, i, (buttons >> (stick * 2 + i)) & 1);
+        }
+    }
+}
+
+ReverseDebugger::ReverseDebugger(CocoEmulator& emulator, int checkpointInterval, size_t maxCheckpoints)
+    : m_emulator(emulator)
+    , m_checkpointInterval(std::max(1, checkpointInterval))
+    , m_maxCheckpoints(std::max<size_t>(1, maxCheckpoints))
+{
+}
+
+ReverseDebugger::~ReverseDebugger()
+{
+    stop();
+}
+
+bool ReverseDebugger::start()
+{
+    stop();
+
+    InstructionsRetired = 0;
+    m_firstFrame = 0;
+    m_frame = 0;
+    m_head = 0;
+    m_cursor = 0;
+    m_frameStarts.assign(1, 0);
+    m_lastInput = InputState::capture();
+    m_inputLog.assign(1, {0, m_lastInput});
+
+    takeCheckpoint();
+    if (m_checkpoints.empty()) {
+        stop();
+        return false;
+    }
+    m_recording = true;
+    m_lastError.clear();
+    return true;
+}
+
+void ReverseDebugger::stop()
+{
+    watch(false);
+    m_recording = false;
+    m_checkpoints.clear();
+    m_frameStarts.clear();
+    m_inputLog.clear();
+}
+
+void ReverseDebugger::runFrame()
+{
+    if (!m_recording) {
+        m_emulator.runFrame();
+        return;
+    }
+
+    const InputState input = InputState::capture();
+    if (m_frame < m_head) {
+        if (input == m_lastInput) {
+            replayFrame();
+            m_cursor = InstructionsRetired;
+            return;
+        }
+        discardFuture();
+    }
+
+    if (m_inputLog.empty() || m_inputLog.back().second != input) {
+        m_inputLog.emplace_back(m_frame, input);
+    }
+    m_lastInput = input;
+
+    m_emulator.runFrame();
+    m_head = ++m_frame;
+    m_frameStarts.push_back(InstructionsRetired);
+    m_cursor = InstructionsRetired;
+
+    if (m_frame % m_checkpointInterval == 0) {
+        takeCheckpoint();
+    }
+}
+
+bool ReverseDebugger::stepBack(ExecutionPoint& point)
+{
+    if (m_recording && m_cursor <= firstInstruction()) {
+        m_lastError = "At the start of the recorded history";
+        return false;
+    }
+    return seek(m_cursor - 1, point);
+}
+
+bool ReverseDebugger::reverseContinue(const std::vector<uint16_t>& breakpoints, ExecutionPoint& point)
+{
+    if (!m_recording) {
+        m_lastError = "Not recording";
+        return false;
+    }
+
+    m_breakpoints = breakpoints;
+    std::sort(m_breakpoints.begin(), m_breakpoints.end());
+
+    // Search one checkpoint interval at a time, newest first, for the last
+    // hit before the end of the interval
+    uint64_t end = m_cursor;
+    for (size_t index = m_checkpoints.size(); index-- > 0;) {
+        const uint64_t first = frameStart(m_checkpoints[index].frame);
+        if (first >= end) {
+            continue;
+        }
+        if (!restoreCheckpoint(index)) {
+            return false;
+        }
+
+        m_searchEnd = end;
+        m_hit = false;
+        watch(true);
+        while (m_frame < m_head && frameStart(m_frame) < end) {
+            replayFrame();
+        }
+        watch(false);
+
+        if (m_hit) {
+            return seek(m_lastHit, point);
+        }
+        end = first;
+    }
+
+    if (seek(firstInstruction(), point)) {
+        m_lastError = "No breakpoint was hit in the recorded history";
+    }
+    return false;
+}
+
+bool ReverseDebugger::seek(uint64_t instruction, ExecutionPoint& point)
+{
+    if (!m_recording) {
+        m_lastError = "Not recording";
+        return false;
+    }
+    if (instruction < firstInstruction() || instruction >= frameStart(m_head)) {
+        m_lastError = "Instruction is outside the recorded history";
+        return false;
+    }
+
+    // The frame that runs the instruction is the last one starting at or
+    // before it
+    const auto next = std::upper_bound(m_frameStarts.begin(), m_frameStarts.end(), instruction);
+    const uint64_t frame = m_firstFrame + (next - m_frameStarts.begin()) - 1;
+
+    size_t index = m_checkpoints.size() - 1;
+    while (m_checkpoints[index].frame > frame) {
+        --index;
+    }
+    if (m_frame > frame || m_frame < m_checkpoints[index].frame) {
+        if (!restoreCheckpoint(index)) {
+            return false;
+        }
+    }
+    while (m_frame < frame) {
+        replayFrame();
+    }
+
+    // Run the frame to catch the instruction, then go back to its start
+    MachineState frameState;
+    if (!m_emulator.saveState(frameState)) {
+        m_lastError = m_emulator.getLastError();
+        return false;
+    }
+    const InputState input = m_lastInput;
+
+    m_target = instruction;
+    m_point = &point;
+    m_hit = false;
+    watch(true);
+    replayFrame();
+    watch(false);
+    m_point = nullptr;
+
+    if (!m_emulator.loadState(frameState)) {
+        m_lastError = m_emulator.getLastError();
+        return false;
+    }
+    m_frame = frame;
+    InstructionsRetired = frameStart(frame);
+    input.apply();
+    m_lastInput = input;
+    m_cursor = instruction;
+
+    if (!m_hit) {
+        m_lastError = "Replay did not reach the instruction";
+        return false;
+    }
+    return true;
+}
+
+void ReverseDebugger::onInstruction(uint16_t pc)
+{
+    const uint64_t count = InstructionsRetired;
+    if (m_point) {
+        if (count != m_target) {
+            return;
+        }
+        m_point->instruction = count;
+        m_point->frame = m_frame;
+        m_point->registers = m_emulator.getCpuType() == CpuType::HD6309 ? HD6309GetState() : MC6809GetState();
+        m_point->memory.resize(0x10000);
+        m_emulator.readMemory(0, m_point->memory.data(), m_point->memory.size());
+        m_hit = true;
+    } else if (count < m_searchEnd && std::binary_search(m_breakpoints.begin(), m_breakpoints.end(), pc)) {
+        m_lastHit = count;
+        m_hit = true;
+    }
+}
+
+const ReverseDebugger::InputState& ReverseDebugger::recordedInput(uint64_t frame) const
+{
+    auto entry = std::upper_bound(m_inputLog.begin(), m_inputLog.end(), frame,
+        [](uint64_t value, const auto& logged) { return value < logged.first; });
+    return std::prev(entry)->second;
+}
+
+void ReverseDebugger::takeCheckpoint()
+{
+    // Reuse the oldest checkpoint's buffers once the limit is reached
+    Checkpoint checkpoint{m_frame, {}};
+    if (m_checkpoints.size() >= m_maxCheckpoints) {
+        checkpoint.state = std::move(m_checkpoints.front().state);
+        m_checkpoints.pop_front();
+    }
+    if (!m_emulator.saveState(checkpoint.state)) {
+        m_lastError = "Could not take a checkpoint: " + m_emulator.getLastError();
+        return;
+    }
+    m_checkpoints.push_back(std::move(checkpoint));
+
+    // Drop the history before the oldest checkpoint, keeping the input
+    // that was in effect when it was taken
+    const uint64_t first = m_checkpoints.front().frame;
+    if (first > m_firstFrame) {
+        m_frameStarts.erase(m_frameStarts.begin(), m_frameStarts.begin() + (first - m_firstFrame));
+        const auto current = std::upper_bound(m_inputLog.begin(), m_inputLog.end(), first,
+            [](uint64_t value, const auto& logged) { return value < logged.first; }) - 1;
+        current->first = first;
+        m_inputLog.erase(m_inputLog.begin(), current);
+        m_firstFrame = first;
+    }
+}
+
+void ReverseDebugger::discardFuture()
+{
+    m_head = m_frame;
+    while (m_checkpoints.back().frame > m_frame) {
+        m_checkpoints.pop_back();
+    }
+    m_frameStarts.resize(m_frame - m_firstFrame + 1);
+    m_inputLog.erase(std::lower_bound(m_inputLog.begin(), m_inputLog.end(), m_frame,
+        [](const auto& logged, uint64_t value) { return logged.first < value; }), m_inputLog.end());
+}
+
+bool ReverseDebugger::restoreCheckpoint(size_t index)
+{
+    const auto& checkpoint = m_checkpoints[index];
+    if (!m_emulator.loadState(checkpoint.state)) {
+        m_lastError = "Could not restore a checkpoint: " + m_emulator.getLastError();
+        return false;
+    }
+    m_frame = checkpoint.frame;
+    InstructionsRetired = frameStart(m_frame);
+    m_lastInput = recordedInput(m_frame);
+    m_lastInput.apply();
+    return true;
+}
+
+void ReverseDebugger::replayFrame()
+{
+    const auto entry = std::lower_bound(m_inputLog.begin(), m_inputLog.end(), m_frame,
+        [](const auto& logged, uint64_t value) { return logged.first < value; });
+    if (entry != m_inputLog.end() && entry->first == m_frame) {
+        entry->second.apply();
+        m_lastInput = entry->second;
+    }
+    m_emulator.runFrame();
+    ++m_frame;
+}
+
+void ReverseDebugger::watch(bool enabled)
+{
+    g_watcher = enabled ? this : nullptr;
+    ReplayWatching = enabled;
+}
+
+} // namespace cutie
+
+void ReplayInstruction(unsigned short pc)
+{
+    if (cutie::g_watcher) {
+        cutie::g_watcher->onInstruction(pc);
+    }
+}
@@ -0,0 +1,560 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/romhooks.h"
+#include "cutie/stubs.h"
+#include "mc6809.h"
+#include "hd6309.h"
+#include "tcc1014mmu.h"
+#include <cstring>
+#include <iterator>
+
+bool RomHooksArmed = false;
+unsigned char RomHookEntries[0x2000] = {};
+
+namespace cutie {
+
+namespace {
+    RomHooks g_romHooks;
+
+    using Regs = VCC::CPUState;
+
+    constexpr uint8_t FlagC = 0x01;
+    constexpr uint8_t FlagV = 0x02;
+    constexpr uint8_t FlagZ = 0x04;
+    constexpr uint8_t FlagN = 0x08;
+    constexpr uint8_t FlagH = 0x20;
+
+    // Where the ROM image starts in the CPU's address space
+    constexpr uint16_t RomBase = 0x8000;
+
+    // Color BASIC's floating point accumulators, in the direct page
+    constexpr uint8_t Fpa0Exponent = 0x4F;   // FP0EXP
+    constexpr uint8_t Fpa0Mantissa = 0x50;   // FPA0, four bytes
+    constexpr uint8_t Fpa0Sign = 0x54;       // FP0SGN
+    constexpr uint8_t Fpa1Exponent = 0x5C;   // FP1EXP
+    constexpr uint8_t Fpa1Mantissa = 0x5D;
+    constexpr uint8_t Fpa1Sign = 0x61;       // FP1SGN
+    constexpr uint8_t Fpa0Extra = 0x63;      // FPSBYT, the byte below FPA0's mantissa
+    constexpr uint8_t VariablePointer = 0x3B;  // VARDES
+    constexpr uint8_t Product = 0x13;          // FPA2, where multiplication builds its product
+
+    // Loops stop at their top after about this many cycles, so that an
+    // interrupt waits no longer for them than for the other routines
+    constexpr int SliceCycles = 256;
+
+    uint16_t direct(const Regs& regs, uint8_t offset)
+    {
+        return static_cast<uint16_t>(regs.DP << 8 | offset);
+    }
+
+    uint8_t get8(const Regs& regs, uint8_t offset)
+    {
+        return MemRead8(direct(regs, offset));
+    }
+
+    uint16_t get16(const Regs& regs, uint8_t offset)
+    {
+        return MemRead16(direct(regs, offset));
+    }
+
+    void put8(const Regs& regs, uint8_t offset, uint8_t value)
+    {
+        MemWrite8(value, direct(regs, offset));
+    }
+
+    void put16(const Regs& regs, uint8_t offset, uint16_t value)
+    {
+        MemWrite16(value, direct(regs, offset));
+    }
+
+    // N and Z for a value loaded or stored, with V cleared
+    uint8_t loaded8(uint8_t cc, uint8_t value)
+    {
+        cc &= ~(FlagN | FlagZ | FlagV);
+        return static_cast<uint8_t>(cc | (value & 0x80 ? FlagN : 0) | (value == 0 ? FlagZ : 0));
+    }
+
+    uint8_t loaded16(uint8_t cc, uint16_t value)
+    {
+        cc &= ~(FlagN | FlagZ | FlagV);
+        return static_cast<uint8_t>(cc | (value & 0x8000 ? FlagN : 0) | (value == 0 ? FlagZ : 0));
+    }
+
+    void returnToCaller(Regs& regs)
+    {
+        regs.PC = MemRead16(regs.S);
+        regs.S = static_cast<uint16_t>(regs.S + 2);
+    }
+
+    // LBC14: unpack the number at X into FPA0
+    int unpackToFpa0(Regs& regs)
+    {
+        const uint16_t x = regs.X;
+        MemWrite8(regs.A, static_cast<uint16_t>(regs.S - 1));  // PSHS A
+        const uint8_t first = MemRead8(static_cast<uint16_t>(x + 1));
+        const uint8_t second = MemRead8(static_cast<uint16_t>(x + 2));
+        put8(regs, Fpa0Sign, first);
+        put8(regs, Fpa0Mantissa, first | 0x80);
+        put8(regs, Fpa0Mantissa + 1, second);
+        put8(regs, Fpa0Extra, 0);
+        regs.B = MemRead8(x);
+        regs.X = MemRead16(static_cast<uint16_t>(x + 3));
+        put16(regs, Fpa0Mantissa + 2, regs.X);
+        put8(regs, Fpa0Exponent, regs.B);
+        regs.A = MemRead8(static_cast<uint16_t>(regs.S - 1));  // PULS A,PC
+        regs.CC = loaded8(regs.CC & ~FlagC, regs.B);
+        returnToCaller(regs);
+        return 56;
+    }
+
+    // LBC35: pack FPA0 into the five bytes at X
+    int packFpa0(Regs& regs)
+    {
+        const uint16_t x = regs.X;
+        MemWrite8(get8(regs, Fpa0Exponent), x);
+        regs.A = static_cast<uint8_t>((get8(regs, Fpa0Sign) | 0x7F) & get8(regs, Fpa0Mantissa));
+        MemWrite8(regs.A, static_cast<uint16_t>(x + 1));
+        regs.A = get8(regs, Fpa0Mantissa + 1);
+        MemWrite8(regs.A, static_cast<uint16_t>(x + 2));
+        regs.U = get16(regs, Fpa0Mantissa + 2);
+        MemWrite16(regs.U, static_cast<uint16_t>(x + 3));
+        regs.CC = loaded16(regs.CC, regs.U);
+        returnToCaller(regs);
+        return 48;
+    }
+
+    // LBC2A: pack FPA0 into the temporary at $45
+    int packFpa0ToTemp1(Regs& regs)
+    {
+        regs.X = 0x0045;
+        return 6 + packFpa0(regs);
+    }
+
+    // LBC2F: pack FPA0 into the temporary at $40. The CMPX that skips the
+    // next entry leaves carry set.
+    int packFpa0ToTemp2(Regs& regs)
+    {
+        regs.X = 0x0040;
+        regs.CC |= FlagC;
+        return 7 + packFpa0(regs);
+    }
+
+    // LBC33: pack FPA0 into the variable VARDES points to
+    int packFpa0ToVariable(Regs& regs)
+    {
+        regs.X = get16(regs, VariablePointer);
+        return 5 + packFpa0(regs);
+    }
+
+    // LBC4A: copy FPA1 to FPA0
+    int fpa1ToFpa0(Regs& regs)
+    {
+        put8(regs, Fpa0Sign, get8(regs, Fpa1Sign));
+        put16(regs, Fpa0Exponent, get16(regs, Fpa1Exponent));
+        put8(regs, Fpa0Extra, 0);
+        put8(regs, Fpa0Mantissa + 1, get8(regs, Fpa1Mantissa + 1));
+        regs.A = get8(regs, Fpa0Sign);
+        regs.X = get16(regs, Fpa1Mantissa + 2);
+        put16(regs, Fpa0Mantissa + 2, regs.X);
+        regs.CC = loaded16(regs.CC & ~FlagC, regs.X);
+        returnToCaller(regs);
+        return 51;
+    }
+
+    // LBC5F: copy FPA0 to FPA1
+    int fpa0ToFpa1(Regs& regs)
+    {
+        const uint16_t d = get16(regs, Fpa0Exponent);
+        put16(regs, Fpa1Exponent, d);
+        regs.X = get16(regs, Fpa0Mantissa + 1);
+        put16(regs, Fpa1Mantissa + 1, regs.X);
+        regs.X = get16(regs, Fpa0Mantissa + 3);
+        put16(regs, Fpa1Mantissa + 3, regs.X);
+        regs.A = static_cast<uint8_t>(d >> 8);
+        regs.B = static_cast<uint8_t>(d);
+        regs.CC = loaded8(regs.CC, regs.A);
+        returnToCaller(regs);
+        return 37;
+    }
+
+    // LA59A: copy B bytes (256 for 0) from X to U. Long moves stop at the
+    // top of the loop, as the CPU would be after that many bytes.
+    int blockMove(Regs& regs)
+    {
+        int cycles = 0;
+        do {
+            regs.A = MemRead8(regs.X++);
+            MemWrite8(regs.A, regs.U++);
+            --regs.B;
+            cycles += 17;
+        } while (regs.B != 0 && cycles < SliceCycles);
+
+        // Flags from the DECB
+        regs.CC = loaded8(regs.CC, regs.B);
+        if (regs.B == 0x7F) {
+            regs.CC |= FlagV;
+        }
+        if (regs.B != 0) {
+            return cycles;
+        }
+        returnToCaller(regs);
+        return cycles + 5;
+    }
+
+    // LA7D3: count X down to zero, from 65536 for 0. Only Z changes.
+    int delay(Regs& regs)
+    {
+        int cycles = 0;
+        do {
+            --regs.X;
+            cycles += 8;
+        } while (regs.X != 0 && cycles < SliceCycles);
+
+        if (regs.X != 0) {
+            regs.CC &= ~FlagZ;
+            return cycles;
+        }
+        regs.CC |= FlagZ;
+        returnToCaller(regs);
+        return cycles + 5;
+    }
+
+    // LBB02: add FPA1's mantissa times B into the product at $13-$16 and
+    // $63, a bit of B at a time from the bottom, shifting the product down
+    // a bit each time. COMA sets the carry that RORB shifts in to mark
+    // when all eight bits are done.
+    int multiplyByNonzeroByte(Regs& regs)
+    {
+        uint8_t product[5];  // $13-$16 and $63
+        uint8_t factor[4];
+        for (uint8_t i = 0; i < 4; ++i) {
+            product[i] = get8(regs, static_cast<uint8_t>(Product + i));
+            factor[i] = get8(regs, static_cast<uint8_t>(Fpa1Mantissa + i));
+        }
+        product[4] = get8(regs, Fpa0Extra);
+        uint8_t cc = regs.CC;
+        uint8_t b = regs.B;
+        uint8_t a = 0;
+        bool carry = true;
+        int cycles = 2;
+
+        for (;;) {
+            a = product[0];
+            const bool low = (b & 1) != 0;
+            b = static_cast<uint8_t>(b >> 1 | (carry ? 0x80 : 0));
+            carry = low;
+            cycles += 9;
+            if (b == 0) {
+                break;
+            }
+            cycles += 3;
+            if (carry) {
+                unsigned sum = 0;
+                for (int i = 3; i >= 0; --i) {
+                    sum = product[i] + factor[i] + (sum >> 8);
+                    if (i == 0) {
+                        cc = static_cast<uint8_t>((cc & ~FlagH) | ((product[0] ^ factor[0] ^ sum) & 0x10 ? FlagH : 0));
+                    }
+                    product[i] = static_cast<uint8_t>(sum);
+                }
+                carry = sum > 0xFF;
+                cycles += 44;
+            }
+            for (uint8_t& byte : product) {
+                const bool out = (byte & 1) != 0;
+                byte = static_cast<uint8_t>(byte >> 1 | (carry ? 0x80 : 0));
+                carry = out;
+            }
+            carry = false;
+            cycles += 35;
+        }
+
+        for (uint8_t i = 0; i < 4; ++i) {
+            put8(regs, static_cast<uint8_t>(Product + i), product[i]);
+        }
+        put8(regs, Fpa0Extra, product[4]);
+        regs.A = a;
+        regs.B = 0;
+        regs.CC = static_cast<uint8_t>((cc & ~(FlagN | FlagV)) | FlagZ | FlagC);
+        returnToCaller(regs);
+        return cycles + 5;
+    }
+
+    // LBB00: as above, but a zero byte only shifts the product down eight
+    // bits, which is left to the ROM
+    int multiplyByByte(Regs& regs)
+    {
+        if (regs.CC & FlagZ) {
+            return 0;
+        }
+        return 3 + multiplyByNonzeroByte(regs);
+    }
+
+    // LBA1C: normalize FPA0, shifting the mantissa up until its top bit is
+    // set and rounding with the byte below it. Everything is worked out
+    // before anything is stored, so that a result too large for the
+    // exponent can be left to the ROM's OV ERROR.
+    int normalizeFpa0(Regs& regs)
+    {
+        uint8_t mantissa[5];  // FPA0's mantissa and the extra byte below it
+        for (uint8_t i = 0; i < 4; ++i) {
+            mantissa[i] = get8(regs, static_cast<uint8_t>(Fpa0Mantissa + i));
+        }
+        mantissa[4] = get8(regs, Fpa0Extra);
+        uint8_t exponent = get8(regs, Fpa0Exponent);
+        uint8_t cc = regs.CC;
+        uint8_t shift = 0;  // B
+        int cycles = 2;
+
+        // Whole bytes first
+        bool zero = false;
+        while (mantissa[0] == 0) {
+            std::memmove(mantissa, mantissa + 1, 4);
+            mantissa[4] = 0;
+            const uint8_t sum = static_cast<uint8_t>(shift + 8);
+            cc = static_cast<uint8_t>((cc & ~FlagH) | ((shift ^ 8 ^ sum) & 0x10 ? FlagH : 0));
+            shift = sum;
+            cycles += 52;
+            if (shift >= 0x28) {
+                zero = true;
+                break;
+            }
+        }
+
+        bool pushed = false;  // B was left below the stack
+        bool rounded = false;
+        uint16_t x = regs.X;
+        if (!zero) {
+            cycles += 10;
+            while (!(mantissa[0] & 0x80)) {
+                for (int i = 0; i < 4; ++i) {
+                    mantissa[i] = static_cast<uint8_t>(mantissa[i] << 1 | mantissa[i + 1] >> 7);
+                }
+                mantissa[4] = static_cast<uint8_t>(mantissa[4] << 1);
+                ++shift;
+                cycles += 35;
+            }
+
+            // Underflow clears FPA0 as a zero mantissa would
+            pushed = true;
+            cycles += 23;
+            zero = exponent <= shift;
+            exponent = static_cast<uint8_t>(exponent - shift);
+        }
+
+        if (zero) {
+            cycles += 15;
+            exponent = 0;
+            cc = static_cast<uint8_t>((cc & ~(FlagN | FlagV | FlagC)) | FlagZ);
+        } else {
+            // The top bit of the extra byte rounds, and the byte is cleared
+            const bool carry = (mantissa[4] & 0x80) != 0;
+            mantissa[4] = 0;
+            cycles += 22 + 5;
+            cc = static_cast<uint8_t>((cc & ~(FlagN | FlagV | FlagC)) | FlagZ | (carry ? FlagC : 0));
+            if (carry) {
+                rounded = true;
+                x = static_cast<uint16_t>((mantissa[2] << 8 | mantissa[3]) + 1);
+                cycles += 7 + 18 + 5 + 3;
+                if (x == 0) {
+                    x = static_cast<uint16_t>((mantissa[0] << 8 | mantissa[1]) + 1);
+                    cycles += 15;
+                }
+                cc = loaded16(cc, x);
+                if (x == 0) {
+                    // The mantissa carried out of its top bit
+                    if (exponent == 0xFF) {
+                        return 0;
+                    }
+                    ++exponent;
+                    std::memset(mantissa, 0, 4);
+                    mantissa[0] = 0x80;
+                    cc = static_cast<uint8_t>((cc & ~(FlagN | FlagV | FlagC)) | FlagZ | (exponent == 0x80 ? FlagV : 0));
+                    cycles += 6 + 3 + 24 + 3;
+                } else if (mantissa[2] == 0xFF && mantissa[3] == 0xFF) {
+                    mantissa[2] = mantissa[3] = 0;
+                    mantissa[0] = static_cast<uint8_t>(x >> 8);
+                    mantissa[1] = static_cast<uint8_t>(x);
+                } else {
+                    mantissa[2] = static_cast<uint8_t>(x >> 8);
+                    mantissa[3] = static_cast<uint8_t>(x);
+                }
+            }
+        }
+
+        for (uint8_t i = 0; i < 4; ++i) {
+            put8(regs, static_cast<uint8_t>(Fpa0Mantissa + i), mantissa[i]);
+        }
+        put8(regs, Fpa0Extra, mantissa[4]);
+        put8(regs, Fpa0Exponent, exponent);
+        if (zero) {
+            put8(regs, Fpa0Sign, 0);
+        }
+        if (pushed) {
+            MemWrite8(shift, static_cast<uint16_t>(regs.S - 1));
+        }
+        if (rounded) {
+            // BSR to the rounding subroutine leaves its return address
+            MemWrite16(0xBA76, static_cast<uint16_t>(regs.S - 2));
+            regs.X = x;
+        }
+        regs.A = 0;
+        regs.B = shift;
+        regs.CC = cc;
+        returnToCaller(regs);
+        return cycles;
+    }
+
+    struct Hook {
+        RomHooks::Routine routine;
+        int (*run)(Regs&);
+    };
+
+    // Entry points in the stock CoCo 3 ROM, with the end of the code each
+    // one runs through
+    constexpr Hook Hooks[] = {
+        {{"block move", 0xA59A, 0xA5A2}, blockMove},
+        {{"delay", 0xA7D3, 0xA7D8}, delay},
+        {{"normalize FPA0", 0xBA1C, 0xBA92}, normalizeFpa0},
+        {{"unpack to FPA0", 0xBC14, 0xBC2A}, unpackToFpa0},
+        {{"pack FPA0 to $45", 0xBC2A, 0xBC4A}, packFpa0ToTemp1},
+        {{"pack FPA0 to $40", 0xBC2F, 0xBC4A}, packFpa0ToTemp2},
+        {{"pack FPA0 to VARDES", 0xBC33, 0xBC4A}, packFpa0ToVariable},
+        {{"pack FPA0", 0xBC35, 0xBC4A}, packFpa0},
+        {{"FPA1 to FPA0", 0xBC4A, 0xBC5F}, fpa1ToFpa0},
+        {{"multiply by a byte", 0xBB00, 0xBB2F}, multiplyByByte},
+        {{"multiply by a nonzero byte", 0xBB02, 0xBB2F}, multiplyByNonzeroByte},
+        {{"FPA0 to FPA1", 0xBC5F, 0xBC6D}, fpa0ToFpa1},
+    };
+    static_assert(std::size(Hooks) <= RomHooks::MaxRoutines, "Too many hooks");
+
+    bool isHD6309()
+    {
+        return CPUExec == HD6309Exec;
+    }
+}
+
+void RomHooks::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+    m_calls = 0;
+    for (Check& check : m_checks) {
+        check.valid = false;
+    }
+    if (this == &g_romHooks) {
+        RomHooksArmed = enabled;
+        std::memset(RomHookEntries, 0, sizeof(RomHookEntries));
+        for (const Hook& hook : Hooks) {
+            if (enabled) {
+                RomHookEntries[hook.routine.entry >> 3] |= static_cast<unsigned char>(1 << (hook.routine.entry & 7));
+            }
+        }
+    }
+}
+
+bool RomHooks::isActive() const
+{
+    return m_enabled && GetSystemRomHash() == StockRomHash;
+}
+
+int RomHooks::run(uint16_t pc)
+{
+    if (!m_enabled || GetSystemRomHash() != StockRomHash) {
+        return 0;
+    }
+    size_t index = 0;
+    while (index < std::size(Hooks) && Hooks[index].routine.entry != pc) {
+        ++index;
+    }
+    if (index == std::size(Hooks)) {
+        return 0;
+    }
+
+    // Native 6309 timings differ, and the direct page must not be I/O
+    Regs regs = isHD6309() ? HD6309GetState() : MC6809GetState();
+    if (regs.IsNative6309 || regs.DP == 0xFF || !verify(index)) {
+        return 0;
+    }
+    const int cycles = Hooks[index].run(regs);
+    if (cycles == 0) {
+        return 0;
+    }
+
+    regs.D = static_cast<uint16_t>(regs.A << 8 | regs.B);
+    if (isHD6309()) {
+        HD6309SetState(regs);
+    } else {
+        MC6809SetState(regs);
+    }
+    ++m_calls;
+    return cycles;
+}
+
+bool RomHooks::verify(size_t index)
+{
+    const Routine& routine = Hooks[index].routine;
+    const unsigned long length = routine.end - routine.entry;
+    const unsigned long offset = routine.entry - RomBase;
+    const unsigned long first = MemLocate(routine.entry);
+    const unsigned long last = MemLocate(static_cast<uint16_t>(routine.end - 1));
+
+    // The ROM itself is known from its hash
+    if (first == (MemRomSpace | offset) && last == (MemRomSpace | (offset + length - 1))) {
+        return true;
+    }
+    // A copy in RAM is compared once per change to its banks
+    if (first >= Get_mem_size() || last != first + length - 1) {
+        return false;
+    }
+    Check& check = m_checks[index];
+    const unsigned long long firstWrites = MemBankWrites(first);
+    const unsigned long long lastWrites = MemBankWrites(last);
+    if (!check.valid || check.location != first || check.firstWrites != firstWrites
+        || check.lastWrites != lastWrites || check.epoch != MemEpoch()) {
+        check.location = first;
+        check.firstWrites = firstWrites;
+        check.lastWrites = lastWrites;
+        check.epoch = MemEpoch();
+        check.matches = std::memcmp(Get_mem_pointer() + first, Getint_rom_pointer() + offset, length) == 0;
+        check.valid = true;
+    }
+    return check.matches;
+}
+
+const RomHooks::Routine& RomHooks::routine(size_t index)
+{
+    return Hooks[index].routine;
+}
+
+size_t RomHooks::routineCount()
+{
+    return std::size(Hooks);
+}
+
+RomHooks& getRomHooks()
+{
+    return g_romHooks;
+}
+
+} // namespace cutie
+
+int RomHook(unsigned short pc)
+{
+    return cutie::g_romHooks.run(pc);
+}
@@ -0,0 +1,465 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/statestore.h"
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace cutie {
+
+namespace {
+
+/**
+ * @brief Minimal SHA-256 (FIPS 180-4) for naming store objects
+ */
+class Sha256 {
+public:
+    Sha256() = default;
+
+    void update(const uint8_t* data, size_t size) {
+        m_length += size;
+        while (size > 0) {
+            size_t take = std::min(size, m_block.size() - m_used);
+            std::memcpy(m_block.data() + m_used, data, take);
+            m_used += take;
+            data += take;
+            size -= take;
+            if (m_used == m_block.size()) {
+                compress();
+                m_used = 0;
+            }
+        }
+    }
+
+    std::string hexDigest() {
+        uint64_t bits = m_length * 8;
+        uint8_t pad = 0x80;
+        update(&pad, 1);
+        pad = 0;
+        while (m_used != 56) {
+            update(&pad, 1);
+        }
+        for (int i = 7; i >= 0; --i) {
+            uint8_t byte = static_cast<uint8_t>(bits >> (i * 8));
+            update(&byte, 1);
+        }
+
+        static const char digits[] = "0123456789abcdef";
+        std::string hex;
+        hex.reserve(64);
+        for (uint32_t word : m_state) {
+            for (int shift = 28; shift >= 0; shift -= 4) {
+                hex += digits[(word >> shift) & 0xF];
+            }
+        }
+        return hex;
+    }
+
+    static std::string of(const uint8_t* data, size_t size) {
+        Sha256 sha;
+        sha.update(data, size);
+        return sha.hexDigest();
+    }
+
+private:
+    static uint32_t rotr(uint32_t x, int n) { return (x >> n) | (x << (32 - n)); }
+
+    void compress() {
+        static constexpr uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+        };
+
+        uint32_t w[64];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = (uint32_t(m_block[i * 4]) << 24) | (uint32_t(m_block[i * 4 + 1]) << 16)
+                 | (uint32_t(m_block[i * 4 + 2]) << 8) | uint32_t(m_block[i * 4 + 3]);
+        }
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+            uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        }
+
+        uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+        uint32_t e = m_state[4], f = m_state[5], g = m_state[6], h = m_state[7];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t t1 = h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+            uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        m_state[0] += a; m_state[1] += b; m_state[2] += c; m_state[3] += d;
+        m_state[4] += e; m_state[5] += f; m_state[6] += g; m_state[7] += h;
+    }
+
+    std::array<uint32_t, 8> m_state = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+    };
+    std::array<uint8_t, 64> m_block{};
+    size_t m_used = 0;
+    uint64_t m_length = 0;
+};
+
+bool isHash(const std::string& text)
+{
+    return text.size() == 64
+        && std::all_of(text.begin(), text.end(), [](char c) {
+               return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+           });
+}
+
+/**
+ * @brief Run body(0..count-1) across the hardware threads
+ */
+template <typename Body>
+void parallelFor(size_t count, Body body)
+{
+    size_t workers = std::min<size_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+    if (workers <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> threads;
+    threads.reserve(workers);
+    for (size_t t = 0; t < workers; ++t) {
+        threads.emplace_back([&] {
+            for (size_t i = next++; i < count; i = next++) {
+                body(i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+bool readFile(const std::filesystem::path& path, std::vector<uint8_t>& data)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    auto size = file.tellg();
+    if (size < 0) {
+        return false;
+    }
+    data.resize(static_cast<size_t>(size));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), size);
+    return static_cast<bool>(file);
+}
+
+const char* cpuName(CpuType type)
+{
+    return type == CpuType::HD6309 ? "6309" : "6809";
+}
+
+const char* memoryName(MemorySize size)
+{
+    switch (size) {
+        case MemorySize::Mem128K: return "128K";
+        case MemorySize::Mem512K: return "512K";
+        case MemorySize::Mem2M:   return "2M";
+        case MemorySize::Mem8M:   return "8M";
+    }
+    return "512K";
+}
+
+} // namespace
+
+StateStore::StateStore(std::filesystem::path root)
+    : m_root(std::move(root))
+{
+    // Random so that processes sharing the store never share a temp file
+    std::random_device random;
+    char tag[24];
+    std::snprintf(tag, sizeof(tag), ".tmp%08x%08x.", random(), random());
+    m_tempTag = tag;
+}
+
+std::filesystem::path StateStore::objectPath(const std::string& hash) const
+{
+    return m_root / "objects" / hash.substr(0, 2) / hash.substr(2);
+}
+
+std::filesystem::path StateStore::statePath(const std::string& id) const
+{
+    return m_root / "states" / id;
+}
+
+bool StateStore::writeFile(const std::filesystem::path& path, const void* data, size_t size)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    auto temp = path;
+    temp += m_tempTag + std::to_string(m_tempCounter++);
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!file.flush()) {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    m_bytesWritten += size;
+    return true;
+}
+
+bool StateStore::writeObject(const std::string& hash, const uint8_t* data, size_t size)
+{
+    auto path = objectPath(hash);
+    std::error_code ec;
+    if (std::filesystem::exists(path, ec)) {
+        ++m_objectsReused;
+        return true;
+    }
+    if (!writeFile(path, data, size)) {
+        return false;
+    }
+    ++m_objectsWritten;
+    return true;
+}
+
+std::string StateStore::save(const MachineState& state)
+{
+    const size_t pageCount = (state.ram.size() + PageSize - 1) / PageSize;
+    auto pageSize = [&state](size_t page) {
+        return std::min(PageSize, state.ram.size() - page * PageSize);
+    };
+
+    std::vector<std::string> pageHashes(pageCount);
+    parallelFor(pageCount, [&](size_t page) {
+        pageHashes[page] = Sha256::of(state.ram.data() + page * PageSize, pageSize(page));
+    });
+
+    // Each distinct object is written once, however many pages share it
+    struct Object { const uint8_t* data; size_t size; };
+    std::map<std::string, Object> objects;
+    for (size_t page = 0; page < pageCount; ++page) {
+        objects.emplace(pageHashes[page], Object{state.ram.data() + page * PageSize, pageSize(page)});
+    }
+
+    std::vector<std::string> deviceHashes;
+    for (const auto& [name, blob] : state.devices) {
+        if (name.empty() || name.find_first_of(" \t\r\n") != std::string::npos) {
+            m_lastError = "Invalid device name in state: " + name;
+            return {};
+        }
+        deviceHashes.push_back(Sha256::of(blob.data(), blob.size()));
+        objects.emplace(deviceHashes.back(), Object{blob.data(), blob.size()});
+    }
+
+    std::vector<std::pair<const std::string*, Object>> pending;
+    pending.reserve(objects.size());
+    for (const auto& [hash, object] : objects) {
+        pending.emplace_back(&hash, object);
+    }
+    std::atomic<bool> failed{false};
+    parallelFor(pending.size(), [&](size_t i) {
+        const auto& [hash, object] = pending[i];
+        if (!writeObject(*hash, object.data, object.size)) {
+            failed = true;
+        }
+    });
+    if (failed) {
+        m_lastError = "Failed to write objects under " + (m_root / "objects").string();
+        return {};
+    }
+
+    char rom[17];
+    std::snprintf(rom, sizeof(rom), "%016" PRIx64, state.systemRomHash);
+
+    std::ostringstream manifest;
+    manifest << "cutiecoco-state 1\n"
+             << "cpu " << cpuName(state.cpuType) << "\n"
+             << "memory " << memoryName(state.memorySize) << "\n"
+             << "rom " << rom << "\n"
+             << "ram " << state.ram.size() << "\n";
+    for (const auto& hash : pageHashes) {
+        manifest << "page " << hash << "\n";
+    }
+    for (size_t i = 0; i < state.devices.size(); ++i) {
+        manifest << "device " << state.devices[i].first << " " << deviceHashes[i] << "\n";
+    }
+
+    const std::string text = manifest.str();
+    const std::string id = Sha256::of(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    std::error_code ec;
+    if (!std::filesystem::exists(statePath(id), ec)
+        && !writeFile(statePath(id), text.data(), text.size())) {
+        m_lastError = "Failed to write " + statePath(id).string();
+        return {};
+    }
+    m_lastError.clear();
+    return id;
+}
+
+bool StateStore::load(const std::string& id, MachineState& state)
+{
+    // Ids also arrive over the control socket, so never build a path from
+    // anything but a well-formed hash
+    if (!isHash(id)) {
+        m_lastError = "Invalid state id: " + id;
+        return false;
+    }
+
+    std::vector<uint8_t> text;
+    if (!readFile(statePath(id), text)) {
+        m_lastError = "No such state: " + id;
+        return false;
+    }
+    if (Sha256::of(text.data(), text.size()) != id) {
+        m_lastError = "State manifest is corrupt: " + id;
+        return false;
+    }
+
+    MachineState loaded;
+    std::vector<std::string> pageHashes;
+    std::vector<std::string> deviceHashes;
+    bool haveHeader = false;
+    bool haveRam = false;
+
+    std::istringstream manifest(std::string(text.begin(), text.end()));
+    std::string line;
+    while (std::getline(manifest, line)) {
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+        if (key == "cutiecoco-state") {
+            int version = 0;
+            fields >> version;
+            haveHeader = version == 1;
+        } else if (key == "cpu") {
+            std::string value;
+            fields >> value;
+            loaded.cpuType = value == "6309" ? CpuType::HD6309 : CpuType::MC6809;
+        } else if (key == "memory") {
+            std::string value;
+            fields >> value;
+            for (auto size : {MemorySize::Mem128K, MemorySize::Mem512K, MemorySize::Mem2M, MemorySize::Mem8M}) {
+                if (value == memoryName(size)) {
+                    loaded.memorySize = size;
+                }
+            }
+        } else if (key == "rom") {
+            fields >> std::hex >> loaded.systemRomHash;
+        } else if (key == "ram") {
+            size_t size = 0;
+            haveRam = static_cast<bool>(fields >> size);
+            loaded.ram.resize(size);
+        } else if (key == "page") {
+            std::string hash;
+            fields >> hash;
+            pageHashes.push_back(hash);
+        } else if (key == "device") {
+            std::string name, hash;
+            fields >> name >> hash;
+            loaded.devices.emplace_back(name, std::vector<uint8_t>());
+            deviceHashes.push_back(hash);
+        }
+    }
+
+    const size_t pageCount = (loaded.ram.size() + PageSize - 1) / PageSize;
+    bool valid = haveHeader && haveRam && pageHashes.size() == pageCount;
+    for (const auto& hash : pageHashes) {
+        valid = valid && isHash(hash);
+    }
+    for (const auto& hash : deviceHashes) {
+        valid = valid && isHash(hash);
+    }
+    if (!valid) {
+        m_lastError = "State manifest is malformed: " + id;
+        return false;
+    }
+
+    std::atomic<bool> failed{false};
+    parallelFor(pageCount, [&](size_t page) {
+        std::vector<uint8_t> data;
+        size_t size = std::min(PageSize, loaded.ram.size() - page * PageSize);
+        if (!readFile(objectPath(pageHashes[page]), data) || data.size() != size
+            || Sha256::of(data.data(), data.size()) != pageHashes[page]) {
+            failed = true;
+            return;
+        }
+        std::memcpy(loaded.ram.data() + page * PageSize, data.data(), size);
+    });
+    for (size_t i = 0; i < deviceHashes.size() && !failed; ++i) {
+        auto& blob = loaded.devices[i].second;
+        if (!readFile(objectPath(deviceHashes[i]), blob)
+            || Sha256::of(blob.data(), blob.size()) != deviceHashes[i]) {
+            failed = true;
+        }
+    }
+    if (failed) {
+        m_lastError = "State has missing or corrupt objects: " + id;
+        return false;
+    }
+
+    state = std::move(loaded);
+    m_lastError.clear();
+    return true;
+}
+
+bool StateStore::contains(const std::string& id) const
+{
+    std::error_code ec;
+    return isHash(id) && std::filesystem::is_regular_file(statePath(id), ec);
+}
+
+StateStore::Stats StateStore::stats() const
+{
+    Stats stats;
+    stats.objectsWritten = m_objectsWritten;
+    stats.objectsReused = m_objectsReused;
+    stats.bytesWritten = m_bytesWritten;
+    return stats;
+}
+
+} // namespace cutie
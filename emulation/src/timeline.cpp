@@ -0,0 +1,90 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+    CutieCoCo is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    CutieCoCo is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with CutieCoCo.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "cutie/timeline.h"
+#include "cutie/compat.h"  // For SystemState
+#include "coco3.h"
+
+namespace cutie {
+
+namespace {
+    RegisterTimeline g_registerTimeline;
+}
+
+void RegisterTimeline::enable(size_t capacity)
+{
+    // A power of two lets record() wrap with a mask
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    m_ring.assign(size, RegisterWrite{});
+    m_mask = size - 1;
+    m_recorded = 0;
+    m_drained = 0;
+    m_lost = 0;
+    m_frame = 0;
+    m_enabled = true;
+}
+
+void RegisterTimeline::disable()
+{
+    m_enabled = false;
+    m_ring.clear();
+    m_ring.shrink_to_fit();
+}
+
+void RegisterTimeline::record(uint16_t address, uint8_t value)
+{
+    unsigned short line = 0;
+    unsigned short cycle = 0;
+    GetBeamPosition(line, cycle);
+
+    m_ring[m_recorded & m_mask] = {m_frame, line, cycle, address, value};
+    ++m_recorded;
+}
+
+size_t RegisterTimeline::drain(std::vector<RegisterWrite>& writes)
+{
+    if (m_recorded - m_drained > m_ring.size()) {
+        m_lost += m_recorded - m_drained - m_ring.size();
+        m_drained = m_recorded - m_ring.size();
+    }
+
+    const auto count = static_cast<size_t>(m_recorded - m_drained);
+    writes.reserve(writes.size() + count);
+    for (; m_drained < m_recorded; ++m_drained) {
+        writes.push_back(m_ring[m_drained & m_mask]);
+    }
+    return count;
+}
+
+RegisterTimeline& getRegisterTimeline()
+{
+    return g_registerTimeline;
+}
+
+} // namespace cutie
+
+void RecordRegisterWrite(unsigned short address, unsigned char value)
+{
+    if (cutie::g_registerTimeline.isEnabled()) {
+        cutie::g_registerTimeline.record(address, value);
+    }
+}
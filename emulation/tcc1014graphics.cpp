@@ -9594,6 +9594,35 @@ void TogBlinkState()
 	return;
 }
 
+// Video mode as set up by the GIME and VDG registers. The palette lookup
+// tables and monitor type are host settings and are left alone.
+template <class StateArchive>
+static void TransferState(StateArchive &state)
+{
+	state(Pallete)(Pallete8Bit)(Pallete16Bit)(Pallete32Bit);
+	state(VidMask)(VresIndex)(CC2Offset)(CC2VDGMode)(CC2VDGPiaMode)(VerticalOffsetRegister)(CompatMode);
+	state(CC3Vmode)(CC3Vres)(CC3BoarderColor)(StartofVidram)(Start)(NewStartofVidram);
+	state(LinesperScreen)(Bpp)(LinesperRow)(BytesperRow)(GraphicsMode);
+	state(TextFGColor)(TextBGColor)(TextFGPallete)(TextBGPallete)(PalleteIndex);
+	state(PixelsperLine)(VPitch)(Stretch)(PixelsperByte)(HorzCenter)(VertCenter);
+	state(LowerCase)(InvertAll)(ExtendedText)(HorzOffsetReg)(Hoffset)(TagY);
+	state(BoarderColor32)(BoarderColor16)(BoarderColor8)(DistoOffset)(MasterMode)(ColorInvert)(BlinkState);
+}
+
+void GimeVideoSaveState(cutie::StateWriter &state)
+{
+	TransferState(state);
+}
+
+bool GimeVideoLoadState(cutie::StateReader &state)
+{
+	TransferState(state);
+	if (!state.complete())
+		return false;
+	BoarderChange=3;	// Redraw the border in the restored colour
+	return true;
+}
+
 // These grab the Video info for all COCO 2 modes
 void SetGimeVdgOffset (unsigned char Offset)
 {
@@ -9853,6 +9882,7 @@ void GimeReset()
 	HorzOffsetReg=0;
 	TagY=0;
 	DistoOffset=0;
+	BlinkState=1;
 	MakeRGBPalette ();
 	MakeCMPpalette();
 	BoarderChange=3;
@@ -10019,6 +10049,17 @@ unsigned short GetDisplayedPixelsPerLine()
 unsigned int GetStartOfVidram() {
 	return StartofVidram;
 }
+
+// RAM the next frame's picture is read from: Size bytes from Start, each
+// address wrapped by Mask as the line renderers do. Covers every row the
+// mode can show plus the largest horizontal offset.
+void GetVideoWindow(unsigned int &Start,unsigned int &Size,unsigned int &Mask)
+{
+	const unsigned int Rows=Lpf[VresIndex]/(LinesperRow ? LinesperRow : 1)+2;
+	Start=NewStartofVidram;
+	Size=Rows*VPitch*ExtendedText+512;
+	Mask=VidMask;
+}
 int GetGraphicsMode() {
 	return GraphicsMode;
 }
@@ -20,7 +20,9 @@ This file is part of VCC (Virtual Color Computer).
 #include "cutie/stubs.h"
 #include <cstdio>
 #include <cstdlib>
+#include <cstdint>
 #include <cstring>
+#include <filesystem>
 #include "tcc1014mmu.h"
 #include "iobus.h"
 #include "tcc1014graphics.h"
@@ -49,10 +51,40 @@ static unsigned int VidMask[4]={0x1FFFF,0x7FFFF,0x1FFFFF,0x7FFFFF};
 static unsigned char CurrentRamConfig=1;
 static unsigned short MmuPrefix=0;
 static unsigned int RamSize=0;
+static cutie::HostBuffer RamAllocation;	// Backs memory, kept across MmuInit() calls
+static cutie::MemoryPolicy RamPolicy;
+static bool RamPolicyChanged=false;
+static unsigned long long SystemRomHash=0;	// FNV-1a of InternalRomBuffer as last loaded
+static unsigned long long BankWrites[1024];	// Write count for each 8K bank of RAM
+static unsigned int MemoryEpoch=0;	// Bumped when RAM or ROM is replaced wholesale
 std::atomic_bool mem_initializing;
+bool VideoWatchArmed=false;
+unsigned char VideoWatchBanks[1024];
+MemFetchWindow FetchWindow;
 
 void UpdateMmuArray();
 
+// Any change to the CPU visible map drops the cached instruction fetch bank.
+static inline void InvalidateFetchWindow()
+{
+	FetchWindow.Size = 0;
+}
+
+// RAM powers up as alternating $FF and $00 bytes. Two bytes are written
+// and then doubled until the buffer is full, so the work is done by memcpy.
+static void FillPowerOnPattern(unsigned char *Ram,unsigned int Size)
+{
+	Ram[0]=0xFF;
+	Ram[1]=0x00;
+	unsigned int Filled=2;
+	while (Filled<Size)
+	{
+		const unsigned int Run=(Filled<Size-Filled) ? Filled : Size-Filled;
+		memcpy(Ram+Filled,Ram,Run);
+		Filled+=Run;
+	}
+}
+
 /*****************************************************************************************
 * MmuInit Initilize and allocate memory for RAM Internal and External ROM Images.        *
 * Copy Rom Images to buffer space and reset GIME MMU registers to 0                      *
@@ -66,31 +98,27 @@ unsigned char * MmuInit(unsigned char RamConfig)
 	// or MemSize config change. Issue does not seem to justify a section lock
 	mem_initializing = true;
 
-	unsigned int Index1=0;
 	RamSize=MemConfig[RamConfig];
 	CurrentRamConfig=RamConfig;
-	if (memory != nullptr)
-		free(memory);
 
-	memory=(unsigned char *)malloc(RamSize);
-	if (memory==nullptr) {
-		mem_initializing = false;
-		RamSize = 0;
-		return nullptr;
-	}
-
-	for (Index1=0;Index1<RamSize;Index1++)
+	// The buffers are kept from one power on to the next; RAM is only
+	// reallocated when its size or host memory policy changes
+	if (RamAllocation.size() != RamSize || RamPolicyChanged)
 	{
-		if (Index1 & 1)
-			memory[Index1]=0;
-		else 
-			memory[Index1]=0xFF;
+		memory=nullptr;
+		RamPolicyChanged=false;
+		if (!RamAllocation.allocate(RamSize,RamPolicy)) {
+			mem_initializing = false;
+			RamSize = 0;
+			return nullptr;
+		}
 	}
+	memory=RamAllocation.data();
+
+	FillPowerOnPattern(memory,RamSize);
 	SetVidMask(VidMask[CurrentRamConfig]);
-	if (InternalRomBuffer != nullptr)
-		free(InternalRomBuffer);
-	InternalRomBuffer=nullptr;
-	InternalRomBuffer=(unsigned char *)malloc(0x8000);
+	if (InternalRomBuffer == nullptr)
+		InternalRomBuffer=(unsigned char *)malloc(0x8000);
 
 	if (InternalRomBuffer == nullptr) {
 		mem_initializing = false;
@@ -104,6 +132,37 @@ unsigned char * MmuInit(unsigned char RamConfig)
 	return memory;
 }
 
+void SetRamPolicy(const cutie::MemoryPolicy &Policy)
+{
+	RamPolicyChanged = RamPolicyChanged || Policy.hugePages != RamPolicy.hugePages || Policy.numaNode != RamPolicy.numaNode;
+	RamPolicy = Policy;
+}
+
+const cutie::HostBuffer &GetRamAllocation()
+{
+	return RamAllocation;
+}
+
+void SetVideoWatch(unsigned int Start,unsigned int Size,unsigned int Mask)
+{
+	bool Physical[1024]={};
+	const unsigned int Banks=RamSize>>13;
+	for (unsigned int Offset=0;Offset<Size+0x2000;Offset+=0x2000)
+	{
+		const unsigned int Address=(Offset<Size) ? Start+Offset : Start+Size-1;
+		if (Banks)
+			Physical[((Address & Mask)>>13)%Banks]=true;
+	}
+	for (unsigned int Page=0;Page<1024;Page++)
+		VideoWatchBanks[Page]=Physical[Page & RamMask[CurrentRamConfig]];
+	VideoWatchArmed=true;
+}
+
+void ClearVideoWatch()
+{
+	VideoWatchArmed=false;
+}
+
 void MmuReset()
 {
 	unsigned int Index1=0,Index2=0;
@@ -114,6 +173,8 @@ void MmuReset()
 	RomMap=0;
 	MapType=0;
 	MmuPrefix=0;
+	MemoryEpoch++;
+	InvalidateFetchWindow();
 	for (Index1=0;Index1<8;Index1++)
 		for (Index2=0;Index2<4;Index2++)
 			MmuRegisters[Index2][Index1]=Index1+StateSwitch[CurrentRamConfig];
@@ -166,6 +227,7 @@ void SetMmuRegister(unsigned char Register,unsigned char data)
 	BankRegister = Register & 7;
 	Task=!!(Register & 8);
 	MmuRegisters[Task][BankRegister]= MmuPrefix |(data & RamMask[CurrentRamConfig]); //gime.c returns what was written so I can get away with this
+	InvalidateFetchWindow();
 	return;
 }
 
@@ -187,6 +249,7 @@ void Set_MmuTask(unsigned char task)
 {
 	MmuTask=task;
 	MmuState= (!MmuEnabled)<<1 | MmuTask;
+	InvalidateFetchWindow();
 	return;
 }
 
@@ -194,6 +257,7 @@ void Set_MmuEnabled (unsigned char usingmmu)
 {
 	MmuEnabled=usingmmu;
 	MmuState= (!MmuEnabled)<<1 | MmuTask;
+	InvalidateFetchWindow();
 	return;
 }
  
@@ -202,6 +266,37 @@ unsigned char * Getint_rom_pointer()
 	return InternalRomBuffer;
 }
 
+// Content hash of the system ROM image. ROM code never changes while it is
+// mapped, so anything derived from it (patch points, decoded routines) can be
+// keyed on this value and reused for as long as the same image is loaded.
+unsigned long long GetSystemRomHash()
+{
+	return SystemRomHash;
+}
+
+static unsigned long long HashRomImage(const unsigned char *image,size_t size)
+{
+	unsigned long long hash=0xCBF29CE484222325ull;
+	for (size_t index=0;index<size;index++)
+	{
+		hash^=image[index];
+		hash*=0x100000001B3ull;
+	}
+	return hash;
+}
+
+// The last system ROM image read from disk. LoadRom() copies it back instead
+// of reading the file again for as long as the file is unchanged.
+static struct
+{
+	std::filesystem::path Path;
+	std::filesystem::file_time_type Time;
+	std::uintmax_t Size=0;
+	unsigned long long Hash=0;
+	bool Valid=false;
+	unsigned char Image[0x8000];
+} RomCache;
+
 // LoadRom() loads Coco3.rom. It is called by MmuInit() here
 // and by SoftReset() in Vcc.c. If LoadRom() fails VCC can not run.
 void LoadRom()
@@ -217,6 +312,7 @@ void LoadRom()
 				"The emulator is configured to use a custom system ROM but no ROM file was specified.",
 				"Unable to load System ROM",
 				MB_TASKMODAL | MB_TOPMOST | MB_SETFOREGROUND);
+			SystemRomHash=HashRomImage(InternalRomBuffer,0x8000);
 			return;
 		}
 	}
@@ -227,6 +323,19 @@ void LoadRom()
 
 	size_t index(0u);
 	static const auto expected_file_size(0x8000u);
+	std::error_code timeError, sizeError;
+	const auto time(std::filesystem::last_write_time(filename, timeError));
+	const auto size(std::filesystem::file_size(filename, sizeError));
+	if (RomCache.Valid && !timeError && !sizeError && RomCache.Path == filename
+		&& RomCache.Time == time && RomCache.Size == size)
+	{
+		memcpy(InternalRomBuffer, RomCache.Image, expected_file_size);
+		SystemRomHash=RomCache.Hash;
+		MemoryEpoch++;
+		return;
+	}
+
+	RomCache.Valid = false;
 	if (auto hFile(fopen(filename.string().c_str(), "rb")); hFile != nullptr)
 	{
 		index = fread(InternalRomBuffer, 1, expected_file_size, hFile);
@@ -255,6 +364,19 @@ void LoadRom()
 			"Unable to load ROM file",
 			MB_TASKMODAL | MB_TOPMOST | MB_SETFOREGROUND | MB_ICONERROR);
 	}
+
+	SystemRomHash=HashRomImage(InternalRomBuffer,expected_file_size);
+	MemoryEpoch++;
+
+	if (index == expected_file_size && !timeError && !sizeError)
+	{
+		memcpy(RomCache.Image, InternalRomBuffer, expected_file_size);
+		RomCache.Path = filename;
+		RomCache.Time = time;
+		RomCache.Size = size;
+		RomCache.Hash = SystemRomHash;
+		RomCache.Valid = true;
+	}
 }
 
 // Coco3 MMU Code
@@ -280,8 +402,8 @@ unsigned char SafeMemRead8(unsigned short address)
 {
 	// Do nothing if memory is in initializing state
 	if (mem_initializing) return 0;
-	// Filter port reads that are not GIME or SAM
-	if ((address > 0xFEFF) && (address < 0xFF90)) return memory[address];
+	// I/O reads can acknowledge interrupts, so peek at the latched values
+	if (address > 0xFEFF) return port_peek(address);
 	// Otherwise use normal MMU MemRead8
 	return MemRead8(address);
 }
@@ -290,8 +412,14 @@ void MemWrite8(unsigned char data,unsigned short address)
 {
 	if (address<0xFE00)
 	{
-		if (MapType | (MmuRegisters[MmuState][address>>13] <VectorMaska[CurrentRamConfig]) | (MmuRegisters[MmuState][address>>13] > VectorMask[CurrentRamConfig]))
-			MemPages[MmuRegisters[MmuState][address>>13]][address & 0x1FFF]=data;
+		unsigned short Page=MmuRegisters[MmuState][address>>13];
+		if (MapType | (Page <VectorMaska[CurrentRamConfig]) | (Page > VectorMask[CurrentRamConfig]))
+		{
+			if (VideoWatchArmed)
+				VideoWatchWrite(Page);
+			MemPages[Page][address & 0x1FFF]=data;
+			BankWrites[Page]++;
+		}
 		return;
 	}
 	if (address>0xFEFF)
@@ -301,11 +429,17 @@ void MemWrite8(unsigned char data,unsigned short address)
 	}
 	if (RamVectors)	//Address must be $FE00 - $FEFF
 	{
+		if (VideoWatchArmed)
+			VideoWatchWrite(VectorMask[CurrentRamConfig]);
 		memory[(0x2000 * VectorMask[CurrentRamConfig]) | (address & 0x1FFF)] = data;
+		BankWrites[VectorMask[CurrentRamConfig]]++;
 	}
 	else if (MapType | (MmuRegisters[MmuState][address >> 13] < VectorMaska[CurrentRamConfig]) | (MmuRegisters[MmuState][address >> 13] > VectorMask[CurrentRamConfig]))
 	{
+		if (VideoWatchArmed)
+			VideoWatchWrite(MmuRegisters[MmuState][address >> 13]);
 		MemPages[MmuRegisters[MmuState][address >> 13]][address & 0x1FFF] = data;
+		BankWrites[MmuRegisters[MmuState][address >> 13]]++;
 	}
 
 	return;
@@ -343,8 +477,14 @@ void fMemWrite8(unsigned char data,unsigned short address)
 {
 	if (address<0xFE00)
 	{
-		if (MapType | (MmuRegisters[MmuState][address>>13] <VectorMaska[CurrentRamConfig]) | (MmuRegisters[MmuState][address>>13] > VectorMask[CurrentRamConfig]))
-			MemPages[MmuRegisters[MmuState][address>>13]][address & 0x1FFF]=data;
+		unsigned short Page=MmuRegisters[MmuState][address>>13];
+		if (MapType | (Page <VectorMaska[CurrentRamConfig]) | (Page > VectorMask[CurrentRamConfig]))
+		{
+			if (VideoWatchArmed)
+				VideoWatchWrite(Page);
+			MemPages[Page][address & 0x1FFF]=data;
+			BankWrites[Page]++;
+		}
 		return;
 	}
 	if (address>0xFEFF)
@@ -354,18 +494,168 @@ void fMemWrite8(unsigned char data,unsigned short address)
 	}
 	if (RamVectors)	//Address must be $FE00 - $FEFF
 	{
+		if (VideoWatchArmed)
+			VideoWatchWrite(VectorMask[CurrentRamConfig]);
 		memory[(0x2000 * VectorMask[CurrentRamConfig]) | (address & 0x1FFF)] = data;
+		BankWrites[VectorMask[CurrentRamConfig]]++;
 	}
 	else
 	{
 		if (MapType | (MmuRegisters[MmuState][address >> 13] < VectorMaska[CurrentRamConfig]) | (MmuRegisters[MmuState][address >> 13] > VectorMask[CurrentRamConfig]))
 		{
+			if (VideoWatchArmed)
+				VideoWatchWrite(MmuRegisters[MmuState][address >> 13]);
 			MemPages[MmuRegisters[MmuState][address >> 13]][address & 0x1FFF] = data;
+			BankWrites[MmuRegisters[MmuState][address >> 13]]++;
 		}
 	}
 	return;
 }
 
+// Instruction fetch that missed FetchWindow. Plain RAM and internal ROM banks
+// below $FE00 are cached for MemFetch8, everything else (cartridge space,
+// vectors and I/O) goes through MemRead8 every time.
+unsigned char MemFetch8Slow(unsigned short address)
+{
+	if (address<0xFE00)
+	{
+		unsigned short Page=MmuRegisters[MmuState][address>>13];
+		if (MemPageOffsets[Page]==1)
+		{
+			FetchWindow.Bank=MemPages[Page];
+			FetchWindow.Base=address & 0xE000;
+			FetchWindow.Size=(FetchWindow.Base==0xE000) ? 0x1E00 : 0x2000;
+			return(FetchWindow.Bank[address & 0x1FFF]);
+		}
+	}
+	return(MemRead8(address));
+}
+
+// Stack block transfers for multi-register pushes and pulls. When the whole
+// span sits in one plain RAM bank below $FE00 the bytes are copied directly,
+// otherwise they go through MemWrite8/MemRead8 in the order the CPU issues
+// them. Bytes[0] is always the lowest address of the span.
+void MemPushBlock(const unsigned char *Bytes,unsigned char Count,unsigned short Stack)
+{
+	const unsigned int Bottom=Stack-Count;
+	if ((Stack>=Count) & (Stack<=0xFE00) & ((Bottom>>13)==((Stack-1u)>>13)))
+	{
+		unsigned short Page=MmuRegisters[MmuState][Bottom>>13];
+		if (MapType | (Page <VectorMaska[CurrentRamConfig]) | (Page > VectorMask[CurrentRamConfig]))
+		{
+			if (VideoWatchArmed)
+				VideoWatchWrite(Page);
+			memcpy(MemPages[Page]+(Bottom & 0x1FFF),Bytes,Count);
+			BankWrites[Page]++;
+			return;
+		}
+	}
+	while (Count)
+		MemWrite8(Bytes[--Count],--Stack);
+}
+
+void MemPullBlock(unsigned char *Bytes,unsigned char Count,unsigned short Stack)
+{
+	const unsigned int Top=Stack+Count;
+	if ((Top<=0xFE00) & ((Stack>>13)==((Top-1u)>>13)))
+	{
+		unsigned short Page=MmuRegisters[MmuState][Stack>>13];
+		if (MemPageOffsets[Page]==1)
+		{
+			memcpy(Bytes,MemPages[Page]+(Stack & 0x1FFF),Count);
+			return;
+		}
+	}
+	for (unsigned char Index=0;Index<Count;Index++)
+		Bytes[Index]=MemRead8(Stack++);
+}
+
+// Span transfers for DMA style devices and loaders. Runs that sit in one
+// plain RAM or internal ROM bank below $FE00 are copied directly; vectors,
+// I/O and cartridge space go through MemRead8/MemWrite8 a byte at a time.
+// Writes to ROM are dropped as they are for the CPU. Addresses wrap at $FFFF.
+static unsigned int SpanRun(unsigned short Address,unsigned int Count)
+{
+	if (Address>=0xFE00)
+		return 1;
+	const unsigned int PageEnd=(Address>=0xE000) ? 0xFE00u : (Address|0x1FFFu)+1;
+	return (Count<PageEnd-Address) ? Count : PageEnd-Address;
+}
+
+void MemReadBlock(unsigned char *Bytes,unsigned short Address,unsigned int Count)
+{
+	while (Count)
+	{
+		const unsigned int Run=SpanRun(Address,Count);
+		const unsigned short Page=MmuRegisters[MmuState][Address>>13];
+		if ((Address<0xFE00) & (MemPageOffsets[Page]==1))
+			memcpy(Bytes,MemPages[Page]+(Address & 0x1FFF),Run);
+		else
+			for (unsigned int Index=0;Index<Run;Index++)
+				Bytes[Index]=MemRead8(Address+Index);
+		Bytes+=Run;
+		Address+=Run;
+		Count-=Run;
+	}
+}
+
+void MemWriteBlock(const unsigned char *Bytes,unsigned short Address,unsigned int Count)
+{
+	while (Count)
+	{
+		const unsigned int Run=SpanRun(Address,Count);
+		const unsigned short Page=MmuRegisters[MmuState][Address>>13];
+		if (Address>=0xFE00)
+			MemWrite8(*Bytes,Address);
+		else if (MapType | (Page <VectorMaska[CurrentRamConfig]) | (Page > VectorMask[CurrentRamConfig]))
+		{
+			if (VideoWatchArmed)
+				VideoWatchWrite(Page);
+			memcpy(MemPages[Page]+(Address & 0x1FFF),Bytes,Run);
+			BankWrites[Page]++;
+		}
+		Bytes+=Run;
+		Address+=Run;
+		Count-=Run;
+	}
+}
+
+// Physical RAM as the GIME addresses it, wrapping at the installed size
+void MemReadPhysical(unsigned char *Bytes,unsigned long Address,unsigned int Count)
+{
+	if (mem_initializing | !RamSize)
+	{
+		memset(Bytes,0,Count);
+		return;
+	}
+	while (Count)
+	{
+		Address%=RamSize;
+		const unsigned int Run=(Count<RamSize-Address) ? Count : RamSize-Address;
+		memcpy(Bytes,memory+Address,Run);
+		Bytes+=Run;
+		Address+=Run;
+		Count-=Run;
+	}
+}
+
+void MemWritePhysical(const unsigned char *Bytes,unsigned long Address,unsigned int Count)
+{
+	if (mem_initializing | !RamSize)
+		return;
+	while (Count)
+	{
+		Address%=RamSize;
+		const unsigned int Run=(Count<RamSize-Address) ? Count : RamSize-Address;
+		memcpy(memory+Address,Bytes,Run);
+		for (unsigned long Bank=Address>>13;Bank<=(Address+Run-1)>>13;Bank++)
+			BankWrites[Bank]++;
+		Bytes+=Run;
+		Address+=Run;
+		Count-=Run;
+	}
+}
+
 /*****************************************************************
 * 16 bit memory handling routines                                *
 *****************************************************************/
@@ -391,7 +681,39 @@ unsigned short GetMem(unsigned long address) {
 }
 void SetMem(unsigned long address, unsigned short data) {
 	if (address < RamSize)
+	{
 		memory[address] = (unsigned char) data;
+		BankWrites[address>>13]++;
+	}
+}
+
+// Where the byte the CPU sees at address comes from, for debug views that
+// keep decoded copies of memory. RAM is its offset in memory, with the count
+// of writes to its 8K bank telling when a copy may be stale.
+unsigned long MemLocate(unsigned short address)
+{
+	if (mem_initializing | (address>0xFEFF))
+		return MemIoSpace;
+	if ((address>=0xFE00) & (RamVectors!=0))
+		return (0x2000*VectorMask[CurrentRamConfig])|(address & 0x1FFF);
+	unsigned short Page=MmuRegisters[MmuState][address>>13];
+	if (MemPageOffsets[Page]!=1)
+		return MemCartSpace|(MemPageOffsets[Page]+(address & 0x1FFF));
+	if ((MemPages[Page]>=InternalRomBuffer) & (MemPages[Page]<InternalRomBuffer+0x8000))
+		return MemRomSpace|((MemPages[Page]-InternalRomBuffer)+(address & 0x1FFF));
+	return (MemPages[Page]-memory)+(address & 0x1FFF);
+}
+
+unsigned long long MemBankWrites(unsigned long location)
+{
+	if (location>=RamSize)
+		return 0;
+	return BankWrites[location>>13];
+}
+
+unsigned int MemEpoch()
+{
+	return MemoryEpoch;
 }
 
 unsigned char * Get_mem_pointer()
@@ -399,6 +721,40 @@ unsigned char * Get_mem_pointer()
 	return memory;
 }
 
+unsigned int Get_mem_size()
+{
+	return RamSize;
+}
+
+// Map registers only; RAM is saved separately through Get_mem_pointer()
+template <class StateArchive>
+static void TransferState(StateArchive &state)
+{
+	state(MmuTask)(MmuEnabled)(RamVectors)(RomMap)(MapType)(MmuRegisters)(MmuPrefix);
+}
+
+void MmuSaveState(cutie::StateWriter &state)
+{
+	TransferState(state);
+}
+
+bool MmuLoadState(cutie::StateReader &state)
+{
+	TransferState(state);
+	if (!state.complete())
+		return false;
+
+	MmuState= (!MmuEnabled)<<1 | MmuTask;
+	MemoryEpoch++;	// RAM was restored before the map
+	for (unsigned int Index1=0;Index1<1024;Index1++)
+	{
+		MemPages[Index1]=memory+( (Index1 & RamMask[CurrentRamConfig]) *0x2000);
+		MemPageOffsets[Index1]=1;
+	}
+	UpdateMmuArray();
+	return true;
+}
+
 void SetDistoRamBank(unsigned char data)
 {
 
@@ -432,6 +788,7 @@ void SetMmuPrefix(unsigned char data)
 
 void UpdateMmuArray()
 {
+	InvalidateFetchWindow();
 	if (MapType)
 	{
 		MemPages[VectorMask[CurrentRamConfig]-3]=memory+(0x2000*(VectorMask[CurrentRamConfig]-3));
@@ -1,6 +1,8 @@
 #ifndef __TCC1014MMU_H__
 #define __TCC1014MMU_H__
 #include <array>
+#include "cutie/hostmemory.h"
+#include "cutie/state.h"
 
 
 /*
@@ -48,6 +50,10 @@ unsigned short MemRead16(unsigned short);
 unsigned char MemRead8(unsigned short);
 unsigned char SafeMemRead8(unsigned short);
 unsigned char * MmuInit(unsigned char);
+// Host memory policy for RAM. A change takes effect at the next MmuInit(),
+// which then allocates the buffer anew.
+void SetRamPolicy(const cutie::MemoryPolicy &);
+const cutie::HostBuffer &GetRamAllocation();
 unsigned char *	Getint_rom_pointer();
 unsigned short GetMem(unsigned long);
 void SetMem(unsigned long, unsigned short);
@@ -56,8 +62,54 @@ bool MemCheckWrite(unsigned short address);
 void fMemWrite8(unsigned char,unsigned short );
 unsigned char fMemRead8(unsigned short);
 
+// Host pointer to the RAM or ROM bank the CPU last fetched instructions from.
+// It is dropped whenever the MMU map changes, so the cores can read straight
+// line code without decoding the MMU registers for every opcode and operand.
+struct MemFetchWindow
+{
+	unsigned char *Bank = nullptr;
+	unsigned short Base = 0;	// CPU address of Bank[0]
+	unsigned short Size = 0;	// Bytes readable from Bank, 0 when invalid
+};
+
+extern MemFetchWindow FetchWindow;
+unsigned char MemFetch8Slow(unsigned short);
+
+inline unsigned char MemFetch8(unsigned short address)
+{
+	const unsigned short Offset = address - FetchWindow.Base;
+	if (Offset < FetchWindow.Size)
+		return FetchWindow.Bank[Offset];
+	return MemFetch8Slow(address);
+}
+
+inline unsigned short MemFetch16(unsigned short address)
+{
+	return (MemFetch8(address)<<8 | MemFetch8(address+1));
+}
+
+void MemPushBlock(const unsigned char *,unsigned char,unsigned short);
+void MemPullBlock(unsigned char *,unsigned char,unsigned short);
+void MemReadBlock(unsigned char *,unsigned short,unsigned int);
+void MemWriteBlock(const unsigned char *,unsigned short,unsigned int);
+void MemReadPhysical(unsigned char *,unsigned long,unsigned int);
+void MemWritePhysical(const unsigned char *,unsigned long,unsigned int);
+
+// Where CPU addresses read from, as MemLocate() returns them: an offset into
+// RAM, or an offset into one of the ROM spaces tagged in the high bits. I/O
+// has no fixed contents and is reported as MemIoSpace.
+const unsigned long MemRomSpace=0x1000000;
+const unsigned long MemCartSpace=0x2000000;
+const unsigned long MemIoSpace=0xFFFFFFFF;
+unsigned long MemLocate(unsigned short);
+// Writes so far to the RAM bank holding a MemLocate() result, 0 for ROM.
+// MemEpoch() changes when all of RAM or the system ROM is replaced.
+unsigned long long MemBankWrites(unsigned long);
+unsigned int MemEpoch();
+
 void SetMapType(unsigned char);
 void LoadRom();
+unsigned long long GetSystemRomHash();
 void Set_MmuTask(unsigned char);
 void SetMmuRegister(unsigned char,unsigned char);
 void Set_MmuEnabled (unsigned char );
@@ -67,6 +119,24 @@ void MmuReset();
 void SetDistoRamBank(unsigned char);
 void SetMmuPrefix(unsigned char);
 unsigned char * Get_mem_pointer();
+unsigned int Get_mem_size();
+void MmuSaveState(cutie::StateWriter &);
+bool MmuLoadState(cutie::StateReader &);
+
+// Banks the picture is read from while a coalesced field runs (see
+// coco3.cpp). A write to one calls VideoWatchHit() before the byte lands,
+// so lines the beam has already passed are drawn as they were.
+extern bool VideoWatchArmed;
+extern unsigned char VideoWatchBanks[1024];
+void SetVideoWatch(unsigned int Start,unsigned int Size,unsigned int Mask);
+void ClearVideoWatch();
+void VideoWatchHit();
+
+inline void VideoWatchWrite(unsigned short Page)
+{
+	if (VideoWatchBanks[Page])
+		VideoWatchHit();
+}
 
 // FIXME: These need to be turned into an enum and the signature of functions
 // that use them updated.
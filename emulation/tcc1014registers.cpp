@@ -22,6 +22,7 @@ This file is part of VCC (Virtual Color Computer).
 #include "tcc1014registers.h"
 #include "tcc1014graphics.h"
 #include "coco3.h"
+#include "cutie/timeline.h"
 
 
 static unsigned char VDG_Mode=0;
@@ -57,6 +58,11 @@ void GimeSetKeyboardInteruptState(unsigned char State)
 
 void GimeWrite(unsigned char port,unsigned char data)
 {
+	// Video registers, the palette and the line interrupts need the lines
+	if (port==0x90 || (port>=0x98 && port<=0x9F) || (port>=0xB0 && port<=0xBF)
+		|| ((port==0x92 || port==0x93) && (data & 0x12)))
+		EndCoalescedField();
+	RecordRegisterWrite(0xFF00 | port, data);
 	GimeRegisters[port]=data;
 
 	switch (port)
@@ -160,6 +166,16 @@ void GimeWrite(unsigned char port,unsigned char data)
 	return;
 }
 
+// GimeRead without acknowledging the IRQ and FIRQ status registers
+unsigned char GimePeek(unsigned char port)
+{
+	if (port==0x92)
+		return LastIrq;
+	if (port==0x93)
+		return LastFirq;
+	return GimeRegisters[port];
+}
+
 unsigned char GimeRead(unsigned char port)
 {
 	unsigned char register_value(0u);
@@ -296,6 +312,11 @@ void SetTimerLSB() //95
 	return;
 }
 
+bool GimeKeyboardInteruptEnabled()
+{
+	return ((GimeRegisters[0x93] & 2) && EnhancedFIRQFlag==1) || ((GimeRegisters[0x92] & 2) && EnhancedIRQFlag==1);
+}
+
 void GimeAssertKeyboardInterupt() 
 {
 	if ( ((GimeRegisters[0x93] & 2)!=0) & (EnhancedFIRQFlag==1))
@@ -374,6 +395,9 @@ void sam_write(unsigned char port)
 	unsigned char mask=0;
 	unsigned char reg=0;
 
+	if ((port >=0xC0) & (port <=0xD3))	//VDG mode and display offset
+		EndCoalescedField();
+
 	if ((port >=0xC6) & (port <=0xD3))	//VDG Display offset Section
 	{
 		port=port-0xC6;
@@ -441,3 +465,24 @@ unsigned char VDG_Modes()
 	return VDG_Mode;
 }
 
+// The side effects of the registers (MMU map, video mode, interrupt enables
+// and timer) are saved by the modules they drive, so only the latches here.
+template <class StateArchive>
+static void TransferState(StateArchive &state)
+{
+	state(VDG_Mode)(Dis_Offset)(MPU_Rate)(GimeRegisters)(VerticalOffsetRegister);
+	state(EnhancedFIRQFlag)(EnhancedIRQFlag)(InteruptTimer)(IRQStearing)(FIRQStearing);
+	state(LastIrq)(LastFirq)(KeyboardInteruptEnabled);
+}
+
+void GimeSaveState(cutie::StateWriter &state)
+{
+	TransferState(state);
+}
+
+bool GimeLoadState(cutie::StateReader &state)
+{
+	TransferState(state);
+	return state.complete();
+}
+
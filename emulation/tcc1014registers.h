@@ -18,9 +18,13 @@ This file is part of VCC (Virtual Color Computer).
     along with VCC (Virtual Color Computer).  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include "cutie/state.h"
+
 
 void GimeWrite(unsigned char,unsigned char);
 unsigned char GimeRead(unsigned char);
+unsigned char GimePeek(unsigned char);
+bool GimeKeyboardInteruptEnabled();
 void GimeAssertKeyboardInterupt();
 unsigned char GimeGetKeyboardInteruptState();
 void GimeAssertHorzInterupt();
@@ -31,5 +35,7 @@ void sam_write(unsigned char);
 void mc6883_reset();
 unsigned char VDG_Offset();
 unsigned char VDG_Modes();
+void GimeSaveState(cutie::StateWriter &);
+bool GimeLoadState(cutie::StateReader &);
 
 #endif
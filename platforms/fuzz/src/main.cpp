@@ -0,0 +1,221 @@
+// CutieCoCo Fuzz Driver
+// Feeds inputs from libFuzzer, AFL++ or files to guest code (see cutie/fuzz.h)
+//
+// The target is described by environment variables, since libFuzzer and
+// AFL++ own the command line. Addresses may be given in hex as 0x....
+//
+//   CUTIECOCO_FUZZ_ROM_PATH     Directory containing coco3.rom
+//   CUTIECOCO_FUZZ_CPU          6809 or 6309 (default 6809)
+//   CUTIECOCO_FUZZ_STATE_STORE  State store holding the starting state
+//   CUTIECOCO_FUZZ_STATE        Id of the starting state, else the machine
+//                               boots from power on
+//   CUTIECOCO_FUZZ_BOOT_FRAMES  Frames to run before the snapshot
+//   CUTIECOCO_FUZZ_ENTRY        Program counter at the start of each run
+//   CUTIECOCO_FUZZ_INPUT        Address the input is written to
+//   CUTIECOCO_FUZZ_INPUT_SIZE   Longest input (default 256)
+//   CUTIECOCO_FUZZ_LENGTH       Address of a big endian input length word
+//   CUTIECOCO_FUZZ_EXIT         Comma separated addresses where a run ends
+//   CUTIECOCO_FUZZ_CRASH        Comma separated addresses that are bugs
+//   CUTIECOCO_FUZZ_CYCLES       Cycle budget per run (default 1000000)
+//
+// Guest crashes abort the process so that either fuzzer records the input.
+// Without a fuzzer the arguments are input files, each run once and
+// reported, which reproduces a finding.
+
+#include "cutie/context.h"
+#include "cutie/emulator.h"
+#include "cutie/fuzz.h"
+#include "cutie/statestore.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::unique_ptr<cutie::CocoEmulator> g_emulator;
+std::unique_ptr<cutie::FuzzHarness> g_harness;
+
+const char* environment(const char* name)
+{
+    const char* value = std::getenv(name);
+    return value != nullptr && *value != '\0' ? value : nullptr;
+}
+
+unsigned long number(const char* name, unsigned long fallback)
+{
+    const char* value = environment(name);
+    return value != nullptr ? std::strtoul(value, nullptr, 0) : fallback;
+}
+
+std::vector<uint16_t> addresses(const char* name)
+{
+    std::vector<uint16_t> list;
+    const char* value = environment(name);
+    while (value != nullptr && *value != '\0') {
+        char* end = nullptr;
+        const unsigned long address = std::strtoul(value, &end, 0);
+        if (end == value) {
+            break;  // Not a number
+        }
+        list.push_back(static_cast<uint16_t>(address));
+        value = *end == ',' ? end + 1 : end;
+    }
+    return list;
+}
+
+// Boots the machine to the target's starting point and takes the snapshot
+bool setUp()
+{
+    cutie::EmulatorConfig config;
+    config.audioSampleRate = 0;
+    if (const char* romPath = environment("CUTIECOCO_FUZZ_ROM_PATH")) {
+        config.systemRomPath = romPath;
+        cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    }
+    if (const char* cpu = environment("CUTIECOCO_FUZZ_CPU")) {
+        config.cpuType = std::strcmp(cpu, "6309") == 0 ? cutie::CpuType::HD6309 : cutie::CpuType::MC6809;
+    }
+
+    g_emulator = cutie::CocoEmulator::create(config);
+    if (!g_emulator->init()) {
+        std::fprintf(stderr, "Failed to initialize emulator: %s\n", g_emulator->getLastError().c_str());
+        return false;
+    }
+
+    const char* storePath = environment("CUTIECOCO_FUZZ_STATE_STORE");
+    const char* stateId = environment("CUTIECOCO_FUZZ_STATE");
+    if (stateId != nullptr) {
+        if (storePath == nullptr) {
+            std::fprintf(stderr, "CUTIECOCO_FUZZ_STATE needs CUTIECOCO_FUZZ_STATE_STORE\n");
+            return false;
+        }
+        cutie::StateStore store(storePath);
+        cutie::MachineState state;
+        if (!store.load(stateId, state) || !g_emulator->loadState(state)) {
+            std::fprintf(stderr, "Failed to load state %s\n", stateId);
+            return false;
+        }
+    }
+    for (unsigned long frame = number("CUTIECOCO_FUZZ_BOOT_FRAMES", 0); frame > 0; --frame) {
+        g_emulator->runFrame();
+    }
+
+    cutie::FuzzHarness::Target target;
+    target.entry = static_cast<uint16_t>(number("CUTIECOCO_FUZZ_ENTRY", 0));
+    target.inputAddress = static_cast<uint16_t>(number("CUTIECOCO_FUZZ_INPUT", 0));
+    target.inputCapacity = static_cast<uint16_t>(number("CUTIECOCO_FUZZ_INPUT_SIZE", 256));
+    target.lengthAddress = static_cast<uint16_t>(number("CUTIECOCO_FUZZ_LENGTH", 0));
+    target.exits = addresses("CUTIECOCO_FUZZ_EXIT");
+    target.crashes = addresses("CUTIECOCO_FUZZ_CRASH");
+    target.maxCycles = number("CUTIECOCO_FUZZ_CYCLES", cutie::FuzzHarness::DefaultMaxCycles);
+
+    g_harness = std::make_unique<cutie::FuzzHarness>(*g_emulator);
+    if (!g_harness->begin(target)) {
+        std::fprintf(stderr, "Failed to start fuzzing: %s\n", g_harness->getLastError().c_str());
+        return false;
+    }
+    return true;
+}
+
+cutie::FuzzHarness::Result runOne(const uint8_t* data, size_t size)
+{
+    const auto result = g_harness->run(data, size);
+    if (result.outcome == cutie::FuzzHarness::Outcome::Crash) {
+        std::fprintf(stderr, "guest crash at $%04X after %llu cycles\n",
+            result.pc, static_cast<unsigned long long>(result.cycles));
+        std::abort();
+    }
+    return result;
+}
+
+} // namespace
+
+#if defined(CUTIECOCO_LIBFUZZER)
+
+// libFuzzer reads these counters after every input, alongside its own
+__attribute__((section("__libfuzzer_extra_counters")))
+static uint8_t g_counters[cutie::FuzzHarness::MapSize];
+
+extern "C" int LLVMFuzzerInitialize(int*, char***)
+{
+    if (!setUp()) {
+        std::exit(1);
+    }
+    g_harness->setCoverageMap(g_counters);
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    runOne(data, size);
+    return 0;
+}
+
+#elif defined(__AFL_HAVE_MANUAL_CONTROL)
+
+// Built with afl-clang-fast: persistent mode with inputs in shared memory
+__AFL_FUZZ_INIT();
+
+extern "C" {
+extern unsigned char* __afl_area_ptr;
+extern unsigned int __afl_map_size;
+}
+
+int main()
+{
+    if (!setUp()) {
+        return 1;
+    }
+
+    __AFL_INIT();
+    if (__afl_map_size < cutie::FuzzHarness::MapSize) {
+        std::fprintf(stderr, "AFL map is %u bytes, %zu needed; set AFL_MAP_SIZE\n",
+            __afl_map_size, cutie::FuzzHarness::MapSize);
+        return 1;
+    }
+    g_harness->setCoverageMap(__afl_area_ptr);
+
+    const unsigned char* buffer = __AFL_FUZZ_TESTCASE_BUF;
+    while (__AFL_LOOP(100000)) {
+        runOne(buffer, static_cast<size_t>(__AFL_FUZZ_TESTCASE_LEN));
+    }
+    return 0;
+}
+
+#else
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s INPUT...\n"
+            "Runs each input file once against the target in CUTIECOCO_FUZZ_*\n", argv[0]);
+        return 2;
+    }
+    if (!setUp()) {
+        return 1;
+    }
+
+    static const char* const outcomes[] = {"exit", "crash", "hang"};
+    for (int i = 1; i < argc; ++i) {
+        std::ifstream file(argv[i], std::ios::binary);
+        if (!file) {
+            std::fprintf(stderr, "%s: cannot read\n", argv[i]);
+            return 1;
+        }
+        const std::vector<uint8_t> input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::fprintf(stderr, "%s: ", argv[i]);
+        const auto result = runOne(input.data(), input.size());
+        std::fprintf(stderr, "%s at $%04X after %llu cycles, %zu edges\n",
+            outcomes[static_cast<int>(result.outcome)], result.pc,
+            static_cast<unsigned long long>(result.cycles), g_harness->edgeCount());
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,239 @@
+// CutieCoCo Headless Runner
+// Runs the emulator under the control of another process (see cutie/control.h)
+
+#include "cutie/context.h"
+#include "cutie/control.h"
+#include "cutie/emulator.h"
+#include "cutie/perfcounters.h"
+#include "cutie/statestore.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+
+static void printUsage(const char* program)
+{
+    std::fprintf(stderr,
+        "Usage: %s (--socket PATH | --tcp PORT | --benchmark FRAMES) [options]\n"
+        "  --socket PATH     Listen on a Unix domain socket\n"
+        "  --tcp PORT        Listen on a loopback TCP port (0 picks one)\n"
+        "  --benchmark N     Run N frames from power on and report timings\n"
+        "                    and host performance counters per phase\n"
+        "  --rom-path DIR    Directory containing coco3.rom\n"
+        "  --cpu 6809|6309   CPU type (default 6809)\n"
+        "  --memory SIZE     128k, 512k or 2m (default 512k)\n"
+        "  --audio-rate HZ   Audio sample rate, 0 disables audio (default 0)\n"
+        "  --state-store DIR Directory for saveState and loadState\n"
+        "  --host-dir DIR    Enable the host call device, with DIR for its files\n"
+        "  --rom-hooks on|off Run hot BASIC ROM routines natively (default off)\n"
+        "  --cartridge PATH  Insert a cartridge before serving\n"
+        "  --boot-state ID   Start from a state in the state store\n"
+        "  --boot-frames N   Run N frames before serving, e.g. to reach the\n"
+        "                    BASIC prompt or a shell\n"
+        "  --fork on|off     Serve each connection from a child forked off the\n"
+        "                    booted machine (default off)\n"
+        "  --huge-pages off|transparent|explicit\n"
+        "                    Back guest RAM and the frame buffer with huge\n"
+        "                    pages (default off)\n"
+        "  --numa-node N     Bind memory and the emulation thread to a NUMA\n"
+        "                    node (default none)\n",
+        program);
+}
+
+static int runBenchmark(cutie::CocoEmulator& emulator, long frames)
+{
+    using cutie::PerfEvent;
+    using cutie::PerfPhase;
+
+    auto& perf = cutie::getPerfCounters();
+    if (!perf.enable()) {
+        std::printf("hardware counters unavailable (%s), timing phases only\n", perf.getLastError().c_str());
+    }
+
+    cutie::PerfFrame total;
+    const auto start = std::chrono::steady_clock::now();
+    for (long frame = 0; frame < frames; ++frame) {
+        emulator.runFrame();
+        const auto& counts = perf.lastFrame().counts;
+        for (size_t phase = 0; phase < cutie::PerfPhaseCount; ++phase) {
+            for (size_t event = 0; event < cutie::PerfEventCount; ++event) {
+                total.counts[phase][event] += counts[phase][event];
+            }
+        }
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::printf("%ld frames %.1f ms (%.3f ms/frame)\n", frames, elapsed.count(), elapsed.count() / frames);
+
+    // Per frame averages; events the host does not offer print as "-"
+    static const char* const phaseNames[] = {"cpu", "render", "audio"};
+    static const char* const eventNames[] = {"instr", "cycles", "br-miss", "l1d-miss", "llc-miss", "us"};
+    std::printf("%-8s", "phase");
+    for (const char* name : eventNames) {
+        std::printf(" %12s", name);
+    }
+    std::printf(" %6s\n", "ipc");
+    for (size_t phase = 0; phase < std::size(phaseNames); ++phase) {
+        std::printf("%-8s", phaseNames[phase]);
+        for (size_t event = 0; event < cutie::PerfEventCount; ++event) {
+            double value = static_cast<double>(total.counts[phase][event]) / frames;
+            if (static_cast<PerfEvent>(event) == PerfEvent::Nanoseconds) {
+                value /= 1000.0;
+            }
+            if (perf.hasEvent(static_cast<PerfEvent>(event))) {
+                std::printf(" %12.1f", value);
+            } else {
+                std::printf(" %12s", "-");
+            }
+        }
+        const auto& counts = total.counts[phase];
+        const auto cycles = counts[static_cast<size_t>(PerfEvent::Cycles)];
+        if (cycles != 0) {
+            std::printf(" %6.2f\n", static_cast<double>(counts[static_cast<size_t>(PerfEvent::Instructions)]) / cycles);
+        } else {
+            std::printf(" %6s\n", "-");
+        }
+    }
+    perf.disable();
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    cutie::EmulatorConfig config;
+    config.audioSampleRate = 0;
+    std::string socketPath;
+    std::string stateStorePath;
+    long tcpPort = -1;
+    long benchmarkFrames = 0;
+    std::string cartridgePath;
+    std::string bootState;
+    long bootFrames = 0;
+    bool fork = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string option = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (value == nullptr) {
+            printUsage(argv[0]);
+            return 2;
+        }
+        ++i;
+
+        if (option == "--socket") {
+            socketPath = value;
+        } else if (option == "--tcp") {
+            tcpPort = std::strtol(value, nullptr, 10);
+        } else if (option == "--benchmark") {
+            benchmarkFrames = std::strtol(value, nullptr, 10);
+        } else if (option == "--rom-path") {
+            config.systemRomPath = value;
+        } else if (option == "--cpu") {
+            config.cpuType = std::strcmp(value, "6309") == 0 ? cutie::CpuType::HD6309 : cutie::CpuType::MC6809;
+        } else if (option == "--memory") {
+            const std::string size = value;
+            config.memorySize = size == "128k" ? cutie::MemorySize::Mem128K
+                : size == "2m" ? cutie::MemorySize::Mem2M
+                : cutie::MemorySize::Mem512K;
+        } else if (option == "--audio-rate") {
+            config.audioSampleRate = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+        } else if (option == "--state-store") {
+            stateStorePath = value;
+        } else if (option == "--host-dir") {
+            config.hostCalls = true;
+            config.hostCallDirectory = value;
+        } else if (option == "--rom-hooks") {
+            config.romHooks = std::strcmp(value, "on") == 0;
+        } else if (option == "--cartridge") {
+            cartridgePath = value;
+        } else if (option == "--boot-state") {
+            bootState = value;
+        } else if (option == "--boot-frames") {
+            bootFrames = std::strtol(value, nullptr, 10);
+        } else if (option == "--fork") {
+            fork = std::strcmp(value, "on") == 0;
+        } else if (option == "--huge-pages") {
+            const std::string mode = value;
+            config.memoryPolicy.hugePages = mode == "explicit" ? cutie::HugePages::Explicit
+                : mode == "transparent" ? cutie::HugePages::Transparent
+                : cutie::HugePages::Off;
+        } else if (option == "--numa-node") {
+            config.memoryPolicy.numaNode = static_cast<int>(std::strtol(value, nullptr, 10));
+        } else {
+            printUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    const int modes = !socketPath.empty() + (tcpPort >= 0) + (benchmarkFrames > 0);
+    if (modes != 1 || tcpPort > 65535 || bootFrames < 0 || (!bootState.empty() && stateStorePath.empty())) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    if (!config.systemRomPath.empty()) {
+        cutie::EmulationContext::instance().setSystemRomPath(config.systemRomPath);
+    }
+
+    auto emulator = cutie::CocoEmulator::create(config);
+    if (!emulator->init()) {
+        std::fprintf(stderr, "Failed to initialize emulator: %s\n", emulator->getLastError().c_str());
+        return 1;
+    }
+
+    // Say what the host granted, since requests it cannot meet are stepped down
+    if (config.memoryPolicy.hugePages != cutie::HugePages::Off || config.memoryPolicy.numaNode >= 0) {
+        std::fprintf(stderr, "memory: %s\n", emulator->getMemoryPolicyReport().describe().c_str());
+    }
+
+    if (benchmarkFrames > 0) {
+        return runBenchmark(*emulator, benchmarkFrames);
+    }
+
+    std::unique_ptr<cutie::StateStore> stateStore;
+    cutie::ControlServer server(*emulator);
+    if (!stateStorePath.empty()) {
+        stateStore = std::make_unique<cutie::StateStore>(stateStorePath);
+        server.setStateStore(stateStore.get());
+    }
+
+    // Bring the machine to the checkpoint every client starts from
+    if (!cartridgePath.empty() && !emulator->loadCartridge(cartridgePath)) {
+        std::fprintf(stderr, "Failed to load cartridge: %s\n", emulator->getLastError().c_str());
+        return 1;
+    }
+    if (!bootState.empty()) {
+        cutie::MachineState state;
+        if (!stateStore->load(bootState, state) || !emulator->loadState(state)) {
+            std::fprintf(stderr, "Failed to load boot state %s\n", bootState.c_str());
+            return 1;
+        }
+    }
+    for (long frame = 0; frame < bootFrames; ++frame) {
+        emulator->runFrame();
+    }
+    server.setForkPerConnection(fork);
+    const bool listening = socketPath.empty()
+        ? server.listenTcp(static_cast<uint16_t>(tcpPort))
+        : server.listenUnix(socketPath);
+    if (!listening) {
+        std::fprintf(stderr, "Failed to open control socket\n");
+        return 1;
+    }
+
+    // Orchestrators read this line to learn where to connect
+    if (socketPath.empty()) {
+        std::printf("listening tcp 127.0.0.1:%u\n", server.port());
+    } else {
+        std::printf("listening unix %s\n", socketPath.c_str());
+    }
+    std::fflush(stdout);
+
+    while (server.poll(-1)) {
+    }
+
+    return 0;
+}
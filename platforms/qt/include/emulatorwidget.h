@@ -9,6 +9,7 @@
 
 namespace cutie {
 class CocoEmulator;
+class GamepadInput;
 }
 
 class QtAudioOutput;
@@ -89,6 +90,9 @@ private:
 
     // Audio output
     std::unique_ptr<QtAudioOutput> m_audioOutput;
+
+    // Native gamepads, read on their own thread
+    std::unique_ptr<cutie::GamepadInput> m_gamepads;
 };
 
 #endif // EMULATORWIDGET_H
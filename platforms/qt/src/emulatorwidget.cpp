@@ -4,6 +4,8 @@
 #include "cutie/keyboard.h"
 #include "cutie/keymapping.h"
 #include "cutie/joystick.h"
+#include "cutie/gamepad.h"
+#include "cutie/perfcounters.h"
 
 #include <QKeyEvent>
 #include <QOpenGLContext>
@@ -257,6 +259,12 @@ EmulatorWidget::EmulatorWidget(QWidget *parent)
     cutie::EmulatorConfig config;
     m_emulator = cutie::CocoEmulator::create(config);
 
+    // Attached gamepads feed the joystick directly from their input thread
+    m_gamepads = std::make_unique<cutie::GamepadInput>(cutie::getJoystick());
+    if (m_gamepads->openAttachedDevices() > 0) {
+        m_gamepads->start();
+    }
+
     // Set up emulation timer
     connect(m_emulationTimer, &QTimer::timeout, this, &EmulatorWidget::onEmulationTick);
     m_emulationTimer->setInterval(FRAME_INTERVAL_MS);
@@ -387,6 +395,8 @@ void EmulatorWidget::onEmulationTick()
     m_emulator->runFrame();
 
     // Get the framebuffer and copy to our QImage
+    auto& perf = cutie::getPerfCounters();
+    perf.switchTo(cutie::PerfPhase::Frontend);
     auto [pixels, size] = m_emulator->getFramebuffer();
     if (pixels && size > 0) {
         std::memcpy(m_framebuffer.bits(), pixels, size);
@@ -399,6 +409,7 @@ void EmulatorWidget::onEmulationTick()
             m_audioOutput->submitSamples(samples, count);
         }
     }
+    perf.switchTo(cutie::PerfPhase::Other);
 
     // Update display
     update();
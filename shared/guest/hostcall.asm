@@ -0,0 +1,88 @@
+* hostcall.asm - guest side of the CutieCoCo host call device
+*
+* Assembles with lwasm or asm6809. Include it in a program, or assemble it
+* on its own with an ORG in front. The device is described in
+* emulation/include/cutie/hostcall.h; it only exists when the emulator was
+* started with host calls enabled (--host-dir for the headless runner).
+*
+* Every routine takes X pointing at a 14 byte parameter block and returns
+* the status in A, with Z set when it is HC.OK. Physical addresses and
+* lengths in the block are 32 bits, big endian.
+
+* Device registers
+HC.CMD	equ	$FF88		write: command, read: status of the last one
+HC.ID	equ	$FF89		reads 'H' when the device is present
+HC.BLK	equ	$FF8A		parameter block address, high byte first
+
+* Commands
+HC.COPY	equ	$01
+HC.FILL	equ	$02
+HC.CRC16 equ	$03
+HC.CRC32 equ	$04
+HC.READ	equ	$05
+HC.WRITE equ	$06
+HC.SIZE	equ	$07
+HC.CLOCK equ	$08
+
+* Status
+HC.OK	equ	$00
+HC.BADCMD equ	$01
+HC.BADADR equ	$02
+HC.NODIR equ	$03
+HC.BADNAM equ	$04
+HC.FILERR equ	$05
+
+* Parameter block
+HB.ADDR	equ	0		physical address (4)
+HB.LEN	equ	4		length (4)
+HB.SRC	equ	8		COPY: source address (4)
+HB.VAL	equ	8		FILL: value (1)
+HB.CRC	equ	8		CRC16: 2 bytes, CRC32: 4 bytes, in and out
+HB.OFS	equ	8		READ, WRITE: offset in the file (4)
+HB.NAME	equ	12		READ, WRITE, SIZE: address of the name, zero ended
+HB.SIZE	equ	14
+
+* Clock results, in the same block
+HB.SECS	equ	0		seconds since 1970, UTC (4)
+HB.YEAR	equ	4		local time: year (2)
+HB.MON	equ	6		month 1-12
+HB.DAY	equ	7		day 1-31
+HB.HOUR	equ	8
+HB.MIN	equ	9
+HB.SEC	equ	10
+
+* HCPRES - Z set if the device is present
+HCPRES	pshs	a
+	lda	HC.ID
+	cmpa	#'H
+	puls	a,pc
+
+* HCALL - run command A on the block at X
+HCALL	stx	HC.BLK
+	sta	HC.CMD
+	lda	HC.CMD
+	rts
+
+HCCOPY	lda	#HC.COPY
+	bra	HCALL
+
+HCFILL	lda	#HC.FILL
+	bra	HCALL
+
+HCCRC16	lda	#HC.CRC16
+	bra	HCALL
+
+HCCRC32	lda	#HC.CRC32
+	bra	HCALL
+
+HCREAD	lda	#HC.READ
+	bra	HCALL
+
+HCWRITE	lda	#HC.WRITE
+	bra	HCALL
+
+HCSIZE	lda	#HC.SIZE
+	bra	HCALL
+
+HCCLOCK	lda	#HC.CLOCK
+	bra	HCALL
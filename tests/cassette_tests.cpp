@@ -0,0 +1,225 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+Cassette Tests - Decoding cassette output into .cas files
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "cutie/cassette.h"
+#include "cutie/context.h"
+#include "cutie/emulator.h"
+#include "test_paths.h"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace fs = std::filesystem;
+using cutie::CassetteRecorder;
+
+namespace {
+
+std::vector<uint8_t> readFile(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+// A block as BLKOUT sends it
+void appendBlock(std::vector<uint8_t>& bytes, uint8_t type, const std::vector<uint8_t>& data) {
+    uint8_t checksum = static_cast<uint8_t>(type + data.size());
+    for (uint8_t byte : data) {
+        checksum = static_cast<uint8_t>(checksum + byte);
+    }
+    bytes.insert(bytes.end(), {0x55, 0x3C, type, static_cast<uint8_t>(data.size())});
+    bytes.insert(bytes.end(), data.begin(), data.end());
+    bytes.insert(bytes.end(), {checksum, 0x55});
+}
+
+// Square waves at the ROM's frequencies, with some slack between bytes
+class Waveform {
+public:
+    explicit Waveform(CassetteRecorder& recorder) : m_recorder(recorder) {}
+
+    void byte(uint8_t value) {
+        for (int bit = 0; bit < 8; ++bit) {
+            cycle((value >> bit) & 1 ? 186 : 373);
+        }
+        m_cycle += 40;
+    }
+
+    void cycle(uint64_t half) {
+        m_recorder.output(0xFA, m_cycle);
+        m_recorder.output(0x02, m_cycle + half);
+        m_cycle += 2 * half;
+    }
+
+    void pause(uint64_t cycles) { m_cycle += cycles; }
+    uint64_t now() const { return m_cycle; }
+
+private:
+    CassetteRecorder& m_recorder;
+    uint64_t m_cycle = 1000;
+};
+
+} // namespace
+
+TEST_CASE("CassetteRecorder: Finds bytes after the leader and sync byte", "[cassette]") {
+    const fs::path path = fs::temp_directory_path() / "cutie_cassette_decode.cas";
+    CassetteRecorder recorder;
+    REQUIRE(recorder.open(path));
+
+    Waveform wave(recorder);
+    recorder.motor(true, wave.now());
+
+    // Noise and a stray half cycle before the leader are dropped
+    for (uint8_t noise : {0x12, 0xF0, 0x3C}) {
+        wave.byte(noise);
+    }
+    wave.cycle(60);
+
+    std::vector<uint8_t> expected(6, 0x55);
+    appendBlock(expected, 0x01, {0x00, 0x3C, 0x55, 0xAA, 0xFF});
+    for (uint8_t byte : expected) {
+        wave.byte(byte);
+    }
+
+    // A gap loses sync in the middle of a byte, and the next leader
+    // finds it again
+    wave.cycle(186);
+    wave.cycle(373);
+    wave.pause(CassetteRecorder::GapCycles + 1);
+    std::vector<uint8_t> second(2, 0x55);
+    appendBlock(second, 0xFF, {});
+    for (uint8_t byte : second) {
+        wave.byte(byte);
+    }
+    expected.insert(expected.end(), second.begin(), second.end());
+
+    // Nothing is recorded with the motor off
+    recorder.motor(false, wave.now());
+    for (int i = 0; i < 4; ++i) {
+        wave.byte(0x55);
+    }
+    wave.byte(0x3C);
+
+    REQUIRE(recorder.bytesWritten() == expected.size());
+    recorder.close();
+    REQUIRE(readFile(path) == expected);
+    fs::remove(path);
+}
+
+namespace {
+
+struct CassetteRun {
+    std::vector<uint8_t> cas;
+    std::vector<uint8_t> expected;
+    uint8_t done = 0;
+    uint8_t checksum = 0;  // Left at $80
+    int frames = 0;
+};
+
+// Hooks the IRQ handler to send a leader and three blocks through the
+// ROM's jump table, recording what comes out
+CassetteRun runCsave(const fs::path& romPath, bool turbo) {
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+    for (int i = 0; i < 60; ++i) {
+        emulator->runFrame();
+    }
+
+    std::vector<uint8_t> header = {'T', 'E', 'S', 'T', ' '};
+    std::vector<uint8_t> data;
+    for (int i = 0; i < 40; ++i) {
+        data.push_back(static_cast<uint8_t>(i * 37));
+    }
+    emulator->writeMemory(0x3200, header.data(), header.size());
+    emulator->writeMemory(0x3210, data.data(), data.size());
+
+    uint8_t vector[3] = {};
+    emulator->readMemory(0x010C, vector, sizeof(vector));
+    REQUIRE(vector[0] == 0x7E);
+    const uint8_t handler[] = {
+        0x7D, 0x31, 0x00,        // TST $3100
+        0x26, 0x3C,              // BNE done
+        0x7C, 0x31, 0x00,        // INC $3100
+        0xAD, 0x9F, 0xA0, 0x0C,  // JSR [$A00C]  WRTLDR
+        0xCC, 0x00, 0x05,        // LDD #$0005
+        0xFD, 0x00, 0x7C,        // STD $7C
+        0x8E, 0x32, 0x00,        // LDX #$3200
+        0xBF, 0x00, 0x7E,        // STX $7E
+        0xAD, 0x9F, 0xA0, 0x08,  // JSR [$A008]  BLKOUT
+        0xCC, 0x01, 0x28,        // LDD #$0128
+        0xFD, 0x00, 0x7C,        // STD $7C
+        0x8E, 0x32, 0x10,        // LDX #$3210
+        0xBF, 0x00, 0x7E,        // STX $7E
+        0xAD, 0x9F, 0xA0, 0x08,  // JSR [$A008]
+        0xCC, 0xFF, 0x00,        // LDD #$FF00
+        0xFD, 0x00, 0x7C,        // STD $7C
+        0xAD, 0x9F, 0xA0, 0x08,  // JSR [$A008]
+        0xB6, 0xFF, 0x21,        // LDA $FF21
+        0x84, 0xF7,              // ANDA #$F7    motor off
+        0xB7, 0xFF, 0x21,        // STA $FF21
+        0x7C, 0x31, 0x00,        // INC $3100
+        0x7E, vector[1], vector[2],  // done: JMP to the ROM's handler
+    };
+    emulator->writeMemory(0x3000, handler, sizeof(handler));
+    const uint8_t zero = 0;
+    emulator->writeMemory(0x3100, &zero, 1);
+
+    CassetteRun run;
+    uint8_t leader[2] = {};
+    emulator->readMemory(0x0092, leader, sizeof(leader));
+    run.expected.assign(leader[0] << 8 | leader[1], 0x55);
+    appendBlock(run.expected, 0x00, header);
+    appendBlock(run.expected, 0x01, data);
+    appendBlock(run.expected, 0xFF, {});
+
+    const fs::path path = fs::temp_directory_path() / "cutie_cassette_csave.cas";
+    auto& recorder = cutie::getCassetteRecorder();
+    REQUIRE(recorder.open(path, turbo));
+    const uint8_t hook[] = {0x7E, 0x30, 0x00};
+    emulator->writeMemory(0x010C, hook, sizeof(hook));
+
+    for (; run.frames < 600 && run.done != 2; ++run.frames) {
+        emulator->runFrame();
+        emulator->readMemory(0x3100, &run.done, 1);
+    }
+    // BASIC carries on afterwards
+    for (int i = 0; i < 10; ++i) {
+        emulator->runFrame();
+    }
+    recorder.close();
+
+    emulator->readMemory(0x0080, &run.checksum, 1);
+    run.cas = readFile(path);
+    fs::remove(path);
+    return run;
+}
+
+} // namespace
+
+TEST_CASE("CassetteRecorder: ROM cassette output decodes to the blocks it sent", "[cassette][integration]") {
+    auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping cassette test");
+    }
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+
+    const CassetteRun wave = runCsave(romPath, false);
+    REQUIRE(wave.done == 2);
+    REQUIRE(wave.frames > 30);
+    REQUIRE(wave.checksum == 0xFF);
+    REQUIRE((wave.cas == wave.expected));
+
+    // Turbo mode writes the same file without running the routines
+    const CassetteRun turbo = runCsave(romPath, true);
+    REQUIRE(turbo.done == 2);
+    REQUIRE(turbo.frames < 3);
+    REQUIRE(turbo.checksum == 0xFF);
+    REQUIRE((turbo.cas == wave.cas));
+}
@@ -0,0 +1,340 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+Compressed Image Tests - Seekable access to BGZF and zip disk images
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "vcc/utils/compressed_image_stream.h"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <zlib.h>
+
+namespace fs = std::filesystem;
+using vcc::utils::compressed_image_buffer;
+using vcc::utils::compressed_image_stream;
+
+namespace {
+
+// Unique per test run so that parallel ctest jobs never share a file
+class TempFile {
+public:
+    explicit TempFile(const std::string& suffix)
+        : m_path(fs::temp_directory_path()
+            / ("cutiecoco-image-" + std::to_string(std::random_device()()) + suffix))
+    {
+    }
+    ~TempFile() {
+        std::error_code ec;
+        fs::remove(m_path, ec);
+    }
+    const fs::path& path() const { return m_path; }
+
+private:
+    fs::path m_path;
+};
+
+/**
+ * Builds an image whose bytes depend on their offset, drawn from a small
+ * alphabet so that it compresses into many deflate blocks.
+ */
+std::vector<uint8_t> makeImage(size_t size) {
+    std::vector<uint8_t> image(size);
+    uint32_t seed = 0x1234567;
+    for (size_t i = 0; i < size; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        image[i] = static_cast<uint8_t>("CoCo3 disk image"[(seed >> 16) & 15] + (i >> 16));
+    }
+    return image;
+}
+
+std::vector<uint8_t> deflateRaw(const uint8_t* data, size_t size) {
+    z_stream stream{};
+    REQUIRE(deflateInit2(&stream, 6, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) == Z_OK);
+    std::vector<uint8_t> out(deflateBound(&stream, static_cast<uLong>(size)));
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = out.data();
+    stream.avail_out = static_cast<uInt>(out.size());
+    REQUIRE(deflate(&stream, Z_FINISH) == Z_STREAM_END);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return out;
+}
+
+void putLe16(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void putLe32(std::vector<uint8_t>& out, uint32_t value) {
+    putLe16(out, value & 0xFFFF);
+    putLe16(out, value >> 16);
+}
+
+void writeFile(const fs::path& path, const std::vector<uint8_t>& data) {
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(data.data()), data.size());
+}
+
+std::vector<uint8_t> readFile(const fs::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {});
+}
+
+/**
+ * Writes the image as bgzip does: gzip members of at most 0xFF00 bytes with
+ * the BC extra field, followed by an empty end of file member.
+ */
+void writeBgzf(const fs::path& path, const std::vector<uint8_t>& image) {
+    std::vector<uint8_t> file;
+    auto member = [&](const uint8_t* data, size_t size) {
+        const auto body = deflateRaw(data, size);
+        const uint8_t header[] = {0x1F, 0x8B, 8, 4, 0, 0, 0, 0, 0, 0xFF, 6, 0, 'B', 'C', 2, 0};
+        file.insert(file.end(), std::begin(header), std::end(header));
+        putLe16(file, static_cast<uint32_t>(sizeof(header) + 2 + body.size() + 8 - 1));
+        file.insert(file.end(), body.begin(), body.end());
+        putLe32(file, crc32(0, data, static_cast<uInt>(size)));
+        putLe32(file, static_cast<uint32_t>(size));
+    };
+
+    for (size_t offset = 0; offset < image.size(); offset += 0xFF00) {
+        member(image.data() + offset, std::min<size_t>(0xFF00, image.size() - offset));
+    }
+    member(nullptr, 0);
+    writeFile(path, file);
+}
+
+/**
+ * Writes a zip archive holding a readme and the image as disk.dsk.
+ */
+void writeZip(const fs::path& path, const std::vector<uint8_t>& image, bool deflated) {
+    struct Entry { std::string name; std::vector<uint8_t> data; bool deflated; };
+    const std::string readme = "Not a disk image";
+    const Entry entries[] = {
+        {"readme.txt", std::vector<uint8_t>(readme.begin(), readme.end()), false},
+        {"disk.dsk", image, deflated},
+    };
+
+    std::vector<uint8_t> file;
+    std::vector<uint8_t> directory;
+    for (const auto& entry : entries) {
+        const auto body = entry.deflated ? deflateRaw(entry.data.data(), entry.data.size()) : entry.data;
+        const auto crc = crc32(0, entry.data.data(), static_cast<uInt>(entry.data.size()));
+        const auto localOffset = static_cast<uint32_t>(file.size());
+
+        auto common = [&](std::vector<uint8_t>& out) {
+            putLe16(out, 20);
+            putLe16(out, 0);
+            putLe16(out, entry.deflated ? 8 : 0);
+            putLe32(out, 0);
+            putLe32(out, crc);
+            putLe32(out, static_cast<uint32_t>(body.size()));
+            putLe32(out, static_cast<uint32_t>(entry.data.size()));
+            putLe16(out, static_cast<uint32_t>(entry.name.size()));
+            putLe16(out, 0);
+        };
+
+        putLe32(file, 0x04034B50);
+        common(file);
+        file.insert(file.end(), entry.name.begin(), entry.name.end());
+        file.insert(file.end(), body.begin(), body.end());
+
+        putLe32(directory, 0x02014B50);
+        putLe16(directory, 20);
+        common(directory);
+        putLe16(directory, 0);
+        putLe16(directory, 0);
+        putLe16(directory, 0);
+        putLe32(directory, 0);
+        putLe32(directory, localOffset);
+        directory.insert(directory.end(), entry.name.begin(), entry.name.end());
+    }
+
+    const auto directoryOffset = static_cast<uint32_t>(file.size());
+    file.insert(file.end(), directory.begin(), directory.end());
+    putLe32(file, 0x06054B50);
+    putLe32(file, 0);
+    putLe16(file, 2);
+    putLe16(file, 2);
+    putLe32(file, static_cast<uint32_t>(directory.size()));
+    putLe32(file, directoryOffset);
+    putLe16(file, 0);
+    writeFile(path, file);
+}
+
+std::vector<uint8_t> readAt(compressed_image_stream& stream, size_t offset, size_t size) {
+    std::vector<uint8_t> data(size);
+    stream.clear();
+    stream.seekg(static_cast<std::streamoff>(offset));
+    stream.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(size));
+    data.resize(static_cast<size_t>(stream.gcount()));
+    return data;
+}
+
+std::vector<uint8_t> slice(const std::vector<uint8_t>& image, size_t offset, size_t size) {
+    return std::vector<uint8_t>(image.begin() + offset, image.begin() + offset + size);
+}
+
+/**
+ * Reads spans that start inside blocks and run across block boundaries, in
+ * an order that jumps back and forth through the image.
+ */
+void checkRandomAccess(compressed_image_stream& stream, const std::vector<uint8_t>& image) {
+    const size_t offsets[] = {
+        image.size() - 100, 0, 0xFF00 - 7, 0x10000 - 3, 3 * 0x10000 + 1, 12345, 2 * 0xFF00 - 1, 0x2ABCD,
+    };
+    for (const auto offset : offsets) {
+        INFO("offset " << offset);
+        REQUIRE(readAt(stream, offset, 200) == slice(image, offset, std::min<size_t>(200, image.size() - offset)));
+    }
+
+    REQUIRE(readAt(stream, 0, image.size()) == image);
+}
+
+} // namespace
+
+TEST_CASE("Compressed image: BGZF members are read in any order", "[compressed-image]") {
+    TempFile file(".dsk.gz");
+    const auto image = makeImage(5 * 0x10000 + 1234);
+    writeBgzf(file.path(), image);
+
+    REQUIRE(compressed_image_buffer::is_compressed_image(file.path()));
+
+    compressed_image_stream stream(file.path());
+    REQUIRE(stream.is_open());
+    checkRandomAccess(stream, image);
+
+    stream.clear();
+    stream.seekg(0, std::ios::end);
+    REQUIRE(static_cast<size_t>(stream.tellg()) == image.size());
+}
+
+TEST_CASE("Compressed image: Plain gzip files are not treated as images", "[compressed-image]") {
+    TempFile file(".dsk.gz");
+    std::vector<uint8_t> gzip = {0x1F, 0x8B, 8, 0, 0, 0, 0, 0, 0, 0xFF};
+    const auto image = makeImage(1000);
+    const auto body = deflateRaw(image.data(), image.size());
+    gzip.insert(gzip.end(), body.begin(), body.end());
+    putLe32(gzip, crc32(0, image.data(), static_cast<uInt>(image.size())));
+    putLe32(gzip, static_cast<uint32_t>(image.size()));
+    writeFile(file.path(), gzip);
+
+    REQUIRE_FALSE(compressed_image_buffer::is_compressed_image(file.path()));
+    REQUIRE_FALSE(compressed_image_stream(file.path()).is_open());
+}
+
+TEST_CASE("Compressed image: Zip entries are read in any order", "[compressed-image]") {
+    const auto image = makeImage(5 * 0x10000 + 1234);
+
+    SECTION("Stored") {
+        TempFile file(".zip");
+        writeZip(file.path(), image, false);
+        REQUIRE(compressed_image_buffer::is_compressed_image(file.path()));
+
+        compressed_image_stream stream(file.path());
+        REQUIRE(stream.is_open());
+        checkRandomAccess(stream, image);
+    }
+
+    SECTION("Deflated") {
+        TempFile file(".zip");
+        writeZip(file.path(), image, true);
+
+        compressed_image_buffer buffer(file.path());
+        REQUIRE(buffer.is_open());
+        REQUIRE(buffer.size() == image.size());
+        // One checkpoint about every 64 KiB rather than a single block
+        REQUIRE(buffer.block_count() >= 4);
+
+        compressed_image_stream stream(file.path());
+        REQUIRE(stream.is_open());
+        checkRandomAccess(stream, image);
+    }
+
+    SECTION("Damaged deflate data") {
+        TempFile file(".zip");
+        writeZip(file.path(), image, true);
+        auto data = readFile(file.path());
+        std::fill(data.begin() + 1000, data.begin() + 1100, 0xFF);
+        writeFile(file.path(), data);
+
+        REQUIRE_FALSE(compressed_image_stream(file.path()).is_open());
+    }
+}
+
+TEST_CASE("Compressed image: The block cache evicts the least recently used block", "[compressed-image]") {
+    TempFile file(".zip");
+    const size_t blockSize = 0x10000;
+    const auto blockCount = compressed_image_buffer::cache_capacity + 2;
+    const auto image = makeImage(blockCount * blockSize);
+    writeZip(file.path(), image, false);
+
+    compressed_image_stream stream(file.path());
+    REQUIRE(stream.is_open());
+
+    // Fill the cache with blocks 0 to 7, use block 0 again, then load block 8,
+    // which pushes out block 1
+    for (size_t block = 0; block < compressed_image_buffer::cache_capacity; ++block) {
+        readAt(stream, block * blockSize, 1);
+    }
+    readAt(stream, 0, 1);
+    readAt(stream, compressed_image_buffer::cache_capacity * blockSize, 1);
+
+    // Change the archive behind the stream's back: only blocks that are not
+    // cached see the change
+    const size_t entryOffset = 30 + 10 + 16 + 30 + 8;  // readme.txt, then disk.dsk's header
+    {
+        std::fstream archive(file.path(), std::ios::in | std::ios::out | std::ios::binary);
+        for (size_t block = 0; block < 3; ++block) {
+            archive.seekp(static_cast<std::streamoff>(entryOffset + block * blockSize));
+            archive.put('X');
+        }
+    }
+
+    // Block 1 goes last, as reloading it pushes out block 2
+    REQUIRE(readAt(stream, 0, 1)[0] == image[0]);
+    REQUIRE(readAt(stream, 2 * blockSize, 1)[0] == image[2 * blockSize]);
+    REQUIRE(readAt(stream, blockSize, 1)[0] == 'X');
+}
+
+TEST_CASE("Compressed image: Writes go to an overlay and not to the archive", "[compressed-image]") {
+    TempFile file(".dsk.gz");
+    auto image = makeImage(3 * 0xFF00);
+    writeBgzf(file.path(), image);
+    const auto archive = readFile(file.path());
+
+    compressed_image_stream stream(file.path());
+    REQUIRE(stream.is_open());
+
+    // Straddle the boundary between the first two members
+    const std::string text = "OVERLAY";
+    const size_t offset = 0xFF00 - 3;
+    stream.seekp(static_cast<std::streamoff>(offset));
+    stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+    stream.flush();
+    REQUIRE(stream.good());
+    std::copy(text.begin(), text.end(), image.begin() + offset);
+
+    compressed_image_buffer& buffer = *static_cast<compressed_image_buffer*>(stream.rdbuf());
+    REQUIRE(buffer.modified_block_count() == 2);
+
+    REQUIRE(readAt(stream, offset - 10, 30) == slice(image, offset - 10, 30));
+    REQUIRE(readAt(stream, 0, image.size()) == image);
+
+    // Writing past the end is refused rather than growing the image
+    stream.clear();
+    stream.seekp(static_cast<std::streamoff>(image.size() - 2));
+    stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+    REQUIRE(stream.bad());
+
+    REQUIRE(readFile(file.path()) == archive);
+    REQUIRE(compressed_image_stream(file.path()).is_open());
+    compressed_image_stream reopened(file.path());
+    REQUIRE(readAt(reopened, offset, text.size()) != std::vector<uint8_t>(text.begin(), text.end()));
+}
@@ -0,0 +1,405 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+Control Tests - JSON-RPC control channel with binary side payloads
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "cutie/context.h"
+#include "cutie/control.h"
+#include "cutie/emulator.h"
+#include "cutie/statestore.h"
+#include "test_paths.h"
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// Blocking client side of a control connection
+class ControlClient {
+public:
+    explicit ControlClient(int fd) : m_fd(fd) {}
+    ~ControlClient() { close(m_fd); }
+
+    void send(const std::string& text) {
+        REQUIRE(::send(m_fd, text.data(), text.size(), 0) == static_cast<ssize_t>(text.size()));
+    }
+
+    std::string readLine() {
+        std::string line;
+        char c;
+        while (::recv(m_fd, &c, 1, 0) == 1 && c != '\n') {
+            line += c;
+        }
+        return line;
+    }
+
+    std::vector<uint8_t> readBytes(size_t count) {
+        std::vector<uint8_t> bytes(count);
+        size_t received = 0;
+        while (received < count) {
+            const ssize_t chunk = ::recv(m_fd, bytes.data() + received, count - received, 0);
+            if (chunk <= 0) break;
+            received += static_cast<size_t>(chunk);
+        }
+        bytes.resize(received);
+        return bytes;
+    }
+
+private:
+    int m_fd;
+};
+
+// Runs the server on its own thread, as the headless runner's main loop would
+class ServerThread {
+public:
+    explicit ServerThread(cutie::ControlServer& server)
+        : m_thread([&server] { while (server.poll(10)) {} }) {}
+    ~ServerThread() { m_thread.join(); }
+
+private:
+    std::thread m_thread;
+};
+
+TEST_CASE("Control: Protocol errors are reported per request", "[control]") {
+    auto emulator = cutie::CocoEmulator::create();
+    cutie::ControlServer server(*emulator);
+
+    int fds[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    REQUIRE(server.addConnection(fds[0]));
+    ControlClient client(fds[1]);
+    ServerThread thread(server);
+
+    client.send("{not json\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":null,"error":{"code":-32700,"message":"Parse error"}})");
+
+    client.send(R"({"jsonrpc":"2.0","id":"a","method":"fly"})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":"a","error":{"code":-32601,"message":"Method not found"}})");
+
+    client.send(R"({"jsonrpc":"2.0","id":2,"method":"runFrames"})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":2,"error":{"code":-32000,"message":"Emulator is not initialized"}})");
+
+    // Notifications are never answered; the next reply belongs to id 3
+    client.send(R"({"jsonrpc":"2.0","method":"fly"})" "\n" R"({"jsonrpc":"2.0","id":3,"method":"quit"})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":3,"result":true})");
+}
+
+TEST_CASE("Control: Memory and framebuffer travel as raw bytes", "[control]") {
+    const auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping control test");
+    }
+
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+
+    cutie::ControlServer server(*emulator);
+    int fds[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    REQUIRE(server.addConnection(fds[0]));
+    ControlClient client(fds[1]);
+    ServerThread thread(server);
+
+    client.send(R"({"jsonrpc":"2.0","id":1,"method":"runFrames","params":{"count":5}})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":1,"result":{"frames":5}})");
+
+    // Split the request and its payload across sends
+    client.send(R"({"jsonrpc":"2.0","id":2,"method":"writeMemory",)");
+    client.send(R"("params":{"address":4096,"length":4}})" "\n" "\x01\n");
+    client.send("\x7f\xff");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":2,"result":{"written":4}})");
+
+    client.send(R"({"jsonrpc":"2.0","id":3,"method":"readMemory","params":{"address":4095,"length":6}})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":3,"result":{"address":4095,"length":6,"binary":6}})");
+    const auto bytes = client.readBytes(6);
+    REQUIRE(bytes.size() == 6);
+    REQUIRE(bytes[1] == 0x01);
+    REQUIRE(bytes[2] == '\n');
+    REQUIRE(bytes[3] == 0x7F);
+    REQUIRE(bytes[4] == 0xFF);
+
+    client.send(R"({"jsonrpc":"2.0","id":4,"method":"screenshot"})" "\n");
+    const auto info = emulator->getFramebufferInfo();
+    const std::string size = std::to_string(info.sizeBytes());
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":4,"result":{"width":640,"height":480,"pitch":640,"format":"RGBA8888","binary":)" + size + "}}");
+    REQUIRE(client.readBytes(info.sizeBytes()).size() == info.sizeBytes());
+
+    client.send(R"({"jsonrpc":"2.0","id":5,"method":"input","params":{"type":"key","row":9,"col":0,"pressed":true}})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":5,"error":{"code":-32602,"message":"Unrecognized input event"}})");
+
+    client.send(R"({"jsonrpc":"2.0","id":6,"method":"quit"})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":6,"result":true})");
+}
+
+TEST_CASE("Control: A refused writeMemory still consumes its payload", "[control]") {
+    const auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping control test");
+    }
+
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+
+    cutie::ControlServer server(*emulator);
+    int fds[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    REQUIRE(server.addConnection(fds[0]));
+    ControlClient client(fds[1]);
+    {
+        ServerThread thread(server);
+
+        // The payload looks like a request of its own and must not run as one
+        const std::string payload = R"({"jsonrpc":"2.0","id":9,"method":"quit"})" "\n";
+        client.send(R"({"jsonrpc":"2.0","id":1,"method":"writeMemory","params":{"address":65536,"length":)"
+            + std::to_string(payload.size()) + "}}\n" + payload.substr(0, 10));
+        REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":1,"error":{"code":-32602,"message":"address and length are required"}})");
+        client.send(payload.substr(10));
+
+        // Longer than the address space, and split across sends
+        client.send(R"({"jsonrpc":"2.0","id":2,"method":"writeMemory","params":{"address":0,"length":70000}})" "\n");
+        REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":2,"error":{"code":-32602,"message":"address and length are required"}})");
+        client.send(std::string(40000, '\n'));
+        client.send(std::string(30000, '{'));
+
+        client.send(R"({"jsonrpc":"2.0","id":3,"method":"readMemory","params":{"address":4096,"length":1}})" "\n");
+        REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":3,"result":{"address":4096,"length":1,"binary":1}})");
+        REQUIRE(client.readBytes(1).size() == 1);
+
+        client.send(R"({"jsonrpc":"2.0","id":4,"method":"quit"})" "\n");
+        REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":4,"result":true})");
+    }
+
+    // Without a length there is no telling where the next request starts
+    client.send(R"({"jsonrpc":"2.0","id":5,"method":"writeMemory","params":{"address":0,"length":-1}})" "\n");
+    server.poll(1000);
+    REQUIRE(server.connectionCount() == 0);
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":5,"error":{"code":-32602,"message":"address and length are required"}})");
+    REQUIRE(client.readLine().empty());
+}
+
+TEST_CASE("Control: Clients connect over a Unix domain socket", "[control]") {
+    auto emulator = cutie::CocoEmulator::create();
+    cutie::ControlServer server(*emulator);
+
+    const auto path = fs::temp_directory_path() / ("cutiecoco-control-" + std::to_string(getpid()) + ".sock");
+    REQUIRE(server.listenUnix(path));
+    REQUIRE(fs::exists(path));
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", path.c_str());
+    REQUIRE(connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+
+    ControlClient client(fd);
+    {
+        ServerThread thread(server);
+        client.send(R"({"jsonrpc":"2.0","id":1,"method":"quit"})" "\n");
+        REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":1,"result":true})");
+    }
+    REQUIRE(server.connectionCount() == 1);
+
+    server.close();
+    REQUIRE_FALSE(fs::exists(path));
+}
+
+TEST_CASE("Control: States round trip through the state store", "[control]") {
+    const auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping control test");
+    }
+
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+
+    // quit is final for a server, so the storeless server gets its own
+    {
+        cutie::ControlServer storeless(*emulator);
+        int fds[2];
+        REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+        REQUIRE(storeless.addConnection(fds[0]));
+        ControlClient client(fds[1]);
+        ServerThread thread(storeless);
+        client.send(R"({"jsonrpc":"2.0","id":1,"method":"saveState"})" "\n");
+        REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":1,"error":{"code":-32000,"message":"No state store is configured"}})");
+        client.send(R"({"jsonrpc":"2.0","id":2,"method":"quit"})" "\n");
+        REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":2,"result":true})");
+    }
+
+    const auto storePath = fs::temp_directory_path() / ("cutiecoco-control-states-" + std::to_string(getpid()));
+    cutie::StateStore store(storePath);
+    cutie::ControlServer server(*emulator);
+    server.setStateStore(&store);
+    int fds[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    REQUIRE(server.addConnection(fds[0]));
+    ControlClient client(fds[1]);
+    ServerThread thread(server);
+
+    client.send(R"({"jsonrpc":"2.0","id":3,"method":"saveState"})" "\n");
+    const std::string saved = client.readLine();
+    const std::string prefix = R"({"jsonrpc":"2.0","id":3,"result":{"id":")";
+    REQUIRE(saved.compare(0, prefix.size(), prefix) == 0);
+    const std::string stateId = saved.substr(prefix.size(), 64);
+    REQUIRE(store.contains(stateId));
+
+    client.send(R"({"jsonrpc":"2.0","id":4,"method":"writeMemory","params":{"address":4096,"length":1}})" "\n" "\x42");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":4,"result":{"written":1}})");
+    client.send(R"({"jsonrpc":"2.0","id":5,"method":"loadState","params":{"id":")" + stateId + R"("}})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":5,"result":true})");
+    uint8_t byte = 0;
+    emulator->readMemory(4096, &byte, 1);
+    REQUIRE(byte != 0x42);
+
+    client.send(R"({"jsonrpc":"2.0","id":6,"method":"loadState","params":{"id":"../x"}})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":6,"error":{"code":-32000,"message":"Invalid state id: ../x"}})");
+
+    client.send(R"({"jsonrpc":"2.0","id":7,"method":"quit"})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":7,"result":true})");
+    std::error_code ec;
+    fs::remove_all(storePath, ec);
+}
+
+TEST_CASE("Control: RAM search narrows down a changing value", "[control]") {
+    const auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping control test");
+    }
+
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+
+    cutie::ControlServer server(*emulator);
+    int fds[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    REQUIRE(server.addConnection(fds[0]));
+    ControlClient client(fds[1]);
+    ServerThread thread(server);
+
+    client.send(R"({"jsonrpc":"2.0","id":1,"method":"searchFilter","params":{"compare":"eq","value":1}})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":1,"error":{"code":-32000,"message":"No search in progress; call searchStart first"}})");
+    client.send(R"({"jsonrpc":"2.0","id":2,"method":"searchStart","params":{"width":2}})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":2,"result":{"candidates":524287}})");
+
+    // $4000 holds $1234, then counts up by $101
+    client.send(R"({"jsonrpc":"2.0","id":3,"method":"writeMemory","params":{"address":16384,"length":2}})" "\n" "\x12\x34");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":3,"result":{"written":2}})");
+    client.send(R"({"jsonrpc":"2.0","id":4,"method":"searchFilter","params":{"compare":"eq","value":4660}})" "\n");
+    const std::string prefix = R"({"jsonrpc":"2.0","id":4,"result":{"candidates":)";
+    REQUIRE(client.readLine().compare(0, prefix.size(), prefix) == 0);
+    client.send(R"({"jsonrpc":"2.0","id":5,"method":"writeMemory","params":{"address":16384,"length":2}})" "\n" "\x13\x35");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":5,"result":{"written":2}})");
+    client.send(R"({"jsonrpc":"2.0","id":6,"method":"searchFilter","params":{"compare":"eq","delta":257}})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":6,"result":{"candidates":1}})");
+
+    // Task 0 maps $4000 to block $3A in a 512K machine
+    client.send(R"({"jsonrpc":"2.0","id":7,"method":"searchResults","params":{"limit":10}})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":7,"result":{"candidates":1,"addresses":[475136]}})");
+
+    client.send(R"({"jsonrpc":"2.0","id":8,"method":"searchFilter","params":{"compare":"around","value":1}})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":8,"error":{"code":-32602,"message":"compare must be eq, ne, lt, le, gt or ge"}})");
+    client.send(R"({"jsonrpc":"2.0","id":9,"method":"searchFilter","params":{"compare":"eq","value":65536}})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":9,"error":{"code":-32602,"message":"value out of range"}})");
+
+    client.send(R"({"jsonrpc":"2.0","id":10,"method":"quit"})" "\n");
+    REQUIRE(client.readLine() == R"({"jsonrpc":"2.0","id":10,"result":true})");
+}
+
+TEST_CASE("Control: Forked clients each start from the booted machine", "[control]") {
+    const auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping control test");
+    }
+
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+    for (int frame = 0; frame < 10; ++frame) {
+        emulator->runFrame();
+    }
+    uint8_t booted = 0;
+    emulator->readMemory(0x1000, &booted, 1);
+
+    cutie::ControlServer server(*emulator);
+    server.setForkPerConnection(true);
+    const auto path = fs::temp_directory_path() / ("cutiecoco-fork-" + std::to_string(getpid()) + ".sock");
+    REQUIRE(server.listenUnix(path));
+
+    const auto connectClient = [&path] {
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::snprintf(address.sun_path, sizeof(address.sun_path), "%s", path.c_str());
+        REQUIRE(connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0);
+        return fd;
+    };
+
+    // Each accept hands the connection to a new child and returns at once
+    ControlClient first(connectClient());
+    while (server.childCount() < 1) {
+        REQUIRE(server.poll(1000));
+    }
+    ControlClient second(connectClient());
+    while (server.childCount() < 2) {
+        REQUIRE(server.poll(1000));
+    }
+    REQUIRE(server.connectionCount() == 0);
+
+    const uint8_t written = static_cast<uint8_t>(booted ^ 0xFF);
+    first.send(R"({"jsonrpc":"2.0","id":1,"method":"writeMemory","params":{"address":4096,"length":1}})" "\n");
+    first.send(std::string(1, static_cast<char>(written)));
+    REQUIRE(first.readLine() == R"({"jsonrpc":"2.0","id":1,"result":{"written":1}})");
+    first.send(R"({"jsonrpc":"2.0","id":2,"method":"readMemory","params":{"address":4096,"length":1}})" "\n");
+    REQUIRE(first.readLine() == R"({"jsonrpc":"2.0","id":2,"result":{"address":4096,"length":1,"binary":1}})");
+    REQUIRE((first.readBytes(1) == std::vector<uint8_t>{written}));
+
+    // Neither the other child nor the parent sees that write
+    second.send(R"({"jsonrpc":"2.0","id":1,"method":"readMemory","params":{"address":4096,"length":1}})" "\n");
+    REQUIRE(second.readLine() == R"({"jsonrpc":"2.0","id":1,"result":{"address":4096,"length":1,"binary":1}})");
+    REQUIRE((second.readBytes(1) == std::vector<uint8_t>{booted}));
+    uint8_t parent = 0;
+    emulator->readMemory(0x1000, &parent, 1);
+    REQUIRE(parent == booted);
+
+    // Quit ends a child, not the server; both are reaped once they exit
+    first.send(R"({"jsonrpc":"2.0","id":3,"method":"quit"})" "\n");
+    REQUIRE(first.readLine() == R"({"jsonrpc":"2.0","id":3,"result":true})");
+    second.send(R"({"jsonrpc":"2.0","id":2,"method":"quit"})" "\n");
+    REQUIRE(second.readLine() == R"({"jsonrpc":"2.0","id":2,"result":true})");
+    for (int attempt = 0; attempt < 500 && server.childCount() > 0; ++attempt) {
+        REQUIRE(server.poll(10));
+    }
+    REQUIRE(server.childCount() == 0);
+
+    server.close();
+    REQUIRE_FALSE(fs::exists(path));
+}
+#endif
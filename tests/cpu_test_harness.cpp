@@ -10,6 +10,7 @@ CPU Test Harness - Sets up the emulation environment for CPU instruction testing
 #include "tcc1014registers.h"
 #include "tcc1014graphics.h"
 #include "mc6809.h"
+#include "hd6309.h"
 #include "cutie/stubs.h"
 #include <cstring>
 
@@ -23,7 +24,9 @@ static constexpr size_t TEST_MEMORY_SIZE = 65536;
 // Flag to track if we're in test mode (bypasses normal MMU mapping)
 static bool s_testMode = false;
 
-CPUTestHarness::CPUTestHarness() {
+CPUTestHarness::CPUTestHarness(CpuType cpu)
+    : m_cpu(cpu)
+{
     setup();
 }
 
@@ -42,7 +45,11 @@ void CPUTestHarness::setup() {
     mc6883_reset();
 
     // Initialize CPU (does not reset - that would read from ROM vector)
-    MC6809Init();
+    if (m_cpu == CpuType::HD6309) {
+        HD6309Init();
+    } else {
+        MC6809Init();
+    }
 }
 
 void CPUTestHarness::teardown() {
@@ -53,7 +60,11 @@ void CPUTestHarness::teardown() {
 void CPUTestHarness::reset() {
     // Clear memory except for test program
     // Reset CPU to use reset vector
-    MC6809Reset();
+    if (m_cpu == CpuType::HD6309) {
+        HD6309Reset();
+    } else {
+        MC6809Reset();
+    }
 }
 
 void CPUTestHarness::loadProgram(uint16_t address, const std::vector<uint8_t>& program) {
@@ -63,24 +74,29 @@ void CPUTestHarness::loadProgram(uint16_t address, const std::vector<uint8_t>& p
 }
 
 void CPUTestHarness::setPC(uint16_t address) {
-    // Use MC6809ForcePC to directly set the program counter
+    // Force the program counter directly
     // This avoids the complexity of the reset vector in ROM space
-    MC6809ForcePC(address);
+    if (m_cpu == CpuType::HD6309) {
+        HD6309ForcePC(address);
+    } else {
+        MC6809ForcePC(address);
+    }
 }
 
 int CPUTestHarness::execute(int cycles) {
-    return MC6809Exec(cycles);
+    return m_cpu == CpuType::HD6309 ? HD6309Exec(cycles) : MC6809Exec(cycles);
 }
 
 int CPUTestHarness::step() {
     // Execute one instruction
-    // Use minimal cycles - MC6809Exec will execute at least one full instruction
-    // if cycles > 0, even if it uses more cycles than requested
-    return MC6809Exec(2);
+    // A one cycle budget runs exactly one instruction, however long it takes
+    // (native 6309 mode has one cycle instructions). Exec returns the budget
+    // left over, which is negative by the cycles used beyond it.
+    return 1 - execute(1);
 }
 
 VCC::CPUState CPUTestHarness::getState() const {
-    return MC6809GetState();
+    return m_cpu == CpuType::HD6309 ? HD6309GetState() : MC6809GetState();
 }
 
 uint8_t CPUTestHarness::readByte(uint16_t address) const {
@@ -11,6 +11,7 @@ CPU Test Harness - Provides a controlled environment for CPU instruction testing
 #include <cstdint>
 #include <vector>
 #include "cutie/compat.h"  // For VCC::CPUState
+#include "cutie/emulator.h"  // For CpuType
 
 namespace cutie {
 namespace test {
@@ -27,7 +28,7 @@ namespace test {
  */
 class CPUTestHarness {
 public:
-    CPUTestHarness();
+    explicit CPUTestHarness(CpuType cpu = CpuType::MC6809);
     ~CPUTestHarness();
 
     /**
@@ -61,7 +62,7 @@ public:
 
     /**
      * @brief Execute a single instruction
-     * @return Cycles used by the instruction
+     * @return Cycles used by the instruction (including indexed mode extras)
      */
     int step();
 
@@ -103,6 +104,8 @@ public:
 private:
     void setup();
     void teardown();
+
+    CpuType m_cpu;
 };
 
 // Condition code bit positions
@@ -0,0 +1,179 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+Disassembler Tests - Decoding and the write driven disassembly cache
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "cutie/disassembler.h"
+#include "tcc1014mmu.h"
+#include <string>
+#include <vector>
+
+using cutie::DisassembledLine;
+using cutie::DisassemblyCache;
+
+namespace {
+
+void store(uint16_t address, const std::vector<uint8_t>& bytes) {
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        MemWrite8(bytes[i], static_cast<uint16_t>(address + i));
+    }
+}
+
+std::string text(const DisassembledLine& line) {
+    return line.operand.empty() ? line.mnemonic : line.mnemonic + " " + line.operand;
+}
+
+std::vector<std::string> listing(DisassemblyCache& cache, uint16_t address, size_t count) {
+    std::vector<std::string> lines;
+    for (const auto& line : cache.lines(address, count)) {
+        lines.push_back(text(line));
+    }
+    return lines;
+}
+
+} // namespace
+
+TEST_CASE("DisassemblyCache: Decodes 6809 instructions", "[disassembler]") {
+    REQUIRE(MmuInit(_512K) != nullptr);
+    store(0x1000, {
+        0x86, 0x12,              // LDA #$12
+        0xBE, 0x12, 0x34,        // LDX $1234
+        0x97, 0x20,              // STA <$20
+        0x31, 0x25,              // LEAY 5,Y
+        0xE6, 0x1E,              // LDB -2,X
+        0xEC, 0x8C, 0x10,        // LDD $10,PCR
+        0xAD, 0x9F, 0xA0, 0x0C,  // JSR [$A00C]
+        0xA6, 0xC9, 0xFF, 0x00,  // LDA -$100,U
+        0x34, 0x93,              // PSHS CC,A,X,PC
+        0x37, 0x46,              // PULU A,B,S
+        0x1F, 0x12,              // TFR X,Y
+        0x10, 0x8E, 0x40, 0x00,  // LDY #$4000
+        0x26, 0xE0,              // BNE $1000
+        0x16, 0x01, 0x00,        // LBRA
+        0x01,                    // Not an instruction on the 6809
+        0x11, 0x3F,              // SWI3
+    });
+
+    DisassemblyCache cache;
+    const std::vector<std::string> expected = {
+        "LDA #$12", "LDX $1234", "STA <$20", "LEAY $05,Y", "LDB -$02,X", "LDD $101E,PCR",
+        "JSR [$A00C]", "LDA -$0100,U", "PSHS CC,A,X,PC", "PULU A,B,S", "TFR X,Y", "LDY #$4000",
+        "BNE $1002", "LBRA $1125", "FCB $01", "SWI3",
+    };
+    REQUIRE(listing(cache, 0x1000, expected.size()) == expected);
+
+    const auto lines = cache.lines(0x1000, expected.size());
+    REQUIRE(lines[6].length == 4);
+    REQUIRE(lines[6].bytes[3] == 0x0C);
+    REQUIRE(lines[14].address == 0x1025);
+    REQUIRE(lines[14].length == 1);
+}
+
+TEST_CASE("DisassemblyCache: Decodes HD6309 instructions", "[disassembler]") {
+    REQUIRE(MmuInit(_512K) != nullptr);
+    store(0x1000, {
+        0xCD, 0x12, 0x34, 0x56, 0x78,  // LDQ #$12345678
+        0x01, 0x40, 0x20,              // OIM #$40,<$20
+        0x6B, 0x01, 0x84,              // TIM #$01,,X
+        0x11, 0x38, 0x12,              // TFM X+,Y+
+        0x11, 0x3B, 0x21,              // TFM Y,X+
+        0x11, 0x30, 0x4A, 0x40,        // BAND A,1,2,<$40
+        0x10, 0x31, 0x89,              // ADCR A,B
+        0xA6, 0xCF,                    // LDA ,W++
+        0xA6, 0xAF, 0x01, 0x00,        // LDA $100,W
+        0xE6, 0xB0, 0x00, 0x10,        // LDB [$10,W]
+        0xA6, 0x87,                    // LDA E,X
+    });
+
+    DisassemblyCache cache(true);
+    const std::vector<std::string> expected = {
+        "LDQ #$12345678", "OIM #$40,<$20", "TIM #$01,,X", "TFM X+,Y+", "TFM Y,X+", "BAND A,1,2,<$40",
+        "ADCR A,B", "LDA ,W++", "LDA $0100,W", "LDB [$0010,W]", "LDA E,X",
+    };
+    REQUIRE(listing(cache, 0x1000, expected.size()) == expected);
+
+    // The same bytes on a 6809
+    cache.setHD6309(false);
+    REQUIRE(cache.size() == 0);
+    REQUIRE(text(cache.at(0x1000)) == "FCB $CD");
+}
+
+TEST_CASE("DisassemblyCache: Only changed instructions are decoded again", "[disassembler]") {
+    REQUIRE(MmuInit(_512K) != nullptr);
+    std::vector<uint8_t> code;
+    for (int i = 0; i < 100; ++i) {
+        code.insert(code.end(), {0x86, static_cast<uint8_t>(i), 0x12});  // LDA #i, NOP
+    }
+    store(0x2000, code);
+
+    DisassemblyCache cache;
+    const auto first = listing(cache, 0x2000, 200);
+    REQUIRE(cache.decodes() == 200);
+    REQUIRE(cache.size() == 200);
+    REQUIRE(listing(cache, 0x2000, 200) == first);
+    REQUIRE(cache.decodes() == 200);
+
+    // Rewriting the same bytes only costs a compare
+    store(0x2000, code);
+    REQUIRE(listing(cache, 0x2000, 200) == first);
+    REQUIRE(cache.decodes() == 200);
+
+    // One changed operand is one decode
+    MemWrite8(0x77, 0x2000 + 3 * 50 + 1);
+    auto changed = listing(cache, 0x2000, 200);
+    REQUIRE(cache.decodes() == 201);
+    REQUIRE(changed[100] == "LDA #$77");
+    changed[100] = first[100];
+    REQUIRE(changed == first);
+
+    // A new opcode changes the boundaries after it, and the walk follows
+    MemWrite8(0xCC, 0x2000 + 3 * 10);  // LDD #$0A12 swallows the NOP
+    const auto lines = cache.lines(0x2000, 21);
+    REQUIRE(text(lines[20]) == "LDD #$0A12");
+    REQUIRE(text(cache.lines(lines[20].address, 2)[1]) == "LDA #$0B");
+
+    // Physical writes are seen too
+    const unsigned long location = MemLocate(0x2000);
+    REQUIRE(location < Get_mem_size());
+    const uint8_t swi = 0x3F;
+    MemWritePhysical(&swi, location, 1);
+    REQUIRE(text(cache.at(0x2000)) == "SWI");
+}
+
+TEST_CASE("DisassemblyCache: Remapped memory finds its own instructions", "[disassembler]") {
+    REQUIRE(MmuInit(_512K) != nullptr);
+    store(0x0100, {0x39});  // RTS in the bank mapped at $0000
+
+    DisassemblyCache cache;
+    REQUIRE(text(cache.at(0x0100)) == "RTS");
+
+    // Put another bank at $0000-$1FFF
+    SetMmuRegister(0, 3);
+    Set_MmuEnabled(1);
+    store(0x0100, {0x12});  // NOP
+    REQUIRE(text(cache.at(0x0100)) == "NOP");
+    REQUIRE(cache.decodes() == 2);
+
+    // Back again, the first bank's line is still valid
+    Set_MmuEnabled(0);
+    REQUIRE(text(cache.at(0x0100)) == "RTS");
+    REQUIRE(cache.decodes() == 2);
+
+    // Scrolling back lands on instruction boundaries
+    store(0x01F0, std::vector<uint8_t>(16, 0x12));
+    store(0x0200, {0x86, 0x01, 0x10, 0x8E, 0x12, 0x34, 0xBD, 0x80, 0x00, 0x12});
+    REQUIRE(cache.previous(0x0209) == 0x0206);
+    REQUIRE(cache.previous(0x0206) == 0x0202);
+    REQUIRE(cache.previous(0x0202) == 0x0200);
+
+    // ROM is cached too, and I/O is not
+    REQUIRE(MemLocate(0x8000) == (MemRomSpace | 0));
+    REQUIRE(MemLocate(0xFF00) == MemIoSpace);
+    const size_t cached = cache.size();
+    cache.at(0x8000);
+    cache.at(0xFF00);
+    REQUIRE(cache.size() == cached + 1);
+}
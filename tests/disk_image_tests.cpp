@@ -0,0 +1,152 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+Disk Image Tests - Sector transfers through caller owned spans
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "vcc/media/disk_images/generic_disk_image.h"
+#include <array>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using vcc::media::disk_error_id;
+using vcc::media::const_sector_span;
+using vcc::media::sector_span;
+using vcc::media::disk_images::generic_disk_image;
+
+namespace {
+
+constexpr size_t SectorSize = 256;
+constexpr size_t SectorCount = 18;
+constexpr size_t TrackCount = 35;
+constexpr size_t ImageSize = 2 * TrackCount * SectorCount * SectorSize;
+
+generic_disk_image::geometry_type geometry()
+{
+    generic_disk_image::geometry_type geometry;
+    geometry.head_count = 2;
+    geometry.track_count = TrackCount;
+    geometry.sector_count = SectorCount;
+    geometry.sector_size = SectorSize;
+    return geometry;
+}
+
+// An image over a string stream, which stays reachable through stream
+struct MemoryImage {
+    explicit MemoryImage(std::string contents, bool writeProtected = false,
+        std::ios::openmode mode = std::ios::in | std::ios::out | std::ios::binary)
+    {
+        auto owned = std::make_unique<std::stringstream>(std::move(contents), mode);
+        stream = owned.get();
+        image = std::make_unique<generic_disk_image>(std::move(owned), geometry(), 0, 1, writeProtected);
+    }
+
+    std::stringstream* stream = nullptr;
+    std::unique_ptr<generic_disk_image> image;
+};
+
+std::array<unsigned char, SectorSize> pattern(unsigned char seed)
+{
+    std::array<unsigned char, SectorSize> bytes{};
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<unsigned char>(seed + i * 7);
+    }
+    return bytes;
+}
+
+} // namespace
+
+TEST_CASE("DiskImage: Sectors round trip through caller owned buffers", "[diskimage]") {
+    MemoryImage disk(std::string(ImageSize, '\0'));
+    const auto written = pattern(0x31);
+
+    // Head 1, track 2, sector 5: tracks interleave the heads
+    REQUIRE(disk.image->write_sector(1, 2, 1, 2, 5, const_sector_span(written)) == disk_error_id::success);
+    const std::string contents = disk.stream->str();
+    const size_t offset = ((2 * 2 + 1) * SectorCount + 4) * SectorSize;
+    REQUIRE(contents.compare(offset, SectorSize, reinterpret_cast<const char*>(written.data()), SectorSize) == 0);
+    REQUIRE(contents.find_first_not_of('\0') == offset);
+    REQUIRE(contents.find_last_not_of('\0') < offset + SectorSize);
+
+    // A buffer larger than the sector is fine; only the sector is filled
+    std::vector<unsigned char> buffer(SectorSize + 64, 0xEE);
+    size_t bytesRead = 0;
+    REQUIRE(disk.image->read_sector(1, 2, 1, 2, 5, sector_span(buffer), bytesRead) == disk_error_id::success);
+    REQUIRE(bytesRead == SectorSize);
+    REQUIRE(std::equal(written.begin(), written.end(), buffer.begin()));
+    REQUIRE(buffer[SectorSize] == 0xEE);
+
+    REQUIRE(disk.image->read_sector(0, 0, 0, 0, 1, sector_span(buffer), bytesRead) == disk_error_id::success);
+    REQUIRE(buffer[0] == 0);
+}
+
+TEST_CASE("DiskImage: Sector transfers report errors as codes", "[diskimage]") {
+    MemoryImage disk(std::string(ImageSize, '\0'));
+    std::array<unsigned char, SectorSize> buffer{};
+    const auto data = pattern(0x52);
+    size_t bytesRead = 99;
+
+    REQUIRE(disk.image->read_sector(2, 0, 2, 0, 1, sector_span(buffer), bytesRead) == disk_error_id::invalid_head);
+    REQUIRE(disk.image->read_sector(0, 35, 0, 35, 1, sector_span(buffer), bytesRead) == disk_error_id::invalid_track);
+    REQUIRE(disk.image->read_sector(0, 0, 0, 0, 0, sector_span(buffer), bytesRead) == disk_error_id::invalid_sector);
+    REQUIRE(disk.image->read_sector(0, 0, 0, 0, 19, sector_span(buffer), bytesRead) == disk_error_id::invalid_sector);
+    REQUIRE(disk.image->read_sector(0, 0, 1, 0, 1, sector_span(buffer), bytesRead) == disk_error_id::invalid_sector);
+    REQUIRE(disk.image->write_sector(0, 35, 0, 35, 1, const_sector_span(data)) == disk_error_id::invalid_track);
+
+    // A short buffer is refused before anything is read or written
+    std::array<unsigned char, SectorSize - 1> shortBuffer{};
+    REQUIRE(disk.image->read_sector(0, 0, 0, 0, 1, sector_span(shortBuffer), bytesRead) == disk_error_id::buffer_too_small);
+    REQUIRE(disk.image->write_sector(0, 0, 0, 0, 1, const_sector_span(data.data(), SectorSize - 1))
+        == disk_error_id::buffer_too_small);
+    REQUIRE(disk.image->read_sector(0, 0, 0, 0, 1, sector_span(), bytesRead) == disk_error_id::buffer_too_small);
+    REQUIRE(bytesRead == 99);
+    REQUIRE(disk.stream->str() == std::string(ImageSize, '\0'));
+}
+
+TEST_CASE("DiskImage: Write protection is checked before the seek", "[diskimage]") {
+    MemoryImage disk(std::string(ImageSize, 'x'), true);
+    REQUIRE(disk.image->is_write_protected());
+    disk.stream->seekp(100);
+    disk.stream->seekg(200);
+
+    const auto data = pattern(0x11);
+    REQUIRE(disk.image->write_sector(0, 3, 0, 3, 7, const_sector_span(data)) == disk_error_id::write_protected);
+    REQUIRE(disk.stream->tellp() == std::streampos(100));
+    REQUIRE(disk.stream->tellg() == std::streampos(200));
+    REQUIRE(disk.stream->str() == std::string(ImageSize, 'x'));
+
+    // Reading is still allowed
+    std::array<unsigned char, SectorSize> buffer{};
+    size_t bytesRead = 0;
+    REQUIRE(disk.image->read_sector(0, 3, 0, 3, 7, sector_span(buffer), bytesRead) == disk_error_id::success);
+    REQUIRE(buffer[0] == 'x');
+}
+
+TEST_CASE("DiskImage: Stream failures come back as io_error", "[diskimage]") {
+    std::array<unsigned char, SectorSize> buffer{};
+    const auto data = pattern(0x77);
+    size_t bytesRead = 0;
+
+    SECTION("An image cut short part way through a sector") {
+        MemoryImage disk(std::string(ImageSize - SectorSize / 2, '\0'));
+        REQUIRE(disk.image->read_sector(1, 34, 1, 34, 18, sector_span(buffer), bytesRead) == disk_error_id::io_error);
+        REQUIRE(disk.image->read_sector(1, 34, 1, 34, 17, sector_span(buffer), bytesRead) == disk_error_id::success);
+    }
+
+    SECTION("An image missing whole tracks") {
+        MemoryImage disk(std::string(SectorCount * SectorSize, '\0'));
+        REQUIRE(disk.image->read_sector(0, 20, 0, 20, 1, sector_span(buffer), bytesRead) == disk_error_id::io_error);
+    }
+
+    SECTION("A stream that cannot be written") {
+        MemoryImage disk(std::string(ImageSize, '\0'), false, std::ios::in | std::ios::binary);
+        REQUIRE(disk.image->write_sector(0, 0, 0, 0, 1, const_sector_span(data)) == disk_error_id::io_error);
+
+        // The stream is usable again for the next transfer
+        REQUIRE(disk.image->read_sector(0, 0, 0, 0, 1, sector_span(buffer), bytesRead) == disk_error_id::success);
+    }
+}
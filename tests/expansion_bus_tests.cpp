@@ -0,0 +1,151 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+Expansion Bus Tests - Default span transfers on the expansion port bus
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "vcc/bus/expansion_port_bus.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// A 64K address space where pages 0-5 are RAM, page 6 is ROM and page 7 is
+// only reachable a byte at a time
+class TestBus : public vcc::bus::expansion_port_bus
+{
+public:
+    TestBus()
+    {
+        for (size_t i = 0; i < memory.size(); ++i) {
+            memory[i] = static_cast<uint8_t>(i ^ (i >> 8));
+        }
+    }
+
+    void reset() override {}
+    void set_cartridge_select_line(bool) override {}
+    void assert_irq_interrupt_line() override {}
+    void assert_nmi_interrupt_line() override {}
+    void assert_cartridge_interrupt_line() override {}
+
+    void write_memory_byte(unsigned char value, unsigned short address) override
+    {
+        ++byteWrites;
+        if (address < 0xC000 || address >= 0xE000) {
+            memory[address] = value;
+        }
+    }
+
+    unsigned char read_memory_byte(unsigned short address) override
+    {
+        ++byteReads;
+        return memory[address];
+    }
+
+    void read_physical_memory(physical_address_type, unsigned char*, size_type) override {}
+    void write_physical_memory(physical_address_type, const unsigned char*, size_type) override {}
+
+    unsigned char* map_memory_page(unsigned short address, bool for_write) override
+    {
+        ++pageLookups;
+        if (address >= 0xE000 || (for_write && address >= 0xC000)) {
+            return nullptr;
+        }
+        return memory.data() + address;
+    }
+
+    std::array<uint8_t, 0x10000> memory;
+    int byteReads = 0;
+    int byteWrites = 0;
+    int pageLookups = 0;
+};
+
+// The same address space without direct access to any page
+class ByteBus : public TestBus
+{
+public:
+    unsigned char* map_memory_page(unsigned short address, bool for_write) override
+    {
+        return vcc::bus::expansion_port_bus::map_memory_page(address, for_write);
+    }
+};
+
+std::vector<uint8_t> pattern(size_t size)
+{
+    std::vector<uint8_t> bytes(size);
+    for (size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<uint8_t>(i * 13 + 5);
+    }
+    return bytes;
+}
+
+} // namespace
+
+TEST_CASE("ExpansionBus: Spans within mapped pages are copied a page at a time", "[expansionbus]") {
+    TestBus bus;
+    const auto data = pattern(0x3000);
+
+    // 0x1800-0x47FF crosses two page boundaries: three runs, no byte calls
+    bus.write_memory(0x1800, data.data(), data.size());
+    REQUIRE(bus.byteWrites == 0);
+    REQUIRE(bus.pageLookups == 3);
+    REQUIRE(std::equal(data.begin(), data.end(), bus.memory.begin() + 0x1800));
+
+    std::vector<uint8_t> read(data.size());
+    bus.read_memory(0x1800, read.data(), read.size());
+    REQUIRE(bus.byteReads == 0);
+    REQUIRE((read == data));
+}
+
+TEST_CASE("ExpansionBus: Unmapped pages fall back to byte access", "[expansionbus]") {
+    TestBus bus;
+    const TestBus original;
+    const auto data = pattern(0x40);
+
+    // The last 0x20 bytes of ROM and the first 0x20 of the byte only page
+    bus.write_memory(0xDFE0, data.data(), data.size());
+    REQUIRE(bus.byteWrites == 0x40);
+    REQUIRE(std::equal(original.memory.begin() + 0xDFE0, original.memory.begin() + 0xE000,
+        bus.memory.begin() + 0xDFE0));
+    REQUIRE(std::equal(data.begin() + 0x20, data.end(), bus.memory.begin() + 0xE000));
+
+    // ROM is read directly; only the last page goes a byte at a time
+    std::vector<uint8_t> read(data.size());
+    bus.read_memory(0xDFE0, read.data(), read.size());
+    REQUIRE(bus.byteReads == 0x20);
+    REQUIRE(std::equal(read.begin(), read.end(), bus.memory.begin() + 0xDFE0));
+}
+
+TEST_CASE("ExpansionBus: Spans wrap at the end of the address space", "[expansionbus]") {
+    TestBus bus;
+    const auto data = pattern(0x20);
+
+    bus.write_memory(0xFFF0, data.data(), data.size());
+    REQUIRE(bus.byteWrites == 0x10);
+    REQUIRE(std::equal(data.begin(), data.begin() + 0x10, bus.memory.begin() + 0xFFF0));
+    REQUIRE(std::equal(data.begin() + 0x10, data.end(), bus.memory.begin()));
+
+    std::vector<uint8_t> read(data.size());
+    bus.read_memory(0xFFF0, read.data(), read.size());
+    REQUIRE((read == data));
+}
+
+TEST_CASE("ExpansionBus: Buses without mapped pages see every byte", "[expansionbus]") {
+    ByteBus bus;
+    const auto data = pattern(0x2100);
+
+    bus.write_memory(0x1F80, data.data(), data.size());
+    REQUIRE(bus.byteWrites == 0x2100);
+    REQUIRE(std::equal(data.begin(), data.end(), bus.memory.begin() + 0x1F80));
+
+    std::vector<uint8_t> read(data.size());
+    bus.read_memory(0x1F80, read.data(), read.size());
+    REQUIRE(bus.byteReads == 0x2100);
+    REQUIRE((read == data));
+
+    bus.read_memory(0x1234, read.data(), 0);
+    REQUIRE(bus.byteReads == 0x2100);
+}
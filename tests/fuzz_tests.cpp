@@ -0,0 +1,207 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+Fuzz Tests - Coverage, stop addresses and page restore in the fuzzing harness
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "cutie/context.h"
+#include "cutie/emulator.h"
+#include "cutie/fuzz.h"
+#include "test_paths.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using cutie::FuzzHarness;
+
+namespace {
+
+constexpr uint16_t Entry = 0x3000;
+constexpr uint16_t Exit = 0x3028;
+constexpr uint16_t Crash = 0x3029;
+constexpr uint16_t Spin = 0x3030;
+constexpr uint16_t Length = 0x3FFE;
+constexpr uint16_t Input = 0x4000;
+constexpr uint16_t Counter = 0x6000;
+
+// Crashes on inputs starting with FUZZ, counting the inputs it looks at
+const std::vector<uint8_t> Parser = {
+    0x8E, 0x40, 0x00,        // 3000 LDX #Input
+    0xFC, 0x3F, 0xFE,        // 3003 LDD Length
+    0x10, 0x83, 0x00, 0x04,  // 3006 CMPD #4
+    0x25, 0x1C,              // 300A BLO Exit
+    0x7C, 0x60, 0x00,        // 300C INC Counter
+    0xA6, 0x80,              // 300F LDA ,X+
+    0x81, 'F',               // 3011 CMPA #'F
+    0x26, 0x13,              // 3013 BNE Exit
+    0xA6, 0x80,              // 3015 LDA ,X+
+    0x81, 'U',               // 3017 CMPA #'U
+    0x26, 0x0D,              // 3019 BNE Exit
+    0xA6, 0x80,              // 301B LDA ,X+
+    0x81, 'Z',               // 301D CMPA #'Z
+    0x26, 0x07,              // 301F BNE Exit
+    0xA6, 0x80,              // 3021 LDA ,X+
+    0x81, 'Z',               // 3023 CMPA #'Z
+    0x27, 0x02,              // 3025 BEQ Crash
+    0x12,                    // 3027 NOP
+    0x12,                    // 3028 Exit
+    0x12,                    // 3029 Crash
+    0x12, 0x12, 0x12, 0x12, 0x12, 0x12,
+    0x20, 0xFE,              // 3030 Spin BRA *
+};
+
+std::unique_ptr<cutie::CocoEmulator> bootEmulator()
+{
+    const auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        return nullptr;
+    }
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+    for (int frame = 0; frame < 30; ++frame) {
+        emulator->runFrame();
+    }
+    emulator->writeMemory(Entry, Parser.data(), Parser.size());
+    return emulator;
+}
+
+FuzzHarness::Target parserTarget()
+{
+    FuzzHarness::Target target;
+    target.entry = Entry;
+    target.inputAddress = Input;
+    target.inputCapacity = 256;
+    target.lengthAddress = Length;
+    target.exits = {Exit};
+    target.crashes = {Crash};
+    return target;
+}
+
+FuzzHarness::Result run(FuzzHarness& harness, const std::string& input)
+{
+    return harness.run(reinterpret_cast<const uint8_t*>(input.data()), input.size());
+}
+
+} // namespace
+
+TEST_CASE("Fuzz: Runs end at exits and crashes, or hang on the budget", "[fuzz]") {
+    auto emulator = bootEmulator();
+    if (!emulator) {
+        SKIP("System ROM not found - skipping fuzz test");
+    }
+
+    FuzzHarness harness(*emulator);
+    FuzzHarness::Target target = parserTarget();
+    target.exits.clear();
+    REQUIRE_FALSE(harness.begin(target));
+    REQUIRE(harness.getLastError() == "Target has no exit address");
+
+    REQUIRE(harness.begin(parserTarget()));
+    FuzzHarness second(*emulator);
+    REQUIRE_FALSE(second.begin(parserTarget()));
+
+    auto result = run(harness, "");
+    REQUIRE(result.outcome == FuzzHarness::Outcome::Exit);
+    REQUIRE(result.pc == Exit);
+    REQUIRE(result.cycles > 0);
+
+    result = run(harness, "FUZX");
+    REQUIRE(result.outcome == FuzzHarness::Outcome::Exit);
+
+    result = run(harness, "FUZZ and more");
+    REQUIRE(result.outcome == FuzzHarness::Outcome::Crash);
+    REQUIRE(result.pc == Crash);
+
+    // Inputs past the capacity are cut, and the length says so
+    target = parserTarget();
+    target.inputCapacity = 3;
+    REQUIRE(harness.begin(target));
+    REQUIRE(run(harness, "FUZZ").outcome == FuzzHarness::Outcome::Exit);
+
+    target = parserTarget();
+    target.entry = Spin;
+    target.maxCycles = 5000;
+    REQUIRE(harness.begin(target));
+    result = run(harness, "FUZZ");
+    REQUIRE(result.outcome == FuzzHarness::Outcome::Hang);
+    REQUIRE(result.pc == Spin);
+    REQUIRE(result.cycles >= 5000);
+    REQUIRE(result.cycles < 5010);
+
+    harness.end();
+    REQUIRE(second.begin(parserTarget()));
+}
+
+TEST_CASE("Fuzz: Coverage grows as more of the input matches", "[fuzz]") {
+    auto emulator = bootEmulator();
+    if (!emulator) {
+        SKIP("System ROM not found - skipping fuzz test");
+    }
+
+    FuzzHarness harness(*emulator);
+    REQUIRE(harness.begin(parserTarget()));
+
+    size_t previous = 0;
+    for (const char* input : {"", "AAAA", "FAAA", "FUAA", "FUZA"}) {
+        INFO(input);
+        run(harness, input);
+        REQUIRE(harness.edgeCount() > previous);
+        previous = harness.edgeCount();
+    }
+
+    // The same input always leaves the same map
+    run(harness, "FUAA");
+    const std::vector<uint8_t> first(harness.coverage(), harness.coverage() + FuzzHarness::MapSize);
+    run(harness, "FUZA");
+    run(harness, "FUAA");
+    const std::vector<uint8_t> again(harness.coverage(), harness.coverage() + FuzzHarness::MapSize);
+    REQUIRE((first == again));
+
+    // A caller's map gets the same counts
+    std::vector<uint8_t> map(FuzzHarness::MapSize, 0xAA);
+    harness.setCoverageMap(map.data());
+    run(harness, "FUAA");
+    REQUIRE((map == first));
+    harness.setCoverageMap(nullptr);
+    REQUIRE(harness.coverage() != map.data());
+}
+
+TEST_CASE("Fuzz: Every run starts from the snapshot", "[fuzz]") {
+    auto emulator = bootEmulator();
+    if (!emulator) {
+        SKIP("System ROM not found - skipping fuzz test");
+    }
+
+    uint8_t counter = 0;
+    emulator->readMemory(Counter, &counter, 1);
+    std::vector<uint8_t> original(8);
+    emulator->readMemory(Input, original.data(), original.size());
+
+    FuzzHarness harness(*emulator);
+    REQUIRE(harness.begin(parserTarget()));
+    for (int i = 0; i < 3; ++i) {
+        run(harness, "ABCDEFGH");
+        uint8_t value = 0;
+        emulator->readMemory(Counter, &value, 1);
+        REQUIRE(value == static_cast<uint8_t>(counter + 1));
+    }
+
+    // Only the pages holding the length, the input and the counter are put
+    // back, and a shorter input does not see the tail of the last one
+    const auto before = harness.stats().pagesRestored;
+    run(harness, "ABCD");
+    REQUIRE(harness.stats().pagesRestored - before >= 1);
+    REQUIRE(harness.stats().pagesRestored - before <= 3);
+    REQUIRE(harness.stats().runs == 4);
+
+    std::vector<uint8_t> input(8);
+    emulator->readMemory(Input, input.data(), input.size());
+    REQUIRE(std::string(input.begin(), input.begin() + 4) == "ABCD");
+    REQUIRE((std::vector<uint8_t>(input.begin() + 4, input.end()) == std::vector<uint8_t>(original.begin() + 4, original.end())));
+}
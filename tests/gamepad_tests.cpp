@@ -0,0 +1,111 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+Input Tests - Gamepad event mapping and the native input thread
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "cutie/gamepad.h"
+#include <chrono>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/input.h>
+#include <unistd.h>
+#endif
+
+using namespace cutie;
+
+// ============================================================================
+// Axis Calibration
+// ============================================================================
+
+TEST_CASE("Gamepad: Axis values span the CoCo range", "[input][gamepad]") {
+    AxisCalibration calibration{0, 255, 0};
+
+    REQUIRE(mapAxisValue(0, calibration) == AXIS_MIN);
+    REQUIRE(mapAxisValue(127, calibration) == AXIS_CENTER);
+    REQUIRE(mapAxisValue(255, calibration) == AXIS_MAX);
+    REQUIRE(mapAxisValue(-50, calibration) == AXIS_MIN);   // Clamped
+    REQUIRE(mapAxisValue(300, calibration) == AXIS_MAX);   // Clamped
+}
+
+TEST_CASE("Gamepad: Dead zone reads as centered", "[input][gamepad]") {
+    AxisCalibration calibration{-32768, 32767, 4000};
+
+    REQUIRE(mapAxisValue(0, calibration) == AXIS_CENTER);
+    REQUIRE(mapAxisValue(3500, calibration) == AXIS_CENTER);
+    REQUIRE(mapAxisValue(-3500, calibration) == AXIS_CENTER);
+    REQUIRE(mapAxisValue(20000, calibration) > AXIS_CENTER);
+    REQUIRE(mapAxisValue(-20000, calibration) < AXIS_CENTER);
+    REQUIRE(mapAxisValue(-32768, calibration) == AXIS_MIN);
+    REQUIRE(mapAxisValue(32767, calibration) == AXIS_MAX);
+}
+
+// ============================================================================
+// Event Mapping
+// ============================================================================
+
+TEST_CASE("Gamepad: Events drive the joystick comparator and buttons", "[input][gamepad]") {
+    Joystick joystick;
+    GamepadMapper mapper(JOYSTICK_RIGHT, {0, 255, 0}, {0, 255, 0});
+
+    mapper.apply({GAMEPAD_EV_ABS, GAMEPAD_ABS_X, 255}, joystick);
+    mapper.apply({GAMEPAD_EV_ABS, GAMEPAD_ABS_Y, 0}, joystick);
+    mapper.apply({GAMEPAD_EV_KEY, GAMEPAD_BTN_SOUTH, 1}, joystick);
+
+    REQUIRE(joystick.getAxis(JOYSTICK_RIGHT, AXIS_X) == AXIS_MAX);
+    REQUIRE(joystick.getAxis(JOYSTICK_RIGHT, AXIS_Y) == AXIS_MIN);
+    REQUIRE(joystick.getButtonBits() == 0x0E);  // Right button 1, active low
+
+    // MUX 0 selects right X: a mid-scale ramp is below the stick
+    joystick.startRamp(32 << 2);
+    REQUIRE_FALSE(joystick.getComparisonResult(0));
+    REQUIRE(joystick.getComparisonResult(1));
+
+    mapper.apply({GAMEPAD_EV_ABS, GAMEPAD_ABS_HAT0X, -1}, joystick);
+    mapper.apply({GAMEPAD_EV_KEY, GAMEPAD_BTN_SOUTH, 0}, joystick);
+    REQUIRE(joystick.getAxis(JOYSTICK_RIGHT, AXIS_X) == AXIS_MIN);
+    REQUIRE(joystick.getButtonBits() == 0x0F);
+}
+
+// ============================================================================
+// Input Thread
+// ============================================================================
+
+#ifdef __linux__
+TEST_CASE("Gamepad: Recorded event stream is replayed on the input thread", "[input][gamepad]") {
+    Joystick joystick;
+    GamepadInput input(joystick);
+
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    REQUIRE(input.addDevice(fds[0], GamepadMapper(JOYSTICK_LEFT, {0, 255, 0}, {0, 255, 0})));
+    REQUIRE(input.start());
+
+    const input_event stream[] = {
+        {{0, 0}, EV_ABS, ABS_X, 0},
+        {{0, 0}, EV_ABS, ABS_Y, 255},
+        {{0, 0}, EV_KEY, BTN_EAST, 1},
+        {{0, 0}, EV_SYN, SYN_REPORT, 0},
+    };
+    // Split a record across writes the way a slow pipe might deliver it
+    const auto* bytes = reinterpret_cast<const char*>(stream);
+    REQUIRE(write(fds[1], bytes, 10) == 10);
+    REQUIRE(write(fds[1], bytes + 10, sizeof(stream) - 10) == static_cast<ssize_t>(sizeof(stream) - 10));
+    close(fds[1]);
+
+    // The device drops out once the stream ends
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (input.deviceCount() != 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    input.stop();
+
+    REQUIRE(input.eventCount() == 4);
+    REQUIRE(joystick.getAxis(JOYSTICK_LEFT, AXIS_X) == AXIS_MIN);
+    REQUIRE(joystick.getAxis(JOYSTICK_LEFT, AXIS_Y) == AXIS_MAX);
+    REQUIRE(joystick.getButton(JOYSTICK_LEFT, BUTTON_2));
+}
+#endif
@@ -0,0 +1,170 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+HD6309 CPU Instruction Tests
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "cpu_test_harness.h"
+#include <vector>
+
+using namespace cutie::test;
+
+namespace {
+
+struct IndexedResult {
+    uint8_t a;
+    int extraCycles;  // Beyond LDA ,X in the same mode
+    uint16_t x;
+    uint16_t w;
+};
+
+/**
+ * Runs LDA with the given postbyte and offset bytes, with X=$2000,
+ * W=$3004 (so E=$30, F=$04) and D=$0810, after placing the byte $C3 at
+ * target and, when pointer is non-zero, the indirect address of target
+ * at pointer.
+ */
+IndexedResult runIndexed(bool native, std::vector<uint8_t> operand, uint16_t target, uint16_t pointer = 0)
+{
+    CPUTestHarness cpu(cutie::CpuType::HD6309);
+
+    if (pointer != 0) {
+        cpu.writeWord(pointer, target);
+    }
+    cpu.writeByte(target, 0xC3);
+
+    std::vector<uint8_t> program = {
+        0x11, 0x3D, static_cast<uint8_t>(native ? 0x01 : 0x00),  // LDMD #native
+        0x8E, 0x20, 0x00,                                       // LDX #$2000
+        0xA6, 0x84,                                             // LDA ,X
+        0x10, 0x86, 0x30, 0x04,                                 // LDW #$3004
+        0xCC, 0x08, 0x10,                                       // LDD #$0810
+        0xA6,                                                   // LDA indexed
+    };
+    program.insert(program.end(), operand.begin(), operand.end());
+    cpu.loadProgram(0x1000, program);
+    cpu.setPC(0x1000);
+
+    cpu.step();  // LDMD
+    cpu.step();  // LDX
+    const int base = cpu.step();
+    cpu.step();  // LDW
+    cpu.step();  // LDD
+    const int cycles = cpu.step();
+
+    const auto state = cpu.getState();
+    REQUIRE(state.PC == 0x1000 + program.size());
+    REQUIRE(state.IsNative6309 == native);
+    return {state.A, cycles - base, state.X, static_cast<uint16_t>((state.E << 8) | state.F)};
+}
+
+} // namespace
+
+// ============================================================================
+// Indexed Addressing
+// ============================================================================
+
+TEST_CASE("HD6309: Indexed register offsets including E, F and W", "[hd6309][indexed]") {
+    for (bool native : {false, true}) {
+        INFO("native " << native);
+
+        auto r = runIndexed(native, {0x87}, 0x2030);         // E,X
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 1);
+
+        r = runIndexed(native, {0x8A}, 0x2004);              // F,X
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 1);
+
+        r = runIndexed(native, {0x8E}, 0x5004);              // W,X
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 4);
+
+        r = runIndexed(native, {0x97}, 0x4444, 0x2030);      // [E,X]
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 4);
+
+        r = runIndexed(native, {0x9A}, 0x4444, 0x2004);      // [F,X]
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 4);
+
+        r = runIndexed(native, {0x9E}, 0x4444, 0x5004);      // [W,X]
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 7);
+    }
+}
+
+TEST_CASE("HD6309: Indexed W register forms", "[hd6309][indexed]") {
+    for (bool native : {false, true}) {
+        INFO("native " << native);
+
+        auto r = runIndexed(native, {0x8F}, 0x3004);                 // ,W
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 0);
+        REQUIRE(r.w == 0x3004);
+
+        r = runIndexed(native, {0xAF, 0x00, 0x10}, 0x3014);          // $0010,W
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 2);
+
+        r = runIndexed(native, {0xCF}, 0x3004);                      // ,W++
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 1);
+        REQUIRE(r.w == 0x3006);
+
+        r = runIndexed(native, {0xEF}, 0x3002);                      // ,--W
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 1);
+        REQUIRE(r.w == 0x3002);
+
+        r = runIndexed(native, {0x90}, 0x4444, 0x3004);              // [,W]
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 3);
+
+        r = runIndexed(native, {0xB0, 0x00, 0x10}, 0x4444, 0x3014);  // [$0010,W]
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 5);
+
+        r = runIndexed(native, {0xD0}, 0x4444, 0x3004);              // [,W++]
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 4);
+        REQUIRE(r.w == 0x3006);
+
+        r = runIndexed(native, {0xF0}, 0x4444, 0x3002);              // [,--W]
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == 4);
+        REQUIRE(r.w == 0x3002);
+    }
+}
+
+TEST_CASE("HD6309: Indexed modes that are faster in native mode", "[hd6309][indexed]") {
+    // Emulation mode extra cycles first, then native mode
+    struct Case { std::vector<uint8_t> operand; uint16_t target; uint16_t x; int extra[2]; };
+    const Case cases[] = {
+        {{0x80}, 0x2000, 0x2001, {2, 1}},                // ,X+
+        {{0x81}, 0x2000, 0x2002, {3, 2}},                // ,X++
+        {{0x82}, 0x1FFF, 0x1FFF, {2, 1}},                // ,-X
+        {{0x83}, 0x1FFE, 0x1FFE, {3, 2}},                // ,--X
+        {{0x89, 0x01, 0x00}, 0x2100, 0x2000, {4, 3}},    // $0100,X
+        {{0x8B}, 0x2810, 0x2000, {4, 2}},                // D,X
+    };
+
+    for (bool native : {false, true}) {
+        for (const auto& c : cases) {
+            INFO("native " << native << " postbyte " << int(c.operand[0]));
+            const auto r = runIndexed(native, c.operand, c.target);
+            REQUIRE(r.a == 0xC3);
+            REQUIRE(r.x == c.x);
+            REQUIRE(r.extraCycles == c.extra[native ? 1 : 0]);
+        }
+    }
+
+    // $0100,PCR: the offset is relative to the end of the instruction at $1013
+    for (bool native : {false, true}) {
+        const auto r = runIndexed(native, {0x8D, 0x01, 0x00}, 0x1113);
+        REQUIRE(r.a == 0xC3);
+        REQUIRE(r.extraCycles == (native ? 3 : 5));
+    }
+}
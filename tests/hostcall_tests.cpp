@@ -0,0 +1,235 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+Host Call Tests - Guest code calling host services through $FF88-$FF8B
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "cpu_test_harness.h"
+#include "cutie/hostcall.h"
+#include "tcc1014mmu.h"
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+using cutie::HostCallDevice;
+using cutie::test::CPUTestHarness;
+
+namespace {
+
+constexpr uint16_t Block = 0x2000;
+constexpr uint16_t Name = 0x2020;
+
+// Runs commands through HCALL from shared/guest/hostcall.asm
+class Guest {
+public:
+    Guest() {
+        cutie::getHostCallDevice().setEnabled(true);
+        m_cpu.loadProgram(0x0E00, {
+            0xBF, 0xFF, 0x8A,  // HCALL STX HC.BLK
+            0xB7, 0xFF, 0x88,  //       STA HC.CMD
+            0xB6, 0xFF, 0x88,  //       LDA HC.CMD
+            0x39,              //       RTS
+        });
+        m_cpu.setS(0x7F00);
+    }
+
+    ~Guest() {
+        cutie::getHostCallDevice().setEnabled(false);
+        cutie::getHostCallDevice().setDirectory({});
+    }
+
+    // Returns the status HCALL left in A, checking that Z matches it
+    uint8_t call(uint8_t command) {
+        m_cpu.loadProgram(0x1000, {
+            0x8E, Block >> 8, Block & 0xFF,  // LDX #Block
+            0x86, command,                   // LDA #command
+            0xBD, 0x0E, 0x00,                // JSR HCALL
+            0x20, 0xFE,                      // BRA *
+        });
+        m_cpu.setPC(0x1000);
+        while (m_cpu.getState().PC != 0x1008) {
+            m_cpu.step();
+        }
+        const auto state = m_cpu.getState();
+        REQUIRE(((state.CC & cutie::test::CC_Z) != 0) == (state.A == HostCallDevice::Ok));
+        return state.A;
+    }
+
+    // Physical RAM behind a CPU address, with the MMU as the harness leaves it
+    static uint32_t physical(uint16_t address) {
+        return static_cast<uint32_t>(MemLocate(address));
+    }
+
+    void block(uint32_t address, uint32_t length, std::vector<uint8_t> rest = {}) {
+        put32(Block, address);
+        put32(Block + 4, length);
+        for (size_t i = 0; i < rest.size(); ++i) {
+            m_cpu.writeByte(static_cast<uint16_t>(Block + 8 + i), rest[i]);
+        }
+    }
+
+    void put32(uint16_t address, uint32_t value) {
+        m_cpu.writeWord(address, static_cast<uint16_t>(value >> 16));
+        m_cpu.writeWord(static_cast<uint16_t>(address + 2), static_cast<uint16_t>(value));
+    }
+
+    uint32_t get32(uint16_t address) const {
+        return uint32_t(m_cpu.readWord(address)) << 16 | m_cpu.readWord(static_cast<uint16_t>(address + 2));
+    }
+
+    void store(uint16_t address, const std::string& bytes) {
+        for (size_t i = 0; i < bytes.size(); ++i) {
+            m_cpu.writeByte(static_cast<uint16_t>(address + i), static_cast<uint8_t>(bytes[i]));
+        }
+    }
+
+    std::string load(uint16_t address, size_t length) const {
+        std::string bytes;
+        for (size_t i = 0; i < length; ++i) {
+            bytes += static_cast<char>(m_cpu.readByte(static_cast<uint16_t>(address + i)));
+        }
+        return bytes;
+    }
+
+    CPUTestHarness& cpu() { return m_cpu; }
+
+private:
+    CPUTestHarness m_cpu;
+};
+
+} // namespace
+
+TEST_CASE("HostCall: The ports belong to the cartridge until enabled", "[hostcall]") {
+    CPUTestHarness cpu;
+    REQUIRE(cpu.readByte(0xFF89) != HostCallDevice::Id);
+
+    cutie::getHostCallDevice().setEnabled(true);
+    REQUIRE(cpu.readByte(0xFF89) == HostCallDevice::Id);
+    cpu.writeWord(0xFF8A, 0x1234);
+    REQUIRE(cpu.readWord(0xFF8A) == 0x1234);
+    REQUIRE(SafeMemRead8(0xFF89) == HostCallDevice::Id);
+
+    cutie::getHostCallDevice().setEnabled(false);
+    REQUIRE(cpu.readByte(0xFF89) != HostCallDevice::Id);
+}
+
+TEST_CASE("HostCall: Copies and fills physical RAM", "[hostcall]") {
+    Guest guest;
+    std::string pattern;
+    for (int i = 0; i < 300; ++i) {
+        pattern += static_cast<char>(i * 7);
+    }
+    guest.store(0x3000, pattern);
+
+    guest.block(Guest::physical(0x4000), 300, {0, 0, 0, 0});
+    guest.put32(Block + 8, Guest::physical(0x3000));
+    REQUIRE(guest.call(HostCallDevice::Copy) == HostCallDevice::Ok);
+    REQUIRE(guest.load(0x4000, 300) == pattern);
+
+    // Overlapping ranges copy as if through a buffer
+    guest.block(Guest::physical(0x3010), 100);
+    guest.put32(Block + 8, Guest::physical(0x3000));
+    REQUIRE(guest.call(HostCallDevice::Copy) == HostCallDevice::Ok);
+    REQUIRE(guest.load(0x3010, 100) == pattern.substr(0, 100));
+
+    guest.block(Guest::physical(0x4000), 16, {0xA5});
+    REQUIRE(guest.call(HostCallDevice::Fill) == HostCallDevice::Ok);
+    REQUIRE(guest.load(0x4000, 17) == std::string(16, '\xA5') + pattern[16]);
+
+    // Anything past the end of RAM is refused, not wrapped
+    guest.block(Get_mem_size() - 8, 9, {0x00});
+    REQUIRE(guest.call(HostCallDevice::Fill) == HostCallDevice::BadAddress);
+    guest.block(0, 0xFFFFFFFF, {0x00});
+    REQUIRE(guest.call(HostCallDevice::Fill) == HostCallDevice::BadAddress);
+    REQUIRE(guest.call(0x7F) == HostCallDevice::BadCommand);
+}
+
+TEST_CASE("HostCall: CRCs match the standard check values", "[hostcall]") {
+    Guest guest;
+    guest.store(0x3000, "123456789");
+
+    guest.block(Guest::physical(0x3000), 9, {0xFF, 0xFF});
+    REQUIRE(guest.call(HostCallDevice::Crc16) == HostCallDevice::Ok);
+    REQUIRE(guest.cpu().readWord(Block + 8) == 0x29B1);
+
+    guest.block(Guest::physical(0x3000), 9, {0, 0, 0, 0});
+    REQUIRE(guest.call(HostCallDevice::Crc32) == HostCallDevice::Ok);
+    REQUIRE(guest.get32(Block + 8) == 0xCBF43926);
+
+    // A running CRC carries on from the value in the block
+    guest.block(Guest::physical(0x3000), 4, {0, 0, 0, 0});
+    REQUIRE(guest.call(HostCallDevice::Crc32) == HostCallDevice::Ok);
+    guest.put32(Block, Guest::physical(0x3004));
+    guest.put32(Block + 4, 5);
+    REQUIRE(guest.call(HostCallDevice::Crc32) == HostCallDevice::Ok);
+    REQUIRE(guest.get32(Block + 8) == 0xCBF43926);
+}
+
+TEST_CASE("HostCall: Reads and writes files in the host directory only", "[hostcall]") {
+    const fs::path directory = fs::temp_directory_path() / "cutie_hostcall";
+    fs::remove_all(directory);
+    fs::create_directories(directory);
+
+    Guest guest;
+    guest.store(Name, std::string("OUT.BIN") + '\0');
+    guest.store(0x3000, "The quick brown fox jumps over the lazy dog");
+    guest.cpu().writeWord(Block + 12, Name);
+
+    // Nothing without a directory
+    guest.block(Guest::physical(0x3000), 43, {0, 0, 0, 0});
+    REQUIRE(guest.call(HostCallDevice::WriteFile) == HostCallDevice::NoDirectory);
+    REQUIRE(guest.get32(Block + 4) == 0);
+
+    cutie::getHostCallDevice().setDirectory(directory);
+    guest.block(Guest::physical(0x3000), 43, {0, 0, 0, 0});
+    REQUIRE(guest.call(HostCallDevice::WriteFile) == HostCallDevice::Ok);
+    REQUIRE(guest.get32(Block + 4) == 43);
+
+    // Writing at an offset keeps the rest of the file
+    guest.block(Guest::physical(0x3004), 5, {0, 0, 0, 40});
+    REQUIRE(guest.call(HostCallDevice::WriteFile) == HostCallDevice::Ok);
+    std::ifstream file(directory / "OUT.BIN", std::ios::binary);
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    REQUIRE(contents == "The quick brown fox jumps over the lazy quick");
+
+    guest.block(0, 0);
+    REQUIRE(guest.call(HostCallDevice::FileSize) == HostCallDevice::Ok);
+    REQUIRE(guest.get32(Block + 4) == 45);
+
+    // A read past the end stops there
+    guest.block(Guest::physical(0x5000), 100, {0, 0, 0, 20});
+    REQUIRE(guest.call(HostCallDevice::ReadFile) == HostCallDevice::Ok);
+    REQUIRE(guest.get32(Block + 4) == 25);
+    REQUIRE(guest.load(0x5000, 25) == contents.substr(20));
+
+    for (const char* name : {"../OUT.BIN", "/etc/passwd", ".hidden", "", "A B"}) {
+        INFO(name);
+        guest.store(Name, std::string(name) + '\0');
+        REQUIRE(guest.call(HostCallDevice::FileSize) == HostCallDevice::BadName);
+    }
+    guest.store(Name, std::string("MISSING") + '\0');
+    REQUIRE(guest.call(HostCallDevice::ReadFile) == HostCallDevice::FileError);
+
+    fs::remove_all(directory);
+}
+
+TEST_CASE("HostCall: Reports the host clock", "[hostcall]") {
+    Guest guest;
+    const std::time_t before = std::time(nullptr);
+    REQUIRE(guest.call(HostCallDevice::Clock) == HostCallDevice::Ok);
+    const std::time_t after = std::time(nullptr);
+
+    const uint32_t seconds = guest.get32(Block);
+    REQUIRE(seconds >= static_cast<uint32_t>(before));
+    REQUIRE(seconds <= static_cast<uint32_t>(after));
+    REQUIRE(guest.cpu().readWord(Block + 4) >= 2024);
+    REQUIRE(guest.cpu().readByte(Block + 6) >= 1);
+    REQUIRE(guest.cpu().readByte(Block + 6) <= 12);
+    REQUIRE(guest.cpu().readByte(Block + 10) <= 60);
+}
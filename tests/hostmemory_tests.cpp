@@ -0,0 +1,137 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+Host Memory Tests - Huge page and NUMA policies for guest RAM and frame buffers
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "cutie/context.h"
+#include "cutie/emulator.h"
+#include "cutie/framebuffer.h"
+#include "cutie/hostmemory.h"
+#include "test_paths.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using cutie::HostBuffer;
+using cutie::HugePages;
+using cutie::MemoryPolicy;
+
+namespace {
+
+MemoryPolicy policy(HugePages hugePages, int numaNode = -1)
+{
+    MemoryPolicy result;
+    result.hugePages = hugePages;
+    result.numaNode = numaNode;
+    return result;
+}
+
+std::vector<uint8_t> runFrames(const MemoryPolicy& memoryPolicy, cutie::MemoryPolicyReport& report)
+{
+    const auto romPath = cutie::test::findSystemRomPath();
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+    config.memoryPolicy = memoryPolicy;
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+    for (int frame = 0; frame < 60; ++frame) {
+        emulator->runFrame();
+    }
+    report = emulator->getMemoryPolicyReport();
+    const auto [pixels, size] = emulator->getFramebuffer();
+    return std::vector<uint8_t>(pixels, pixels + size);
+}
+
+} // namespace
+
+TEST_CASE("HostMemory: Buffers start zeroed and requests are stepped down", "[hostmemory]") {
+    for (const HugePages requested : {HugePages::Off, HugePages::Transparent, HugePages::Explicit}) {
+        INFO(cutie::hugePagesName(requested));
+        HostBuffer buffer;
+        REQUIRE(buffer.allocate(0x80000, policy(requested)));
+        REQUIRE(buffer.data() != nullptr);
+        REQUIRE(buffer.size() == 0x80000);
+        REQUIRE(reinterpret_cast<uintptr_t>(buffer.data()) % 4096 == 0);
+        REQUIRE(std::all_of(buffer.data(), buffer.data() + buffer.size(), [](uint8_t byte) { return byte == 0; }));
+        buffer.data()[buffer.size() - 1] = 0x55;
+
+        // Never more than was asked for
+        if (requested == HugePages::Off) {
+            REQUIRE(buffer.hugePages() == HugePages::Off);
+            REQUIRE(buffer.hugePageBytes() == 0);
+        } else if (requested == HugePages::Transparent) {
+            REQUIRE(buffer.hugePages() != HugePages::Explicit);
+        }
+        REQUIRE(buffer.numaNode() == -1);
+    }
+
+    HostBuffer empty;
+    REQUIRE_FALSE(empty.allocate(0, MemoryPolicy()));
+    REQUIRE(empty.data() == nullptr);
+}
+
+TEST_CASE("HostMemory: A NUMA node that does not exist is dropped", "[hostmemory]") {
+    HostBuffer buffer;
+    REQUIRE(buffer.allocate(0x10000, policy(HugePages::Off, 100000)));
+    REQUIRE(buffer.numaNode() == -1);
+    REQUIRE_FALSE(cutie::bindThreadToNumaNode(-1));
+    REQUIRE_FALSE(cutie::bindThreadToNumaNode(100000));
+
+    // Node 0 exists wherever NUMA does, but the kernel may still refuse
+    REQUIRE(buffer.allocate(0x10000, policy(HugePages::Off, 0)));
+    REQUIRE((buffer.numaNode() == 0 || buffer.numaNode() == -1));
+}
+
+TEST_CASE("HostMemory: Buffers move and release", "[hostmemory]") {
+    HostBuffer first;
+    REQUIRE(first.allocate(0x4000, policy(HugePages::Transparent)));
+    first.data()[0] = 0xA5;
+    const HugePages granted = first.hugePages();
+
+    HostBuffer second(std::move(first));
+    REQUIRE(first.data() == nullptr);
+    REQUIRE(first.size() == 0);
+    REQUIRE(second.size() == 0x4000);
+    REQUIRE(second.data()[0] == 0xA5);
+    REQUIRE(second.hugePages() == granted);
+
+    first = std::move(second);
+    REQUIRE(first.data()[0] == 0xA5);
+    first.release();
+    REQUIRE(first.data() == nullptr);
+    REQUIRE(first.hugePages() == HugePages::Off);
+
+    cutie::FrameBuffer framebuffer(64, 32, policy(HugePages::Transparent));
+    REQUIRE(framebuffer.sizeBytes() == framebuffer.buffer().size());
+    REQUIRE(framebuffer.pixels()[64 * 32 - 1] == 0xFF000000);
+}
+
+TEST_CASE("HostMemory: The machine runs the same under any policy", "[hostmemory]") {
+    if (cutie::test::findSystemRomPath().empty()) {
+        SKIP("System ROM not found - skipping host memory test");
+    }
+
+    cutie::MemoryPolicyReport plainReport;
+    const auto plain = runFrames(MemoryPolicy(), plainReport);
+    REQUIRE(plainReport.ramHugePages == HugePages::Off);
+    REQUIRE(plainReport.framebufferHugePages == HugePages::Off);
+    REQUIRE(plainReport.threadNode == -1);
+
+    cutie::MemoryPolicyReport hugeReport;
+    const auto huge = runFrames(policy(HugePages::Transparent), hugeReport);
+    REQUIRE((plain == huge));
+    REQUIRE(hugeReport.requested.hugePages == HugePages::Transparent);
+    REQUIRE(hugeReport.ramHugePages != HugePages::Explicit);
+    REQUIRE(hugeReport.describe().find("huge pages transparent requested") == 0);
+
+    // Back to ordinary pages, which reallocates RAM
+    cutie::MemoryPolicyReport againReport;
+    REQUIRE((runFrames(MemoryPolicy(), againReport) == plain));
+    REQUIRE(againReport.ramHugePages == HugePages::Off);
+}
@@ -8,49 +8,31 @@ Integration Tests - Tests the full emulation system via CocoEmulator API
 #include <catch2/catch_test_macros.hpp>
 #include "cutie/emulator.h"
 #include "cutie/context.h"
+#include "cutie/perfcounters.h"
+#include "cutie/reverse.h"
+#include "cutie/timeline.h"
+#include "test_paths.h"
 #include <cstring>
 #include <filesystem>
+#include <set>
+#include <vector>
 
 namespace fs = std::filesystem;
 
-// ============================================================================
-// Helper to find system ROM
-// ============================================================================
-
-static fs::path findSystemRomPath() {
-    // Try common locations relative to test execution
-    std::vector<fs::path> candidates = {
-        "system-roms",
-        "../system-roms",
-        "../../system-roms",
-        "shared/system-roms",
-        "../shared/system-roms",
-        "../../shared/system-roms",
-    };
-
-    for (const auto& dir : candidates) {
-        fs::path romPath = dir / "coco3.rom";
-        if (fs::exists(romPath)) {
-            return dir;
-        }
-    }
-    return "";  // Not found
-}
-
 // ============================================================================
 // CocoEmulator Creation Tests
 // ============================================================================
 
 TEST_CASE("CocoEmulator: Create with default config", "[integration][emulator]") {
     cutie::EmulatorConfig config;
-    config.systemRomPath = findSystemRomPath();
+    config.systemRomPath = cutie::test::findSystemRomPath();
 
     auto emulator = cutie::CocoEmulator::create(config);
     REQUIRE(emulator != nullptr);
 }
 
 TEST_CASE("CocoEmulator: Create with various memory sizes", "[integration][emulator]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
 
     SECTION("128K memory") {
         cutie::EmulatorConfig config;
@@ -90,7 +72,7 @@ TEST_CASE("CocoEmulator: Create with various memory sizes", "[integration][emula
 }
 
 TEST_CASE("CocoEmulator: Create with different CPU types", "[integration][emulator]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping CPU type test");
     }
@@ -123,7 +105,7 @@ TEST_CASE("CocoEmulator: Create with different CPU types", "[integration][emulat
 // ============================================================================
 
 TEST_CASE("CocoEmulator: Init succeeds with valid ROM", "[integration][emulator]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping ROM-dependent test");
     }
@@ -152,7 +134,7 @@ TEST_CASE("CocoEmulator: Init fails with invalid ROM path", "[integration][emula
 // ============================================================================
 
 TEST_CASE("CocoEmulator: Can run frames without crashing", "[integration][execution]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping execution test");
     }
@@ -173,7 +155,7 @@ TEST_CASE("CocoEmulator: Can run frames without crashing", "[integration][execut
 }
 
 TEST_CASE("CocoEmulator: Framebuffer is non-null after running frames", "[integration][execution]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping framebuffer test");
     }
@@ -196,7 +178,7 @@ TEST_CASE("CocoEmulator: Framebuffer is non-null after running frames", "[integr
 }
 
 TEST_CASE("CocoEmulator: Framebuffer info returns valid dimensions", "[integration][execution]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping framebuffer info test");
     }
@@ -227,7 +209,7 @@ TEST_CASE("CocoEmulator: Framebuffer info returns valid dimensions", "[integrati
 // ============================================================================
 
 TEST_CASE("CocoEmulator: Reset does not crash", "[integration][reset]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping reset test");
     }
@@ -254,12 +236,64 @@ TEST_CASE("CocoEmulator: Reset does not crash", "[integration][reset]") {
     REQUIRE(emulator->isReady());
 }
 
+TEST_CASE("CocoEmulator: Hard reset starts over from power on", "[integration][reset]") {
+    auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping reset test");
+    }
+
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+    const auto bootRam = [&emulator] {
+        for (int i = 0; i < 60; ++i) {
+            emulator->runFrame();
+        }
+        const auto ram = emulator->getRam();
+        return std::vector<uint8_t>(ram.first, ram.first + ram.second);
+    };
+    const auto booted = bootRam();
+
+    // RAM goes back to its power-on pattern in the same buffer
+    const uint8_t* buffer = emulator->getRam().first;
+    const uint8_t junk[] = {0x12, 0x34, 0x56};
+    emulator->writeMemory(0x0400, junk, sizeof(junk));
+    emulator->hardReset();
+    auto ram = emulator->getRam();
+    REQUIRE(ram.first == buffer);
+    REQUIRE(ram.second == 0x80000);
+    bool pattern = true;
+    for (size_t i = 0; i < ram.second; ++i) {
+        pattern = pattern && ram.first[i] == ((i & 1) ? 0x00 : 0xFF);
+    }
+    REQUIRE(pattern);
+    REQUIRE((bootRam() == booted));
+
+    // A new memory size waits for the next hard reset
+    emulator->setMemorySize(cutie::MemorySize::Mem128K);
+    REQUIRE(emulator->getMemorySize() == cutie::MemorySize::Mem512K);
+    emulator->reset();
+    REQUIRE(emulator->getRam().second == 0x80000);
+    emulator->hardReset();
+    REQUIRE(emulator->getMemorySize() == cutie::MemorySize::Mem128K);
+    REQUIRE(emulator->getRam().second == 0x20000);
+    bootRam();
+
+    emulator->setMemorySize(cutie::MemorySize::Mem512K);
+    emulator->hardReset();
+    REQUIRE((bootRam() == booted));
+}
+
 // ============================================================================
 // Input Tests
 // ============================================================================
 
 TEST_CASE("CocoEmulator: setKeyState does not crash", "[integration][input]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping input test");
     }
@@ -286,7 +320,7 @@ TEST_CASE("CocoEmulator: setKeyState does not crash", "[integration][input]") {
 }
 
 TEST_CASE("CocoEmulator: setJoystickAxis does not crash", "[integration][input]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping joystick test");
     }
@@ -315,7 +349,7 @@ TEST_CASE("CocoEmulator: setJoystickAxis does not crash", "[integration][input]"
 }
 
 TEST_CASE("CocoEmulator: setJoystickButton does not crash", "[integration][input]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping joystick button test");
     }
@@ -344,7 +378,7 @@ TEST_CASE("CocoEmulator: setJoystickButton does not crash", "[integration][input
 // ============================================================================
 
 TEST_CASE("CocoEmulator: hasCartridge returns false initially", "[integration][cartridge]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping cartridge test");
     }
@@ -360,7 +394,7 @@ TEST_CASE("CocoEmulator: hasCartridge returns false initially", "[integration][c
 }
 
 TEST_CASE("CocoEmulator: loadCartridge fails with invalid path", "[integration][cartridge]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping cartridge test");
     }
@@ -378,7 +412,7 @@ TEST_CASE("CocoEmulator: loadCartridge fails with invalid path", "[integration][
 }
 
 TEST_CASE("CocoEmulator: ejectCartridge does not crash when empty", "[integration][cartridge]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping eject test");
     }
@@ -401,7 +435,7 @@ TEST_CASE("CocoEmulator: ejectCartridge does not crash when empty", "[integratio
 // ============================================================================
 
 TEST_CASE("CocoEmulator: getAudioSamples with audio disabled", "[integration][audio]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping audio test");
     }
@@ -421,7 +455,7 @@ TEST_CASE("CocoEmulator: getAudioSamples with audio disabled", "[integration][au
 }
 
 TEST_CASE("CocoEmulator: getAudioInfo returns valid data", "[integration][audio]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping audio info test");
     }
@@ -458,12 +492,450 @@ TEST_CASE("EmulationContext: Default interfaces are non-null", "[integration][co
     REQUIRE(ctx.cartridge() != nullptr);
 }
 
+// ============================================================================
+// Memory Access Tests
+// ============================================================================
+
+TEST_CASE("CocoEmulator: readMemory does not acknowledge GIME interrupts", "[integration][memory]") {
+    auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping memory test");
+    }
+
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+    for (int i = 0; i < 60; ++i) {
+        emulator->runFrame();
+    }
+
+    // Enable GIME IRQs and the vertical border interrupt, then let it fire
+    uint8_t init0 = 0;
+    emulator->readMemory(0xFF90, &init0, 1);
+    const uint8_t enable[] = {static_cast<uint8_t>(init0 | 0x20), 0x00, 0x08};
+    emulator->writeMemory(0xFF90, enable, sizeof(enable));
+    emulator->runFrame();
+
+    // The pending flag survives any number of reads, including a full I/O dump
+    uint8_t io[256];
+    emulator->readMemory(0xFF00, io, sizeof(io));
+    REQUIRE((io[0x92] & 0x08) != 0);
+    uint8_t status = 0;
+    emulator->readMemory(0xFF92, &status, 1);
+    REQUIRE(status == io[0x92]);
+
+    // I/O space is served by the devices, not by the RAM behind it
+    REQUIRE(io[0x90] == enable[0]);
+    uint8_t vectors[16];
+    emulator->readMemory(0xFFF0, vectors, sizeof(vectors));
+    REQUIRE(std::memcmp(vectors, io + 0xF0, sizeof(vectors)) == 0);
+}
+
+TEST_CASE("CocoEmulator: A key press raises the GIME keyboard interrupt", "[integration][input]") {
+    auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping keyboard interrupt test");
+    }
+
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+    for (int i = 0; i < 60; ++i) {
+        emulator->runFrame();
+    }
+
+    // Enable GIME IRQs and only the keyboard interrupt
+    uint8_t init0 = 0;
+    emulator->readMemory(0xFF90, &init0, 1);
+    const uint8_t enable[] = {static_cast<uint8_t>(init0 | 0x20), 0x00, 0x02};
+    emulator->writeMemory(0xFF90, enable, sizeof(enable));
+    emulator->runFrame();
+
+    uint8_t status = 0;
+    emulator->readMemory(0xFF92, &status, 1);
+    REQUIRE((status & 0x02) == 0);
+
+    // Any row going low interrupts, whichever column BASIC is strobing
+    emulator->setKeyState(0, 1, true);
+    emulator->runFrame();
+    emulator->setKeyState(0, 1, false);
+    emulator->readMemory(0xFF92, &status, 1);
+    REQUIRE((status & 0x02) != 0);
+}
+
+TEST_CASE("CocoEmulator: A masked GIME timer interrupts once it is unmasked", "[integration][timer]") {
+    auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping timer test");
+    }
+
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+    for (int i = 0; i < 60; ++i) {
+        emulator->runFrame();
+    }
+
+    // A short timer running for a while with nowhere to go
+    uint8_t init0 = 0;
+    emulator->readMemory(0xFF90, &init0, 1);
+    const uint8_t masked[] = {static_cast<uint8_t>(init0 | 0x20), 0x20, 0x00, 0x00, 0x00, 0x40};
+    emulator->writeMemory(0xFF90, masked, sizeof(masked));
+    for (int i = 0; i < 10; ++i) {
+        emulator->runFrame();
+    }
+    uint8_t status = 0;
+    emulator->readMemory(0xFF92, &status, 1);
+    REQUIRE((status & 0x20) == 0);
+
+    const uint8_t unmask = 0x20;
+    emulator->writeMemory(0xFF92, &unmask, 1);
+    emulator->runFrame();
+    emulator->readMemory(0xFF92, &status, 1);
+    REQUIRE((status & 0x20) != 0);
+}
+
+TEST_CASE("CocoEmulator: Register writes are stamped with the beam position", "[integration][timeline]") {
+    auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping timeline test");
+    }
+
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+
+    auto& timeline = cutie::getRegisterTimeline();
+    timeline.enable();
+    for (int i = 0; i < 120; ++i) {
+        emulator->runFrame();
+    }
+
+    // BASIC polls the keyboard through the PIA all the time it waits for input
+    std::vector<cutie::RegisterWrite> writes;
+    REQUIRE(timeline.drain(writes) > 0);
+    REQUIRE(timeline.lost() == 0);
+    REQUIRE(timeline.frame() == 120);
+
+    std::set<uint16_t> lines;
+    for (size_t i = 0; i < writes.size(); ++i) {
+        const auto& write = writes[i];
+        INFO("write " << i << " to " << write.address);
+        const bool pia = (write.address & 0xFFDC) == 0xFF00 || (write.address & 0xFFDC) == 0xFF20;
+        REQUIRE((pia || (write.address >= 0xFF90 && write.address <= 0xFFBF)));
+        REQUIRE(write.line < 263);
+        REQUIRE(write.cycle < 200);
+        if (i > 0) {
+            const auto& last = writes[i - 1];
+            REQUIRE(write.frame >= last.frame);
+            if (write.frame == last.frame) {
+                REQUIRE((write.line > last.line || (write.line == last.line && write.cycle >= last.cycle)));
+            }
+        }
+        lines.insert(write.line);
+    }
+    REQUIRE(lines.size() > 100);
+
+    // A small ring keeps the newest writes and counts the rest
+    timeline.enable(16);
+    emulator->runFrame();
+    writes.clear();
+    REQUIRE(timeline.drain(writes) == 16);
+    REQUIRE(timeline.lost() > 0);
+    REQUIRE(timeline.drain(writes) == 0);
+
+    timeline.disable();
+    emulator->runFrame();
+    REQUIRE(timeline.drain(writes) == 0);
+}
+
+namespace {
+
+struct CoalescedRun {
+    std::vector<uint8_t> ram;
+    std::vector<uint8_t> framebuffer;
+    cutie::MachineState state;
+    uint8_t handlerRuns = 0;  // Low byte, at $3100
+};
+
+// IRQ handler that writes the border and text colours for about 90
+// scanlines, counting its runs at $3100
+const std::vector<uint8_t> PaletteHandler = {
+    0xC6, 0xC1,        // LDB #193
+    0xF7, 0xFF, 0x9A,  // STB $FF9A
+    0xF7, 0xFF, 0xBC,  // STB $FFBC
+    0xF7, 0xFF, 0xBD,  // STB $FFBD
+    0x7C, 0x31, 0x00,  // INC $3100
+    0x5A,              // DECB
+    0x26, 0xF1,        // BNE $3002
+};
+
+// IRQ handler that fills the top eight text rows with its run count, slowly
+// enough that the beam overtakes it about half way down
+const std::vector<uint8_t> TextRaceHandler = {
+    0x8E, 0x04, 0x00,  // LDX #$0400
+    0xB6, 0x31, 0x00,  // LDA $3100
+    0xA7, 0x80,        // STA ,X+
+    0xC6, 0x05,        // LDB #5
+    0x5A,              // DECB
+    0x26, 0xFD,        // BNE $300A
+    0x8C, 0x05, 0x00,  // CMPX #$0500
+    0x26, 0xF4,        // BNE $3006
+    0x7C, 0x31, 0x00,  // INC $3100
+};
+
+// Runs BASIC with or without coalesced fields. A handler, if given, is run
+// from the IRQ vector before BASIC's own.
+CoalescedRun runCoalesced(const fs::path& romPath, bool coalesce, const std::vector<uint8_t>& handler) {
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+    config.coalesceScanlines = coalesce;
+
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+    for (int i = 0; i < 60; ++i) {
+        emulator->runFrame();
+    }
+
+    if (!handler.empty()) {
+        uint8_t vector[3] = {};
+        emulator->readMemory(0x010C, vector, sizeof(vector));
+        REQUIRE(vector[0] == 0x7E);
+        std::vector<uint8_t> code = handler;
+        code.insert(code.end(), {0x7E, vector[1], vector[2]});
+        emulator->writeMemory(0x3000, code.data(), code.size());
+        const uint8_t count = 0;
+        emulator->writeMemory(0x3100, &count, 1);
+        const uint8_t hook[] = {0x7E, 0x30, 0x00};
+        emulator->writeMemory(0x010C, hook, sizeof(hook));
+    }
+    for (int i = 0; i < 30; ++i) {
+        emulator->runFrame();
+    }
+
+    CoalescedRun run;
+    emulator->readMemory(0x3100, &run.handlerRuns, 1);
+    const auto ram = emulator->getRam();
+    run.ram.assign(ram.first, ram.first + ram.second);
+    const auto framebuffer = emulator->getFramebuffer();
+    run.framebuffer.assign(framebuffer.first, framebuffer.first + framebuffer.second);
+    REQUIRE(emulator->saveState(run.state));
+    return run;
+}
+
+} // namespace
+
+TEST_CASE("CocoEmulator: Coalesced fields match line by line execution", "[integration][execution]") {
+    auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping coalesced field test");
+    }
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+
+    for (bool hookIrq : {false, true}) {
+        INFO("palette writes from the IRQ handler " << hookIrq);
+        const std::vector<uint8_t> handler = hookIrq ? PaletteHandler : std::vector<uint8_t>();
+        const CoalescedRun lines = runCoalesced(romPath, false, handler);
+        const CoalescedRun field = runCoalesced(romPath, true, handler);
+
+        if (hookIrq) {
+            REQUIRE(field.handlerRuns != 0);
+        }
+        REQUIRE((field.ram == lines.ram));
+        REQUIRE((field.framebuffer == lines.framebuffer));
+
+        // Only the sub-cycle timing may round differently
+        REQUIRE(field.state.devices.size() == lines.state.devices.size());
+        for (size_t i = 0; i < field.state.devices.size(); ++i) {
+            const auto& device = field.state.devices[i];
+            INFO("device " << device.first);
+            REQUIRE(device.first == lines.state.devices[i].first);
+            if (device.first != "timing") {
+                REQUIRE((device.second == lines.state.devices[i].second));
+            }
+        }
+    }
+}
+
+TEST_CASE("CocoEmulator: Coalesced fields show video RAM written mid-frame", "[integration][execution]") {
+    auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping coalesced field test");
+    }
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+
+    const CoalescedRun lines = runCoalesced(romPath, false, TextRaceHandler);
+    const CoalescedRun field = runCoalesced(romPath, true, TextRaceHandler);
+    REQUIRE(field.handlerRuns == lines.handlerRuns);
+    REQUIRE(field.handlerRuns > 20);
+    REQUIRE((field.ram == lines.ram));
+
+    // Rows the beam drew before the handler reached them still show the
+    // previous count
+    REQUIRE((field.framebuffer == lines.framebuffer));
+}
+
+TEST_CASE("CocoEmulator: Perf counters charge frame time to phases", "[integration][perf]") {
+    auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping perf counter test");
+    }
+
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+
+    // Hardware events depend on the host; elapsed time is always counted
+    using cutie::PerfEvent;
+    using cutie::PerfPhase;
+    auto& perf = cutie::getPerfCounters();
+    const bool hardware = perf.enable();
+    REQUIRE(perf.isEnabled());
+    REQUIRE(perf.hasEvent(PerfEvent::Nanoseconds));
+    // enable() reports any hardware event; which ones open is up to the host
+    bool anyHardware = false;
+    for (size_t event = 0; event < cutie::PerfEventCount; ++event) {
+        if (static_cast<PerfEvent>(event) != PerfEvent::Nanoseconds) {
+            anyHardware = anyHardware || perf.hasEvent(static_cast<PerfEvent>(event));
+        }
+    }
+    REQUIRE(hardware == anyHardware);
+    if (!hardware) {
+        REQUIRE_FALSE(perf.getLastError().empty());
+    }
+
+    emulator->runFrame();
+    const auto& frame = perf.lastFrame();
+    REQUIRE(frame.get(PerfPhase::Cpu, PerfEvent::Nanoseconds) > 0);
+    REQUIRE(frame.get(PerfPhase::Render, PerfEvent::Nanoseconds) > 0);
+    REQUIRE(frame.get(PerfPhase::Frontend, PerfEvent::Nanoseconds) == 0);
+    for (const PerfEvent event : {PerfEvent::Instructions, PerfEvent::Cycles}) {
+        if (perf.hasEvent(event)) {
+            REQUIRE(frame.get(PerfPhase::Cpu, event) > 0);
+        }
+    }
+
+    perf.disable();
+    REQUIRE_FALSE(perf.hasEvent(PerfEvent::Nanoseconds));
+}
+
+TEST_CASE("CocoEmulator: Reverse execution replays recorded frames", "[integration][reverse]") {
+    auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping reverse execution test");
+    }
+
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.audioSampleRate = 0;
+
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+
+    cutie::ReverseDebugger debugger(*emulator, 20, 6);
+    REQUIRE(debugger.start());
+
+    // Type at BASIC so that the replay has to reproduce the input
+    for (int i = 0; i < 150; ++i) {
+        emulator->setKeyState(0, 1, i >= 100 && i < 104);  // A
+        debugger.runFrame();
+    }
+    emulator->setKeyState(0, 1, false);
+    REQUIRE(debugger.recordedFrames() == 150);
+    REQUIRE(debugger.checkpointCount() == 6);
+    REQUIRE(debugger.firstInstruction() > 0);
+
+    cutie::MachineState recorded;
+    REQUIRE(emulator->saveState(recorded));
+    const uint64_t end = debugger.instruction();
+    REQUIRE(end > 0);
+
+    // One instruction back: the machine is left at the start of the last
+    // frame, and the point describes the instruction before the end
+    cutie::ExecutionPoint point;
+    REQUIRE(debugger.stepBack(point));
+    REQUIRE(point.instruction == end - 1);
+    REQUIRE(point.frame == 149);
+    REQUIRE(point.memory.size() == 0x10000);
+    REQUIRE(debugger.instruction() == end - 1);
+    REQUIRE(debugger.frame() == 149);
+
+    cutie::ExecutionPoint previous;
+    REQUIRE(debugger.stepBack(previous));
+    REQUIRE(previous.instruction == end - 2);
+
+    // Reverse-continue finds the same instruction again from the end
+    debugger.runFrame();
+    REQUIRE(debugger.instruction() == end);
+    cutie::ExecutionPoint hit;
+    REQUIRE(debugger.reverseContinue({point.registers.PC}, hit));
+    REQUIRE(hit.instruction == end - 1);
+    REQUIRE(hit.registers.PC == point.registers.PC);
+    REQUIRE(hit.memory == point.memory);
+
+    // Going further back lands on an earlier visit to the same address
+    cutie::ExecutionPoint earlier;
+    REQUIRE(debugger.reverseContinue({point.registers.PC}, earlier));
+    REQUIRE(earlier.instruction < end - 1);
+    REQUIRE(earlier.registers.PC == point.registers.PC);
+
+    // Replaying forward from an older checkpoint reproduces the recording,
+    // key press included
+    REQUIRE(debugger.seek(debugger.firstInstruction() + 10, point));
+    REQUIRE(debugger.frame() < 100);
+    while (debugger.frame() < debugger.recordedFrames()) {
+        debugger.runFrame();
+    }
+    REQUIRE(debugger.instruction() == end);
+    cutie::MachineState replayed;
+    REQUIRE(emulator->saveState(replayed));
+    REQUIRE(replayed.ram == recorded.ram);
+    REQUIRE(replayed.devices == recorded.devices);
+
+    // History older than the oldest checkpoint is gone
+    REQUIRE_FALSE(debugger.seek(debugger.firstInstruction() - 1, point));
+    REQUIRE_FALSE(debugger.reverseContinue({0xFFFF}, point));
+    REQUIRE(debugger.instruction() == debugger.firstInstruction());
+
+    // New input in the past discards the recorded future
+    REQUIRE(debugger.seek(debugger.firstInstruction() + 10, point));
+    const uint64_t frame = debugger.frame();
+    emulator->setKeyState(0, 2, true);  // B
+    debugger.runFrame();
+    emulator->setKeyState(0, 2, false);
+    REQUIRE(debugger.recordedFrames() == frame + 1);
+    REQUIRE_FALSE(debugger.seek(end - 1, point));
+    debugger.stop();
+}
+
 // ============================================================================
 // Stress Tests
 // ============================================================================
 
 TEST_CASE("CocoEmulator: Can run many frames continuously", "[integration][stress]") {
-    auto romPath = findSystemRomPath();
+    auto romPath = cutie::test::findSystemRomPath();
     if (romPath.empty()) {
         SKIP("System ROM not found - skipping stress test");
     }
@@ -7,6 +7,11 @@ MC6809 CPU Instruction Tests
 
 #include <catch2/catch_test_macros.hpp>
 #include "cpu_test_harness.h"
+#include "tcc1014mmu.h"
+#include "cutie/context.h"
+#include <filesystem>
+#include <fstream>
+#include <vector>
 
 using namespace cutie::test;
 
@@ -519,6 +524,61 @@ TEST_CASE("MC6809: EXG exchanges register values", "[mc6809][transfer]") {
     REQUIRE(state.B == 0xAA);
 }
 
+// ============================================================================
+// Indexed Addressing
+// ============================================================================
+
+TEST_CASE("MC6809: Indexed constant offsets and auto increment", "[mc6809][indexed]") {
+    CPUTestHarness cpu;
+
+    cpu.writeByte(0x1FFE, 0x11);
+    cpu.writeByte(0x2000, 0x22);
+    cpu.writeByte(0x2001, 0x33);
+    cpu.writeByte(0x2080, 0x44);
+
+    cpu.loadProgram(0x1000, {
+        0x8E, 0x20, 0x00,        // LDX #$2000
+        0xA6, 0x1E,              // LDA -2,X
+        0xE6, 0x80,              // LDB ,X+
+        0xA6, 0x84,              // LDA ,X
+        0xE6, 0x89, 0x00, 0x7F   // LDB $007F,X
+    });
+    cpu.setPC(0x1000);
+    cpu.step();
+
+    cpu.step();
+    REQUIRE(cpu.getState().A == 0x11);
+    cpu.step();
+    REQUIRE(cpu.getState().B == 0x22);
+    REQUIRE(cpu.getState().X == 0x2001);
+    cpu.step();
+    REQUIRE(cpu.getState().A == 0x33);
+    cpu.step();
+    REQUIRE(cpu.getState().B == 0x44);
+    REQUIRE(cpu.getState().PC == 0x100D);
+}
+
+TEST_CASE("MC6809: Indexed PC relative and extended indirect", "[mc6809][indexed]") {
+    CPUTestHarness cpu;
+
+    cpu.writeWord(0x3000, 0x2100);
+    cpu.writeByte(0x2100, 0x5A);
+
+    cpu.loadProgram(0x1000, {
+        0xA6, 0x8C, 0x01,        // LDA 1,PCR (reads $1004)
+        0x12, 0x12,              // NOP, NOP
+        0xE6, 0x9F, 0x30, 0x00   // LDB [$3000]
+    });
+    cpu.setPC(0x1000);
+    cpu.step();
+    REQUIRE(cpu.getState().A == 0x12);
+
+    cpu.setPC(0x1005);
+    cpu.step();
+    REQUIRE(cpu.getState().B == 0x5A);
+    REQUIRE(cpu.getState().PC == 0x1009);
+}
+
 // ============================================================================
 // Stack Instructions
 // ============================================================================
@@ -561,3 +621,199 @@ TEST_CASE("MC6809: PULS pulls registers from stack", "[mc6809][stack]") {
     REQUIRE(state.A == 0x37);
     REQUIRE(state.S == 0x3000);  // S incremented
 }
+
+TEST_CASE("MC6809: PSHS/PULS round trip across an MMU bank boundary", "[mc6809][stack]") {
+    CPUTestHarness cpu;
+
+    // PSHS U,X,A pushes five bytes from $2004, filling $1FFF-$2003 across
+    // the $1FFF/$2000 bank boundary
+    cpu.loadProgram(0x1000, {
+        0x10, 0xCE, 0x20, 0x04,  // LDS #$2004
+        0xCE, 0x55, 0xAA,        // LDU #$55AA
+        0x8E, 0x12, 0x34,        // LDX #$1234
+        0x86, 0x42,              // LDA #$42
+        0x34, 0x52,              // PSHS U,X,A
+        0x4F,                    // CLRA
+        0x8E, 0x00, 0x00,        // LDX #$0000
+        0x35, 0x12               // PULS A,X
+    });
+    cpu.setPC(0x1000);
+    for (int i = 0; i < 5; ++i) cpu.step();
+
+    REQUIRE(cpu.getState().S == 0x1FFF);
+    REQUIRE(cpu.readByte(0x1FFF) == 0x42);
+    REQUIRE(cpu.readWord(0x2000) == 0x1234);
+    REQUIRE(cpu.readWord(0x2002) == 0x55AA);
+
+    for (int i = 0; i < 3; ++i) cpu.step();
+
+    auto state = cpu.getState();
+    REQUIRE(state.A == 0x42);
+    REQUIRE(state.X == 0x1234);
+    REQUIRE(state.S == 0x2002);
+}
+
+TEST_CASE("MC6809: PSHS/PULS round trip across $FE00 and up to the I/O page", "[mc6809][stack]") {
+    CPUTestHarness cpu;
+
+    // $FE00-$FEFF is the vector page, so these spans take the byte at a
+    // time path rather than the block copy. Select the all-RAM map so that
+    // the top bank is writable.
+    cpu.writeByte(0xFFDF, 0);
+    cpu.loadProgram(0x1000, {
+        0x10, 0xCE, 0xFE, 0x03,  // LDS #$FE03
+        0xCE, 0x55, 0xAA,        // LDU #$55AA
+        0x8E, 0x12, 0x34,        // LDX #$1234
+        0x86, 0x42,              // LDA #$42
+        0x34, 0x52,              // PSHS U,X,A
+        0x4F,                    // CLRA
+        0x8E, 0x00, 0x00,        // LDX #$0000
+        0x35, 0x12,              // PULS A,X
+        0x10, 0xCE, 0xFF, 0x00,  // LDS #$FF00
+        0x86, 0x5A,              // LDA #$5A
+        0x34, 0x02,              // PSHS A
+        0x4F,                    // CLRA
+        0x35, 0x02               // PULS A
+    });
+    cpu.setPC(0x1000);
+    for (int i = 0; i < 5; ++i) cpu.step();
+
+    REQUIRE(cpu.getState().S == 0xFDFE);
+    REQUIRE(cpu.readByte(0xFDFE) == 0x42);
+    REQUIRE(cpu.readWord(0xFDFF) == 0x1234);
+    REQUIRE(cpu.readWord(0xFE01) == 0x55AA);
+
+    for (int i = 0; i < 3; ++i) cpu.step();
+
+    auto state = cpu.getState();
+    REQUIRE(state.A == 0x42);
+    REQUIRE(state.X == 0x1234);
+    REQUIRE(state.S == 0xFE01);
+
+    // The last byte below the I/O page
+    for (int i = 0; i < 3; ++i) cpu.step();
+    REQUIRE(cpu.getState().S == 0xFEFF);
+    REQUIRE(cpu.readByte(0xFEFF) == 0x5A);
+
+    for (int i = 0; i < 2; ++i) cpu.step();
+    state = cpu.getState();
+    REQUIRE(state.A == 0x5A);
+    REQUIRE(state.S == 0xFF00);
+}
+
+// ============================================================================
+// Instruction Fetch
+// ============================================================================
+
+TEST_CASE("MC6809: Instruction fetch follows MMU bank remaps", "[mc6809][mmu]") {
+    CPUTestHarness cpu;
+
+    // Enable the MMU and place a different LDA at $4000 in two physical pages
+    cpu.writeByte(0xFF90, 0x40);
+    cpu.writeByte(0xFFA2, 0x30);
+    cpu.loadProgram(0x4000, {0x86, 0x11});  // LDA #$11
+    cpu.writeByte(0xFFA2, 0x31);
+    cpu.loadProgram(0x4000, {0x86, 0x22});  // LDA #$22
+
+    cpu.writeByte(0xFFA2, 0x30);
+    cpu.setPC(0x4000);
+    cpu.step();
+    REQUIRE(cpu.getState().A == 0x11);
+
+    // Remapping the bank must not leave the old page cached for fetches
+    cpu.writeByte(0xFFA2, 0x31);
+    cpu.setPC(0x4000);
+    cpu.step();
+    REQUIRE(cpu.getState().A == 0x22);
+}
+
+TEST_CASE("MC6809: Instruction fetch sees self-modified code", "[mc6809][mmu]") {
+    CPUTestHarness cpu;
+
+    cpu.loadProgram(0x1000, {0x86, 0x11});  // LDA #$11
+    cpu.setPC(0x1000);
+    cpu.step();
+    REQUIRE(cpu.getState().A == 0x11);
+
+    cpu.writeByte(0x1001, 0x33);
+    cpu.setPC(0x1000);
+    cpu.step();
+    REQUIRE(cpu.getState().A == 0x33);
+}
+
+TEST_CASE("MMU: Span transfers match byte at a time access", "[mmu]") {
+    CPUTestHarness cpu;
+
+    // Two unrelated physical blocks side by side in the CPU's view
+    cpu.writeByte(0xFF90, 0x40);
+    cpu.writeByte(0xFFA1, 0x30);
+    cpu.writeByte(0xFFA2, 0x12);
+
+    std::vector<uint8_t> data(0x40);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 7 + 1);
+    }
+    MemWriteBlock(data.data(), 0x3FE0, static_cast<unsigned int>(data.size()));
+    for (size_t i = 0; i < data.size(); ++i) {
+        REQUIRE(cpu.readByte(static_cast<uint16_t>(0x3FE0 + i)) == data[i]);
+    }
+
+    std::vector<uint8_t> read(data.size());
+    MemReadBlock(read.data(), 0x3FE0, static_cast<unsigned int>(read.size()));
+    REQUIRE(read == data);
+
+    // Each half lands in its own block of physical RAM
+    MemReadPhysical(read.data(), 0x30 * 0x2000 + 0x1FE0, 0x20);
+    MemReadPhysical(read.data() + 0x20, 0x12 * 0x2000, 0x20);
+    REQUIRE(read == data);
+
+    // Physical RAM wraps at the installed 512K
+    MemWritePhysical(data.data(), 0x80000 - 0x10, 0x20);
+    MemReadPhysical(read.data(), 0x80000 - 0x10, 0x20);
+    REQUIRE(std::vector<uint8_t>(read.begin(), read.begin() + 0x20)
+            == std::vector<uint8_t>(data.begin(), data.begin() + 0x20));
+    REQUIRE(GetMem(0) == data[0x10]);
+
+    // Spans running into the I/O page go through the registers
+    const uint8_t remap[] = {0x31, 0x32};
+    MemWriteBlock(remap, 0xFFA1, sizeof(remap));
+    REQUIRE(cpu.readByte(0xFFA1) == 0x31);
+    REQUIRE(cpu.readByte(0xFFA2) == 0x32);
+}
+
+// ============================================================================
+// System ROM
+// ============================================================================
+
+TEST_CASE("MMU: System ROM hash identifies the loaded image", "[mmu][rom]") {
+    CPUTestHarness cpu;
+    auto& context = cutie::EmulationContext::instance();
+    const auto dir = std::filesystem::temp_directory_path();
+
+    auto loadImage = [&](const char* name, uint8_t fill) {
+        const auto path = dir / name;
+        std::vector<char> image(0x8000, static_cast<char>(fill));
+        std::ofstream(path, std::ios::binary).write(image.data(), image.size());
+        context.setCustomSystemRomPath(path);
+        LoadRom();
+        std::filesystem::remove(path);
+        return GetSystemRomHash();
+    };
+
+    const auto original = GetSystemRomHash();
+    const bool useCustom = context.useCustomSystemRom();
+    const auto customPath = context.customSystemRomPath();
+    context.setUseCustomSystemRom(true);
+    const auto first = loadImage("cutiecoco-rom-a.rom", 0x12);
+    const auto second = loadImage("cutiecoco-rom-b.rom", 0x34);
+    const auto again = loadImage("cutiecoco-rom-a.rom", 0x12);
+    context.setUseCustomSystemRom(useCustom);
+    context.setCustomSystemRomPath(customPath);
+
+    // Put the original image back for the tests that follow
+    LoadRom();
+
+    REQUIRE(first != second);
+    REQUIRE(first == again);
+    REQUIRE(GetSystemRomHash() == original);
+}
@@ -0,0 +1,196 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+Memory Search Tests - Narrowing RAM candidates with byte and word compares
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "cutie/context.h"
+#include "cutie/emulator.h"
+#include "cutie/memorysearch.h"
+#include "test_paths.h"
+#include <random>
+#include <vector>
+
+using cutie::MemorySearch;
+using cutie::SearchCompare;
+using cutie::SearchWidth;
+
+namespace {
+
+const SearchCompare AllCompares[] = {
+    SearchCompare::Equal, SearchCompare::NotEqual, SearchCompare::Less,
+    SearchCompare::LessOrEqual, SearchCompare::Greater, SearchCompare::GreaterOrEqual,
+};
+
+uint16_t valueAt(const std::vector<uint8_t>& memory, size_t address, SearchWidth width) {
+    return width == SearchWidth::Word ? static_cast<uint16_t>(memory[address] << 8 | memory[address + 1])
+                                      : memory[address];
+}
+
+bool holds(SearchCompare compare, unsigned value, unsigned reference) {
+    switch (compare) {
+    case SearchCompare::Equal: return value == reference;
+    case SearchCompare::NotEqual: return value != reference;
+    case SearchCompare::Less: return value < reference;
+    case SearchCompare::LessOrEqual: return value <= reference;
+    case SearchCompare::Greater: return value > reference;
+    case SearchCompare::GreaterOrEqual: return value >= reference;
+    }
+    return false;
+}
+
+// One address at a time, to check the vector passes against
+class ReferenceSearch {
+public:
+    void start(const std::vector<uint8_t>& memory, SearchWidth width) {
+        m_width = width;
+        m_candidates.clear();
+        const size_t values = width == SearchWidth::Word ? memory.size() - 1 : memory.size();
+        for (size_t address = 0; address < values; ++address) {
+            m_candidates.push_back(static_cast<uint32_t>(address));
+        }
+        m_previous = memory;
+    }
+
+    void filter(const std::vector<uint8_t>& memory, SearchCompare compare, bool relative, int reference) {
+        const unsigned mask = m_width == SearchWidth::Word ? 0xFFFF : 0xFF;
+        std::vector<uint32_t> kept;
+        for (uint32_t address : m_candidates) {
+            const unsigned other = relative
+                ? (valueAt(m_previous, address, m_width) + reference) & mask
+                : static_cast<unsigned>(reference);
+            if (holds(compare, valueAt(memory, address, m_width), other)) {
+                kept.push_back(address);
+            }
+        }
+        m_candidates = kept;
+        m_previous = memory;
+    }
+
+    const std::vector<uint32_t>& candidates() const { return m_candidates; }
+
+private:
+    SearchWidth m_width = SearchWidth::Byte;
+    std::vector<uint32_t> m_candidates;
+    std::vector<uint8_t> m_previous;
+};
+
+} // namespace
+
+TEST_CASE("MemorySearch: Passes match a one address at a time search", "[memorysearch]") {
+    std::mt19937 random(1234);
+
+    for (SearchWidth width : {SearchWidth::Byte, SearchWidth::Word}) {
+        for (SearchCompare compare : AllCompares) {
+            // Sizes off the 64 address groups exercise the scalar tail
+            for (size_t size : {size_t(1000), size_t(4096), size_t(4097)}) {
+                INFO("width " << static_cast<int>(width) << " compare " << static_cast<int>(compare)
+                     << " size " << size);
+
+                // Few distinct values so that every compare keeps some
+                std::vector<uint8_t> memory(size);
+                for (auto& byte : memory) {
+                    byte = static_cast<uint8_t>(random() % 4 * 0x3F);
+                }
+
+                MemorySearch search;
+                ReferenceSearch reference;
+                search.start(memory.data(), memory.size(), width);
+                reference.start(memory, width);
+                REQUIRE(search.count() == reference.candidates().size());
+
+                for (int pass = 0; pass < 4; ++pass) {
+                    for (size_t i = 0; i < size / 8; ++i) {
+                        memory[random() % size] += static_cast<uint8_t>(random() % 3 - 1);
+                    }
+
+                    const bool relative = pass % 2 == 1;
+                    const int value = relative ? static_cast<int>(random() % 3) - 1
+                        : static_cast<int>(valueAt(memory, random() % (size - 1), width));
+                    if (relative) {
+                        search.filterRelative(memory.data(), compare, value);
+                    } else {
+                        search.filter(memory.data(), compare, static_cast<uint16_t>(value));
+                    }
+                    reference.filter(memory, compare, relative, value);
+
+                    INFO("pass " << pass << " value " << value);
+                    REQUIRE(search.count() == reference.candidates().size());
+                    REQUIRE(search.candidates() == reference.candidates());
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("MemorySearch: Words are big endian at every offset", "[memorysearch]") {
+    std::vector<uint8_t> memory(256, 0);
+    memory[100] = 0x12;
+    memory[101] = 0x34;
+    memory[200] = 0x34;
+    memory[201] = 0x12;
+
+    MemorySearch search;
+    search.start(memory.data(), memory.size(), SearchWidth::Word);
+    REQUIRE(search.count() == 255);
+    REQUIRE(search.filter(memory.data(), SearchCompare::Equal, 0x1234) == 1);
+    REQUIRE(search.candidates() == std::vector<uint32_t>{100});
+    REQUIRE(search.previousValue(100) == 0x1234);
+
+    // The counter goes down by one and is found by a relative pass
+    memory[101] = 0x33;
+    REQUIRE(search.filterRelative(memory.data(), SearchCompare::Equal, -1) == 1);
+    memory[101] = 0x40;
+    REQUIRE(search.filterRelative(memory.data(), SearchCompare::Less) == 0);
+}
+
+TEST_CASE("MemorySearch: A byte compare with a wider constant", "[memorysearch]") {
+    std::vector<uint8_t> memory(128, 0xFF);
+
+    MemorySearch search;
+    search.start(memory.data(), memory.size());
+    REQUIRE(search.filter(memory.data(), SearchCompare::Less, 0x100) == 128);
+    REQUIRE(search.filter(memory.data(), SearchCompare::Equal, 0x1FF) == 0);
+}
+
+TEST_CASE("MemorySearch: Finds a value the guest changes in RAM", "[memorysearch][integration]") {
+    const auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping memory search test");
+    }
+
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.memorySize = cutie::MemorySize::Mem2M;
+    config.audioSampleRate = 0;
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+    for (int i = 0; i < 60; ++i) {
+        emulator->runFrame();
+    }
+
+    const auto ram = emulator->getRam();
+    REQUIRE(ram.first != nullptr);
+    REQUIRE(ram.second == 2 * 1024 * 1024);
+
+    // A counter only the test changes, through the CPU's view of memory
+    const uint16_t address = 0x3000;
+    uint8_t value = 0x55;
+    emulator->writeMemory(address, &value, 1);
+
+    MemorySearch search;
+    search.start(ram.first, ram.second);
+    search.filter(ram.first, SearchCompare::Equal, 0x55);
+    for (int pass = 0; pass < 4 && search.count() > 1; ++pass) {
+        value += 3;
+        emulator->writeMemory(address, &value, 1);
+        search.filterRelative(ram.first, SearchCompare::Equal, 3);
+    }
+
+    REQUIRE(search.count() == 1);
+    const uint32_t found = search.candidates()[0];
+    REQUIRE(ram.first[found] == value);
+}
@@ -0,0 +1,370 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+ROM Hook Tests - Native BASIC routines against the ROM code they replace
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "cpu_test_harness.h"
+#include "test_paths.h"
+#include "cutie/context.h"
+#include "cutie/romhooks.h"
+#include "cutie/stubs.h"
+#include "mc6809.h"
+#include "hd6309.h"
+#include "tcc1014mmu.h"
+#include <functional>
+#include <random>
+#include <vector>
+
+using cutie::CpuType;
+using cutie::RomHooks;
+using cutie::test::CPUTestHarness;
+
+namespace {
+
+constexpr uint16_t Caller = 0x1000;
+constexpr uint16_t Stack = 0x7EFF;
+
+struct Registers {
+    uint8_t a = 0, b = 0, cc = 0;
+    uint16_t x = 0, y = 0, u = 0;
+};
+
+struct Outcome {
+    VCC::CPUState regs;
+    std::vector<uint8_t> memory;
+    int cycles = 0;
+    uint64_t calls = 0;
+};
+
+// Fills in memory before a call
+using Setup = std::function<void(CPUTestHarness&)>;
+
+bool useStockRom() {
+    const auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        return false;
+    }
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    CPUTestHarness cpu;
+    return GetSystemRomHash() == RomHooks::StockRomHash;
+}
+
+// Calls entry from $1000 with the registers given, on a fresh machine,
+// and runs until it returns
+Outcome call(CpuType type, uint16_t entry, const Registers& in, const Setup& setup, bool hooks) {
+    CPUTestHarness cpu(type);
+    CPUExec = type == CpuType::HD6309 ? HD6309Exec : MC6809Exec;
+    setup(cpu);
+    cpu.writeByte(Stack, in.cc);
+    cpu.loadProgram(Caller, {
+        0x10, 0xCE, Stack >> 8, Stack & 0xFF,                                     // LDS #Stack
+        0x4F, 0x1F, 0x8B,                                                         // CLRA, TFR A,DP
+        0x8E, static_cast<uint8_t>(in.x >> 8), static_cast<uint8_t>(in.x),        // LDX
+        0x10, 0x8E, static_cast<uint8_t>(in.y >> 8), static_cast<uint8_t>(in.y),  // LDY
+        0xCE, static_cast<uint8_t>(in.u >> 8), static_cast<uint8_t>(in.u),        // LDU
+        0xCC, in.a, in.b,                                                         // LDD
+        0x35, 0x01,                                                               // PULS CC
+        0xBD, static_cast<uint8_t>(entry >> 8), static_cast<uint8_t>(entry),      // JSR entry
+        0x20, 0xFE,                                                               // BRA *
+    });
+    constexpr uint16_t Done = Caller + 25;
+    cpu.setPC(Caller);
+    cutie::getRomHooks().setEnabled(hooks);
+
+    Outcome outcome;
+    for (int steps = 0; cpu.getState().PC != Done; ++steps) {
+        REQUIRE(steps < 100000);
+        outcome.cycles += cpu.step();
+    }
+    outcome.calls = cutie::getRomHooks().calls();
+    cutie::getRomHooks().setEnabled(false);
+    CPUExec = MC6809Exec;
+
+    outcome.regs = cpu.getState();
+    for (unsigned address = 0; address < 0xFF00; ++address) {
+        outcome.memory.push_back(cpu.readByte(static_cast<uint16_t>(address)));
+    }
+    return outcome;
+}
+
+// Runs a call with and without the hooks and requires the same result
+void compare(CpuType type, uint16_t entry, const Registers& in, const Setup& setup, bool hooks = true) {
+    const Outcome rom = call(type, entry, in, setup, false);
+    const Outcome hooked = call(type, entry, in, setup, true);
+    INFO("entry " << entry << " A " << int(in.a) << " B " << int(in.b) << " CC " << int(in.cc) << " X " << in.x);
+    REQUIRE(rom.calls == 0);
+    REQUIRE((hooked.calls > 0) == hooks);
+    REQUIRE(hooked.regs.A == rom.regs.A);
+    REQUIRE(hooked.regs.B == rom.regs.B);
+    REQUIRE(hooked.regs.X == rom.regs.X);
+    REQUIRE(hooked.regs.Y == rom.regs.Y);
+    REQUIRE(hooked.regs.U == rom.regs.U);
+    REQUIRE(hooked.regs.S == rom.regs.S);
+    REQUIRE(hooked.regs.DP == rom.regs.DP);
+    REQUIRE(hooked.regs.CC == rom.regs.CC);
+    REQUIRE(hooked.cycles == rom.cycles);
+    REQUIRE((hooked.memory == rom.memory));
+}
+
+// Floating point accumulators and temporaries with bytes that favour the
+// edge cases: zeros, $FF and set top bits
+std::vector<uint8_t> fpBytes(std::mt19937& random, size_t count) {
+    std::vector<uint8_t> bytes;
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned pick = random() % 10;
+        bytes.push_back(pick < 3 ? 0x00 : pick < 5 ? 0xFF : pick < 6 ? 0x80 : static_cast<uint8_t>(random()));
+    }
+    return bytes;
+}
+
+Setup directPage(const std::vector<uint8_t>& bytes, uint16_t start = 0x003B) {
+    return [bytes, start](CPUTestHarness& cpu) {
+        cpu.loadProgram(start, bytes);
+    };
+}
+
+Registers randomRegisters(std::mt19937& random) {
+    Registers in;
+    in.a = static_cast<uint8_t>(random());
+    in.b = static_cast<uint8_t>(random());
+    in.cc = static_cast<uint8_t>(random() | 0x50);  // Interrupts masked
+    in.x = static_cast<uint16_t>(0x2000 + random() % 0x100);
+    in.y = static_cast<uint16_t>(random());
+    in.u = static_cast<uint16_t>(random());
+    return in;
+}
+
+} // namespace
+
+TEST_CASE("RomHooks: Each hook matches the ROM routine it stands in for", "[romhooks]") {
+    if (!useStockRom()) {
+        SKIP("Stock CoCo 3 ROM not found - skipping ROM hook test");
+    }
+
+    std::mt19937 random(1234);
+    for (const CpuType type : {CpuType::MC6809, CpuType::HD6309}) {
+        for (size_t index = 0; index < RomHooks::routineCount(); ++index) {
+            const RomHooks::Routine& routine = RomHooks::routine(index);
+            INFO(routine.name << (type == CpuType::HD6309 ? " on the 6309" : " on the 6809"));
+            for (int i = 0; i < 12; ++i) {
+                Registers in = randomRegisters(random);
+                if (routine.entry == 0xBB00) {
+                    in.cc &= ~cutie::test::CC_Z;  // A zero byte is left to the ROM
+                }
+                // The direct page from VARDES to FPSBYT, VARDES pointing at $2100
+                std::vector<uint8_t> page = fpBytes(random, 0x29);
+                page[0] = 0x21;
+                page[1] = static_cast<uint8_t>(random());
+                std::vector<uint8_t> data = fpBytes(random, 0x100);
+                compare(type, routine.entry, in, [&](CPUTestHarness& cpu) {
+                    directPage(page)(cpu);
+                    cpu.loadProgram(0x2000, data);
+                    cpu.loadProgram(0x3000, data);
+                });
+            }
+        }
+    }
+}
+
+TEST_CASE("RomHooks: Block moves match for every length and overlap", "[romhooks]") {
+    if (!useStockRom()) {
+        SKIP("Stock CoCo 3 ROM not found - skipping ROM hook test");
+    }
+
+    std::vector<uint8_t> data;
+    for (int i = 0; i < 0x200; ++i) {
+        data.push_back(static_cast<uint8_t>(i * 13 + 7));
+    }
+    const Setup setup = [&](CPUTestHarness& cpu) { cpu.loadProgram(0x2000, data); };
+
+    for (unsigned length : {1u, 2u, 15u, 16u, 17u, 0x7Fu, 0x80u, 0x81u, 0xFFu, 0u}) {
+        Registers in;
+        in.b = static_cast<uint8_t>(length);
+        in.cc = 0x53;
+        in.x = 0x2000;
+        in.u = 0x2800;
+        compare(CpuType::MC6809, 0xA59A, in, setup);
+
+        // Forwards onto itself, spreading the first byte
+        in.u = 0x2001;
+        compare(CpuType::MC6809, 0xA59A, in, setup);
+    }
+}
+
+TEST_CASE("RomHooks: Multiplying by a byte matches for every bit pattern", "[romhooks]") {
+    if (!useStockRom()) {
+        SKIP("Stock CoCo 3 ROM not found - skipping ROM hook test");
+    }
+
+    // Product, then FPA1's mantissa
+    const std::vector<std::vector<uint8_t>> operands = {
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00},
+        {0x12, 0x34, 0x56, 0x78, 0x9A, 0xFF, 0xFF, 0xFF, 0xFF},
+        {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x88, 0x88, 0x88, 0x88},
+    };
+    for (const auto& operand : operands) {
+        for (const uint8_t b : {0x01, 0x80, 0x55, 0xAA, 0xFF, 0x08}) {
+            const Setup setup = [&](CPUTestHarness& cpu) {
+                cpu.loadProgram(0x0013, {operand[0], operand[1], operand[2], operand[3]});
+                cpu.writeByte(0x0063, operand[4]);
+                cpu.loadProgram(0x005D, {operand[5], operand[6], operand[7], operand[8]});
+            };
+            Registers in;
+            in.a = 0x5A;
+            in.b = b;
+            in.cc = 0x50;
+            compare(CpuType::MC6809, 0xBB00, in, setup);
+            in.cc = 0x7B;
+            compare(CpuType::MC6809, 0xBB02, in, setup);
+        }
+
+        // A zero byte is a shift the ROM does itself
+        Registers in;
+        in.cc = 0x54;
+        compare(CpuType::MC6809, 0xBB00, in, [&](CPUTestHarness& cpu) {
+            cpu.loadProgram(0x0013, {operand[0], operand[1], operand[2], operand[3]});
+        }, false);
+    }
+}
+
+TEST_CASE("RomHooks: Normalizing shifts, rounds and underflows as the ROM does", "[romhooks]") {
+    if (!useStockRom()) {
+        SKIP("Stock CoCo 3 ROM not found - skipping ROM hook test");
+    }
+
+    // Exponent, mantissa, sign and the extra byte below the mantissa
+    struct Fpa0 {
+        uint8_t exponent;
+        std::vector<uint8_t> mantissa;
+        uint8_t sign;
+        uint8_t extra;
+    };
+    const std::vector<Fpa0> cases = {
+        {0x81, {0x80, 0x00, 0x00, 0x00}, 0x00, 0x00},  // Already normal
+        {0x81, {0x40, 0x00, 0x00, 0x00}, 0xFF, 0x00},  // One bit
+        {0x90, {0x00, 0x01, 0x23, 0x45}, 0x00, 0x67},  // Bytes and bits
+        {0x90, {0x00, 0x00, 0x00, 0x00}, 0x00, 0x80},  // Only the extra byte
+        {0x90, {0x00, 0x00, 0x00, 0x00}, 0xFF, 0x00},  // Zero
+        {0x08, {0x00, 0x01, 0x00, 0x00}, 0x00, 0x00},  // Underflow
+        {0x0F, {0x00, 0x01, 0x00, 0x00}, 0x00, 0x00},  // Just no underflow
+        {0x0E, {0x00, 0x01, 0x00, 0x00}, 0x00, 0x00},  // Exactly zero exponent
+        {0x81, {0x80, 0x00, 0x12, 0x34}, 0x00, 0x80},  // Rounds up
+        {0x81, {0x80, 0x00, 0xFF, 0xFF}, 0x00, 0xC0},  // Carries into the top word
+        {0x81, {0xFF, 0xFF, 0xFF, 0xFF}, 0x00, 0x80},  // Carries into the exponent
+        {0x7F, {0xFF, 0xFF, 0xFF, 0xFF}, 0x00, 0x80},  // Exponent reaches $80
+        {0x84, {0x7F, 0xFF, 0xFF, 0xFF}, 0x00, 0xC0},  // Shifted then rounded
+    };
+
+    for (const CpuType type : {CpuType::MC6809, CpuType::HD6309}) {
+        for (const Fpa0& fpa0 : cases) {
+            for (const uint8_t cc : {0x50, 0x7F}) {
+                Registers in;
+                in.a = 0x11;
+                in.b = 0x22;
+                in.cc = cc;
+                in.x = 0x2508;
+                compare(type, 0xBA1C, in, [&](CPUTestHarness& cpu) {
+                    cpu.writeByte(0x004F, fpa0.exponent);
+                    cpu.loadProgram(0x0050, fpa0.mantissa);
+                    cpu.writeByte(0x0054, fpa0.sign);
+                    cpu.writeByte(0x0063, fpa0.extra);
+                });
+            }
+        }
+    }
+
+    // A result too big for the exponent is left to the ROM's OV ERROR
+    CPUTestHarness cpu;
+    cpu.writeByte(0x004F, 0xFF);
+    cpu.loadProgram(0x0050, {0xFF, 0xFF, 0xFF, 0xFF});
+    cpu.writeByte(0x0063, 0x80);
+    cpu.setS(Stack);
+    cutie::getRomHooks().setEnabled(true);
+    REQUIRE(cutie::getRomHooks().run(0xBA1C) == 0);
+    REQUIRE(cpu.readByte(0x004F) == 0xFF);
+    cutie::getRomHooks().setEnabled(false);
+}
+
+TEST_CASE("RomHooks: A RAM copy of BASIC is hooked only while it matches the ROM", "[romhooks]") {
+    if (!useStockRom()) {
+        SKIP("Stock CoCo 3 ROM not found - skipping ROM hook test");
+    }
+
+    CPUTestHarness cpu;
+    auto& hooks = cutie::getRomHooks();
+    hooks.setEnabled(true);
+    REQUIRE(hooks.isActive());
+    REQUIRE(MemLocate(0xBC5F) == (MemRomSpace | 0x3C5F));
+
+    // Copy the ROM to RAM and map all RAM, as the CoCo 3 does at power on
+    const unsigned char* rom = Getint_rom_pointer();
+    cpu.writeByte(0xFFDF, 0);
+    for (unsigned address = 0x8000; address < 0xFF00; ++address) {
+        cpu.writeByte(static_cast<uint16_t>(address), rom[address - 0x8000]);
+    }
+    REQUIRE(MemLocate(0xBC5F) < Get_mem_size());
+
+    cpu.loadProgram(0x1000, {0xBD, 0xBC, 0x5F, 0x20, 0xFE});  // JSR LBC5F, BRA *
+    cpu.setS(Stack);
+    cpu.setPC(0x1000);
+    cpu.step();
+    REQUIRE(cpu.step() == 37);
+    REQUIRE(hooks.calls() == 1);
+    REQUIRE(cpu.getState().PC == 0x1003);
+
+    // A patched routine runs on the CPU; TSTA becomes TSTB
+    cpu.writeByte(0xBC6B, 0x5D);
+    cpu.setPC(0x1000);
+    cpu.step();
+    REQUIRE(cpu.step() == 5);
+    REQUIRE(hooks.calls() == 1);
+
+    // And is hooked again once it is put back
+    cpu.writeByte(0xBC6B, 0x4D);
+    cpu.setPC(0x1000);
+    cpu.step();
+    REQUIRE(cpu.step() == 37);
+    REQUIRE(hooks.calls() == 2);
+
+    // Writes elsewhere in the bank only cost another compare
+    cpu.writeByte(0xA000, cpu.readByte(0xA000));
+    cpu.setPC(0x1000);
+    cpu.step();
+    REQUIRE(cpu.step() == 37);
+    REQUIRE(hooks.calls() == 3);
+    hooks.setEnabled(false);
+}
+
+TEST_CASE("RomHooks: Nothing is hooked without the stock ROM or in native 6309 mode", "[romhooks]") {
+    if (!useStockRom()) {
+        SKIP("Stock CoCo 3 ROM not found - skipping ROM hook test");
+    }
+    auto& hooks = cutie::getRomHooks();
+
+    {
+        CPUTestHarness cpu(CpuType::HD6309);
+        CPUExec = HD6309Exec;
+        cpu.loadProgram(0x1000, {0x11, 0x3D, 0x01});  // LDMD #1
+        cpu.setPC(0x1000);
+        cpu.step();
+        REQUIRE(cpu.getState().IsNative6309);
+        cpu.setS(Stack);
+        hooks.setEnabled(true);
+        REQUIRE(hooks.run(0xBC5F) == 0);
+        hooks.setEnabled(false);
+        CPUExec = MC6809Exec;
+    }
+
+    // No ROM at all reads as $FF everywhere, which is not the stock image
+    cutie::EmulationContext::instance().setSystemRomPath("");
+    CPUTestHarness cpu;
+    cpu.setS(Stack);
+    hooks.setEnabled(true);
+    REQUIRE(GetSystemRomHash() != RomHooks::StockRomHash);
+    REQUIRE_FALSE(hooks.isActive());
+    REQUIRE(hooks.run(0xBC5F) == 0);
+    hooks.setEnabled(false);
+}
@@ -0,0 +1,204 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+State Tests - Save states and the content-addressed state store
+*/
+
+#include <catch2/catch_test_macros.hpp>
+#include "cutie/context.h"
+#include "cutie/emulator.h"
+#include "cutie/statestore.h"
+#include "test_paths.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static std::unique_ptr<cutie::CocoEmulator> createEmulator(const fs::path& romPath, cutie::CpuType cpu) {
+    cutie::EmulationContext::instance().setSystemRomPath(romPath);
+    cutie::EmulatorConfig config;
+    config.systemRomPath = romPath;
+    config.cpuType = cpu;
+    config.audioSampleRate = 0;
+    auto emulator = cutie::CocoEmulator::create(config);
+    REQUIRE(emulator->init());
+    return emulator;
+}
+
+static std::vector<uint8_t> framebuffer(const cutie::CocoEmulator& emulator) {
+    const auto pixels = emulator.getFramebuffer();
+    return std::vector<uint8_t>(pixels.first, pixels.first + pixels.second);
+}
+
+// Unique per test run so that parallel ctest jobs never share a store
+class TempStore {
+public:
+    TempStore()
+        : m_path(fs::temp_directory_path() / ("cutiecoco-states-" + std::to_string(std::random_device()())))
+    {
+    }
+    ~TempStore() {
+        std::error_code ec;
+        fs::remove_all(m_path, ec);
+    }
+    const fs::path& path() const { return m_path; }
+
+private:
+    fs::path m_path;
+};
+
+TEST_CASE("State: Restoring a state replays the same frames", "[state]") {
+    const auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping state test");
+    }
+
+    for (auto cpu : {cutie::CpuType::MC6809, cutie::CpuType::HD6309}) {
+        auto emulator = createEmulator(romPath, cpu);
+        for (int frame = 0; frame < 60; ++frame) {
+            emulator->runFrame();
+        }
+
+        cutie::MachineState state;
+        REQUIRE(emulator->saveState(state));
+        REQUIRE(state.cpuType == cpu);
+
+        // Type into BASIC so the frames after the snapshot differ from it
+        emulator->setKeyState(1, 1, true);
+        for (int frame = 0; frame < 30; ++frame) {
+            emulator->runFrame();
+        }
+        emulator->setKeyState(1, 1, false);
+        for (int frame = 0; frame < 30; ++frame) {
+            emulator->runFrame();
+        }
+        const auto expectedPixels = framebuffer(*emulator);
+        cutie::MachineState expected;
+        REQUIRE(emulator->saveState(expected));
+
+        REQUIRE(emulator->loadState(state));
+        emulator->setKeyState(1, 1, true);
+        for (int frame = 0; frame < 30; ++frame) {
+            emulator->runFrame();
+        }
+        emulator->setKeyState(1, 1, false);
+        for (int frame = 0; frame < 30; ++frame) {
+            emulator->runFrame();
+        }
+        cutie::MachineState replayed;
+        REQUIRE(emulator->saveState(replayed));
+
+        REQUIRE(replayed.ram == expected.ram);
+        REQUIRE(replayed.devices == expected.devices);
+        REQUIRE(framebuffer(*emulator) == expectedPixels);
+    }
+}
+
+TEST_CASE("State: Mismatched or damaged states are refused", "[state]") {
+    const auto romPath = cutie::test::findSystemRomPath();
+    if (romPath.empty()) {
+        SKIP("System ROM not found - skipping state test");
+    }
+
+    auto emulator = createEmulator(romPath, cutie::CpuType::MC6809);
+    for (int frame = 0; frame < 10; ++frame) {
+        emulator->runFrame();
+    }
+    cutie::MachineState before;
+    REQUIRE(emulator->saveState(before));
+
+    SECTION("Different CPU") {
+        auto state = before;
+        state.cpuType = cutie::CpuType::HD6309;
+        REQUIRE_FALSE(emulator->loadState(state));
+    }
+
+    SECTION("Different system ROM") {
+        auto state = before;
+        state.systemRomHash ^= 1;
+        REQUIRE_FALSE(emulator->loadState(state));
+    }
+
+    SECTION("Truncated device blob") {
+        auto state = before;
+        state.ram.assign(state.ram.size(), 0x5A);
+        state.devices[1].second.pop_back();
+        REQUIRE_FALSE(emulator->loadState(state));
+    }
+
+    cutie::MachineState after;
+    REQUIRE(emulator->saveState(after));
+    REQUIRE(after.ram == before.ram);
+    REQUIRE(after.devices == before.devices);
+}
+
+TEST_CASE("StateStore: Pages and blobs are stored once", "[state][store]") {
+    TempStore temp;
+    cutie::StateStore store(temp.path());
+
+    cutie::MachineState state;
+    state.cpuType = cutie::CpuType::HD6309;
+    state.memorySize = cutie::MemorySize::Mem128K;
+    state.systemRomHash = 0x0123456789ABCDEFull;
+    state.ram.assign(128 * 1024, 0);
+    state.ram[5] = 1;
+    state.devices = {{"cpu", {1, 2, 3}}, {"mmu", {}}, {"pia", {1, 2, 3}}};
+
+    const auto id = store.save(state);
+    REQUIRE(id.size() == 64);
+    REQUIRE(store.contains(id));
+
+    // 15 zero pages, one other page, one non-empty blob and one empty blob
+    REQUIRE(store.stats().objectsWritten == 4);
+
+    cutie::MachineState loaded;
+    REQUIRE(store.load(id, loaded));
+    REQUIRE(loaded.cpuType == state.cpuType);
+    REQUIRE(loaded.memorySize == state.memorySize);
+    REQUIRE(loaded.systemRomHash == state.systemRomHash);
+    REQUIRE(loaded.ram == state.ram);
+    REQUIRE(loaded.devices == state.devices);
+
+    // Saving again is free, and a one byte change costs one page
+    REQUIRE(store.save(state) == id);
+    REQUIRE(store.stats().objectsWritten == 4);
+    state.ram[20000] = 7;
+    const auto changed = store.save(state);
+    REQUIRE(changed != id);
+    REQUIRE(store.stats().objectsWritten == 5);
+
+    // A second store on the same directory sees both states
+    cutie::StateStore reopened(temp.path());
+    REQUIRE(reopened.load(changed, loaded));
+    REQUIRE(loaded.ram == state.ram);
+}
+
+TEST_CASE("StateStore: Corrupt objects and bad ids are rejected", "[state][store]") {
+    TempStore temp;
+    cutie::StateStore store(temp.path());
+
+    cutie::MachineState state;
+    state.ram.assign(3 * cutie::StateStore::PageSize, 0x11);
+    state.devices = {{"cpu", {9, 9}}};
+    const auto id = store.save(state);
+    REQUIRE_FALSE(id.empty());
+
+    cutie::MachineState loaded;
+    REQUIRE_FALSE(store.load("../../etc/passwd", loaded));
+    REQUIRE_FALSE(store.load(std::string(64, '0'), loaded));
+    REQUIRE_FALSE(store.contains("states"));
+
+    // Flip a byte in every stored object
+    for (const auto& entry : fs::recursive_directory_iterator(temp.path() / "objects")) {
+        if (entry.is_regular_file() && entry.file_size() > 0) {
+            std::fstream file(entry.path(), std::ios::in | std::ios::out | std::ios::binary);
+            file.put(0x22);
+        }
+    }
+    REQUIRE_FALSE(store.load(id, loaded));
+    REQUIRE(loaded.ram.empty());
+}
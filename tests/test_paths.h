@@ -0,0 +1,42 @@
+/*
+Copyright 2024-2025 CutieCoCo Contributors
+This file is part of CutieCoCo.
+
+Test Paths - Locates shared test resources such as the system ROM.
+*/
+
+#ifndef CUTIE_TEST_PATHS_H
+#define CUTIE_TEST_PATHS_H
+
+#include <filesystem>
+
+namespace cutie {
+namespace test {
+
+/**
+ * @brief Directory containing coco3.rom, or an empty path if there is none
+ *
+ * The build passes the source tree's shared/system-roms, so ROM-dependent
+ * tests run wherever ctest is started. The relative candidates cover running
+ * a test binary by hand from another build layout.
+ */
+inline std::filesystem::path findSystemRomPath() {
+    namespace fs = std::filesystem;
+#ifdef CUTIECOCO_SYSTEM_ROM_DIR
+    if (fs::exists(fs::path(CUTIECOCO_SYSTEM_ROM_DIR) / "coco3.rom")) {
+        return CUTIECOCO_SYSTEM_ROM_DIR;
+    }
+#endif
+    for (const fs::path dir : {"system-roms", "../system-roms", "../../system-roms",
+                               "shared/system-roms", "../shared/system-roms", "../../shared/system-roms"}) {
+        if (fs::exists(dir / "coco3.rom")) {
+            return dir;
+        }
+    }
+    return "";
+}
+
+} // namespace test
+} // namespace cutie
+
+#endif // CUTIE_TEST_PATHS_H